@@ -39,10 +39,13 @@
 #include <ztd/text/char8_t.hpp>
 #include <ztd/text/encoding.hpp>
 #include <ztd/text/c_string_view.hpp>
+#include <ztd/text/simd_level.hpp>
 
 #include <ztd/text/encode.hpp>
 #include <ztd/text/decode.hpp>
 #include <ztd/text/transcode.hpp>
+#include <ztd/text/streaming_transcoder.hpp>
+#include <ztd/text/transcoding_streambuf.hpp>
 #include <ztd/text/count_code_units.hpp>
 #include <ztd/text/count_code_points.hpp>
 #include <ztd/text/validate_code_units.hpp>
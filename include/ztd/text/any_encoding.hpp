@@ -1027,6 +1027,16 @@ namespace ztd { namespace text {
 		any_byte_encoding& operator=(any_byte_encoding&&) = default;
 	};
 
+	namespace __detail {
+		template <typename _EncodeCodeUnits, typename _EncodeCodePoints, typename _DecodeCodeUnits,
+			typename _DecodeCodePoints, ::std::size_t _MaxCodeUnits, ::std::size_t _MaxCodePoints>
+		class __is_library_encoding<any_encoding_with<_EncodeCodeUnits, _EncodeCodePoints, _DecodeCodeUnits,
+			_DecodeCodePoints, _MaxCodeUnits, _MaxCodePoints>> : public ::std::true_type { };
+
+		template <typename _Byte, typename _CodePoint>
+		class __is_library_encoding<any_byte_encoding<_Byte, _CodePoint>> : public ::std::true_type { };
+	} // namespace __detail
+
 	//////
 	/// @brief The canonical erased encoding type which uses a @c std::byte as its code unit type and an @c
 	/// unicode_code_point as its code point type, with spans for input and output operations.
@@ -161,17 +161,12 @@ namespace ztd { namespace text {
 			auto __outit   = __detail::__adl::__adl_begin(__output);
 			auto __outlast = __detail::__adl::__adl_end(__output);
 
-			if constexpr (__call_error_handler) {
-				if (__outit == __outlast) {
-					return __error_handler(ascii {},
-						_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-						     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
-						     __s, encoding_error::insufficient_output_space),
-						::ztd::text::span<code_unit, 0>());
-				}
-			}
-			else {
-				(void)__outlast;
+			if (__outit == __outlast) {
+				return __error_handler(ascii {},
+					_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+					     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+					     __s, encoding_error::insufficient_output_space),
+					::ztd::text::span<code_unit, 0>());
 			}
 
 			code_unit __units[1] {};
@@ -192,8 +187,9 @@ namespace ztd { namespace text {
 			__detail::__dereference(__outit) = __unit;
 			__outit                          = __detail::__next(__outit);
 
-			return _Result(::std::move(__init), ::std::move(__inlast), ::std::move(__outit), ::std::move(__outlast),
-				__s, encoding_error::ok);
+			return _Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+				__detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast), __s,
+				encoding_error::ok);
 		}
 
 		//////
@@ -234,17 +230,12 @@ namespace ztd { namespace text {
 			auto __outit   = __detail::__adl::__adl_begin(__output);
 			auto __outlast = __detail::__adl::__adl_end(__output);
 
-			if constexpr (__call_error_handler) {
-				if (__outit == __outlast) {
-					return __error_handler(ascii {},
-						_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-						     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
-						     __s, encoding_error::insufficient_output_space),
-						::ztd::text::span<code_point, 0>());
-				}
-			}
-			else {
-				(void)__outlast;
+			if (__outit == __outlast) {
+				return __error_handler(ascii {},
+					_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+					     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+					     __s, encoding_error::insufficient_output_space),
+					::ztd::text::span<code_point, 0>());
 			}
 
 			code_point __points[1] {};
@@ -272,6 +263,11 @@ namespace ztd { namespace text {
 		}
 	};
 
+	namespace __detail {
+		template <typename _CodeUnit, typename _CodePoint>
+		class __is_library_encoding<basic_ascii<_CodeUnit, _CodePoint>> : public ::std::true_type { };
+	} // namespace __detail
+
 
 	//////
 	/// @brief The American Standard Code for Information Exchange (ASCII) Encoding.
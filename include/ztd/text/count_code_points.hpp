@@ -106,45 +106,43 @@ namespace ztd { namespace text {
 				              _Input, _ErrorHandler, _State>) {
 
 				::std::size_t __code_point_count = 0;
+				bool __handled_error             = false;
 
-				for (;;) {
+				while (!__detail::__adl::__adl_empty(__working_input)) {
 					auto __result = __encoding.count_code_points_one(
 						::std::move(__working_input), __error_handler, __state);
+					__handled_error |= __result.handled_error;
 					if (__result.error_code != encoding_error::ok) {
 						return _Result(::std::move(__result.input), __code_point_count, __state,
-							__result.error_code, false);
+							__result.error_code, __handled_error);
 					}
 					__code_point_count += __result.count;
 					__working_input = ::std::move(__result.input);
-					if (__detail::__adl::__adl_empty(__working_input)) {
-						break;
-					}
 				}
-				return _Result(
-					::std::move(__working_input), __code_point_count, __state, encoding_error::ok, false);
+				return _Result(::std::move(__working_input), __code_point_count, __state, encoding_error::ok,
+					__handled_error);
 			}
 			else {
 				using _CodePoint = code_point_t<_UEncoding>;
 
 				::std::size_t __code_point_count = 0;
+				bool __handled_error             = false;
 
 				_CodePoint __code_point_buf[max_code_points_v<_UEncoding>];
 
-				for (;;) {
+				while (!__detail::__adl::__adl_empty(__working_input)) {
 					auto __result = __detail::__basic_count_code_points_one(
 						::std::move(__working_input), __encoding, __code_point_buf, __error_handler, __state);
+					__handled_error |= __result.handled_error;
 					if (__result.error_code != encoding_error::ok) {
 						return _Result(::std::move(__result.input), __code_point_count, __state,
-							__result.error_code, false);
+							__result.error_code, __handled_error);
 					}
 					__code_point_count += __result.count;
 					__working_input = ::std::move(__result.input);
-					if (__detail::__adl::__adl_empty(__working_input)) {
-						break;
-					}
 				}
-				return _Result(
-					::std::move(__working_input), __code_point_count, __state, encoding_error::ok, false);
+				return _Result(::std::move(__working_input), __code_point_count, __state, encoding_error::ok,
+					__handled_error);
 			}
 		}
 	}
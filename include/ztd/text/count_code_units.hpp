@@ -106,7 +106,7 @@ namespace ztd { namespace text {
 
 				::std::size_t __code_point_count = 0;
 
-				for (;;) {
+				while (!__detail::__adl::__adl_empty(__working_input)) {
 					auto __result = __encoding.count_code_units_one(__working_input, __error_handler, __state);
 					if (__result.error_code != encoding_error::ok) {
 						return _Result(::std::move(__result.input), __code_point_count, __state,
@@ -114,9 +114,6 @@ namespace ztd { namespace text {
 					}
 					__code_point_count += __result.count;
 					__working_input = ::std::move(__result.input);
-					if (__detail::__adl::__adl_empty(__working_input)) {
-						break;
-					}
 				}
 				return _Result(
 					::std::move(__working_input), __code_point_count, __state, encoding_error::ok, false);
@@ -129,7 +126,7 @@ namespace ztd { namespace text {
 				_CodeUnit __code_unit_buf[max_code_units_v<_UEncoding>];
 				::ztd::text::span<_CodeUnit, max_code_units_v<_UEncoding>> __buf_view(__code_unit_buf);
 
-				for (;;) {
+				while (!__detail::__adl::__adl_empty(__working_input)) {
 					auto __result = __detail::__basic_count_code_units_one(
 						__working_input, __encoding, __error_handler, __state);
 					if (__result.error_code != encoding_error::ok) {
@@ -138,9 +135,6 @@ namespace ztd { namespace text {
 					}
 					__code_point_count += __result.count;
 					__working_input = ::std::move(__result.input);
-					if (__detail::__adl::__adl_empty(__working_input)) {
-						break;
-					}
 				}
 				return _Result(
 					::std::move(__working_input), __code_point_count, __state, encoding_error::ok, false);
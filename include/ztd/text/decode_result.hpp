@@ -191,12 +191,12 @@ namespace ztd { namespace text {
 		}
 
 		template <typename _Input, typename _Output, typename _State, typename _DesiredOutput>
-		constexpr decode_result<_Input, __detail::__remove_cvref_t<_DesiredOutput>, _State> __replace_result_output(
+		constexpr decode_result<_Input, _DesiredOutput, _State> __replace_result_output(
 			decode_result<_Input, _Output, _State>&& __result,
 			_DesiredOutput&&
 			     __desired_output) noexcept(::std::is_nothrow_constructible_v<decode_result<_Input, _Output, _State>,
 			_Input&&, _DesiredOutput, _State&, encoding_error, bool>) {
-			using _Result = decode_result<_Input, __detail::__remove_cvref_t<_DesiredOutput>, _State>;
+			using _Result = decode_result<_Input, _DesiredOutput, _State>;
 			return _Result(::std::move(__result.input), ::std::forward<_DesiredOutput>(__desired_output),
 				__result.state, __result.error_code, __result.handled_error);
 		}
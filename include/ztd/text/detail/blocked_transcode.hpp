@@ -0,0 +1,226 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_BLOCKED_TRANSCODE_HPP
+#define ZTD_TEXT_DETAIL_BLOCKED_TRANSCODE_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/code_point.hpp>
+#include <ztd/text/encode.hpp>
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/error_handler.hpp>
+#include <ztd/text/transcode_result.hpp>
+#include <ztd/text/detail/transcode_one.hpp>
+#include <ztd/text/detail/adl.hpp>
+#include <ztd/text/detail/encoding_range.hpp>
+#include <ztd/text/detail/range.hpp>
+#include <ztd/text/detail/reconstruct.hpp>
+#include <ztd/text/detail/span.hpp>
+#include <ztd/text/detail/type_traits.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		//////
+		/// @brief How many code points the blocked transcoding loop decodes before it encodes them all.
+		//////
+		inline constexpr ::std::size_t __blocked_transcode_size = 256;
+
+		//////
+		/// @brief Whether the blocked transcoding loop should be used.
+		///
+		/// @remarks It is meant for encodings written outside of this library, which usually only have an
+		/// @c encode_one (and maybe a @c text_encode extension point): the encodings in this library are left out,
+		/// since the plain loop already has every @c encode_one call of theirs inlined into it, and measurements
+		/// (including the internal bulk paths of UTF-8) showed the plain loop to be as fast or faster for all of
+		/// them. Both the input and the output have to be visitable more than once, and the encoding state has to be
+		/// copyable, so that a block which fails to encode can be encoded again from its start; the decoding state
+		/// has to be empty, so that it never has to be rolled back along with the input.
+		//////
+		template <typename _WorkingInput, typename _FromEncoding, typename _WorkingOutput, typename _ToEncoding,
+			typename _FromState, typename _ToState>
+		inline constexpr bool __is_blocked_transcodable_v = !__is_library_encoding_v<_ToEncoding>
+			&& ::std::is_empty_v<_FromState> && ::std::is_copy_constructible_v<_ToState>
+			&& ::std::is_copy_assignable_v<_ToState>
+			&& __is_range_iterator_concept_or_better_v<::std::forward_iterator_tag, _WorkingInput>
+			&& __is_range_iterator_concept_or_better_v<::std::forward_iterator_tag, _WorkingOutput>;
+
+		//////
+		/// @brief The same loop as the one ztd::text::transcode_into uses, except that it decodes up to
+		/// ztd::text::__detail::__blocked_transcode_size code points into a buffer on the stack, then encodes all of
+		/// them with one call to ztd::text::encode_into, rather than going back and forth between the two encodings
+		/// for every code point.
+		///
+		/// @remarks The result is exactly the one the plain loop produces: if encoding a code point fails, the input
+		/// and the output are pointed back at where they were before the @c decode_one call that produced it, and if
+		/// decoding fails, the code points before it are encoded first. A block is first encoded with a
+		/// ztd::text::pass_handler, so that the encoding error handler is never called there: only if that fails is
+		/// the block encoded again, one @c decode_one call's code points at a time, with the encoding error handler.
+		/// That way it is called exactly as often as in the plain loop. The only difference is that, when encoding
+		/// fails, the decoding error handler may have already been called for a later code point in the same block.
+		//////
+		template <typename _Input, typename _FromEncoding, typename _Output, typename _ToEncoding,
+			typename _FromErrorHandler, typename _ToErrorHandler, typename _FromState, typename _ToState>
+		constexpr auto __blocked_transcode(_Input&& __input, _FromEncoding& __from_encoding, _Output&& __output,
+			_ToEncoding& __to_encoding, _FromErrorHandler& __from_error_handler, _ToErrorHandler& __to_error_handler,
+			_FromState& __from_state, _ToState& __to_state) {
+			using _UInput                = __remove_cvref_t<_Input>;
+			using _UOutput               = __remove_cvref_t<_Output>;
+			using _InputValueType        = __range_value_type_t<_UInput>;
+			using _WorkingInput          = __reconstruct_t<::std::conditional_t<::std::is_array_v<_UInput>,
+                    ::std::conditional_t<__is_character_v<_InputValueType>, ::std::basic_string_view<_InputValueType>,
+                         ::ztd::text::span<const _InputValueType>>,
+                    _UInput>>;
+			using _WorkingOutput         = __reconstruct_t<_UOutput>;
+			using _InputIterator         = __range_iterator_t<_WorkingInput>;
+			using _InputSentinel         = __range_sentinel_t<_WorkingInput>;
+			using _UFromEncoding         = __remove_cvref_t<_FromEncoding>;
+			using _IntermediateCodePoint = code_point_t<_UFromEncoding>;
+			using _Intermediate          = ::ztd::text::span<_IntermediateCodePoint>;
+			using _Result = __reconstruct_transcode_result_t<_WorkingInput, _WorkingOutput, _FromState, _ToState>;
+			constexpr ::std::size_t _MaxCodePoints = max_code_points_v<_UFromEncoding>;
+			constexpr ::std::size_t _BlockSize
+				= _MaxCodePoints > __blocked_transcode_size ? _MaxCodePoints : __blocked_transcode_size;
+
+			_WorkingInput __working_input(
+				__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
+			_WorkingOutput __working_output(
+				__reconstruct(::std::in_place_type<_WorkingOutput>, ::std::forward<_Output>(__output)));
+
+			_IntermediateCodePoint __block[_BlockSize] {};
+			_InputIterator __step_input_lasts[_BlockSize] {};
+			::std::size_t __step_code_points_lasts[_BlockSize] {};
+			bool __step_handled_errors[_BlockSize] {};
+			bool __handled_error = false;
+			for (;;) {
+				_InputIterator __block_first = __adl::__adl_begin(__working_input);
+				_InputSentinel __input_last  = __adl::__adl_end(__working_input);
+				_WorkingInput __block_input  = ::std::move(__working_input);
+				::std::size_t __step_count   = 0;
+				::std::size_t __code_points  = 0;
+				encoding_error __decode_error_code = encoding_error::ok;
+				bool __decode_handled_error        = false;
+				// decode: stop when the block is full, or at the first error that could not be handled
+				while (__step_count < _BlockSize && (_BlockSize - __code_points) >= _MaxCodePoints
+					&& !__adl::__adl_empty(__block_input)) {
+					_IntermediateCodePoint* __decode_first = __block + __code_points;
+					subrange<_IntermediateCodePoint*> __decode_output(
+						__decode_first, __decode_first + _MaxCodePoints);
+					auto __decode_result = __basic_decode_one<__consume::__no>(::std::move(__block_input),
+						__from_encoding, __decode_output, __from_error_handler, __from_state);
+					if (__decode_result.error_code != encoding_error::ok) {
+						__decode_error_code    = __decode_result.error_code;
+						__decode_handled_error = __decode_result.handled_error;
+						break;
+					}
+					__code_points += static_cast<::std::size_t>(
+						__adl::__adl_begin(__decode_result.output) - __decode_first);
+					__block_input = ::std::move(__decode_result.input);
+					__handled_error |= __decode_result.handled_error;
+					__step_input_lasts[__step_count]       = __adl::__adl_begin(__block_input);
+					__step_code_points_lasts[__step_count] = __code_points;
+					__step_handled_errors[__step_count]    = __decode_result.handled_error;
+					++__step_count;
+				}
+				// encode: the whole block at once, so the encoding's own bulk encode gets used; errors are only
+				// passed through here, so that the error handler is not called for the same code point twice
+				if (__code_points != 0) {
+					_WorkingOutput __block_output = __working_output;
+					_ToState __block_to_state     = __to_state;
+					_Intermediate __encode_input(__block + 0, __code_points);
+					pass_handler __block_error_handler {};
+					auto __encode_result = encode_into(
+						__encode_input, __to_encoding, __working_output, __block_error_handler, __to_state);
+					if (__encode_result.error_code == encoding_error::ok) {
+						__working_output = ::std::move(__encode_result.output);
+					}
+					else {
+						// the plain loop stops with both the input and the output where they were before the
+						// decode_one call whose code points failed to encode (or were fixed up by the error
+						// handler): go back to the start of the block and encode it again, one such call at a
+						// time and with the real error handler, to find where that is
+						__working_output = ::std::move(__block_output);
+						__to_state       = ::std::move(__block_to_state);
+						for (::std::size_t __step_index = 0; __step_index < __step_count; ++__step_index) {
+							const ::std::size_t __step_code_points_first
+								= __step_index == 0 ? 0 : __step_code_points_lasts[__step_index - 1];
+							_Intermediate __step_encode_input(__block + __step_code_points_first,
+								__step_code_points_lasts[__step_index] - __step_code_points_first);
+							auto __step_result = encode_into(__step_encode_input, __to_encoding,
+								__working_output, __to_error_handler, __to_state);
+							if (__step_result.error_code != encoding_error::ok) {
+								_InputIterator __step_first = __step_index == 0
+									? __block_first
+									: __step_input_lasts[__step_index - 1];
+								return _Result(__reconstruct(::std::in_place_type<_WorkingInput>,
+									               ::std::move(__step_first), ::std::move(__input_last)),
+									::std::move(__working_output), __from_state, __to_state,
+									__step_result.error_code,
+									__step_handled_errors[__step_index] || __step_result.handled_error);
+							}
+							__handled_error |= __step_result.handled_error;
+							__working_output = ::std::move(__step_result.output);
+						}
+					}
+				}
+				if (__decode_error_code != encoding_error::ok) {
+					_InputIterator __step_first
+						= __step_count == 0 ? __block_first : __step_input_lasts[__step_count - 1];
+					return _Result(__reconstruct(::std::in_place_type<_WorkingInput>, ::std::move(__step_first),
+						               ::std::move(__input_last)),
+						::std::move(__working_output), __from_state, __to_state, __decode_error_code,
+						__decode_handled_error);
+				}
+				__working_input = ::std::move(__block_input);
+				if (__adl::__adl_empty(__working_input)) {
+					break;
+				}
+			}
+			return _Result(::std::move(__working_input), ::std::move(__working_output), __from_state, __to_state,
+				encoding_error::ok, __handled_error);
+		}
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_BLOCKED_TRANSCODE_HPP
@@ -0,0 +1,221 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_BULK_HPP
+#define ZTD_TEXT_DETAIL_BULK_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/unbounded.hpp>
+#include <ztd/text/detail/adl.hpp>
+#include <ztd/text/detail/memory.hpp>
+#include <ztd/text/detail/range.hpp>
+#include <ztd/text/detail/reconstruct.hpp>
+#include <ztd/text/detail/type_traits.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		//////
+		/// @brief The result of a bulk check over a contiguous buffer: how far it got, and why it stopped.
+		///
+		/// @remarks If @c error is ztd::text::encoding_error::ok, @c offset is the size of the input. Otherwise,
+		/// @c offset is the index of the first code unit of the sequence that failed.
+		//////
+		struct __bulk_result {
+			::std::size_t offset;
+			encoding_error error;
+		};
+
+		//////
+		/// @brief The result of a bulk conversion kernel: how many input units were consumed and how many output
+		/// units were written.
+		///
+		/// @remarks Kernels only ever consume complete, valid input sequences whose output fits entirely. They stop
+		/// right before anything else (an error, a truncated sequence, or not enough output space) so that the
+		/// one-at-a-time encoding functions can deal with it, error handlers and all.
+		//////
+		struct __bulk_io {
+			::std::size_t input_read;
+			::std::size_t output_written;
+		};
+
+		//////
+		/// @brief Whether the bulk (run-time only) kernels may be used right now.
+		//////
+		constexpr bool __is_bulk_allowed() noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_STD_LIBRARY_IS_CONSTANT_EVALUATED_I_)
+			return !::std::is_constant_evaluated();
+#else
+			// without a way to tell, only the constexpr-capable paths can be used
+			return false;
+#endif
+		}
+
+		template <typename _Type, ::std::size_t _Size, typename = void>
+		struct __is_bulk_unit : ::std::false_type { };
+
+		template <typename _Type, ::std::size_t _Size>
+		struct __is_bulk_unit<_Type, _Size, ::std::enable_if_t<::std::is_integral_v<_Type>>>
+		: ::std::integral_constant<bool, sizeof(_Type) == _Size> { };
+
+		template <typename _Type, ::std::size_t _Size>
+		inline constexpr bool __is_bulk_unit_v = __is_bulk_unit<_Type, _Size>::value;
+
+		template <typename _Input, ::std::size_t _UnitSize, typename = void>
+		struct __is_bulk_input : ::std::false_type { };
+
+		template <typename _Input, ::std::size_t _UnitSize>
+		struct __is_bulk_input<_Input, _UnitSize,
+			::std::enable_if_t<__is_sized_contiguous_range_v<_Input>>>
+		: ::std::integral_constant<bool,
+			  __is_bulk_unit_v<__remove_cvref_t<__range_value_type_t<_Input>>, _UnitSize>> { };
+
+		//////
+		/// @brief Whether or not @p _Input is a contiguous, sized range of integral @p _UnitSize -byte units.
+		//////
+		template <typename _Input, ::std::size_t _UnitSize>
+		inline constexpr bool __is_bulk_input_v = __is_bulk_input<__remove_cvref_t<_Input>, _UnitSize>::value;
+
+		template <typename _Iterator, typename _Unit>
+		using __detect_output_assign = decltype(*::std::declval<_Iterator&>() = ::std::declval<_Unit>());
+
+		template <typename _Output, typename _OutputUnit, typename = void>
+		struct __bulk_output_kind : ::std::integral_constant<int, 0> { };
+
+		template <typename _Output, typename _OutputUnit>
+		struct __bulk_output_kind<_Output, _OutputUnit,
+			::std::enable_if_t<__is_sized_contiguous_range_v<_Output>>>
+		: ::std::integral_constant<int,
+			  (__is_bulk_unit_v<__range_value_type_t<_Output>, sizeof(_OutputUnit)>
+			       && !::std::is_const_v<::std::remove_reference_t<__range_reference_t<_Output>>>)
+			       ? 1
+			       : 0> { };
+
+		template <typename _Iterator, typename _OutputUnit>
+		struct __bulk_output_kind<unbounded_view<_Iterator>, _OutputUnit, void>
+		: ::std::integral_constant<int,
+			  (__is_iterator_concept_or_better_v<contiguous_iterator_tag,
+			        _Iterator> && __is_bulk_unit_v<__iterator_value_type_t<_Iterator>, sizeof(_OutputUnit)>)
+			       ? 2
+			       : (__is_detected_v<__detect_output_assign, _Iterator, _OutputUnit> ? 3 : 0)> { };
+
+		//////
+		/// @brief How the bulk kernels can write into @p _Output : not at all (0), directly into a sized contiguous
+		/// range (1), directly into an unbounded contiguous range (2), or through a small buffer which is then
+		/// written out through the output's iterator, e.g. a @c std::back_insert_iterator (3).
+		//////
+		template <typename _Output, typename _OutputUnit>
+		inline constexpr int __bulk_output_kind_v = __bulk_output_kind<__remove_cvref_t<_Output>, _OutputUnit>::value;
+
+		template <typename _Output, typename _OutputUnit>
+		inline constexpr bool __is_bulk_output_v = __bulk_output_kind_v<_Output, _OutputUnit> != 0;
+
+		inline constexpr ::std::size_t __bulk_buffer_size = 2048;
+
+		//////
+		/// @brief Runs @p __kernel over as much of @p __input as it can take, writing into @p __output and moving
+		/// both past what was read and written.
+		///
+		/// @tparam _OutputUnit The type of unit the kernel produces, when the output itself does not say (e.g. an
+		/// unbounded_view of a back inserter).
+		///
+		/// @remarks Run-time only: @p __input must satisfy ztd::text::__detail::__is_bulk_input_v and @p __output
+		/// must satisfy ztd::text::__detail::__is_bulk_output_v. Not @c noexcept : writing through the output's
+		/// iterator (e.g. a @c std::back_insert_iterator ) can allocate, and so throw.
+		//////
+		template <typename _OutputUnit, typename _WorkingInput, typename _WorkingOutput, typename _Kernel>
+		void __bulk_advance(_WorkingInput& __input, _WorkingOutput& __output, _Kernel __kernel) {
+			using _InputDifference = __range_difference_type_t<_WorkingInput>;
+			constexpr int _OutputKind = __bulk_output_kind_v<_WorkingOutput, _OutputUnit>;
+
+			auto __in_first = __adl::__adl_begin(__input);
+			auto __in_last  = __adl::__adl_end(__input);
+			const auto* __in_pointer       = __adl::__adl_to_address(__in_first);
+			const ::std::size_t __in_size = static_cast<::std::size_t>(__in_last - __in_first);
+			::std::size_t __in_read       = 0;
+
+			if constexpr (_OutputKind == 1 || _OutputKind == 2) {
+				using _OutputDifference = __range_difference_type_t<_WorkingOutput>;
+				auto __out_first        = __adl::__adl_begin(__output);
+				auto __out_last         = __adl::__adl_end(__output);
+				auto* __out_pointer     = __adl::__adl_to_address(__out_first);
+				::std::size_t __out_size;
+				if constexpr (_OutputKind == 1) {
+					__out_size = static_cast<::std::size_t>(__out_last - __out_first);
+				}
+				else {
+					// unbounded: only the input bounds how much gets written
+					__out_size = (::std::numeric_limits<::std::size_t>::max)() / 8;
+				}
+				const __bulk_io __result = __kernel(__in_pointer, __in_size, __out_pointer, __out_size);
+				__in_read                = __result.input_read;
+				__output = __reconstruct(::std::in_place_type<_WorkingOutput>,
+					__out_first + static_cast<_OutputDifference>(__result.output_written), __out_last);
+			}
+			else {
+				static_assert(_OutputKind == 3, "the output for a bulk operation must be writable");
+				_OutputUnit __buffer[__bulk_buffer_size / sizeof(_OutputUnit)];
+				auto __out_first = __adl::__adl_begin(__output);
+				for (;;) {
+					const __bulk_io __result = __kernel(__in_pointer + __in_read, __in_size - __in_read,
+						__buffer + 0, __adl::__adl_size(__buffer));
+					for (::std::size_t __index = 0; __index < __result.output_written; ++__index) {
+						*__out_first = __buffer[__index];
+						++__out_first;
+					}
+					__in_read += __result.input_read;
+					if (__result.input_read == 0 || __in_read == __in_size) {
+						break;
+					}
+				}
+				__output = __reconstruct(
+					::std::in_place_type<_WorkingOutput>, ::std::move(__out_first), __adl::__adl_end(__output));
+			}
+			__input = __reconstruct(::std::in_place_type<_WorkingInput>,
+				__in_first + static_cast<_InputDifference>(__in_read), __in_last);
+		}
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_BULK_HPP
@@ -0,0 +1,168 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_BULK_COPY_HPP
+#define ZTD_TEXT_DETAIL_BULK_COPY_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/code_unit.hpp>
+#include <ztd/text/state.hpp>
+#include <ztd/text/forward.hpp>
+#include <ztd/text/is_ignorable_error_handler.hpp>
+#include <ztd/text/is_transcoding_compatible.hpp>
+#include <ztd/text/max_transcode_expansion.hpp>
+#include <ztd/text/detail/bulk.hpp>
+#include <ztd/text/detail/bulk_transcode.hpp>
+#include <ztd/text/detail/type_traits.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		enum class __bitwise_copy_cut {
+			// only the whole input can be copied: where its sequences end is unknown
+			__whole,
+			// every code unit is a complete sequence
+			__anywhere,
+			// UTF-8 and its variants: never right before a continuation byte
+			__before_lead_byte,
+			// UTF-16: never right before a trailing surrogate
+			__before_non_trail_surrogate
+		};
+
+		// whether wide_execution works with UTF-32 code units, which is what lets it be copied to and from
+		// UTF-32 (see its ztd::text::is_bitwise_transcoding_compatible specializations)
+		template <typename _Encoding>
+		inline constexpr bool __is_utf32_wide_execution_v =
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_WCHAR_T_UTF32_COMPATIBLE_I_) && ZTD_TEXT_IS_OFF(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+			::std::is_same_v<_Encoding, wide_execution> && sizeof(wchar_t) == sizeof(char32_t);
+#else
+			false;
+#endif
+
+		// clang-format off
+		template <typename _Encoding>
+		inline constexpr __bitwise_copy_cut __bitwise_copy_cut_v
+			= (__is_ascii_encoding<_Encoding>::value || ::std::is_base_of_v<__impl::__utf32_tag, _Encoding>
+				|| __is_utf32_wide_execution_v<_Encoding>)
+			? __bitwise_copy_cut::__anywhere
+			: ::std::is_base_of_v<__impl::__utf8_tag, _Encoding>
+				? __bitwise_copy_cut::__before_lead_byte
+				: ::std::is_base_of_v<__impl::__utf16_tag, _Encoding>
+					? __bitwise_copy_cut::__before_non_trail_surrogate
+					: __bitwise_copy_cut::__whole;
+		// clang-format on
+
+		//////
+		/// @brief A bulk transcoding kernel for encodings that are ztd::text::is_bitwise_transcoding_compatible: the
+		/// input is valid (it is only used with an ignorable error handler), so it is copied as-is.
+		///
+		/// @remarks When the output cannot take all of the input, as much as possible is copied up to the end of
+		/// the last complete sequence of @p _FromEncoding that fits. If that cannot be told for @p _FromEncoding,
+		/// nothing is copied and the rest is left to the one-at-a-time loop.
+		//////
+		template <typename _FromEncoding>
+		struct __bitwise_copy_kernel {
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				static_assert(sizeof(_InputUnit) == sizeof(_OutputUnit),
+					"bitwise-compatible encodings must have code units of the same size");
+				constexpr __bitwise_copy_cut _Cut = __bitwise_copy_cut_v<_FromEncoding>;
+				::std::size_t __size              = __input_size;
+				if (__output_size < __input_size) {
+					__size = __output_size;
+					if constexpr (_Cut == __bitwise_copy_cut::__whole) {
+						__size = 0;
+					}
+					else if constexpr (_Cut == __bitwise_copy_cut::__before_lead_byte) {
+						while (__size > 0 && (static_cast<unsigned char>(__input[__size]) & 0xC0) == 0x80) {
+							--__size;
+						}
+					}
+					else if constexpr (_Cut == __bitwise_copy_cut::__before_non_trail_surrogate) {
+						const ::std::uint_least16_t __unit = static_cast<::std::uint_least16_t>(__input[__size]);
+						if (__size > 0 && __unit >= 0xDC00 && __unit <= 0xDFFF) {
+							--__size;
+						}
+					}
+				}
+				if (__size != 0) {
+					::std::memcpy(__output, __input, __size * sizeof(_InputUnit));
+				}
+				return __bulk_io { __size, __size };
+			}
+		};
+
+		template <typename _FromEncoding, typename _ToEncoding>
+		inline constexpr bool __is_bitwise_copy_stateless_v
+			= __bitwise_copy_cut_v<_FromEncoding> != __bitwise_copy_cut::__whole
+			|| (::std::is_empty_v<decode_state_t<_FromEncoding>> && ::std::is_empty_v<encode_state_t<_ToEncoding>>);
+
+		template <typename _Input, typename _FromEncoding, typename _Output, typename _ToEncoding,
+			typename _FromErrorHandler, typename = void>
+		struct __is_bulk_copyable : ::std::false_type { };
+
+		template <typename _Input, typename _FromEncoding, typename _Output, typename _ToEncoding,
+			typename _FromErrorHandler>
+		struct __is_bulk_copyable<_Input, _FromEncoding, _Output, _ToEncoding, _FromErrorHandler,
+			::std::enable_if_t<is_bitwise_transcoding_compatible_v<_FromEncoding, _ToEncoding>>>
+		: ::std::integral_constant<bool,
+			  is_ignorable_error_handler_v<_FromErrorHandler>
+			       && sizeof(code_unit_t<_FromEncoding>) == sizeof(code_unit_t<_ToEncoding>)
+			       && __is_bitwise_copy_stateless_v<_FromEncoding, _ToEncoding>
+			       && __is_bulk_transcodable_v<_Input, sizeof(code_unit_t<_FromEncoding>), _Output,
+			            code_unit_t<_ToEncoding>>> { };
+
+		//////
+		/// @brief Whether ztd::text::transcode_into can convert @p _Input to @p _Output by copying it: the encodings
+		/// are bitwise-compatible and stateless, the input and output are contiguous, and the error handler for the
+		/// decoding side is ignorable (so the input does not have to be checked first).
+		//////
+		template <typename _Input, typename _FromEncoding, typename _Output, typename _ToEncoding,
+			typename _FromErrorHandler>
+		inline constexpr bool __is_bulk_copyable_v = __is_bulk_copyable<_Input, __remove_cvref_t<_FromEncoding>,
+			_Output, __remove_cvref_t<_ToEncoding>, __remove_cvref_t<_FromErrorHandler>>::value;
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_BULK_COPY_HPP
@@ -0,0 +1,359 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_BULK_EXECUTION_HPP
+#define ZTD_TEXT_DETAIL_BULK_EXECUTION_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/detail/bulk.hpp>
+#include <ztd/text/detail/bulk_utf8.hpp>
+#include <ztd/text/detail/encoding_name.hpp>
+#include <ztd/text/detail/unicode.hpp>
+#include <ztd/text/detail/simd.hpp>
+#include <ztd/text/detail/windows.hpp>
+#include <ztd/text/detail/posix.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		//////
+		/// @brief How the locale-based execution encodings can be converted in bulk: not at all, with the UTF-8
+		/// kernels (the locale is UTF-8), or with the C library's whole-string conversion functions (the locale is
+		/// some other encoding without shift states, and @c wchar_t holds code points).
+		//////
+		enum class __execution_bulk_kind { __none, __utf8, __wide };
+
+		inline bool __is_active_code_page_utf8() noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+			return __windows::__determine_active_code_page() == CP_UTF8;
+#elif ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_UNIX_I_)
+			return __posix::__determine_active_code_page() == __encoding_id::__utf8;
+#else
+			return false;
+#endif
+		}
+
+		//////
+		/// @brief Picks the bulk kernel for a locale, given whether its encoding is UTF-8 and whether it has shift
+		/// states.
+		///
+		/// @remarks Shift states (e.g. ISO-2022-JP) rule out the C library's conversions: the kernels always start
+		/// from the initial shift state and have no way to hand a different one back, so those are left to the
+		/// encodings.
+		//////
+		inline __execution_bulk_kind __execution_bulk_kind_for(bool __is_utf8, bool __has_shift_states) noexcept {
+			if (__is_utf8) {
+				return __execution_bulk_kind::__utf8;
+			}
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_UNIX_I_) && ZTD_TEXT_IS_ON(ZTD_TEXT_WCHAR_T_UTF32_COMPATIBLE_I_)
+			if (!__has_shift_states) {
+				return __execution_bulk_kind::__wide;
+			}
+#else
+			(void)__has_shift_states;
+#endif
+			return __execution_bulk_kind::__none;
+		}
+
+		//////
+		/// @brief Looks at the current locale once, so that a whole conversion can pick its bulk kernel up front
+		/// rather than asking again for every code point.
+		///
+		/// @remarks Whether the locale has shift states is worked out from its encoding, rather than asked of the C
+		/// library, so this is safe to call from any thread.
+		//////
+		inline __execution_bulk_kind __determine_execution_bulk_kind() noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_UNIX_I_)
+			const __encoding_id __id = __posix::__determine_active_code_page();
+			return __execution_bulk_kind_for(__id == __encoding_id::__utf8, __is_shift_state_encoding_id(__id));
+#else
+			return __execution_bulk_kind_for(__is_active_code_page_utf8(), true);
+#endif
+		}
+
+		//////
+		/// @brief Whether an execution encoding state is in the initial shift state, with nothing left over from a
+		/// previous call.
+		//////
+		template <typename _State>
+		bool __is_execution_state_initial(const _State& __state) noexcept {
+			return !__state.__output_pending && ::std::mbsinit(&__state.__narrow_state) != 0;
+		}
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_UNIX_I_) && ZTD_TEXT_IS_ON(ZTD_TEXT_WCHAR_T_UTF32_COMPATIBLE_I_)
+		inline constexpr ::std::size_t __execution_wide_buffer_size = __bulk_buffer_size / sizeof(wchar_t);
+
+		//////
+		/// @brief Converts the longest prefix of complete, valid multibyte characters that fits in the output with
+		/// @c mbsnrtowcs, a buffer at a time.
+		///
+		/// @remarks @c mbsnrtowcs stops at a null character and does not say how much it wrote when it finds an
+		/// invalid sequence, or where a truncated character began; each of those is cut off and converted again,
+		/// so the kernel still stops right before whatever ztd::text::execution::decode_one has to deal with.
+		//////
+		template <typename _OutputUnit>
+		__bulk_io __mbsnrtowcs_decode(const char* __input, ::std::size_t __input_size, _OutputUnit* __output,
+			::std::size_t __output_size) noexcept {
+			wchar_t __buffer[__execution_wide_buffer_size];
+			::std::size_t __index        = 0;
+			::std::size_t __output_index = 0;
+			while (__index < __input_size && __output_index < __output_size) {
+				// every character takes at least one code unit, so this many never write past either buffer
+				::std::size_t __chunk = __input_size - __index;
+				if (__chunk > __output_size - __output_index) {
+					__chunk = __output_size - __output_index;
+				}
+				if (__chunk > __execution_wide_buffer_size) {
+					__chunk = __execution_wide_buffer_size;
+				}
+				const char* const __chunk_first = __input + __index;
+				const void* __nul_position      = ::std::memchr(__chunk_first, 0, __chunk);
+				if (__nul_position != nullptr) {
+					__chunk = static_cast<::std::size_t>(static_cast<const char*>(__nul_position) - __chunk_first);
+				}
+				if (__chunk == 0) {
+					break;
+				}
+				::std::mbstate_t __state {};
+				const char* __source    = __chunk_first;
+				::std::size_t __written = ::mbsnrtowcs(__buffer, &__source, __chunk, __chunk, &__state);
+				bool __stop             = false;
+				if (__written == static_cast<::std::size_t>(-1)) {
+					// __source is left on the invalid sequence: redo everything before it, then stop
+					if (__source < __chunk_first || __source >= __chunk_first + __chunk) {
+						break;
+					}
+					__chunk   = static_cast<::std::size_t>(__source - __chunk_first);
+					__state   = ::std::mbstate_t {};
+					__source  = __chunk_first;
+					__written = ::mbsnrtowcs(__buffer, &__source, __chunk, __chunk, &__state);
+					__stop    = true;
+					if (__written == static_cast<::std::size_t>(-1)) {
+						break;
+					}
+				}
+				if (::std::mbsinit(&__state) == 0) {
+					// the chunk ends part-way through a character: redo only the complete ones, and start the next
+					// chunk at the split character
+					__state   = ::std::mbstate_t {};
+					__source  = __chunk_first;
+					__written = ::mbsnrtowcs(__buffer, &__source, __chunk, __written, &__state);
+					if (__written == static_cast<::std::size_t>(-1) || ::std::mbsinit(&__state) == 0) {
+						break;
+					}
+				}
+				if (__written == 0) {
+					break;
+				}
+				for (::std::size_t __buffer_index = 0; __buffer_index < __written; ++__buffer_index) {
+					__output[__output_index + __buffer_index] = static_cast<_OutputUnit>(__buffer[__buffer_index]);
+				}
+				__index += static_cast<::std::size_t>(__source - __chunk_first);
+				__output_index += __written;
+				if (__stop) {
+					break;
+				}
+			}
+			return __bulk_io { __index, __output_index };
+		}
+
+		//////
+		/// @brief Converts the longest prefix of code points whose complete multibyte form fits in the output with
+		/// @c wcsnrtombs, a buffer at a time.
+		///
+		/// @remarks Null characters and values that are not code points are never handed to @c wcsnrtombs. As with
+		/// ztd::text::__detail::__mbsnrtowcs_decode, an unrepresentable code point is cut off and the part before it
+		/// converted again, so the kernel stops right before it.
+		//////
+		template <typename _InputUnit>
+		__bulk_io __wcsnrtombs_encode(const _InputUnit* __input, ::std::size_t __input_size, char* __output,
+			::std::size_t __output_size) noexcept {
+			wchar_t __buffer[__execution_wide_buffer_size];
+			::std::size_t __index        = 0;
+			::std::size_t __output_index = 0;
+			while (__index < __input_size && __output_index < __output_size) {
+				::std::size_t __chunk = __input_size - __index;
+				if (__chunk > __execution_wide_buffer_size) {
+					__chunk = __execution_wide_buffer_size;
+				}
+				::std::size_t __buffer_size = 0;
+				for (; __buffer_size < __chunk; ++__buffer_size) {
+					const char32_t __code_point = __utf32_unit(__input[__index + __buffer_size]);
+					if (__code_point == 0 || __code_point > __last_code_point || __is_surrogate(__code_point)) {
+						break;
+					}
+					__buffer[__buffer_size] = static_cast<wchar_t>(__code_point);
+				}
+				if (__buffer_size == 0) {
+					break;
+				}
+				::std::mbstate_t __state {};
+				const wchar_t* __source = __buffer;
+				char* const __target    = __output + __output_index;
+				const ::std::size_t __room = __output_size - __output_index;
+				::std::size_t __written    = ::wcsnrtombs(__target, &__source, __buffer_size, __room, &__state);
+				if (__written == static_cast<::std::size_t>(-1)) {
+					if (__source < __buffer || __source >= __buffer + __buffer_size) {
+						break;
+					}
+					__buffer_size = static_cast<::std::size_t>(__source - __buffer);
+					__state       = ::std::mbstate_t {};
+					__source      = __buffer;
+					__written     = ::wcsnrtombs(__target, &__source, __buffer_size, __room, &__state);
+					if (__written == static_cast<::std::size_t>(-1)) {
+						break;
+					}
+				}
+				if (::std::mbsinit(&__state) == 0 || __written == 0) {
+					break;
+				}
+				const ::std::size_t __read = static_cast<::std::size_t>(__source - __buffer);
+				__index += __read;
+				__output_index += __written;
+				if (__read != __buffer_size || __buffer_size != __chunk) {
+					break;
+				}
+			}
+			return __bulk_io { __index, __output_index };
+		}
+#endif
+
+		//////
+		/// @brief The bulk decoding kernel for ztd::text::execution: which conversion it runs was decided once, for
+		/// the whole call, by ztd::text::__detail::__determine_execution_bulk_kind.
+		///
+		/// @remarks The kernel only runs while @p _State is in its initial shift state; anything else is left to
+		/// ztd::text::execution::decode_one.
+		//////
+		template <typename _State, bool _AssumeValid>
+		struct __execution_decode_kernel {
+			__execution_bulk_kind _M_kind;
+			const _State* _M_state;
+
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				if (!__is_execution_state_initial(*_M_state)) {
+					return __bulk_io { 0, 0 };
+				}
+				switch (_M_kind) {
+				case __execution_bulk_kind::__utf8:
+					return __utf8_decode_kernel<sizeof(_OutputUnit), _AssumeValid> {}(
+						__input, __input_size, __output, __output_size);
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_UNIX_I_) && ZTD_TEXT_IS_ON(ZTD_TEXT_WCHAR_T_UTF32_COMPATIBLE_I_)
+				case __execution_bulk_kind::__wide:
+					return __mbsnrtowcs_decode(
+						reinterpret_cast<const char*>(__input), __input_size, __output, __output_size);
+#endif
+				default:
+					return __bulk_io { 0, 0 };
+				}
+			}
+		};
+
+		//////
+		/// @brief The bulk encoding kernel for ztd::text::execution. See
+		/// ztd::text::__detail::__execution_decode_kernel.
+		//////
+		template <typename _State>
+		struct __execution_encode_kernel {
+			__execution_bulk_kind _M_kind;
+			const _State* _M_state;
+
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				if (!__is_execution_state_initial(*_M_state)) {
+					return __bulk_io { 0, 0 };
+				}
+				switch (_M_kind) {
+				case __execution_bulk_kind::__utf8:
+					return __utf32_to_utf8_kernel {}(__input, __input_size, __output, __output_size);
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_UNIX_I_) && ZTD_TEXT_IS_ON(ZTD_TEXT_WCHAR_T_UTF32_COMPATIBLE_I_)
+				case __execution_bulk_kind::__wide:
+					return __wcsnrtombs_encode(
+						__input, __input_size, reinterpret_cast<char*>(__output), __output_size);
+#endif
+				default:
+					return __bulk_io { 0, 0 };
+				}
+			}
+		};
+
+		//////
+		/// @brief Copies the longest prefix of Unicode scalar values that fits in the output, for a @c wchar_t that
+		/// holds code points under a UTF-8 locale: surrogates and values past the last code point are left behind.
+		//////
+		struct __wide_execution_utf8_kernel {
+			bool _M_enabled;
+
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				if (!_M_enabled) {
+					return __bulk_io { 0, 0 };
+				}
+				const ::std::size_t __size = __input_size < __output_size ? __input_size : __output_size;
+				::std::size_t __index      = 0;
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+				for (; __index + 4 <= __size; __index += 4) {
+					const __m128i __block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__input + __index));
+					if (_mm_movemask_epi8(__utf32_invalid_sse(__block)) != 0) {
+						break;
+					}
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(__output + __index), __block);
+				}
+#endif
+				for (; __index < __size; ++__index) {
+					const char32_t __code_point = __utf32_unit(__input[__index]);
+					if (__code_point > __last_code_point || __is_surrogate(__code_point)) {
+						break;
+					}
+					__output[__index] = static_cast<_OutputUnit>(__code_point);
+				}
+				return __bulk_io { __index, __index };
+			}
+		};
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_BULK_EXECUTION_HPP
@@ -0,0 +1,415 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_BULK_SINGLE_BYTE_HPP
+#define ZTD_TEXT_DETAIL_BULK_SINGLE_BYTE_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/detail/unicode.hpp>
+#include <ztd/text/detail/bulk.hpp>
+#include <ztd/text/detail/simd.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		//////
+		/// @brief Whether a single-byte code page table entry decodes to a code point, rather than marking a byte the
+		/// code page leaves undefined.
+		//////
+		constexpr bool __is_single_byte_mapped(char32_t __code_point) noexcept {
+			return __code_point <= __last_code_point;
+		}
+
+		constexpr bool __is_single_byte_total(const ::std::array<char32_t, 256>& __code_points) noexcept {
+			for (char32_t __code_point : __code_points) {
+				if (!__is_single_byte_mapped(__code_point)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		constexpr bool __is_single_byte_ascii_compatible(const ::std::array<char32_t, 256>& __code_points) noexcept {
+			for (::std::size_t __index = 0; __index <= __last_ascii_value; ++__index) {
+				if (__code_points[__index] != static_cast<char32_t>(__index)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		constexpr bool __is_single_byte_bmp_only(const ::std::array<char32_t, 256>& __code_points) noexcept {
+			for (char32_t __code_point : __code_points) {
+				if (__is_single_byte_mapped(__code_point) && __code_point > __last_bmp_value) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		//////
+		/// @brief The encoding direction of a single-byte code page: a two-level table from a Basic Multilingual
+		/// Plane code point to its byte.
+		///
+		/// @remarks The first level picks, from the high 8 bits of a code point, one of the blocks of the second
+		/// level; the low 8 bits then pick the byte inside of it. Block 0 is all zeroes and stands in for every block
+		/// of code points the code page has nothing from, so a typical table is only a handful of 256-byte blocks. A
+		/// 0 found this way is only the real answer for the code point byte 0 decodes to.
+		//////
+		template <::std::size_t _BlockCount>
+		struct __single_byte_reverse_table {
+			::std::array<unsigned char, 256> __block_of;
+			::std::array<::std::array<unsigned char, 256>, _BlockCount> __blocks;
+		};
+
+		constexpr ::std::size_t __single_byte_reverse_block_count(
+			const ::std::array<char32_t, 256>& __code_points) noexcept {
+			bool __seen[256] {};
+			::std::size_t __count = 1;
+			for (char32_t __code_point : __code_points) {
+				if (!__is_single_byte_mapped(__code_point) || __seen[__code_point >> 8]) {
+					continue;
+				}
+				__seen[__code_point >> 8] = true;
+				++__count;
+			}
+			return __count;
+		}
+
+		template <::std::size_t _BlockCount>
+		constexpr __single_byte_reverse_table<_BlockCount> __make_single_byte_reverse_table(
+			const ::std::array<char32_t, 256>& __code_points) noexcept {
+			static_assert(_BlockCount <= 256, "a single-byte code page cannot use more than 255 blocks");
+			__single_byte_reverse_table<_BlockCount> __table {};
+			::std::size_t __next_block = 1;
+			// go from the last byte to the first, so that the lowest byte wins when several decode to the same code
+			// point
+			for (::std::size_t __byte = __code_points.size(); __byte-- > 0;) {
+				const char32_t __code_point = __code_points[__byte];
+				if (!__is_single_byte_mapped(__code_point)) {
+					continue;
+				}
+				unsigned char& __block = __table.__block_of[__code_point >> 8];
+				if (__block == 0) {
+					__block = static_cast<unsigned char>(__next_block++);
+				}
+				__table.__blocks[__block][__code_point & 0xFF] = static_cast<unsigned char>(__byte);
+			}
+			return __table;
+		}
+
+		template <typename _Table>
+		inline constexpr auto __single_byte_reverse_table_v
+			= __make_single_byte_reverse_table<__single_byte_reverse_block_count(_Table::code_points)>(
+			     _Table::code_points);
+
+		//////
+		/// @brief Looks up the byte @p __code_point encodes to in the code page described by @p _Table, returning
+		/// false if it has none.
+		//////
+		template <typename _Table>
+		constexpr bool __single_byte_encode_one(char32_t __code_point, unsigned char& __unit) noexcept {
+			if (__code_point > __last_bmp_value) {
+				return false;
+			}
+			const auto& __reverse      = __single_byte_reverse_table_v<_Table>;
+			const auto& __block        = __reverse.__blocks[__reverse.__block_of[__code_point >> 8]];
+			const unsigned char __byte = __block[__code_point & 0xFF];
+			if (__byte == 0 && _Table::code_points[0] != __code_point) {
+				return false;
+			}
+			__unit = __byte;
+			return true;
+		}
+
+		//////
+		/// @brief Every byte of a single-byte code page as UTF-8: up to 3 code units, padded to 4 so that they can
+		/// always be copied as a whole, with their count in the last one (0 for a byte which does not decode).
+		//////
+		constexpr ::std::array<::std::array<unsigned char, 4>, 256> __make_single_byte_utf8_table(
+			const ::std::array<char32_t, 256>& __code_points) noexcept {
+			::std::array<::std::array<unsigned char, 4>, 256> __table {};
+			for (::std::size_t __byte = 0; __byte < __code_points.size(); ++__byte) {
+				const char32_t __code_point = __code_points[__byte];
+				::std::array<unsigned char, 4>& __units = __table[__byte];
+				if (!__is_single_byte_mapped(__code_point)) {
+					continue;
+				}
+				if (__code_point <= __last_1byte_value) {
+					__units[0] = static_cast<unsigned char>(__code_point);
+					__units[3] = 1;
+				}
+				else if (__code_point <= __last_2byte_value) {
+					__units[0] = static_cast<unsigned char>(0xC0 | (__code_point >> 6));
+					__units[1] = static_cast<unsigned char>(0x80 | (__code_point & 0x3F));
+					__units[3] = 2;
+				}
+				else {
+					__units[0] = static_cast<unsigned char>(0xE0 | (__code_point >> 12));
+					__units[1] = static_cast<unsigned char>(0x80 | ((__code_point >> 6) & 0x3F));
+					__units[2] = static_cast<unsigned char>(0x80 | (__code_point & 0x3F));
+					__units[3] = 3;
+				}
+			}
+			return __table;
+		}
+
+		template <typename _Table>
+		inline constexpr ::std::array<::std::array<unsigned char, 4>, 256> __single_byte_utf8_table_v
+			= __make_single_byte_utf8_table(_Table::code_points);
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+		// Looks up blocks of 16 bytes in __code_points with two 8-lane gathers for as long as every byte in the block
+		// decodes, returning how many were converted. There must be room for at least __size code points in __output.
+		template <bool _AsciiCompatible, typename _OutputUnit>
+		ZTD_TEXT_SIMD_TARGET_AVX2_I_ inline ::std::size_t __single_byte_decode_avx2(const char32_t* __code_points,
+			const unsigned char* __first, ::std::size_t __size, _OutputUnit* __output) noexcept {
+			// there is no unsigned 32-bit comparison in AVX2 either: flip the sign bits first
+			const __m256i __bias  = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+			const __m256i __limit = _mm256_set1_epi32(static_cast<int>(0x80000000u | __last_code_point));
+			const int* __base     = reinterpret_cast<const int*>(__code_points);
+			::std::size_t __index = 0;
+			for (; __index + 16 <= __size; __index += 16) {
+				const __m128i __block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__first + __index));
+				const __m256i __low_bytes  = _mm256_cvtepu8_epi32(__block);
+				const __m256i __high_bytes = _mm256_cvtepu8_epi32(_mm_srli_si128(__block, 8));
+				__m256i* __target          = reinterpret_cast<__m256i*>(__output + __index);
+				if constexpr (_AsciiCompatible) {
+					if (_mm_movemask_epi8(__block) == 0) {
+						_mm256_storeu_si256(__target + 0, __low_bytes);
+						_mm256_storeu_si256(__target + 1, __high_bytes);
+						continue;
+					}
+				}
+				const __m256i __low  = _mm256_i32gather_epi32(__base, __low_bytes, 4);
+				const __m256i __high = _mm256_i32gather_epi32(__base, __high_bytes, 4);
+				const __m256i __unmapped
+					= _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_xor_si256(__low, __bias), __limit),
+					     _mm256_cmpgt_epi32(_mm256_xor_si256(__high, __bias), __limit));
+				if (!_mm256_testz_si256(__unmapped, __unmapped)) {
+					break;
+				}
+				_mm256_storeu_si256(__target + 0, __low);
+				_mm256_storeu_si256(__target + 1, __high);
+			}
+			return __index;
+		}
+#endif
+
+		//////
+		/// @brief Decodes the longest prefix of a single-byte code page's input whose bytes all decode and fit in the
+		/// output.
+		///
+		/// @remarks With AVX2, 16 bytes at a time are looked up in the table with vector gathers. Otherwise, blocks
+		/// of 16 ASCII bytes are widened in one go (for code pages whose lower half is ASCII) and everything else is
+		/// one table lookup per byte. The kernel stops right before the first byte which does not decode, leaving it
+		/// to ztd::text::basic_single_byte_encoding::decode_one.
+		//////
+		template <typename _Table>
+		struct __single_byte_decode_kernel {
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				constexpr bool __ascii_compatible = __is_single_byte_ascii_compatible(_Table::code_points);
+				const unsigned char* __first      = reinterpret_cast<const unsigned char*>(__input);
+				const char32_t* __code_points     = _Table::code_points.data();
+				const ::std::size_t __size        = __input_size < __output_size ? __input_size : __output_size;
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+				const bool __use_avx2 = active_simd_level() >= simd_level::avx2;
+#endif
+				::std::size_t __index = 0;
+				while (__index < __size) {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+					if (__use_avx2 && __index + 16 <= __size) {
+						__index += __single_byte_decode_avx2<__ascii_compatible>(
+							__code_points, __first + __index, __size - __index, __output + __index);
+					}
+#endif
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+					if constexpr (__ascii_compatible) {
+						if (__index + 16 <= __size) {
+							const __m128i __block
+								= _mm_loadu_si128(reinterpret_cast<const __m128i*>(__first + __index));
+							if (_mm_movemask_epi8(__block) == 0) {
+								const __m128i __zero  = _mm_setzero_si128();
+								const __m128i __low   = _mm_unpacklo_epi8(__block, __zero);
+								const __m128i __high  = _mm_unpackhi_epi8(__block, __zero);
+								__m128i* __target     = reinterpret_cast<__m128i*>(__output + __index);
+								_mm_storeu_si128(__target + 0, _mm_unpacklo_epi16(__low, __zero));
+								_mm_storeu_si128(__target + 1, _mm_unpackhi_epi16(__low, __zero));
+								_mm_storeu_si128(__target + 2, _mm_unpacklo_epi16(__high, __zero));
+								_mm_storeu_si128(__target + 3, _mm_unpackhi_epi16(__high, __zero));
+								__index += 16;
+								continue;
+							}
+						}
+					}
+#endif
+					// go one byte at a time through (at least) the next 16 bytes
+					const ::std::size_t __scalar_last = __size - __index < 16 ? __size : __index + 16;
+					for (; __index < __scalar_last; ++__index) {
+						const char32_t __code_point = __code_points[__first[__index]];
+						if (!__is_single_byte_mapped(__code_point)) {
+							return __bulk_io { __index, __index };
+						}
+						__output[__index] = static_cast<_OutputUnit>(__code_point);
+					}
+				}
+				return __bulk_io { __index, __index };
+			}
+		};
+
+		//////
+		/// @brief Encodes the longest prefix of UTF-32 input whose code points all have a byte in a single-byte code
+		/// page and fit in the output.
+		///
+		/// @remarks For code pages whose lower half is ASCII, blocks of 16 ASCII code points are narrowed in one go.
+		/// Everything else is looked up in the code page's two-level reverse table one code point at a time.
+		//////
+		template <typename _Table>
+		struct __single_byte_encode_kernel {
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				constexpr bool __ascii_compatible = __is_single_byte_ascii_compatible(_Table::code_points);
+				const ::std::size_t __size        = __input_size < __output_size ? __input_size : __output_size;
+				::std::size_t __index             = 0;
+				while (__index < __size) {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+					if constexpr (__ascii_compatible) {
+						if (__index + 16 <= __size) {
+							const __m128i* __source = reinterpret_cast<const __m128i*>(__input + __index);
+							const __m128i __blocks[4]
+								= { _mm_loadu_si128(__source + 0), _mm_loadu_si128(__source + 1),
+									  _mm_loadu_si128(__source + 2), _mm_loadu_si128(__source + 3) };
+							const __m128i __all = _mm_or_si128(
+								_mm_or_si128(__blocks[0], __blocks[1]), _mm_or_si128(__blocks[2], __blocks[3]));
+							const __m128i __non_ascii
+								= _mm_and_si128(__all, _mm_set1_epi32(static_cast<int>(~__last_ascii_value)));
+							if (_mm_movemask_epi8(_mm_cmpeq_epi32(__non_ascii, _mm_setzero_si128())) == 0xFFFF) {
+								_mm_storeu_si128(reinterpret_cast<__m128i*>(__output + __index),
+									_mm_packus_epi16(_mm_packs_epi32(__blocks[0], __blocks[1]),
+									     _mm_packs_epi32(__blocks[2], __blocks[3])));
+								__index += 16;
+								continue;
+							}
+						}
+					}
+#endif
+					// go one code point at a time through (at least) the next 16 code points
+					const ::std::size_t __scalar_last = __size - __index < 16 ? __size : __index + 16;
+					for (; __index < __scalar_last; ++__index) {
+						const char32_t __code_point = static_cast<char32_t>(
+							static_cast<::std::uint_least32_t>(__input[__index]));
+						unsigned char __unit        = 0;
+						if (__ascii_compatible && __code_point <= __last_ascii_value) {
+							__unit = static_cast<unsigned char>(__code_point);
+						}
+						else if (!__single_byte_encode_one<_Table>(__code_point, __unit)) {
+							return __bulk_io { __index, __index };
+						}
+						__output[__index] = static_cast<_OutputUnit>(__unit);
+					}
+				}
+				return __bulk_io { __index, __index };
+			}
+		};
+
+		//////
+		/// @brief Converts the longest prefix of a single-byte code page's input whose bytes all decode and whose
+		/// UTF-8 fits in the output.
+		///
+		/// @remarks Runs of ASCII are copied as they are (for code pages whose lower half is ASCII); every other byte
+		/// is written out from a table of the code page's bytes already encoded as UTF-8, so no code point is ever
+		/// materialized.
+		//////
+		template <typename _Table>
+		struct __single_byte_to_utf8_kernel {
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				constexpr bool __ascii_compatible = __is_single_byte_ascii_compatible(_Table::code_points);
+				const unsigned char* __first      = reinterpret_cast<const unsigned char*>(__input);
+				const auto& __utf8                = __single_byte_utf8_table_v<_Table>;
+				::std::size_t __index             = 0;
+				::std::size_t __output_index      = 0;
+				while (__index < __input_size) {
+					const unsigned char __byte = __first[__index];
+					if constexpr (__ascii_compatible) {
+						if (__byte <= __last_ascii_value) {
+							const ::std::size_t __left  = __input_size - __index;
+							const ::std::size_t __room  = __output_size - __output_index;
+							const ::std::size_t __ascii
+								= __ascii_prefix_length(__first + __index, __left < __room ? __left : __room);
+							if (__ascii == 0) {
+								break;
+							}
+							::std::memcpy(__output + __output_index, __first + __index, __ascii);
+							__index += __ascii;
+							__output_index += __ascii;
+							continue;
+						}
+					}
+					const ::std::array<unsigned char, 4>& __units = __utf8[__byte];
+					const ::std::size_t __length                  = __units[3];
+					const ::std::size_t __room                    = __output_size - __output_index;
+					if (__length == 0 || __room < __length) {
+						break;
+					}
+					if (__room >= __units.size()) {
+						// the padding gets overwritten by whatever comes next
+						::std::memcpy(__output + __output_index, __units.data(), __units.size());
+					}
+					else {
+						::std::memcpy(__output + __output_index, __units.data(), __length);
+					}
+					++__index;
+					__output_index += __length;
+				}
+				return __bulk_io { __index, __output_index };
+			}
+		};
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_BULK_SINGLE_BYTE_HPP
@@ -0,0 +1,276 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_BULK_TRANSCODE_HPP
+#define ZTD_TEXT_DETAIL_BULK_TRANSCODE_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/code_point.hpp>
+#include <ztd/text/count_result.hpp>
+#include <ztd/text/transcode_result.hpp>
+#include <ztd/text/detail/bulk.hpp>
+#include <ztd/text/detail/transcode_one.hpp>
+#include <ztd/text/detail/adl.hpp>
+#include <ztd/text/detail/range.hpp>
+#include <ztd/text/detail/reconstruct.hpp>
+#include <ztd/text/detail/span.hpp>
+#include <ztd/text/detail/type_traits.hpp>
+
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		//////
+		/// @brief Whether the bulk transcoding loop can be used for this input, reading @p _InputUnitSize -byte
+		/// units, and this output, writing @p _OutputUnit s.
+		//////
+		template <typename _Input, ::std::size_t _InputUnitSize, typename _Output, typename _OutputUnit>
+		inline constexpr bool __is_bulk_transcodable_v = __is_bulk_input_v<_Input, _InputUnitSize>
+			&& __is_bulk_output_v<__reconstruct_t<__remove_cvref_t<_Output>>, _OutputUnit>;
+
+		//////
+		/// @brief The same loop as the one ztd::text::transcode_into uses, except that before every one-at-a-time
+		/// step, @p __kernel is given the chance to convert as much of the remaining input as it can in one go.
+		///
+		/// @remarks The kernel only ever takes complete, valid code points that fit in the output, so anything it
+		/// leaves behind (errors, truncated input, a full output) is handled by the encodings themselves, with the
+		/// exact same results and error handler calls as the plain loop.
+		//////
+		template <typename _OutputUnit, typename _Input, typename _FromEncoding, typename _Output,
+			typename _ToEncoding, typename _FromErrorHandler, typename _ToErrorHandler, typename _FromState,
+			typename _ToState, typename _Kernel>
+		constexpr auto __bulk_transcode(_Input&& __input, _FromEncoding& __from_encoding, _Output&& __output,
+			_ToEncoding& __to_encoding, _FromErrorHandler& __from_error_handler, _ToErrorHandler& __to_error_handler,
+			_FromState& __from_state, _ToState& __to_state, _Kernel __kernel) {
+			using _UInput                = __remove_cvref_t<_Input>;
+			using _UOutput               = __remove_cvref_t<_Output>;
+			using _InputValueType        = __range_value_type_t<_UInput>;
+			using _WorkingInput          = __reconstruct_t<::std::conditional_t<::std::is_array_v<_UInput>,
+                    ::std::conditional_t<__is_character_v<_InputValueType>, ::std::basic_string_view<_InputValueType>,
+                         ::ztd::text::span<const _InputValueType>>,
+                    _UInput>>;
+			using _WorkingOutput         = __reconstruct_t<_UOutput>;
+			using _UFromEncoding         = __remove_cvref_t<_FromEncoding>;
+			using _IntermediateCodePoint = code_point_t<_UFromEncoding>;
+			using _Result = __reconstruct_transcode_result_t<_WorkingInput, _WorkingOutput, _FromState, _ToState>;
+
+			_WorkingInput __working_input(
+				__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
+			_WorkingOutput __working_output(
+				__reconstruct(::std::in_place_type<_WorkingOutput>, ::std::forward<_Output>(__output)));
+
+			_IntermediateCodePoint __intermediate[max_code_points_v<_UFromEncoding>];
+			bool __handled_error = false;
+			while (!__adl::__adl_empty(__working_input)) {
+				if (__is_bulk_allowed()) {
+					__bulk_advance<_OutputUnit>(__working_input, __working_output, __kernel);
+					if (__adl::__adl_empty(__working_input)) {
+						break;
+					}
+				}
+				auto __transcode_result = __basic_transcode_one<__consume::__no>(::std::move(__working_input),
+					__from_encoding, __intermediate, ::std::move(__working_output), __to_encoding,
+					__from_error_handler, __to_error_handler, __from_state, __to_state);
+				if (__transcode_result.error_code != encoding_error::ok) {
+					return _Result(::std::move(__working_input), ::std::move(__working_output), __from_state,
+						__to_state, __transcode_result.error_code, __transcode_result.handled_error);
+				}
+				__handled_error |= __transcode_result.handled_error;
+				// the step may hand back a different (but equivalent) range type, e.g. a subrange for a span
+				__working_input  = __reconstruct(::std::in_place_type<_WorkingInput>,
+					__adl::__adl_begin(__transcode_result.input), __adl::__adl_end(__transcode_result.input));
+				__working_output = __reconstruct(::std::in_place_type<_WorkingOutput>,
+					__adl::__adl_begin(__transcode_result.output), __adl::__adl_end(__transcode_result.output));
+			}
+			return _Result(::std::move(__working_input), ::std::move(__working_output), __from_state, __to_state,
+				encoding_error::ok, __handled_error);
+		}
+
+		//////
+		/// @brief The same loop as ztd::text::basic_decode_into, except that before every call to @c decode_one,
+		/// @p __kernel is given the chance to decode as much of the remaining input as it can in one go.
+		//////
+		template <typename _OutputUnit, typename _Input, typename _Encoding, typename _Output, typename _ErrorHandler,
+			typename _State, typename _Kernel>
+		constexpr auto __bulk_decode(_Input&& __input, _Encoding& __encoding, _Output&& __output,
+			_ErrorHandler& __error_handler, _State& __state, _Kernel __kernel) {
+			using _UInput             = __remove_cvref_t<_Input>;
+			using _UOutput            = __remove_cvref_t<_Output>;
+			using _InputValueType     = __range_value_type_t<_UInput>;
+			using _IntermediateInput  = __reconstruct_t<::std::conditional_t<::std::is_array_v<_UInput>,
+                    ::std::conditional_t<__is_character_v<_InputValueType>, ::std::basic_string_view<_InputValueType>,
+                         ::ztd::text::span<const _InputValueType>>,
+                    _UInput>>;
+			using _IntermediateOutput = __reconstruct_t<_UOutput>;
+			using _Result             = decltype(__encoding.decode_one(::std::declval<_IntermediateInput>(),
+                    ::std::declval<_IntermediateOutput>(), __error_handler, __state));
+			using _WorkingInput       = __remove_cvref_t<decltype(::std::declval<_Result>().input)>;
+			using _WorkingOutput      = __remove_cvref_t<decltype(::std::declval<_Result>().output)>;
+
+			_WorkingInput __working_input(
+				__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
+			_WorkingOutput __working_output(
+				__reconstruct(::std::in_place_type<_WorkingOutput>, ::std::forward<_Output>(__output)));
+			bool __handled_error = false;
+
+			while (!__adl::__adl_empty(__working_input)) {
+				if (__is_bulk_allowed()) {
+					__bulk_advance<_OutputUnit>(__working_input, __working_output, __kernel);
+					if (__adl::__adl_empty(__working_input)) {
+						break;
+					}
+				}
+				auto __result = __encoding.decode_one(
+					::std::move(__working_input), ::std::move(__working_output), __error_handler, __state);
+				if (__result.error_code != encoding_error::ok) {
+					return __result;
+				}
+				__handled_error |= __result.handled_error;
+				__working_input  = ::std::move(__result.input);
+				__working_output = ::std::move(__result.output);
+			}
+			return _Result(::std::move(__working_input), ::std::move(__working_output), __state, encoding_error::ok,
+				__handled_error);
+		}
+
+		//////
+		/// @brief The same loop as ztd::text::basic_encode_into, except that before every call to @c encode_one,
+		/// @p __kernel is given the chance to encode as much of the remaining input as it can in one go.
+		//////
+		template <typename _OutputUnit, typename _Input, typename _Encoding, typename _Output, typename _ErrorHandler,
+			typename _State, typename _Kernel>
+		constexpr auto __bulk_encode(_Input&& __input, _Encoding& __encoding, _Output&& __output,
+			_ErrorHandler& __error_handler, _State& __state, _Kernel __kernel) {
+			using _UInput             = __remove_cvref_t<_Input>;
+			using _UOutput            = __remove_cvref_t<_Output>;
+			using _InputValueType     = __range_value_type_t<_UInput>;
+			using _IntermediateInput  = __reconstruct_t<::std::conditional_t<::std::is_array_v<_UInput>,
+                    ::std::conditional_t<__is_character_v<_InputValueType>, ::std::basic_string_view<_InputValueType>,
+                         ::ztd::text::span<const _InputValueType>>,
+                    _UInput>>;
+			using _IntermediateOutput = __reconstruct_t<_UOutput>;
+			using _Result             = decltype(__encoding.encode_one(::std::declval<_IntermediateInput>(),
+                    ::std::declval<_IntermediateOutput>(), __error_handler, __state));
+			using _WorkingInput       = __remove_cvref_t<decltype(::std::declval<_Result>().input)>;
+			using _WorkingOutput      = __remove_cvref_t<decltype(::std::declval<_Result>().output)>;
+
+			_WorkingInput __working_input(
+				__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
+			_WorkingOutput __working_output(
+				__reconstruct(::std::in_place_type<_WorkingOutput>, ::std::forward<_Output>(__output)));
+			bool __handled_error = false;
+
+			while (!__adl::__adl_empty(__working_input)) {
+				if (__is_bulk_allowed()) {
+					__bulk_advance<_OutputUnit>(__working_input, __working_output, __kernel);
+					if (__adl::__adl_empty(__working_input)) {
+						break;
+					}
+				}
+				auto __result = __encoding.encode_one(
+					::std::move(__working_input), ::std::move(__working_output), __error_handler, __state);
+				if (__result.error_code != encoding_error::ok) {
+					return __result;
+				}
+				__handled_error |= __result.handled_error;
+				__working_input  = ::std::move(__result.input);
+				__working_output = ::std::move(__result.output);
+			}
+			return _Result(::std::move(__working_input), ::std::move(__working_output), __state, encoding_error::ok,
+				__handled_error);
+		}
+
+		//////
+		/// @brief The same loop as ztd::text::count_code_points, except that before every one-at-a-time step, @p
+		/// __kernel is given the chance to count as many of the remaining code points as it can in one go.
+		///
+		/// @remarks The kernel is called with a pointer to the input and its size, and reports how many code units it
+		/// read and how many code points they make up (as its @c input_read and @c output_written ). It only ever
+		/// counts complete, valid code points, so errors still stop the count (or get replaced) at exactly the same
+		/// place as they do with the plain loop.
+		//////
+		template <typename _Input, typename _Encoding, typename _ErrorHandler, typename _State, typename _Kernel>
+		constexpr auto __bulk_count_code_points(_Input&& __input, _Encoding& __encoding,
+			_ErrorHandler& __error_handler, _State& __state, _Kernel __kernel) {
+			using _UInput         = __remove_cvref_t<_Input>;
+			using _InputValueType = __range_value_type_t<_UInput>;
+			using _WorkingInput   = __reconstruct_t<::std::conditional_t<::std::is_array_v<_UInput>,
+                    ::std::conditional_t<__is_character_v<_InputValueType>, ::std::basic_string_view<_InputValueType>,
+                         ::ztd::text::span<const _InputValueType>>,
+                    _UInput>>;
+			using _Difference     = __range_difference_type_t<_WorkingInput>;
+			using _Result         = count_result<_WorkingInput, _State>;
+
+			_WorkingInput __working_input(
+				__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
+			::std::size_t __code_point_count = 0;
+			bool __handled_error             = false;
+			while (!__adl::__adl_empty(__working_input)) {
+				if (__is_bulk_allowed()) {
+					auto __first            = __adl::__adl_begin(__working_input);
+					auto __last             = __adl::__adl_end(__working_input);
+					const __bulk_io __count = __kernel(
+						__adl::__adl_to_address(__first), static_cast<::std::size_t>(__last - __first));
+					__code_point_count += __count.output_written;
+					__working_input = __reconstruct(::std::in_place_type<_WorkingInput>,
+						__first + static_cast<_Difference>(__count.input_read), __last);
+					if (__adl::__adl_empty(__working_input)) {
+						break;
+					}
+				}
+				auto __result = __basic_count_code_points_one(
+					::std::move(__working_input), __encoding, __error_handler, __state);
+				__handled_error |= __result.handled_error;
+				if (__result.error_code != encoding_error::ok) {
+					return _Result(::std::move(__result.input), __code_point_count, __state, __result.error_code,
+						__handled_error);
+				}
+				__code_point_count += __result.count;
+				__working_input = ::std::move(__result.input);
+			}
+			return _Result(
+				::std::move(__working_input), __code_point_count, __state, encoding_error::ok, __handled_error);
+		}
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_BULK_TRANSCODE_HPP
@@ -0,0 +1,587 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_BULK_UTF16_HPP
+#define ZTD_TEXT_DETAIL_BULK_UTF16_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/detail/unicode.hpp>
+#include <ztd/text/detail/bulk.hpp>
+#include <ztd/text/detail/bulk_utf8.hpp>
+#include <ztd/text/detail/simd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		template <typename _InputUnit>
+		inline char32_t __utf16_unit(_InputUnit __unit) noexcept {
+			return static_cast<char32_t>(static_cast<::std::uint_least16_t>(__unit));
+		}
+
+		// Reads the code point at __input[__index], which must not be a lone surrogate, moving __index past it.
+		template <typename _InputUnit>
+		inline char32_t __utf16_read_paired(const _InputUnit* __input, ::std::size_t& __index) noexcept {
+			const char32_t __unit = __utf16_unit(__input[__index]);
+			if (__is_lead_surrogate(__unit)) {
+				const char32_t __trail = __utf16_unit(__input[__index + 1]);
+				__index += 2;
+				return __utf16_combine_surrogates(static_cast<char16_t>(__unit), static_cast<char16_t>(__trail));
+			}
+			__index += 1;
+			return __unit;
+		}
+
+		// Reads the code point at __input[__index] into __code_point, returning how many code units it takes; or 0
+		// if it is a lone surrogate or a lead surrogate at the very end of the input, which
+		// ztd::text::basic_utf16::decode_one has to deal with.
+		template <typename _InputUnit>
+		inline ::std::size_t __utf16_read_checked(const _InputUnit* __input, ::std::size_t __input_size,
+			::std::size_t __index, char32_t& __code_point) noexcept {
+			const char32_t __unit = __utf16_unit(__input[__index]);
+			if (!__is_surrogate(__unit)) {
+				__code_point = __unit;
+				return 1;
+			}
+			if (!__is_lead_surrogate(__unit) || __index + 1 == __input_size) {
+				return 0;
+			}
+			const char32_t __trail = __utf16_unit(__input[__index + 1]);
+			if (!__is_trail_surrogate(__trail)) {
+				return 0;
+			}
+			__code_point = __utf16_combine_surrogates(static_cast<char16_t>(__unit), static_cast<char16_t>(__trail));
+			return 2;
+		}
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+		inline bool __utf16_is_ascii_sse(__m128i __block) noexcept {
+			const __m128i __non_ascii = _mm_and_si128(__block, _mm_set1_epi16(static_cast<short>(0xFF80)));
+			return _mm_movemask_epi8(_mm_cmpeq_epi16(__non_ascii, _mm_setzero_si128())) == 0xFFFF;
+		}
+
+		// Lanes of __block which are greater than __value, comparing as unsigned 16-bit integers.
+		inline __m128i __utf16_greater_than_sse(__m128i __block, short __value) noexcept {
+			const __m128i __zero = _mm_setzero_si128();
+			return _mm_xor_si128(
+				_mm_cmpeq_epi16(_mm_subs_epu16(__block, _mm_set1_epi16(__value)), __zero), _mm_set1_epi16(-1));
+		}
+
+		// Lanes of __block whose bits under __mask are __bits: 0xF800 and 0xD800 for all surrogates, 0xFC00 and
+		// 0xD800 for lead surrogates only.
+		inline __m128i __utf16_surrogates_sse(__m128i __block, int __mask, int __bits) noexcept {
+			return _mm_cmpeq_epi16(_mm_and_si128(__block, _mm_set1_epi16(static_cast<short>(__mask))),
+				_mm_set1_epi16(static_cast<short>(__bits)));
+		}
+
+		// Whether every surrogate of __block (whose surrogate lanes are __surrogates) is half of a pair that lies
+		// entirely within the block.
+		inline bool __utf16_is_paired_sse(__m128i __block, __m128i __surrogates) noexcept {
+			// every lead must be followed by a trail (the masks have 2 bits per code unit), and the last code unit
+			// cannot be a lead
+			const int __leads  = _mm_movemask_epi8(__utf16_surrogates_sse(__block, 0xFC00, 0xD800));
+			const int __trails = _mm_movemask_epi8(__surrogates) & ~__leads;
+			return ((__leads << 2) & 0xFFFF) == __trails && (__leads & 0xC000) == 0;
+		}
+
+		// Converts the 8 code units at __input (already loaded into __block, and not all ASCII) to UTF-8, if they
+		// are all complete, valid code points whose UTF-8 form fits in __room code units. Returns how many code
+		// units were written, or 0 (having written nothing) if the block has to be converted one code point at a
+		// time.
+		template <typename _InputUnit, typename _OutputUnit>
+		inline ::std::size_t __utf16_to_utf8_block_sse(
+			const _InputUnit* __input, __m128i __block, ::std::size_t __room, _OutputUnit* __output) noexcept {
+			// classify by UTF-8 length and find the surrogates in the same pass
+			const __m128i __two        = __utf16_greater_than_sse(__block, 0x7F);
+			const __m128i __three      = __utf16_greater_than_sse(__block, 0x7FF);
+			const __m128i __surrogates = __utf16_surrogates_sse(__block, 0xF800, 0xD800);
+			if (!__utf16_is_paired_sse(__block, __surrogates)) {
+				// an unpaired surrogate, or a pair split across blocks
+				return 0;
+			}
+			// one more code unit for every comparison that holds, and one less for every half of a surrogate pair
+			// (which would otherwise count as 3 + 3, rather than 4)
+			__m128i __extra = _mm_sub_epi16(_mm_sub_epi16(_mm_setzero_si128(), __two), __three);
+			__extra         = _mm_add_epi16(__extra, __surrogates);
+			__extra         = _mm_madd_epi16(__extra, _mm_set1_epi16(1));
+			__extra         = _mm_add_epi32(__extra, _mm_shuffle_epi32(__extra, _MM_SHUFFLE(1, 0, 3, 2)));
+			__extra         = _mm_add_epi32(__extra, _mm_shuffle_epi32(__extra, _MM_SHUFFLE(2, 3, 0, 1)));
+			const ::std::size_t __length = 8 + static_cast<::std::size_t>(_mm_cvtsi128_si32(__extra));
+			if (__room < __length) {
+				return 0;
+			}
+			if (_mm_movemask_epi8(_mm_andnot_si128(__three, __two)) == 0xFFFF) {
+				// all in [ U+0080, U+07FF ]: a lead and a continuation for every code unit
+				const __m128i __lead_units = _mm_or_si128(_mm_srli_epi16(__block, 6), _mm_set1_epi16(0xC0));
+				const __m128i __continuation_units
+					= _mm_or_si128(_mm_and_si128(__block, _mm_set1_epi16(0x3F)), _mm_set1_epi16(0x80));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(__output),
+					_mm_or_si128(__lead_units, _mm_slli_epi16(__continuation_units, 8)));
+				return 16;
+			}
+			for (::std::size_t __index = 0; __index < 8;) {
+				__output += __utf8_write_unchecked(__utf16_read_paired(__input, __index), __output);
+			}
+			return __length;
+		}
+#endif
+
+		//////
+		/// @brief Converts the longest prefix of valid UTF-16 whose UTF-8 form fits in the output.
+		///
+		/// @remarks The input is taken 8 code units at a time. In one pass over each block, the code units are
+		/// classified by the length of their UTF-8 form and every surrogate is checked to be part of a pair. A block
+		/// that passes has the exact size of its UTF-8 form checked against the output once, and is then written
+		/// without further checks: in one go when it is all ASCII or all 2-code unit sequences (most Latin, Greek,
+		/// Cyrillic, Hebrew and Arabic letters). Any other block goes one code point at a time, stopping right
+		/// before a lone surrogate, a lead surrogate at the very end of the input, or a code point that does not
+		/// fit. That is exactly where ztd::text::basic_utf16::decode_one and ztd::text::basic_utf8::encode_one take
+		/// over and call the error handlers.
+		//////
+		struct __utf16_to_utf8_kernel {
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				::std::size_t __index        = 0;
+				::std::size_t __output_index = 0;
+				while (__index < __input_size) {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+					if (__index + 8 <= __input_size) {
+						const ::std::size_t __room = __output_size - __output_index;
+						const __m128i __block
+							= _mm_loadu_si128(reinterpret_cast<const __m128i*>(__input + __index));
+						if (__utf16_is_ascii_sse(__block)) {
+							if (__room >= 8) {
+								_mm_storel_epi64(reinterpret_cast<__m128i*>(__output + __output_index),
+									_mm_packus_epi16(__block, __block));
+								__index += 8;
+								__output_index += 8;
+								continue;
+							}
+						}
+						else if (const ::std::size_t __written = __utf16_to_utf8_block_sse(
+							          __input + __index, __block, __room, __output + __output_index);
+							     __written != 0) {
+							__index += 8;
+							__output_index += __written;
+							continue;
+						}
+					}
+#endif
+					// go one code point at a time through (at least) the next 8 code units
+					const ::std::size_t __scalar_last = __input_size - __index < 8 ? __input_size : __index + 8;
+					while (__index < __scalar_last) {
+						char32_t __code_point = 0;
+						const ::std::size_t __read
+							= __utf16_read_checked(__input, __input_size, __index, __code_point);
+						if (__read == 0) {
+							return __bulk_io { __index, __output_index };
+						}
+						const ::std::size_t __needed = static_cast<::std::size_t>(__decode_length(__code_point));
+						if (__output_size - __output_index < __needed) {
+							return __bulk_io { __index, __output_index };
+						}
+						__output_index += __utf8_write_unchecked(__code_point, __output + __output_index);
+						__index += __read;
+					}
+				}
+				return __bulk_io { __index, __output_index };
+			}
+		};
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+		// Widens blocks of 16 code units without any surrogates to UTF-32 for as long as they last and fit in
+		// __room, returning how many were converted.
+		template <typename _InputUnit, typename _OutputUnit>
+		ZTD_TEXT_SIMD_TARGET_AVX2_I_ inline ::std::size_t __utf16_widen_bmp_avx2(const _InputUnit* __input,
+			::std::size_t __size, _OutputUnit* __output, ::std::size_t __room) noexcept {
+			const ::std::size_t __last = __size < __room ? __size : __room;
+			::std::size_t __index      = 0;
+			for (; __index + 16 <= __last; __index += 16) {
+				const __m256i __block
+					= _mm256_loadu_si256(reinterpret_cast<const __m256i*>(__input + __index));
+				const __m256i __surrogates = _mm256_cmpeq_epi16(
+					_mm256_and_si256(__block, _mm256_set1_epi16(static_cast<short>(0xF800))),
+					_mm256_set1_epi16(static_cast<short>(0xD800)));
+				if (_mm256_movemask_epi8(__surrogates) != 0) {
+					break;
+				}
+				__m256i* __target = reinterpret_cast<__m256i*>(__output + __index);
+				_mm256_storeu_si256(__target + 0, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(__block)));
+				_mm256_storeu_si256(__target + 1, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(__block, 1)));
+			}
+			return __index;
+		}
+#endif
+
+		//////
+		/// @brief Converts the longest prefix of valid UTF-16 whose UTF-32 form fits in the output.
+		///
+		/// @remarks Blocks of 8 (16 with AVX2) code units without any surrogates are widened in one go. A block
+		/// whose surrogates are all paired up within it is combined pair by pair without further checks. Anything
+		/// else goes one code point at a time, stopping right before a lone surrogate, a lead surrogate at the very
+		/// end of the input, or the end of the output.
+		//////
+		struct __utf16_to_utf32_kernel {
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+				const bool __use_avx2 = active_simd_level() >= simd_level::avx2;
+#endif
+				::std::size_t __index        = 0;
+				::std::size_t __output_index = 0;
+				while (__index < __input_size) {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+					if (__use_avx2 && __index + 16 <= __input_size) {
+						const ::std::size_t __widened = __utf16_widen_bmp_avx2(__input + __index,
+							__input_size - __index, __output + __output_index, __output_size - __output_index);
+						if (__widened != 0) {
+							__index += __widened;
+							__output_index += __widened;
+							continue;
+						}
+					}
+#endif
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+					// 8 code units never make more than 8 code points
+					if (__index + 8 <= __input_size && __output_size - __output_index >= 8) {
+						const __m128i __block
+							= _mm_loadu_si128(reinterpret_cast<const __m128i*>(__input + __index));
+						const __m128i __surrogates = __utf16_surrogates_sse(__block, 0xF800, 0xD800);
+						if (_mm_movemask_epi8(__surrogates) == 0) {
+							const __m128i __zero = _mm_setzero_si128();
+							__m128i* __target    = reinterpret_cast<__m128i*>(__output + __output_index);
+							_mm_storeu_si128(__target + 0, _mm_unpacklo_epi16(__block, __zero));
+							_mm_storeu_si128(__target + 1, _mm_unpackhi_epi16(__block, __zero));
+							__index += 8;
+							__output_index += 8;
+							continue;
+						}
+						if (__utf16_is_paired_sse(__block, __surrogates)) {
+							const ::std::size_t __block_last = __index + 8;
+							while (__index < __block_last) {
+								__output[__output_index]
+									= static_cast<_OutputUnit>(__utf16_read_paired(__input, __index));
+								++__output_index;
+							}
+							continue;
+						}
+					}
+#endif
+					// go one code point at a time through (at least) the next 8 code units
+					const ::std::size_t __scalar_last = __input_size - __index < 8 ? __input_size : __index + 8;
+					while (__index < __scalar_last) {
+						char32_t __code_point = 0;
+						const ::std::size_t __read
+							= __utf16_read_checked(__input, __input_size, __index, __code_point);
+						if (__read == 0 || __output_index == __output_size) {
+							return __bulk_io { __index, __output_index };
+						}
+						__output[__output_index] = static_cast<_OutputUnit>(__code_point);
+						++__output_index;
+						__index += __read;
+					}
+				}
+				return __bulk_io { __index, __output_index };
+			}
+		};
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+		// Converts the 8 code points at __input to UTF-16, if they are all valid and their UTF-16 form fits in
+		// __room code units. Returns how many code units were written, or 0 (having written nothing) if the block
+		// has to be converted one code point at a time.
+		template <typename _InputUnit, typename _OutputUnit>
+		inline ::std::size_t __utf32_to_utf16_block_sse(
+			const _InputUnit* __input, ::std::size_t __room, _OutputUnit* __output) noexcept {
+			const __m128i* __source = reinterpret_cast<const __m128i*>(__input);
+			const __m128i __low     = _mm_loadu_si128(__source + 0);
+			const __m128i __high    = _mm_loadu_si128(__source + 1);
+			if (_mm_movemask_epi8(_mm_or_si128(__utf32_invalid_sse(__low), __utf32_invalid_sse(__high))) != 0) {
+				return 0;
+			}
+			// valid code points are never negative, so the signed comparison is fine; 2 mask bits per code point
+			const __m128i __last_bmp = _mm_set1_epi32(static_cast<int>(__last_bmp_value));
+			const ::std::uint_least32_t __supplementary_mask = static_cast<::std::uint_least32_t>(_mm_movemask_epi8(
+				_mm_packs_epi32(_mm_cmpgt_epi32(__low, __last_bmp), _mm_cmpgt_epi32(__high, __last_bmp))));
+			if (__supplementary_mask == 0) {
+				if (__room < 8) {
+					return 0;
+				}
+				// there is no unsigned 32-to-16-bit narrowing in SSE2: move the values into the signed range,
+				// narrow, and then move them back
+				const __m128i __bias32 = _mm_set1_epi32(0x8000);
+				const __m128i __narrow
+					= _mm_packs_epi32(_mm_sub_epi32(__low, __bias32), _mm_sub_epi32(__high, __bias32));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(__output),
+					_mm_xor_si128(__narrow, _mm_set1_epi16(static_cast<short>(0x8000))));
+				return 8;
+			}
+			const ::std::size_t __length = 8 + static_cast<::std::size_t>(__popcount(__supplementary_mask) / 2);
+			if (__room < __length) {
+				return 0;
+			}
+			for (::std::size_t __index = 0; __index < 8; ++__index) {
+				__output += __utf16_write_unchecked(__utf32_unit(__input[__index]), __output);
+			}
+			return __length;
+		}
+#endif
+
+		//////
+		/// @brief Converts the longest prefix of valid UTF-32 whose UTF-16 form fits in the output.
+		///
+		/// @remarks Blocks of 8 code points that are all in the Basic Multilingual Plane (and not surrogates) are
+		/// narrowed in one go. Blocks of valid code points with some above it have the exact size of their UTF-16
+		/// form checked against the output once, and are then split into surrogate pairs without further checks.
+		/// Anything else goes one code point at a time, stopping right before a surrogate, a value past the last
+		/// code point, or a code point that does not fit.
+		//////
+		struct __utf32_to_utf16_kernel {
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				::std::size_t __index        = 0;
+				::std::size_t __output_index = 0;
+				while (__index < __input_size) {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+					if (__index + 8 <= __input_size) {
+						const ::std::size_t __written = __utf32_to_utf16_block_sse(
+							__input + __index, __output_size - __output_index, __output + __output_index);
+						if (__written != 0) {
+							__index += 8;
+							__output_index += __written;
+							continue;
+						}
+					}
+#endif
+					// go one code point at a time through (at least) the next 8 code points
+					const ::std::size_t __scalar_last = __input_size - __index < 8 ? __input_size : __index + 8;
+					for (; __index < __scalar_last; ++__index) {
+						const char32_t __code_point = __utf32_unit(__input[__index]);
+						if (__code_point > __last_code_point || __is_surrogate(__code_point)) {
+							return __bulk_io { __index, __output_index };
+						}
+						const ::std::size_t __needed = __code_point > __last_bmp_value ? 2 : 1;
+						if (__output_size - __output_index < __needed) {
+							return __bulk_io { __index, __output_index };
+						}
+						__output_index += __utf16_write_unchecked(__code_point, __output + __output_index);
+					}
+				}
+				return __bulk_io { __index, __output_index };
+			}
+		};
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+		// Returns the offset of the first block of 16 code units with a surrogate in it (or that is not all there).
+		template <typename _InputUnit>
+		ZTD_TEXT_SIMD_TARGET_AVX2_I_ inline ::std::size_t __utf16_surrogate_free_blocks_avx2(
+			const _InputUnit* __input, ::std::size_t __size) noexcept {
+			::std::size_t __index = 0;
+			for (; __index + 16 <= __size; __index += 16) {
+				const __m256i __block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(__input + __index));
+				const __m256i __surrogates = _mm256_cmpeq_epi16(
+					_mm256_and_si256(__block, _mm256_set1_epi16(static_cast<short>(0xF800))),
+					_mm256_set1_epi16(static_cast<short>(0xD800)));
+				if (!_mm256_testz_si256(__surrogates, __surrogates)) {
+					break;
+				}
+			}
+			return __index;
+		}
+
+		// Counts the trail surrogates of the whole blocks of 16 in [ __input, __input + __size ).
+		template <typename _InputUnit>
+		ZTD_TEXT_SIMD_TARGET_AVX2_I_ inline ::std::size_t __utf16_count_trails_avx2(
+			const _InputUnit* __input, ::std::size_t __size) noexcept {
+			const __m256i __ones  = _mm256_set1_epi16(1);
+			::std::size_t __count = 0;
+			::std::size_t __index = 0;
+			while (__index + 16 <= __size) {
+				// every 16-bit lane counts at most 32767 blocks, so that they can be summed up as signed values
+				::std::size_t __blocks = (__size - __index) / 16;
+				__blocks               = __blocks < 32767 ? __blocks : 32767;
+				__m256i __lanes        = _mm256_setzero_si256();
+				for (; __blocks != 0; --__blocks, __index += 16) {
+					const __m256i __block
+						= _mm256_loadu_si256(reinterpret_cast<const __m256i*>(__input + __index));
+					const __m256i __trails = _mm256_cmpeq_epi16(
+						_mm256_and_si256(__block, _mm256_set1_epi16(static_cast<short>(0xFC00))),
+						_mm256_set1_epi16(static_cast<short>(0xDC00)));
+					__lanes = _mm256_sub_epi16(__lanes, __trails);
+				}
+				const __m256i __pairs = _mm256_madd_epi16(__lanes, __ones);
+				__m128i __sums
+					= _mm_add_epi32(_mm256_castsi256_si128(__pairs), _mm256_extracti128_si256(__pairs, 1));
+				__sums = _mm_add_epi32(__sums, _mm_srli_si128(__sums, 8));
+				__sums = _mm_add_epi32(__sums, _mm_srli_si128(__sums, 4));
+				__count += static_cast<::std::size_t>(_mm_cvtsi128_si32(__sums));
+			}
+			return __count;
+		}
+#endif
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+		// Counts the trail surrogates of the whole blocks of 8 in [ __input, __input + __size ).
+		template <typename _InputUnit>
+		inline ::std::size_t __utf16_count_trails_sse(const _InputUnit* __input, ::std::size_t __size) noexcept {
+			const __m128i __ones  = _mm_set1_epi16(1);
+			::std::size_t __count = 0;
+			::std::size_t __index = 0;
+			while (__index + 8 <= __size) {
+				::std::size_t __blocks = (__size - __index) / 8;
+				__blocks               = __blocks < 32767 ? __blocks : 32767;
+				__m128i __lanes        = _mm_setzero_si128();
+				for (; __blocks != 0; --__blocks, __index += 8) {
+					const __m128i __block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__input + __index));
+					__lanes = _mm_sub_epi16(__lanes, __utf16_surrogates_sse(__block, 0xFC00, 0xDC00));
+				}
+				__m128i __sums = _mm_madd_epi16(__lanes, __ones);
+				__sums         = _mm_add_epi32(__sums, _mm_srli_si128(__sums, 8));
+				__sums         = _mm_add_epi32(__sums, _mm_srli_si128(__sums, 4));
+				__count += static_cast<::std::size_t>(_mm_cvtsi128_si32(__sums));
+			}
+			return __count;
+		}
+#endif
+
+		// Counts the code points in [ __input, __input + __size ), which must not contain lone surrogates: every
+		// code unit but the trail surrogates starts one.
+		template <typename _InputUnit>
+		inline ::std::size_t __utf16_count_unchecked(const _InputUnit* __input, ::std::size_t __size) noexcept {
+			::std::size_t __trails = 0;
+			::std::size_t __index  = 0;
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+			if (active_simd_level() >= simd_level::avx2) {
+				__trails += __utf16_count_trails_avx2(__input, __size);
+				__index = __size - __size % 16;
+			}
+#endif
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+			__trails += __utf16_count_trails_sse(__input + __index, __size - __index);
+			__index = __size - __size % 8;
+#endif
+			for (; __index < __size; ++__index) {
+				__trails += __is_trail_surrogate(__utf16_unit(__input[__index])) ? 1 : 0;
+			}
+			return __size - __trails;
+		}
+
+		//////
+		/// @brief Counts the code points in the longest prefix of valid UTF-16, reporting them as the @c
+		/// output_written of the result.
+		///
+		/// @remarks Blocks of 8 (16 with AVX2) code units without any surrogates count as that many code points, and
+		/// a block whose surrogates are all paired up within it counts one less for every pair. Anything else goes
+		/// one code point at a time, stopping right before a lone surrogate or a lead surrogate at the very end of
+		/// the input.
+		///
+		/// If @p _AssumeValid is true, the input is taken to be valid (as with ztd::text::assume_valid_handler) and
+		/// all of it is counted without being checked.
+		//////
+		template <bool _AssumeValid = false>
+		struct __utf16_count_kernel {
+			template <typename _InputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size) const noexcept {
+				if constexpr (_AssumeValid) {
+					return __bulk_io { __input_size, __utf16_count_unchecked(__input, __input_size) };
+				}
+				else {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+					const bool __use_avx2 = active_simd_level() >= simd_level::avx2;
+#endif
+					::std::size_t __index = 0;
+					::std::size_t __count = 0;
+					while (__index < __input_size) {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+						if (__use_avx2 && __index + 16 <= __input_size) {
+							const ::std::size_t __surrogate_free
+								= __utf16_surrogate_free_blocks_avx2(__input + __index, __input_size - __index);
+							if (__surrogate_free != 0) {
+								__index += __surrogate_free;
+								__count += __surrogate_free;
+								continue;
+							}
+						}
+#endif
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+						if (__index + 8 <= __input_size) {
+							const __m128i __block
+								= _mm_loadu_si128(reinterpret_cast<const __m128i*>(__input + __index));
+							const __m128i __surrogates = __utf16_surrogates_sse(__block, 0xF800, 0xD800);
+							const int __mask           = _mm_movemask_epi8(__surrogates);
+							if (__mask == 0) {
+								__index += 8;
+								__count += 8;
+								continue;
+							}
+							if (__utf16_is_paired_sse(__block, __surrogates)) {
+								// 2 mask bits for each of the 2 code units in a pair
+								__index += 8;
+								__count += 8 - static_cast<::std::size_t>(__popcount(
+									static_cast<::std::uint_least32_t>(__mask)) / 4);
+								continue;
+							}
+						}
+#endif
+						// go one code point at a time through (at least) the next 8 code units
+						const ::std::size_t __scalar_last
+							= __input_size - __index < 8 ? __input_size : __index + 8;
+						while (__index < __scalar_last) {
+							char32_t __code_point = 0;
+							const ::std::size_t __read
+								= __utf16_read_checked(__input, __input_size, __index, __code_point);
+							if (__read == 0) {
+								return __bulk_io { __index, __count };
+							}
+							__index += __read;
+							++__count;
+						}
+					}
+					return __bulk_io { __index, __count };
+				}
+			}
+		};
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_BULK_UTF16_HPP
@@ -0,0 +1,831 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_BULK_UTF8_HPP
+#define ZTD_TEXT_DETAIL_BULK_UTF8_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/detail/unicode.hpp>
+#include <ztd/text/detail/utf8_dfa.hpp>
+#include <ztd/text/detail/bulk.hpp>
+#include <ztd/text/detail/range.hpp>
+#include <ztd/text/detail/memory.hpp>
+#include <ztd/text/detail/type_traits.hpp>
+#include <ztd/text/detail/simd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		template <typename _Input, typename _CodeUnit>
+		inline constexpr bool __is_bulk_utf8_input_v = (sizeof(_CodeUnit) == 1)
+			&& __is_sized_contiguous_range_v<_Input> && (sizeof(__range_value_type_t<_Input>) == 1)
+			&& __is_character_v<__remove_cvref_t<__range_value_type_t<_Input>>>;
+
+		// Validates a single sequence starting at __index, with exactly the same result as
+		// ztd::text::basic_utf8::decode_one. On success, __index is moved past the sequence.
+		template <typename _It>
+		constexpr encoding_error __utf8_validate_sequence(
+			const _It& __first, ::std::size_t __size, ::std::size_t& __index) noexcept {
+			char32_t __code_point = 0;
+			return __utf8_decode_sequence(__first, __size, __index, __code_point);
+		}
+
+		template <typename _It>
+		constexpr __bulk_result __utf8_validate_scalar(
+			const _It& __first, ::std::size_t __size, ::std::size_t __index = 0) noexcept {
+			while (__index < __size) {
+				if (static_cast<uchar8_t>(__first[__index]) < 0x80) {
+					++__index;
+					continue;
+				}
+				const ::std::size_t __sequence_index = __index;
+				const encoding_error __error         = __utf8_validate_sequence(__first, __size, __index);
+				if (__error != encoding_error::ok) {
+					return __bulk_result { __sequence_index, __error };
+				}
+			}
+			return __bulk_result { __size, encoding_error::ok };
+		}
+
+		// Given that [0, __index) has been checked by a block validator which does not look past __index, backs
+		// __index up to the start of any multi-unit sequence that is cut off at __index.
+		inline ::std::size_t __utf8_last_boundary(const unsigned char* __first, ::std::size_t __index) noexcept {
+			for (::std::size_t __back = 1; __back <= 3 && __back <= __index; ++__back) {
+				const unsigned char __unit = __first[__index - __back];
+				if (__unit < 0x80) {
+					break;
+				}
+				if (__unit >= 0xC0) {
+					const ::std::size_t __length = static_cast<::std::size_t>(__sequence_length(__unit));
+					return __length > __back ? __index - __back : __index;
+				}
+			}
+			return __index;
+		}
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE4_2_I_)
+		// Lookup tables for the "lookup" UTF-8 validation algorithm from John Keiser and Daniel Lemire's
+		// "Validating UTF-8 In Less Than One Instruction Per Byte". Each table is indexed by a nibble of either the
+		// previous or the current code unit; the AND of the 3 lookups is non-zero only for an invalid pair.
+		inline constexpr unsigned char __utf8_too_short      = 1 << 0;
+		inline constexpr unsigned char __utf8_too_long       = 1 << 1;
+		inline constexpr unsigned char __utf8_overlong_3     = 1 << 2;
+		inline constexpr unsigned char __utf8_too_large      = 1 << 3;
+		inline constexpr unsigned char __utf8_surrogate      = 1 << 4;
+		inline constexpr unsigned char __utf8_overlong_2     = 1 << 5;
+		inline constexpr unsigned char __utf8_too_large_1000 = 1 << 6;
+		inline constexpr unsigned char __utf8_overlong_4     = 1 << 6;
+		inline constexpr unsigned char __utf8_two_conts      = 1 << 7;
+		inline constexpr unsigned char __utf8_carry = __utf8_too_short | __utf8_too_long | __utf8_two_conts;
+
+		alignas(16) inline constexpr unsigned char __utf8_byte_1_high_table[16] = {
+			// 0_______ ________ : ASCII as the first unit
+			__utf8_too_long, __utf8_too_long, __utf8_too_long, __utf8_too_long, __utf8_too_long, __utf8_too_long,
+			__utf8_too_long, __utf8_too_long,
+			// 10______ ________ : continuation as the first unit
+			__utf8_two_conts, __utf8_two_conts, __utf8_two_conts, __utf8_two_conts,
+			// 1100____ ________ : 2-unit lead
+			__utf8_too_short | __utf8_overlong_2,
+			// 1101____ ________ : 2-unit lead
+			__utf8_too_short,
+			// 1110____ ________ : 3-unit lead
+			__utf8_too_short | __utf8_overlong_3 | __utf8_surrogate,
+			// 1111____ ________ : 4-unit (or more) lead
+			__utf8_too_short | __utf8_too_large | __utf8_too_large_1000 | __utf8_overlong_4
+		};
+
+		alignas(16) inline constexpr unsigned char __utf8_byte_1_low_table[16] = {
+			// ____0000 ________
+			__utf8_carry | __utf8_overlong_3 | __utf8_overlong_2 | __utf8_overlong_4,
+			// ____0001 ________
+			__utf8_carry | __utf8_overlong_2,
+			// ____001_ ________
+			__utf8_carry, __utf8_carry,
+			// ____0100 ________
+			__utf8_carry | __utf8_too_large,
+			// ____0101 ________
+			__utf8_carry | __utf8_too_large | __utf8_too_large_1000,
+			// ____011_ ________
+			__utf8_carry | __utf8_too_large | __utf8_too_large_1000,
+			__utf8_carry | __utf8_too_large | __utf8_too_large_1000,
+			// ____1___ ________
+			__utf8_carry | __utf8_too_large | __utf8_too_large_1000,
+			__utf8_carry | __utf8_too_large | __utf8_too_large_1000,
+			__utf8_carry | __utf8_too_large | __utf8_too_large_1000,
+			__utf8_carry | __utf8_too_large | __utf8_too_large_1000,
+			__utf8_carry | __utf8_too_large | __utf8_too_large_1000,
+			// ____1101 ________
+			__utf8_carry | __utf8_too_large | __utf8_too_large_1000 | __utf8_surrogate,
+			__utf8_carry | __utf8_too_large | __utf8_too_large_1000,
+			__utf8_carry | __utf8_too_large | __utf8_too_large_1000
+		};
+
+		alignas(16) inline constexpr unsigned char __utf8_byte_2_high_table[16] = {
+			// ________ 0_______ : ASCII as the second unit
+			__utf8_too_short, __utf8_too_short, __utf8_too_short, __utf8_too_short, __utf8_too_short,
+			__utf8_too_short, __utf8_too_short, __utf8_too_short,
+			// ________ 1000____
+			__utf8_too_long | __utf8_overlong_2 | __utf8_two_conts | __utf8_overlong_3 | __utf8_too_large_1000
+			     | __utf8_overlong_4,
+			// ________ 1001____
+			__utf8_too_long | __utf8_overlong_2 | __utf8_two_conts | __utf8_overlong_3 | __utf8_too_large,
+			// ________ 101_____
+			__utf8_too_long | __utf8_overlong_2 | __utf8_two_conts | __utf8_surrogate | __utf8_too_large,
+			__utf8_too_long | __utf8_overlong_2 | __utf8_two_conts | __utf8_surrogate | __utf8_too_large,
+			// ________ 11______ : lead as the second unit
+			__utf8_too_short, __utf8_too_short, __utf8_too_short, __utf8_too_short
+		};
+
+		alignas(16) inline constexpr unsigned char __utf8_incomplete_table[32] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1 };
+
+		ZTD_TEXT_SIMD_TARGET_SSE4_2_I_ inline __m128i __utf8_check_block_sse(
+			__m128i __input, __m128i __prev_input) noexcept {
+			const __m128i __nibble_mask = _mm_set1_epi8(0x0F);
+			const __m128i __byte_1_high_lookup
+				= _mm_load_si128(reinterpret_cast<const __m128i*>(__utf8_byte_1_high_table));
+			const __m128i __byte_1_low_lookup
+				= _mm_load_si128(reinterpret_cast<const __m128i*>(__utf8_byte_1_low_table));
+			const __m128i __byte_2_high_lookup
+				= _mm_load_si128(reinterpret_cast<const __m128i*>(__utf8_byte_2_high_table));
+
+			const __m128i __prev1 = _mm_alignr_epi8(__input, __prev_input, 15);
+			const __m128i __byte_1_high
+				= _mm_shuffle_epi8(__byte_1_high_lookup, _mm_and_si128(_mm_srli_epi16(__prev1, 4), __nibble_mask));
+			const __m128i __byte_1_low
+				= _mm_shuffle_epi8(__byte_1_low_lookup, _mm_and_si128(__prev1, __nibble_mask));
+			const __m128i __byte_2_high
+				= _mm_shuffle_epi8(__byte_2_high_lookup, _mm_and_si128(_mm_srli_epi16(__input, 4), __nibble_mask));
+			const __m128i __special_cases = _mm_and_si128(_mm_and_si128(__byte_1_high, __byte_1_low), __byte_2_high);
+
+			const __m128i __prev2          = _mm_alignr_epi8(__input, __prev_input, 14);
+			const __m128i __prev3          = _mm_alignr_epi8(__input, __prev_input, 13);
+			const __m128i __is_third_unit  = _mm_subs_epu8(__prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+			const __m128i __is_fourth_unit = _mm_subs_epu8(__prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+			const __m128i __must_be_continuation = _mm_and_si128(
+				_mm_or_si128(__is_third_unit, __is_fourth_unit), _mm_set1_epi8(static_cast<char>(0x80)));
+			return _mm_xor_si128(__must_be_continuation, __special_cases);
+		}
+#endif
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+		ZTD_TEXT_SIMD_TARGET_AVX2_I_ inline __m256i __utf8_check_block_avx2(
+			__m256i __input, __m256i __prev_input) noexcept {
+			const __m256i __nibble_mask        = _mm256_set1_epi8(0x0F);
+			const __m256i __byte_1_high_lookup = _mm256_broadcastsi128_si256(
+				_mm_load_si128(reinterpret_cast<const __m128i*>(__utf8_byte_1_high_table)));
+			const __m256i __byte_1_low_lookup = _mm256_broadcastsi128_si256(
+				_mm_load_si128(reinterpret_cast<const __m128i*>(__utf8_byte_1_low_table)));
+			const __m256i __byte_2_high_lookup = _mm256_broadcastsi128_si256(
+				_mm_load_si128(reinterpret_cast<const __m128i*>(__utf8_byte_2_high_table)));
+
+			// the high half of the previous block + the low half of this one, so alignr can shift across lanes
+			const __m256i __straddle = _mm256_permute2x128_si256(__prev_input, __input, 0x21);
+			const __m256i __prev1    = _mm256_alignr_epi8(__input, __straddle, 15);
+			const __m256i __byte_1_high = _mm256_shuffle_epi8(
+				__byte_1_high_lookup, _mm256_and_si256(_mm256_srli_epi16(__prev1, 4), __nibble_mask));
+			const __m256i __byte_1_low
+				= _mm256_shuffle_epi8(__byte_1_low_lookup, _mm256_and_si256(__prev1, __nibble_mask));
+			const __m256i __byte_2_high = _mm256_shuffle_epi8(
+				__byte_2_high_lookup, _mm256_and_si256(_mm256_srli_epi16(__input, 4), __nibble_mask));
+			const __m256i __special_cases
+				= _mm256_and_si256(_mm256_and_si256(__byte_1_high, __byte_1_low), __byte_2_high);
+
+			const __m256i __prev2 = _mm256_alignr_epi8(__input, __straddle, 14);
+			const __m256i __prev3 = _mm256_alignr_epi8(__input, __straddle, 13);
+			const __m256i __is_third_unit
+				= _mm256_subs_epu8(__prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+			const __m256i __is_fourth_unit
+				= _mm256_subs_epu8(__prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+			const __m256i __must_be_continuation = _mm256_and_si256(
+				_mm256_or_si256(__is_third_unit, __is_fourth_unit), _mm256_set1_epi8(static_cast<char>(0x80)));
+			return _mm256_xor_si256(__must_be_continuation, __special_cases);
+		}
+#endif
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+		// Returns the offset of the first block of 32 code units with an error in it (or that is not all there).
+		ZTD_TEXT_SIMD_TARGET_AVX2_I_ inline ::std::size_t __utf8_validate_blocks_avx2(
+			const unsigned char* __first, ::std::size_t __size) noexcept {
+			const __m256i __incomplete_max
+				= _mm256_loadu_si256(reinterpret_cast<const __m256i*>(__utf8_incomplete_table));
+			__m256i __prev_input      = _mm256_setzero_si256();
+			__m256i __prev_incomplete = _mm256_setzero_si256();
+			::std::size_t __index     = 0;
+			for (; __index + 32 <= __size; __index += 32) {
+				const __m256i __input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(__first + __index));
+				__m256i __error;
+				if (_mm256_movemask_epi8(__input) == 0) {
+					__error           = __prev_incomplete;
+					__prev_incomplete = _mm256_setzero_si256();
+				}
+				else {
+					__error           = __utf8_check_block_avx2(__input, __prev_input);
+					__prev_incomplete = _mm256_subs_epu8(__input, __incomplete_max);
+				}
+				if (!_mm256_testz_si256(__error, __error)) {
+					break;
+				}
+				__prev_input = __input;
+			}
+			return __index;
+		}
+#endif
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE4_2_I_)
+		// Returns the offset of the first block of 16 code units with an error in it (or that is not all there).
+		ZTD_TEXT_SIMD_TARGET_SSE4_2_I_ inline ::std::size_t __utf8_validate_blocks_sse4_2(
+			const unsigned char* __first, ::std::size_t __size) noexcept {
+			const __m128i __incomplete_max
+				= _mm_load_si128(reinterpret_cast<const __m128i*>(__utf8_incomplete_table + 16));
+			__m128i __prev_input      = _mm_setzero_si128();
+			__m128i __prev_incomplete = _mm_setzero_si128();
+			::std::size_t __index     = 0;
+			for (; __index + 16 <= __size; __index += 16) {
+				const __m128i __input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__first + __index));
+				__m128i __error;
+				if (_mm_movemask_epi8(__input) == 0) {
+					__error           = __prev_incomplete;
+					__prev_incomplete = _mm_setzero_si128();
+				}
+				else {
+					__error           = __utf8_check_block_sse(__input, __prev_input);
+					__prev_incomplete = _mm_subs_epu8(__input, __incomplete_max);
+				}
+				if (!_mm_testz_si128(__error, __error)) {
+					break;
+				}
+				__prev_input = __input;
+			}
+			return __index;
+		}
+#endif
+
+		// Returns an index into the input such that [0, index) is valid UTF-8 and ends on a code point boundary.
+		// It stops at the first block containing an error (or that cannot be loaded in full); the scalar validator
+		// takes over from there to find the exact offset and kind of the error.
+		inline ::std::size_t __utf8_validate_blocks(const unsigned char* __first, ::std::size_t __size) noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE4_2_I_)
+			const simd_level __level = active_simd_level();
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+			if (__level >= simd_level::avx2) {
+				return __utf8_last_boundary(__first, __utf8_validate_blocks_avx2(__first, __size));
+			}
+#endif
+			if (__level >= simd_level::sse4_2) {
+				return __utf8_last_boundary(__first, __utf8_validate_blocks_sse4_2(__first, __size));
+			}
+#else
+			(void)__first;
+			(void)__size;
+#endif
+			return 0;
+		}
+
+		inline __bulk_result __utf8_validate_fast(const unsigned char* __first, ::std::size_t __size) noexcept {
+			::std::size_t __index = __utf8_validate_blocks(__first, __size);
+			while (__index < __size) {
+				__index += __ascii_prefix_length(__first + __index, __size - __index);
+				if (__index == __size) {
+					break;
+				}
+				const ::std::size_t __sequence_index = __index;
+				const encoding_error __error         = __utf8_validate_sequence(__first, __size, __index);
+				if (__error != encoding_error::ok) {
+					return __bulk_result { __sequence_index, __error };
+				}
+			}
+			return __bulk_result { __size, encoding_error::ok };
+		}
+
+		//////
+		/// @brief Validates [ __first, __first + __size ) as strict UTF-8, returning the offset and kind of the first
+		/// error exactly as a loop over ztd::text::basic_utf8::decode_one would.
+		///
+		/// @remarks During constant evaluation this uses a plain scalar loop; at run time it uses the widest block
+		/// validator enabled for the target, a word-at-a-time ASCII skip, and the scalar check for the rest.
+		//////
+		template <typename _It>
+		constexpr __bulk_result __utf8_validate(const _It& __first, ::std::size_t __size) noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_STD_LIBRARY_IS_CONSTANT_EVALUATED_I_)
+			if (!::std::is_constant_evaluated()) {
+				return __utf8_validate_fast(
+					reinterpret_cast<const unsigned char*>(__adl::__adl_to_address(__first)), __size);
+			}
+#endif
+			return __utf8_validate_scalar(__first, __size);
+		}
+
+		// Decodes the (already validated) sequence starting at __first[__index], moving __index past it.
+		inline char32_t __utf8_decode_one_unchecked(const unsigned char* __first, ::std::size_t& __index) noexcept {
+			const unsigned char __unit0 = __first[__index];
+			if (__unit0 < 0x80) {
+				__index += 1;
+				return static_cast<char32_t>(__unit0);
+			}
+			if (__unit0 < 0xE0) {
+				const char32_t __decoded = __decode(__unit0, __first[__index + 1]);
+				__index += 2;
+				return __decoded;
+			}
+			if (__unit0 < 0xF0) {
+				const char32_t __decoded = __decode(__unit0, __first[__index + 1], __first[__index + 2]);
+				__index += 3;
+				return __decoded;
+			}
+			const char32_t __decoded
+				= __decode(__unit0, __first[__index + 1], __first[__index + 2], __first[__index + 3]);
+			__index += 4;
+			return __decoded;
+		}
+
+		template <typename _OutputUnit>
+		inline ::std::size_t __utf16_write_unchecked(char32_t __code_point, _OutputUnit* __output) noexcept {
+			if (__code_point <= __last_bmp_value) {
+				__output[0] = static_cast<_OutputUnit>(__code_point);
+				return 1;
+			}
+			const char32_t __normal = __code_point - __normalizing_value;
+			__output[0]             = static_cast<_OutputUnit>(
+                    __first_lead_surrogate + ((__normal & __lead_surrogate_bitmask) >> __lead_shifted_bits));
+			__output[1] = static_cast<_OutputUnit>(__first_trail_surrogate + (__normal & __trail_surrogate_bitmask));
+			return 2;
+		}
+
+		// Writes a decoded code point as either UTF-16 or UTF-32, depending on the size of the output unit.
+		template <typename _OutputUnit>
+		inline ::std::size_t __utf8_write_decoded(char32_t __code_point, _OutputUnit* __output) noexcept {
+			if constexpr (sizeof(_OutputUnit) == 4) {
+				__output[0] = static_cast<_OutputUnit>(__code_point);
+				return 1;
+			}
+			else {
+				return __utf16_write_unchecked(__code_point, __output);
+			}
+		}
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+		// Widens blocks of 32 ASCII code units to UTF-16 or UTF-32 for as long as they last, returning how many
+		// were converted. There must be room for at least __size code units in __output.
+		template <typename _OutputUnit>
+		ZTD_TEXT_SIMD_TARGET_AVX2_I_ inline ::std::size_t __utf8_widen_ascii_avx2(
+			const unsigned char* __first, ::std::size_t __size, _OutputUnit* __output) noexcept {
+			::std::size_t __index = 0;
+			for (; __index + 32 <= __size; __index += 32) {
+				const __m256i __block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(__first + __index));
+				if (_mm256_movemask_epi8(__block) != 0) {
+					break;
+				}
+				__m256i* __target = reinterpret_cast<__m256i*>(__output + __index);
+				if constexpr (sizeof(_OutputUnit) == 4) {
+					const __m128i __low  = _mm256_castsi256_si128(__block);
+					const __m128i __high = _mm256_extracti128_si256(__block, 1);
+					_mm256_storeu_si256(__target + 0, _mm256_cvtepu8_epi32(__low));
+					_mm256_storeu_si256(__target + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(__low, 8)));
+					_mm256_storeu_si256(__target + 2, _mm256_cvtepu8_epi32(__high));
+					_mm256_storeu_si256(__target + 3, _mm256_cvtepu8_epi32(_mm_srli_si128(__high, 8)));
+				}
+				else {
+					_mm256_storeu_si256(__target + 0, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(__block)));
+					_mm256_storeu_si256(__target + 1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(__block, 1)));
+				}
+			}
+			return __index;
+		}
+#endif
+
+		// Converts [ __first, __first + __size ), which must be valid UTF-8 that ends on a code point boundary, to
+		// UTF-16 or UTF-32. There must be room for at least __size code units in __output.
+		template <typename _OutputUnit>
+		inline ::std::size_t __utf8_decode_unchecked(
+			const unsigned char* __first, ::std::size_t __size, _OutputUnit* __output) noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+			const bool __use_avx2 = active_simd_level() >= simd_level::avx2;
+#endif
+			::std::size_t __index        = 0;
+			::std::size_t __output_index = 0;
+			while (__index < __size) {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+				if (__use_avx2 && __index + 32 <= __size) {
+					const ::std::size_t __widened
+						= __utf8_widen_ascii_avx2(__first + __index, __size - __index, __output + __output_index);
+					if (__widened != 0) {
+						__index += __widened;
+						__output_index += __widened;
+						continue;
+					}
+				}
+#endif
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+				if (__index + 16 <= __size) {
+					const __m128i __block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__first + __index));
+					if (_mm_movemask_epi8(__block) == 0) {
+						const __m128i __zero = _mm_setzero_si128();
+						const __m128i __low  = _mm_unpacklo_epi8(__block, __zero);
+						const __m128i __high = _mm_unpackhi_epi8(__block, __zero);
+						__m128i* __target    = reinterpret_cast<__m128i*>(__output + __output_index);
+						if constexpr (sizeof(_OutputUnit) == 4) {
+							_mm_storeu_si128(__target + 0, _mm_unpacklo_epi16(__low, __zero));
+							_mm_storeu_si128(__target + 1, _mm_unpackhi_epi16(__low, __zero));
+							_mm_storeu_si128(__target + 2, _mm_unpacklo_epi16(__high, __zero));
+							_mm_storeu_si128(__target + 3, _mm_unpackhi_epi16(__high, __zero));
+						}
+						else {
+							_mm_storeu_si128(__target + 0, __low);
+							_mm_storeu_si128(__target + 1, __high);
+						}
+						__index += 16;
+						__output_index += 16;
+						continue;
+					}
+				}
+#endif
+				// not a pure ASCII block: go through (at least) the next 16 code units one code point at a time
+				const ::std::size_t __scalar_last = __size - __index < 16 ? __size : __index + 16;
+				do {
+					__output_index += __utf8_write_decoded(
+						__utf8_decode_one_unchecked(__first, __index), __output + __output_index);
+				} while (__index < __scalar_last);
+			}
+			return __output_index;
+		}
+
+		//////
+		/// @brief Decodes the longest prefix of valid UTF-8 whose UTF-16 (@p _OutputUnitSize is 2) or UTF-32 (@p
+		/// _OutputUnitSize is 4) form fits in the output.
+		///
+		/// @remarks Whenever the output has room for more code units than are left in the input (neither UTF-16 nor
+		/// UTF-32 ever need more code units than UTF-8 does), whole blocks are validated and then converted without
+		/// further checks. Everything else goes one code point at a time, with the same checks as
+		/// ztd::text::basic_utf8::decode_one.
+		///
+		/// If @p _AssumeValid is true, the input is taken to be valid (as with ztd::text::assume_valid_handler) and
+		/// is not validated at all: as much of it as fits in the output is converted in one go.
+		//////
+		template <::std::size_t _OutputUnitSize, bool _AssumeValid = false>
+		struct __utf8_decode_kernel {
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				static_assert(sizeof(_OutputUnit) == _OutputUnitSize, "the output unit size must match the kernel");
+				const unsigned char* __first = reinterpret_cast<const unsigned char*>(__input);
+				::std::size_t __index        = 0;
+				::std::size_t __output_index = 0;
+				while (__index < __input_size) {
+					const ::std::size_t __input_left  = __input_size - __index;
+					const ::std::size_t __output_left = __output_size - __output_index;
+					const ::std::size_t __convertible
+						= __input_left < __output_left ? __input_left : __output_left;
+					::std::size_t __valid;
+					if constexpr (_AssumeValid) {
+						__valid = __utf8_last_boundary(__first + __index, __convertible);
+					}
+					else {
+						__valid = __utf8_validate_blocks(__first + __index, __convertible);
+					}
+					if (__valid != 0) {
+						__output_index
+							+= __utf8_decode_unchecked(__first + __index, __valid, __output + __output_index);
+						__index += __valid;
+						continue;
+					}
+					// the block validator could not make progress (too little room, or an error somewhere
+					// close): go one code point at a time for a little while
+					const ::std::size_t __scalar_last = __input_left < 64 ? __input_size : __index + 64;
+					while (__index < __scalar_last) {
+						if (__output_index == __output_size) {
+							return __bulk_io { __index, __output_index };
+						}
+						if (__first[__index] < 0x80) {
+							const ::std::size_t __room = __output_size - __output_index;
+							::std::size_t __ascii
+								= __ascii_prefix_length(__first + __index, __scalar_last - __index);
+							__ascii = __ascii < __room ? __ascii : __room;
+							for (::std::size_t __ascii_index = 0; __ascii_index < __ascii; ++__ascii_index) {
+								__output[__output_index + __ascii_index]
+									= static_cast<_OutputUnit>(__first[__index + __ascii_index]);
+							}
+							__index += __ascii;
+							__output_index += __ascii;
+							continue;
+						}
+						::std::size_t __next  = __index;
+						char32_t __code_point = 0;
+						if (__utf8_decode_sequence(__first, __input_size, __next, __code_point)
+							!= encoding_error::ok) {
+							return __bulk_io { __index, __output_index };
+						}
+						const ::std::size_t __needed = (_OutputUnitSize == 2 && (__next - __index) == 4) ? 2 : 1;
+						if (__output_size - __output_index < __needed) {
+							return __bulk_io { __index, __output_index };
+						}
+						__output_index += __utf8_write_decoded(__code_point, __output + __output_index);
+						__index = __next;
+					}
+				}
+				return __bulk_io { __index, __output_index };
+			}
+		};
+
+		using __utf8_to_utf16_kernel = __utf8_decode_kernel<2>;
+		using __utf8_to_utf32_kernel = __utf8_decode_kernel<4>;
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+		// Counts the code units of the whole blocks of 32 in [ __first, __first + __size ) that are not
+		// continuations.
+		ZTD_TEXT_SIMD_TARGET_AVX2_I_ inline ::std::size_t __utf8_count_leads_avx2(
+			const unsigned char* __first, ::std::size_t __size) noexcept {
+			const __m256i __zero             = _mm256_setzero_si256();
+			const __m256i __continuation_max = _mm256_set1_epi8(static_cast<char>(0xBF));
+			::std::size_t __count            = 0;
+			::std::size_t __index            = 0;
+			while (__index + 32 <= __size) {
+				// every byte lane counts at most 255 blocks before being summed up
+				::std::size_t __blocks = (__size - __index) / 32;
+				__blocks               = __blocks < 255 ? __blocks : 255;
+				__m256i __lanes        = __zero;
+				for (; __blocks != 0; --__blocks, __index += 32) {
+					const __m256i __block
+						= _mm256_loadu_si256(reinterpret_cast<const __m256i*>(__first + __index));
+					// as signed bytes, continuations (0x80 to 0xBF) are the only values not greater than 0xBF
+					__lanes = _mm256_sub_epi8(__lanes, _mm256_cmpgt_epi8(__block, __continuation_max));
+				}
+				const __m256i __sums   = _mm256_sad_epu8(__lanes, __zero);
+				const __m128i __halves = _mm_add_epi64(
+					_mm256_castsi256_si128(__sums), _mm256_extracti128_si256(__sums, 1));
+				__count += static_cast<::std::size_t>(_mm_cvtsi128_si32(__halves))
+					+ static_cast<::std::size_t>(_mm_cvtsi128_si32(_mm_srli_si128(__halves, 8)));
+			}
+			return __count;
+		}
+#endif
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+		// Counts the code units of the whole blocks of 16 in [ __first, __first + __size ) that are not
+		// continuations.
+		inline ::std::size_t __utf8_count_leads_sse(const unsigned char* __first, ::std::size_t __size) noexcept {
+			const __m128i __zero             = _mm_setzero_si128();
+			const __m128i __continuation_max = _mm_set1_epi8(static_cast<char>(0xBF));
+			::std::size_t __count            = 0;
+			::std::size_t __index            = 0;
+			while (__index + 16 <= __size) {
+				::std::size_t __blocks = (__size - __index) / 16;
+				__blocks               = __blocks < 255 ? __blocks : 255;
+				__m128i __lanes        = __zero;
+				for (; __blocks != 0; --__blocks, __index += 16) {
+					const __m128i __block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__first + __index));
+					__lanes = _mm_sub_epi8(__lanes, _mm_cmpgt_epi8(__block, __continuation_max));
+				}
+				const __m128i __sums = _mm_sad_epu8(__lanes, __zero);
+				__count += static_cast<::std::size_t>(_mm_cvtsi128_si32(__sums))
+					+ static_cast<::std::size_t>(_mm_cvtsi128_si32(_mm_srli_si128(__sums, 8)));
+			}
+			return __count;
+		}
+#endif
+
+		// Counts the code points in [ __first, __first + __size ), which must be made of whole sequences: each one
+		// has exactly one code unit that is not a continuation.
+		inline ::std::size_t __utf8_count_unchecked(const unsigned char* __first, ::std::size_t __size) noexcept {
+			::std::size_t __count = 0;
+			::std::size_t __index = 0;
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+			if (active_simd_level() >= simd_level::avx2) {
+				__count += __utf8_count_leads_avx2(__first, __size);
+				__index = __size - __size % 32;
+			}
+#endif
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+			__count += __utf8_count_leads_sse(__first + __index, __size - __index);
+			__index = __size - __size % 16;
+#endif
+			for (; __index < __size; ++__index) {
+				__count += (__first[__index] & 0xC0) != 0x80 ? 1 : 0;
+			}
+			return __count;
+		}
+
+		inline constexpr ::std::size_t __utf8_count_chunk_size = 16384;
+
+		//////
+		/// @brief Counts the code points in the longest prefix of valid UTF-8, reporting them as the @c
+		/// output_written of the result.
+		///
+		/// @remarks The input is validated a chunk at a time (small enough to still be in the cache when it is read
+		/// again) and each valid chunk is then counted a whole vector at a time. Near an error, it goes one code
+		/// point at a time with the same checks as ztd::text::basic_utf8::decode_one, stopping right before the
+		/// error.
+		///
+		/// If @p _AssumeValid is true, the input is taken to be valid (as with ztd::text::assume_valid_handler) and
+		/// all of it is counted without being validated.
+		//////
+		template <bool _AssumeValid = false>
+		struct __utf8_count_kernel {
+			template <typename _InputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size) const noexcept {
+				const unsigned char* __first = reinterpret_cast<const unsigned char*>(__input);
+				if constexpr (_AssumeValid) {
+					return __bulk_io { __input_size, __utf8_count_unchecked(__first, __input_size) };
+				}
+				else {
+					::std::size_t __index = 0;
+					::std::size_t __count = 0;
+					while (__index < __input_size) {
+						const ::std::size_t __input_left = __input_size - __index;
+						const ::std::size_t __chunk
+							= __input_left < __utf8_count_chunk_size ? __input_left : __utf8_count_chunk_size;
+						const ::std::size_t __valid = __utf8_validate_blocks(__first + __index, __chunk);
+						if (__valid != 0) {
+							__count += __utf8_count_unchecked(__first + __index, __valid);
+							__index += __valid;
+							continue;
+						}
+						const ::std::size_t __scalar_last = __input_left < 64 ? __input_size : __index + 64;
+						while (__index < __scalar_last) {
+							if (__first[__index] < 0x80) {
+								const ::std::size_t __ascii
+									= __ascii_prefix_length(__first + __index, __scalar_last - __index);
+								__index += __ascii;
+								__count += __ascii;
+								continue;
+							}
+							const ::std::size_t __sequence_index = __index;
+							if (__utf8_validate_sequence(__first, __input_size, __index) != encoding_error::ok) {
+								return __bulk_io { __sequence_index, __count };
+							}
+							++__count;
+						}
+					}
+					return __bulk_io { __index, __count };
+				}
+			}
+		};
+
+		template <typename _OutputUnit>
+		inline ::std::size_t __utf8_write_unchecked(char32_t __code_point, _OutputUnit* __output) noexcept {
+			if (__code_point <= __last_1byte_value) {
+				__output[0] = static_cast<_OutputUnit>(__code_point);
+				return 1;
+			}
+			if (__code_point <= __last_2byte_value) {
+				__output[0] = static_cast<_OutputUnit>(0xC0 | (__code_point >> 6));
+				__output[1] = static_cast<_OutputUnit>(0x80 | (__code_point & 0x3F));
+				return 2;
+			}
+			if (__code_point <= __last_3byte_value) {
+				__output[0] = static_cast<_OutputUnit>(0xE0 | (__code_point >> 12));
+				__output[1] = static_cast<_OutputUnit>(0x80 | ((__code_point >> 6) & 0x3F));
+				__output[2] = static_cast<_OutputUnit>(0x80 | (__code_point & 0x3F));
+				return 3;
+			}
+			__output[0] = static_cast<_OutputUnit>(0xF0 | (__code_point >> 18));
+			__output[1] = static_cast<_OutputUnit>(0x80 | ((__code_point >> 12) & 0x3F));
+			__output[2] = static_cast<_OutputUnit>(0x80 | ((__code_point >> 6) & 0x3F));
+			__output[3] = static_cast<_OutputUnit>(0x80 | (__code_point & 0x3F));
+			return 4;
+		}
+
+		template <typename _InputUnit>
+		inline char32_t __utf32_unit(_InputUnit __unit) noexcept {
+			return static_cast<char32_t>(static_cast<::std::uint_least32_t>(__unit));
+		}
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+		// Returns a lane mask of the code points in __block which are surrogates or above the last code point.
+		inline __m128i __utf32_invalid_sse(__m128i __block) noexcept {
+			// there is no unsigned 32-bit comparison in SSE2: flip the sign bits first
+			const __m128i __bias      = _mm_set1_epi32(static_cast<int>(0x80000000u));
+			const __m128i __too_large = _mm_cmpgt_epi32(_mm_xor_si128(__block, __bias),
+				_mm_set1_epi32(static_cast<int>(0x80000000u | __last_code_point)));
+			const __m128i __surrogate
+				= _mm_cmpeq_epi32(_mm_and_si128(__block, _mm_set1_epi32(static_cast<int>(0xFFFFF800u))),
+				     _mm_set1_epi32(static_cast<int>(__first_surrogate)));
+			return _mm_or_si128(__too_large, __surrogate);
+		}
+#endif
+
+		//////
+		/// @brief Encodes the longest prefix of valid UTF-32 whose UTF-8 form fits in the output.
+		///
+		/// @remarks The input is taken 16 code points at a time. An all-ASCII block is narrowed in one go. Any other
+		/// block is classified by how many code units each of its code points needs, which gives the exact size of
+		/// its UTF-8 form: that is checked against the room left in the output once, and then the block is written
+		/// without any per-code unit bounds checks. Blocks with a surrogate or a value past the last code point,
+		/// and whatever does not fit, go one code point at a time, stopping right before the code point that
+		/// ztd::text::basic_utf8::encode_one has to deal with.
+		//////
+		struct __utf32_to_utf8_kernel {
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				::std::size_t __index        = 0;
+				::std::size_t __output_index = 0;
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+				for (; __index + 16 <= __input_size; __index += 16) {
+					const __m128i* __source = reinterpret_cast<const __m128i*>(__input + __index);
+					const __m128i __blocks[4] = { _mm_loadu_si128(__source + 0), _mm_loadu_si128(__source + 1),
+						_mm_loadu_si128(__source + 2), _mm_loadu_si128(__source + 3) };
+					const ::std::size_t __room = __output_size - __output_index;
+					_OutputUnit* __target      = __output + __output_index;
+					const __m128i __all        = _mm_or_si128(
+                              _mm_or_si128(__blocks[0], __blocks[1]), _mm_or_si128(__blocks[2], __blocks[3]));
+					const __m128i __non_ascii
+						= _mm_and_si128(__all, _mm_set1_epi32(static_cast<int>(~__last_1byte_value)));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi32(__non_ascii, _mm_setzero_si128())) == 0xFFFF) {
+						// the most common case, and the cheapest to classify: 16 code units
+						if (__room < 16) {
+							break;
+						}
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(__target),
+							_mm_packus_epi16(_mm_packs_epi32(__blocks[0], __blocks[1]),
+							     _mm_packs_epi32(__blocks[2], __blocks[3])));
+						__output_index += 16;
+						continue;
+					}
+					__m128i __invalid = _mm_setzero_si128();
+					__m128i __extra   = _mm_setzero_si128();
+					for (const __m128i& __block : __blocks) {
+						__invalid = _mm_or_si128(__invalid, __utf32_invalid_sse(__block));
+						// every comparison that holds adds one more code unit (each true lane is -1)
+						__extra = _mm_sub_epi32(__extra,
+							_mm_cmpgt_epi32(__block, _mm_set1_epi32(static_cast<int>(__last_1byte_value))));
+						__extra = _mm_sub_epi32(__extra,
+							_mm_cmpgt_epi32(__block, _mm_set1_epi32(static_cast<int>(__last_2byte_value))));
+						__extra = _mm_sub_epi32(__extra,
+							_mm_cmpgt_epi32(__block, _mm_set1_epi32(static_cast<int>(__last_3byte_value))));
+					}
+					if (_mm_movemask_epi8(__invalid) != 0) {
+						break;
+					}
+					__extra = _mm_add_epi32(__extra, _mm_shuffle_epi32(__extra, _MM_SHUFFLE(1, 0, 3, 2)));
+					__extra = _mm_add_epi32(__extra, _mm_shuffle_epi32(__extra, _MM_SHUFFLE(2, 3, 0, 1)));
+					const ::std::size_t __length = 16 + static_cast<::std::size_t>(_mm_cvtsi128_si32(__extra));
+					if (__room < __length) {
+						break;
+					}
+					for (::std::size_t __block_index = 0; __block_index < 16; ++__block_index) {
+						__target
+							+= __utf8_write_unchecked(__utf32_unit(__input[__index + __block_index]), __target);
+					}
+					__output_index += __length;
+				}
+#endif
+				for (; __index < __input_size; ++__index) {
+					const char32_t __code_point = __utf32_unit(__input[__index]);
+					if (__code_point > __last_code_point || __is_surrogate(__code_point)) {
+						break;
+					}
+					const ::std::size_t __room = __output_size - __output_index;
+					if (__room < static_cast<::std::size_t>(__decode_length(__code_point))) {
+						break;
+					}
+					__output_index += __utf8_write_unchecked(__code_point, __output + __output_index);
+				}
+				return __bulk_io { __index, __output_index };
+			}
+		};
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_BULK_UTF8_HPP
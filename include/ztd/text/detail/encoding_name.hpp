@@ -40,9 +40,12 @@
 #include <ztd/text/utf32.hpp>
 #include <ztd/text/encoding_scheme.hpp>
 #include <ztd/text/ascii.hpp>
+#include <ztd/text/single_byte_encoding.hpp>
 #include <ztd/text/no_encoding.hpp>
 
+#include <cstddef>
 #include <string_view>
+#include <tuple>
 
 namespace ztd { namespace text {
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
@@ -52,26 +55,24 @@ namespace ztd { namespace text {
 		inline constexpr bool __is_encoding_name_equal(
 			::std::string_view __left, ::std::string_view __right) noexcept {
 			constexpr std::string_view __readable_characters
-				= "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuuvwxyz1234567890";
-			constexpr std::string_view __uncased_characters = "abcdefghijklmnopqrstuuvwxyz";
+				= "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz1234567890";
+			constexpr std::string_view __uncased_characters = "abcdefghijklmnopqrstuvwxyz";
 			constexpr std::string_view __cased_characters   = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-			::std::size_t __left_size                       = __left.size();
-			::std::size_t __right_size                      = __right.size();
 			const char* __left_ptr                          = __left.data();
 			const char* __right_ptr                         = __right.data();
 			::std::size_t __left_index                      = 0;
 			::std::size_t __right_index                     = 0;
-			for (; __left_index < __left_size && __right_index < __right_size;) {
-				// find the first non-ignorable character we can read
-				::std::size_t __left_first_index = __left.find_first_of(__readable_characters, __left_index);
-				if (__left_first_index == ::std::string_view::npos) {
-					return __left_index == __right_index;
-				}
-				__left_index                      = __left_first_index + 1;
-				::std::size_t __right_first_index = __right.find_first_of(__readable_characters, __right_index);
-				if (__right_first_index == ::std::string_view::npos) {
-					return __left_index == __right_index;
+			for (;;) {
+				// find the next non-ignorable character we can read on both sides
+				const ::std::size_t __left_first_index = __left.find_first_of(__readable_characters, __left_index);
+				const ::std::size_t __right_first_index
+					= __right.find_first_of(__readable_characters, __right_index);
+				if (__left_first_index == ::std::string_view::npos
+					|| __right_first_index == ::std::string_view::npos) {
+					// both have to run out at the same time: "UTF-16" is not "UTF-16LE"
+					return __left_first_index == __right_first_index;
 				}
+				__left_index   = __left_first_index + 1;
 				__right_index  = __right_first_index + 1;
 				char __left_c  = __left_ptr[__left_first_index];
 				char __right_c = __right_ptr[__right_first_index];
@@ -85,12 +86,10 @@ namespace ztd { namespace text {
 					__right_c = __cased_characters[__right_c_casing_index];
 				}
 				// finally, check
-				if (__left_c == __right_c) {
-					continue;
+				if (__left_c != __right_c) {
+					return false;
 				}
-				return false;
 			}
-			return true;
 		}
 
 		inline constexpr bool __is_unicode_encoding_name(std::string_view __encoding_name) noexcept {
@@ -124,9 +123,126 @@ namespace ztd { namespace text {
 			__gb18030,
 			__utf1,
 			__cesu8,
-			__ascii
+			__ascii,
+			// the single-byte code pages, in the same order as __single_byte_table_list
+			__iso_8859_1,
+			__iso_8859_2,
+			__iso_8859_3,
+			__iso_8859_4,
+			__iso_8859_5,
+			__iso_8859_6,
+			__iso_8859_7,
+			__iso_8859_8,
+			__iso_8859_9,
+			__iso_8859_10,
+			__iso_8859_13,
+			__iso_8859_14,
+			__iso_8859_15,
+			__iso_8859_16,
+			__windows_1250,
+			__windows_1251,
+			__windows_1252,
+			__windows_1253,
+			__windows_1254,
+			__windows_1255,
+			__windows_1256,
+			__windows_1257,
+			__windows_1258,
+			__koi8_r,
+			__koi8_u,
+			__cp437,
+			__cp850,
+			__cp866
+		};
+
+		struct __encoding_name_entry {
+			::std::string_view __name;
+			__encoding_id __id;
 		};
 
+		inline constexpr __encoding_name_entry __single_byte_encoding_names[] = {
+			{ "ISO-8859-1", __encoding_id::__iso_8859_1 },
+			{ "LATIN1", __encoding_id::__iso_8859_1 },
+			{ "CP819", __encoding_id::__iso_8859_1 },
+			{ "IBM819", __encoding_id::__iso_8859_1 },
+			{ "ISO-8859-2", __encoding_id::__iso_8859_2 },
+			{ "LATIN2", __encoding_id::__iso_8859_2 },
+			{ "ISO-8859-3", __encoding_id::__iso_8859_3 },
+			{ "LATIN3", __encoding_id::__iso_8859_3 },
+			{ "ISO-8859-4", __encoding_id::__iso_8859_4 },
+			{ "LATIN4", __encoding_id::__iso_8859_4 },
+			{ "ISO-8859-5", __encoding_id::__iso_8859_5 },
+			{ "CYRILLIC", __encoding_id::__iso_8859_5 },
+			{ "ISO-8859-6", __encoding_id::__iso_8859_6 },
+			{ "ARABIC", __encoding_id::__iso_8859_6 },
+			{ "ISO-8859-7", __encoding_id::__iso_8859_7 },
+			{ "GREEK", __encoding_id::__iso_8859_7 },
+			{ "ISO-8859-8", __encoding_id::__iso_8859_8 },
+			{ "HEBREW", __encoding_id::__iso_8859_8 },
+			{ "ISO-8859-9", __encoding_id::__iso_8859_9 },
+			{ "LATIN5", __encoding_id::__iso_8859_9 },
+			{ "ISO-8859-10", __encoding_id::__iso_8859_10 },
+			{ "LATIN6", __encoding_id::__iso_8859_10 },
+			{ "ISO-8859-13", __encoding_id::__iso_8859_13 },
+			{ "LATIN7", __encoding_id::__iso_8859_13 },
+			{ "ISO-8859-14", __encoding_id::__iso_8859_14 },
+			{ "LATIN8", __encoding_id::__iso_8859_14 },
+			{ "ISO-8859-15", __encoding_id::__iso_8859_15 },
+			{ "LATIN9", __encoding_id::__iso_8859_15 },
+			{ "ISO-8859-16", __encoding_id::__iso_8859_16 },
+			{ "LATIN10", __encoding_id::__iso_8859_16 },
+			{ "WINDOWS-1250", __encoding_id::__windows_1250 },
+			{ "CP1250", __encoding_id::__windows_1250 },
+			{ "WINDOWS-1251", __encoding_id::__windows_1251 },
+			{ "CP1251", __encoding_id::__windows_1251 },
+			{ "WINDOWS-1252", __encoding_id::__windows_1252 },
+			{ "CP1252", __encoding_id::__windows_1252 },
+			{ "WINDOWS-1253", __encoding_id::__windows_1253 },
+			{ "CP1253", __encoding_id::__windows_1253 },
+			{ "WINDOWS-1254", __encoding_id::__windows_1254 },
+			{ "CP1254", __encoding_id::__windows_1254 },
+			{ "WINDOWS-1255", __encoding_id::__windows_1255 },
+			{ "CP1255", __encoding_id::__windows_1255 },
+			{ "WINDOWS-1256", __encoding_id::__windows_1256 },
+			{ "CP1256", __encoding_id::__windows_1256 },
+			{ "WINDOWS-1257", __encoding_id::__windows_1257 },
+			{ "CP1257", __encoding_id::__windows_1257 },
+			{ "WINDOWS-1258", __encoding_id::__windows_1258 },
+			{ "CP1258", __encoding_id::__windows_1258 },
+			{ "KOI8-R", __encoding_id::__koi8_r },
+			{ "KOI8-U", __encoding_id::__koi8_u },
+			{ "IBM437", __encoding_id::__cp437 },
+			{ "CP437", __encoding_id::__cp437 },
+			{ "IBM850", __encoding_id::__cp850 },
+			{ "CP850", __encoding_id::__cp850 },
+			{ "IBM866", __encoding_id::__cp866 },
+			{ "CP866", __encoding_id::__cp866 },
+		};
+
+		using __single_byte_table_list = ::std::tuple<
+			__single_byte_tables::__iso_8859_1, __single_byte_tables::__iso_8859_2,
+			__single_byte_tables::__iso_8859_3, __single_byte_tables::__iso_8859_4,
+			__single_byte_tables::__iso_8859_5, __single_byte_tables::__iso_8859_6,
+			__single_byte_tables::__iso_8859_7, __single_byte_tables::__iso_8859_8,
+			__single_byte_tables::__iso_8859_9, __single_byte_tables::__iso_8859_10,
+			__single_byte_tables::__iso_8859_13, __single_byte_tables::__iso_8859_14,
+			__single_byte_tables::__iso_8859_15, __single_byte_tables::__iso_8859_16,
+			__single_byte_tables::__windows_1250, __single_byte_tables::__windows_1251,
+			__single_byte_tables::__windows_1252, __single_byte_tables::__windows_1253,
+			__single_byte_tables::__windows_1254, __single_byte_tables::__windows_1255,
+			__single_byte_tables::__windows_1256, __single_byte_tables::__windows_1257,
+			__single_byte_tables::__windows_1258, __single_byte_tables::__koi8_r, __single_byte_tables::__koi8_u,
+			__single_byte_tables::__cp437, __single_byte_tables::__cp850, __single_byte_tables::__cp866>;
+
+		inline constexpr bool __is_single_byte_encoding_id(__encoding_id __id) noexcept {
+			return __id >= __encoding_id::__iso_8859_1 && __id <= __encoding_id::__cp866;
+		}
+
+		static_assert(::std::tuple_size_v<__single_byte_table_list>
+			     == static_cast<::std::size_t>(__encoding_id::__cp866)
+			          - static_cast<::std::size_t>(__encoding_id::__iso_8859_1) + 1,
+			"every single-byte encoding id needs its table");
+
 		inline constexpr __encoding_id __to_encoding_id(::std::string_view __name) {
 			if (__is_encoding_name_equal(__name, "UTF-8")) {
 				return __encoding_id::__utf8;
@@ -180,6 +296,11 @@ namespace ztd { namespace text {
 				return __encoding_id::__utf7imap;
 			}
 			else {
+				for (const __encoding_name_entry& __entry : __single_byte_encoding_names) {
+					if (__is_encoding_name_equal(__name, __entry.__name)) {
+						return __entry.__id;
+					}
+				}
 				return __encoding_id::__unknown;
 			}
 		}
@@ -209,6 +330,23 @@ namespace ztd { namespace text {
 			}
 		}
 
+		//////
+		/// @brief Whether an encoding may carry shift states between characters.
+		///
+		/// @remarks An unknown encoding is assumed to have them. The only portable way to ask the C library (@c mblen
+		/// with a null pointer) reads and resets hidden state shared by every thread, so it is never used for this.
+		//////
+		inline constexpr bool __is_shift_state_encoding_id(__encoding_id __id) noexcept {
+			switch (__id) {
+			case __encoding_id::__utf7:
+			case __encoding_id::__utf7imap:
+			case __encoding_id::__unknown:
+				return true;
+			default:
+				return false;
+			}
+		}
+
 		template <typename _CharType, __encoding_id _Id>
 		constexpr auto __select_encoding() {
 			if constexpr (_Id == __encoding_id::__utf8) {
@@ -224,27 +362,57 @@ namespace ztd { namespace text {
 				return basic_utf16<_CharType> {};
 			}
 			else if constexpr (_Id == __encoding_id::__utf16le) {
-				// TODO: beef up encoding_scheme to handle this better...!
-				return basic_utf16_le<_CharType> {};
+				if constexpr (sizeof(_CharType) == sizeof(char16_t) && endian::native == endian::little) {
+					// whole code units (e.g. wchar_t) that are already in the machine's own byte order
+					return basic_utf16<_CharType> {};
+				}
+				else {
+					// TODO: beef up encoding_scheme to handle this better...!
+					return basic_utf16_le<_CharType> {};
+				}
 			}
 			else if constexpr (_Id == __encoding_id::__utf16be) {
-				// TODO: beef up encoding_scheme to handle this better...!
-				return basic_utf16_be<_CharType> {};
+				if constexpr (sizeof(_CharType) == sizeof(char16_t) && endian::native == endian::big) {
+					// whole code units (e.g. wchar_t) that are already in the machine's own byte order
+					return basic_utf16<_CharType> {};
+				}
+				else {
+					// TODO: beef up encoding_scheme to handle this better...!
+					return basic_utf16_be<_CharType> {};
+				}
 			}
 			else if constexpr (_Id == __encoding_id::__utf32) {
 				return basic_utf32<_CharType> {};
 			}
 			else if constexpr (_Id == __encoding_id::__utf32le) {
-				// TODO: beef up encoding_scheme to handle this better...!
-				return basic_utf32_le<_CharType> {};
+				if constexpr (sizeof(_CharType) == sizeof(char32_t) && endian::native == endian::little) {
+					// whole code units (e.g. wchar_t) that are already in the machine's own byte order
+					return basic_utf32<_CharType> {};
+				}
+				else {
+					// TODO: beef up encoding_scheme to handle this better...!
+					return basic_utf32_le<_CharType> {};
+				}
 			}
 			else if constexpr (_Id == __encoding_id::__utf32be) {
-				// TODO: beef up encoding_scheme to handle this better...!
-				return basic_utf32_be<_CharType> {};
+				if constexpr (sizeof(_CharType) == sizeof(char32_t) && endian::native == endian::big) {
+					// whole code units (e.g. wchar_t) that are already in the machine's own byte order
+					return basic_utf32<_CharType> {};
+				}
+				else {
+					// TODO: beef up encoding_scheme to handle this better...!
+					return basic_utf32_be<_CharType> {};
+				}
 			}
 			else if constexpr (_Id == __encoding_id::__ascii) {
 				return basic_ascii<_CharType> {};
 			}
+			else if constexpr (__is_single_byte_encoding_id(_Id)) {
+				using _Table = ::std::tuple_element_t<static_cast<::std::size_t>(_Id)
+					     - static_cast<::std::size_t>(__encoding_id::__iso_8859_1),
+					__single_byte_table_list>;
+				return basic_single_byte_encoding<_Table, _CharType> {};
+			}
 			else {
 				return basic_no_encoding<_CharType, unicode_code_point> {};
 			}
@@ -0,0 +1,119 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_EXACT_SIZE_HPP
+#define ZTD_TEXT_DETAIL_EXACT_SIZE_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/error_handler.hpp>
+#include <ztd/text/is_ignorable_error_handler.hpp>
+#include <ztd/text/detail/adl.hpp>
+#include <ztd/text/detail/blackhole_iterator.hpp>
+#include <ztd/text/detail/range.hpp>
+#include <ztd/text/detail/type_traits.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		//////
+		/// @brief An output iterator which throws away everything written through it, but keeps track of how many
+		/// times it has been moved forward.
+		///
+		/// @remarks Running a conversion into an unbounded_view of one of these counts exactly how many code units
+		/// the same conversion writes into a real output.
+		//////
+		class __counting_iterator {
+		public:
+			using iterator_category = ::std::output_iterator_tag;
+			using difference_type   = ::std::ptrdiff_t;
+			using pointer           = __blackhole*;
+			using value_type        = __blackhole;
+			using reference         = __blackhole;
+
+			constexpr ::std::size_t count() const noexcept {
+				return _M_count;
+			}
+
+			constexpr __counting_iterator& operator++() noexcept {
+				++_M_count;
+				return *this;
+			}
+
+			constexpr __counting_iterator operator++(int) noexcept {
+				auto __copy = *this;
+				++_M_count;
+				return __copy;
+			}
+
+			constexpr reference operator*() const noexcept {
+				return reference {};
+			}
+
+		private:
+			::std::size_t _M_count = 0;
+		};
+
+		//////
+		/// @brief Whether the exact-size conversion functions (e.g. ztd::text::decode_to_exact) can count their
+		/// output before writing it: @p _Input has to be a sized range that can be read more than once, and @p
+		/// _OutputContainer a contiguous container that can be resized.
+		//////
+		template <typename _Input, typename _OutputContainer>
+		inline constexpr bool __is_exact_size_capable_v
+			= __is_detected_v<__detect_adl_size, _Input>
+			&& __is_range_iterator_concept_or_better_v<::std::forward_iterator_tag, __remove_cvref_t<_Input>>
+			&& __is_sized_contiguous_range_v<_OutputContainer>
+			&& __is_detected_v<__detect_resize_with_size_type, _OutputContainer&>;
+
+		//////
+		/// @brief The error handler used to count the output before it is written: it never changes anything, so
+		/// that any error shows up in the count's result without the user's error handler being called twice.
+		/// Ignorable error handlers are kept ignorable, so trusted input is not checked either way.
+		//////
+		template <typename _ErrorHandler>
+		using __exact_size_count_handler_t = ::std::conditional_t<
+			is_ignorable_error_handler_v<__remove_cvref_t<_ErrorHandler>>, assume_valid_handler, pass_handler>;
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_EXACT_SIZE_HPP
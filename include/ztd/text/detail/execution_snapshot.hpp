@@ -0,0 +1,177 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_EXECUTION_SNAPSHOT_HPP
+#define ZTD_TEXT_DETAIL_EXECUTION_SNAPSHOT_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/detail/bulk_execution.hpp>
+#include <ztd/text/detail/encoding_name.hpp>
+#include <ztd/text/detail/windows.hpp>
+#include <ztd/text/detail/posix.hpp>
+
+#include <atomic>
+#include <clocale>
+#include <cstdint>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		//////
+		/// @brief What is known about the encoding of the current C locale: detected once and kept, rather than
+		/// asked of the C library (and matched against every known encoding name) each time it is needed.
+		///
+		/// @remarks The key of the locale it was taken for is kept with it, so that the bulk conversions can tell
+		/// when the calling thread's locale has moved on (see
+		/// ztd::text::__detail::__current_execution_bulk_snapshot).
+		//////
+		struct __execution_snapshot {
+			bool __is_utf8;
+			bool __is_unicode;
+			__execution_bulk_kind __bulk_kind;
+			::std::uint_least64_t __locale_key;
+		};
+
+		inline constexpr ::std::uint_least64_t __execution_snapshot_taken      = 0x01;
+		inline constexpr ::std::uint_least64_t __execution_snapshot_utf8       = 0x02;
+		inline constexpr ::std::uint_least64_t __execution_snapshot_unicode    = 0x04;
+		inline constexpr ::std::uint_least64_t __execution_snapshot_kind_shift = 3;
+		inline constexpr ::std::uint_least64_t __execution_snapshot_kind_mask  = 0x03;
+		inline constexpr ::std::uint_least64_t __execution_snapshot_key_shift  = 8;
+
+		// packed into one word along with the key of the locale it was taken for, so that it can be read and replaced
+		// from any thread without a lock; 0 means no snapshot has been taken yet
+		inline ::std::atomic<::std::uint_least64_t> __execution_snapshot_bits { 0 };
+
+		//////
+		/// @brief Returns a cheap fingerprint of the encoding of the calling thread's C locale: the active code page
+		/// on Windows, and otherwise a hash of the name of the locale's character set.
+		///
+		/// @remarks This is only a few loads and a short loop, unlike the full detection, so it can be checked on
+		/// every bulk conversion. It is shifted up to sit next to the snapshot's own bits.
+		//////
+		inline ::std::uint_least64_t __execution_locale_key() noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+			const ::std::uint_least64_t __key = static_cast<::std::uint_least64_t>(
+				static_cast<unsigned int>(__windows::__determine_active_code_page()));
+#else
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_NL_LANGINFO_I_) || ZTD_TEXT_IS_ON(ZTD_TEXT_LANGINFO_I_)
+			const char* __name = nl_langinfo(CODESET);
+#else
+			const char* __name = ::std::setlocale(LC_CTYPE, nullptr);
+#endif
+			// FNV-1a
+			::std::uint_least64_t __key = 0xcbf29ce484222325ull;
+			for (; __name != nullptr && *__name != '\0'; ++__name) {
+				__key ^= static_cast<unsigned char>(*__name);
+				__key *= 0x100000001b3ull;
+			}
+#endif
+			return __key << __execution_snapshot_key_shift;
+		}
+
+		inline ::std::uint_least64_t __take_execution_snapshot() noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+			const bool __is_unicode
+				= __windows::__is_unicode_code_page(__windows::__determine_active_code_page());
+#elif ZTD_TEXT_IS_ON(ZTD_TEXT_NL_LANGINFO_I_) || ZTD_TEXT_IS_ON(ZTD_TEXT_LANGINFO_I_)
+			const bool __is_unicode = __is_unicode_encoding_name(nl_langinfo(CODESET));
+#else
+			const char* __ctype_name = ::std::setlocale(LC_CTYPE, nullptr);
+			const bool __is_unicode  = __ctype_name != nullptr && __is_unicode_encoding_name(__ctype_name);
+#endif
+			const __execution_bulk_kind __bulk_kind = __determine_execution_bulk_kind();
+			::std::uint_least64_t __bits            = __execution_locale_key() | __execution_snapshot_taken;
+			if (__bulk_kind == __execution_bulk_kind::__utf8) {
+				__bits |= __execution_snapshot_utf8;
+			}
+			if (__is_unicode) {
+				__bits |= __execution_snapshot_unicode;
+			}
+			__bits |= static_cast<::std::uint_least64_t>(__bulk_kind) << __execution_snapshot_kind_shift;
+			return __bits;
+		}
+
+		//////
+		/// @brief Detects the encoding of the current C locale again, and keeps the result for every later call of
+		/// ztd::text::__detail::__current_execution_snapshot.
+		//////
+		inline void __refresh_execution_snapshot() noexcept {
+			__execution_snapshot_bits.store(__take_execution_snapshot(), ::std::memory_order_relaxed);
+		}
+
+		//////
+		/// @brief Returns the kept snapshot of the current C locale's encoding, taking it first if this is the
+		/// first call.
+		///
+		/// @remarks Two threads racing on the first call may both detect the encoding; they store the same answer.
+		//////
+		inline __execution_snapshot __current_execution_snapshot() noexcept {
+			::std::uint_least64_t __bits = __execution_snapshot_bits.load(::std::memory_order_relaxed);
+			if (__bits == 0) {
+				__bits = __take_execution_snapshot();
+				__execution_snapshot_bits.store(__bits, ::std::memory_order_relaxed);
+			}
+			return __execution_snapshot { (__bits & __execution_snapshot_utf8) != 0,
+				(__bits & __execution_snapshot_unicode) != 0,
+				static_cast<__execution_bulk_kind>(
+				     (__bits >> __execution_snapshot_kind_shift) & __execution_snapshot_kind_mask),
+				__bits >> __execution_snapshot_key_shift << __execution_snapshot_key_shift };
+		}
+
+		//////
+		/// @brief Returns the kept snapshot if it was taken for the same encoding as the calling thread's C locale
+		/// uses right now, and otherwise a snapshot that does not allow any bulk kernel.
+		///
+		/// @remarks The bulk conversions use this, because the one-at-a-time conversions they fall back to always
+		/// follow the calling thread's locale (including one set with @c uselocale, or with @c setlocale after the
+		/// snapshot was taken). When the two disagree, the bulk conversions go through the one-at-a-time path
+		/// instead of trusting a stale answer.
+		//////
+		inline __execution_snapshot __current_execution_bulk_snapshot() noexcept {
+			__execution_snapshot __snapshot = __current_execution_snapshot();
+			if (__snapshot.__locale_key != __execution_locale_key()) {
+				__snapshot.__is_utf8   = false;
+				__snapshot.__bulk_kind = __execution_bulk_kind::__none;
+			}
+			return __snapshot;
+		}
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_EXECUTION_SNAPSHOT_HPP
@@ -0,0 +1,337 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_ICONV_HPP
+#define ZTD_TEXT_DETAIL_ICONV_HPP
+
+#include <ztd/text/version.hpp>
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_USE_ICONV_I_)
+
+#include <ztd/text/endian.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <utility>
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+#include <ztd/text/detail/windows.hpp>
+#else
+extern "C" {
+#include <dlfcn.h>
+}
+#endif
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail { namespace __iconv {
+
+		using __open_function    = void*(const char*, const char*);
+		using __convert_function = ::std::size_t(void*, char**, ::std::size_t*, char**, ::std::size_t*);
+		using __close_function   = int(void*);
+
+		//////
+		/// @brief The three iconv entry points, looked up at run time rather than linked against, so that programs
+		/// using this library never have to link with (or be licensed as) the iconv library itself.
+		//////
+		struct __functions {
+			__open_function* __open;
+			__convert_function* __convert;
+			__close_function* __close;
+
+			bool __is_loaded() const noexcept {
+				return this->__open != nullptr && this->__convert != nullptr && this->__close != nullptr;
+			}
+		};
+
+		inline void* __failed_descriptor() noexcept {
+			return reinterpret_cast<void*>(static_cast<::std::intptr_t>(-1));
+		}
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+		inline bool __load_from(::HMODULE __library, const char* __open_name, const char* __convert_name,
+			const char* __close_name, __functions& __loaded) noexcept {
+			if (__library == nullptr) {
+				return false;
+			}
+			__loaded.__open    = reinterpret_cast<__open_function*>(::GetProcAddress(__library, __open_name));
+			__loaded.__convert = reinterpret_cast<__convert_function*>(::GetProcAddress(__library, __convert_name));
+			__loaded.__close   = reinterpret_cast<__close_function*>(::GetProcAddress(__library, __close_name));
+			return __loaded.__is_loaded();
+		}
+
+		inline __functions __load() noexcept {
+			__functions __loaded { nullptr, nullptr, nullptr };
+			const wchar_t* const __library_names[] = { L"libiconv-2.dll", L"libiconv.dll", L"iconv.dll" };
+			for (const wchar_t* __library_name : __library_names) {
+				// the library stays loaded for the rest of the program: descriptors may outlive any one encoding
+				::HMODULE __library = ::LoadLibraryW(__library_name);
+				if (__load_from(__library, "libiconv_open", "libiconv", "libiconv_close", __loaded)
+					|| __load_from(__library, "iconv_open", "iconv", "iconv_close", __loaded)) {
+					return __loaded;
+				}
+			}
+			return __functions { nullptr, nullptr, nullptr };
+		}
+#else
+		inline bool __load_from(void* __library, const char* __open_name, const char* __convert_name,
+			const char* __close_name, __functions& __loaded) noexcept {
+			if (__library == nullptr) {
+				return false;
+			}
+			__loaded.__open    = reinterpret_cast<__open_function*>(::dlsym(__library, __open_name));
+			__loaded.__convert = reinterpret_cast<__convert_function*>(::dlsym(__library, __convert_name));
+			__loaded.__close   = reinterpret_cast<__close_function*>(::dlsym(__library, __close_name));
+			return __loaded.__is_loaded();
+		}
+
+		inline __functions __load() noexcept {
+			__functions __loaded { nullptr, nullptr, nullptr };
+			// the C library (e.g. glibc, musl) or something already loaded into the program may provide it
+			if (__load_from(::dlopen(nullptr, RTLD_LAZY), "iconv_open", "iconv", "iconv_close", __loaded)) {
+				return __loaded;
+			}
+			const char* const __library_names[] = { "libiconv.so.2", "libiconv.so", "libiconv.2.dylib",
+				"libiconv.dylib" };
+			for (const char* __library_name : __library_names) {
+				// the library stays loaded for the rest of the program: descriptors may outlive any one encoding
+				void* __library = ::dlopen(__library_name, RTLD_LAZY | RTLD_LOCAL);
+				if (__load_from(__library, "libiconv_open", "libiconv", "libiconv_close", __loaded)
+					|| __load_from(__library, "iconv_open", "iconv", "iconv_close", __loaded)) {
+					return __loaded;
+				}
+			}
+			return __functions { nullptr, nullptr, nullptr };
+		}
+#endif
+
+		//////
+		/// @brief The iconv entry points, looked up the first time any of them is needed.
+		//////
+		inline const __functions& __loaded_functions() noexcept {
+			static const __functions __loaded = __load();
+			return __loaded;
+		}
+
+		//////
+		/// @brief The name iconv knows UTF-32 in this platform's byte order by. The byte order is spelled out so
+		/// that iconv neither writes nor expects a byte order mark.
+		//////
+		inline constexpr const char* __utf32_name() noexcept {
+			return endian::native == endian::big ? "UTF-32BE" : "UTF-32LE";
+		}
+
+		//////
+		/// @brief An owned iconv conversion descriptor, which also holds the shift state of the conversion.
+		//////
+		class __descriptor {
+		private:
+			void* _M_handle;
+
+		public:
+			__descriptor() noexcept : _M_handle(__failed_descriptor()) {
+			}
+
+			__descriptor(const char* __to_name, const char* __from_name, ::std::error_code& __error) noexcept
+			: _M_handle(__failed_descriptor()) {
+				const __functions& __iconv = __loaded_functions();
+				if (!__iconv.__is_loaded()) {
+					__error = ::std::make_error_code(::std::errc::not_supported);
+					return;
+				}
+				errno           = 0;
+				this->_M_handle = __iconv.__open(__to_name, __from_name);
+				if (this->_M_handle == __failed_descriptor()) {
+					__error = ::std::error_code(errno == 0 ? EINVAL : errno, ::std::generic_category());
+					return;
+				}
+				__error.clear();
+			}
+
+			__descriptor(const __descriptor&) = delete;
+			__descriptor& operator=(const __descriptor&) = delete;
+
+			__descriptor(__descriptor&& __other) noexcept
+			: _M_handle(::std::exchange(__other._M_handle, __failed_descriptor())) {
+			}
+
+			__descriptor& operator=(__descriptor&& __other) noexcept {
+				::std::swap(this->_M_handle, __other._M_handle);
+				return *this;
+			}
+
+			~__descriptor() {
+				if (this->__is_valid()) {
+					__loaded_functions().__close(this->_M_handle);
+				}
+			}
+
+			bool __is_valid() const noexcept {
+				return this->_M_handle != __failed_descriptor();
+			}
+
+			//////
+			/// @brief Converts as much of the input as possible with a single call to @c iconv, moving the pointers
+			/// and sizes past what was read and written.
+			///
+			/// @returns @c 0 if all of the input was converted; otherwise, the @c errno value @c iconv stopped with:
+			/// @c EILSEQ for an invalid (or unrepresentable) sequence, @c EINVAL for an incomplete one at the end of
+			/// the input, and @c E2BIG when the output is full.
+			//////
+			int __convert(const char*& __input, ::std::size_t& __input_size, char*& __output,
+				::std::size_t& __output_size) const noexcept {
+				if (!this->__is_valid()) {
+					return EBADF;
+				}
+				// iconv never writes through the input pointer: it is only non-const for historical reasons
+				char* __input_pointer = const_cast<char*>(__input);
+				errno                 = 0;
+				const ::std::size_t __result = __loaded_functions().__convert(
+					this->_M_handle, &__input_pointer, &__input_size, &__output, &__output_size);
+				__input = __input_pointer;
+				if (__result == static_cast<::std::size_t>(-1)) {
+					return errno == 0 ? EILSEQ : errno;
+				}
+				return 0;
+			}
+
+			//////
+			/// @brief Writes whatever is needed to return the output to the initial shift state.
+			///
+			/// @returns Whether or not it fit in the output.
+			//////
+			bool __flush(char*& __output, ::std::size_t& __output_size) const noexcept {
+				if (!this->__is_valid()) {
+					return true;
+				}
+				return __loaded_functions().__convert(this->_M_handle, nullptr, nullptr, &__output, &__output_size)
+					!= static_cast<::std::size_t>(-1);
+			}
+
+			//////
+			/// @brief Returns the descriptor to the initial shift state, without writing anything.
+			//////
+			void __reset() const noexcept {
+				if (this->__is_valid()) {
+					__loaded_functions().__convert(this->_M_handle, nullptr, nullptr, nullptr, nullptr);
+				}
+			}
+		};
+
+		//////
+		/// @brief Whether encoding to @p __name depends on what came before (shift sequences, byte order marks and
+		/// the like).
+		///
+		/// @remarks iconv offers no way to ask, so a few code points are encoded twice over: a stateless encoding
+		/// writes the same bytes both times, and never has anything to write to go back to the initial state.
+		//////
+		inline bool __has_shift_states(const char* __name) noexcept {
+			::std::error_code __error;
+			__descriptor __to(__name, __utf32_name(), __error);
+			if (__error) {
+				return true;
+			}
+			const char32_t __probes[] = { U'A', U'\u00E9', U'\u0416', U'\u3042', U'\u4E00', U'\uAC00' };
+			for (const char32_t& __probe : __probes) {
+				char __units[2][32];
+				::std::size_t __unit_sizes[2] = {};
+				bool __converted              = true;
+				for (::std::size_t __pass = 0; __pass < 2; ++__pass) {
+					const char* __input         = reinterpret_cast<const char*>(&__probe);
+					::std::size_t __input_size  = sizeof(__probe);
+					char* __output              = __units[__pass];
+					::std::size_t __output_size = sizeof(__units[__pass]);
+					if (__to.__convert(__input, __input_size, __output, __output_size) != 0) {
+						__converted = false;
+						break;
+					}
+					__unit_sizes[__pass] = sizeof(__units[__pass]) - __output_size;
+				}
+				if (__converted) {
+					char __shift[32];
+					char* __output              = __shift;
+					::std::size_t __output_size = sizeof(__shift);
+					if (!__to.__flush(__output, __output_size) || __output_size != sizeof(__shift)
+						|| __unit_sizes[0] != __unit_sizes[1]
+						|| !::std::equal(__units[0], __units[0] + __unit_sizes[0], __units[1])) {
+						return true;
+					}
+				}
+				__to.__reset();
+			}
+			return false;
+		}
+
+		//////
+		/// @brief Whether decoding from @p __name can hold a character back inside of the descriptor, waiting to
+		/// see whether the next one combines with it (as glibc does for e.g. CP1255, CP1258 and TCVN). Such a
+		/// character only comes out with the next one, or when the descriptor is flushed.
+		///
+		/// @remarks Every byte is decoded on its own: one that converts without error and without output (unlike a
+		/// shift sequence, which has nothing to flush either) was held back.
+		//////
+		inline bool __holds_back_characters(const char* __name) noexcept {
+			::std::error_code __error;
+			__descriptor __from(__utf32_name(), __name, __error);
+			if (__error) {
+				return false;
+			}
+			for (int __byte = 0; __byte < 256; ++__byte) {
+				const char __unit = static_cast<char>(static_cast<unsigned char>(__byte));
+				char32_t __points[8];
+				const char* __input         = &__unit;
+				::std::size_t __input_size  = 1;
+				char* __output              = reinterpret_cast<char*>(__points);
+				::std::size_t __output_size = sizeof(__points);
+				if (__from.__convert(__input, __input_size, __output, __output_size) == 0
+					&& __output_size == sizeof(__points)) {
+					if (!__from.__flush(__output, __output_size) || __output_size != sizeof(__points)) {
+						return true;
+					}
+				}
+				__from.__reset();
+			}
+			return false;
+		}
+
+	}} // namespace __detail::__iconv
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // iconv
+
+#endif // ZTD_TEXT_DETAIL_ICONV_HPP
@@ -0,0 +1,276 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_MAPPED_FILE_HPP
+#define ZTD_TEXT_DETAIL_MAPPED_FILE_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <system_error>
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+#include <ztd/text/detail/windows.hpp>
+#elif ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_UNIX_I_)
+extern "C" {
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+}
+#else
+#include <vector>
+#endif
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		inline ::std::error_code __last_errno_error() noexcept {
+			return ::std::error_code(errno, ::std::generic_category());
+		}
+
+		//////
+		/// @brief A read-only view of a whole file's bytes. The file is mapped into memory where the platform allows
+		/// it, so that its pages are only read in as they are used and can be dropped again by the operating system
+		/// afterwards; elsewhere, it is read into memory.
+		//////
+		class __mapped_file {
+		public:
+			__mapped_file() noexcept : _M_data(nullptr), _M_size(0) {
+			}
+
+			__mapped_file(const __mapped_file&) = delete;
+			__mapped_file& operator=(const __mapped_file&) = delete;
+
+			~__mapped_file() {
+				this->_M_close();
+			}
+
+			::std::error_code open(const ::std::filesystem::path& __path) noexcept {
+				this->_M_close();
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+				HANDLE __file = ::CreateFileW(__path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+					FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+				if (__file == INVALID_HANDLE_VALUE) {
+					return ::std::error_code(static_cast<int>(::GetLastError()), ::std::system_category());
+				}
+				LARGE_INTEGER __file_size {};
+				if (!::GetFileSizeEx(__file, &__file_size)) {
+					::std::error_code __error(static_cast<int>(::GetLastError()), ::std::system_category());
+					::CloseHandle(__file);
+					return __error;
+				}
+				if (static_cast<unsigned long long>(__file_size.QuadPart)
+					> (::std::numeric_limits<::std::size_t>::max)()) {
+					::CloseHandle(__file);
+					return ::std::make_error_code(::std::errc::file_too_large);
+				}
+				this->_M_size = static_cast<::std::size_t>(__file_size.QuadPart);
+				if (this->_M_size != 0) {
+					// an empty file cannot be mapped, but it also has nothing to map
+					HANDLE __mapping = ::CreateFileMappingW(__file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+					if (__mapping == nullptr) {
+						::std::error_code __error(static_cast<int>(::GetLastError()), ::std::system_category());
+						::CloseHandle(__file);
+						this->_M_size = 0;
+						return __error;
+					}
+					this->_M_data = static_cast<const unsigned char*>(
+						::MapViewOfFile(__mapping, FILE_MAP_READ, 0, 0, this->_M_size));
+					::std::error_code __error(static_cast<int>(::GetLastError()), ::std::system_category());
+					::CloseHandle(__mapping);
+					if (this->_M_data == nullptr) {
+						::CloseHandle(__file);
+						this->_M_size = 0;
+						return __error;
+					}
+				}
+				::CloseHandle(__file);
+				return ::std::error_code();
+#elif ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_UNIX_I_)
+				int __file = ::open(__path.c_str(), O_RDONLY | O_CLOEXEC);
+				if (__file == -1) {
+					return __last_errno_error();
+				}
+				struct ::stat __file_info {};
+				if (::fstat(__file, &__file_info) == -1) {
+					::std::error_code __error = __last_errno_error();
+					::close(__file);
+					return __error;
+				}
+				if (static_cast<::std::uintmax_t>(__file_info.st_size)
+					> (::std::numeric_limits<::std::size_t>::max)()) {
+					::close(__file);
+					return ::std::make_error_code(::std::errc::file_too_large);
+				}
+				this->_M_size = static_cast<::std::size_t>(__file_info.st_size);
+				if (this->_M_size != 0) {
+					// an empty file cannot be mapped, but it also has nothing to map
+					void* __data = ::mmap(nullptr, this->_M_size, PROT_READ, MAP_PRIVATE, __file, 0);
+					if (__data == MAP_FAILED) {
+						::std::error_code __error = __last_errno_error();
+						::close(__file);
+						this->_M_size = 0;
+						return __error;
+					}
+#if defined(MADV_SEQUENTIAL)
+					// read-ahead more aggressively, and drop pages that have already been read first
+					::madvise(__data, this->_M_size, MADV_SEQUENTIAL);
+#endif
+					this->_M_data = static_cast<const unsigned char*>(__data);
+				}
+				::close(__file);
+				return ::std::error_code();
+#else
+				::std::FILE* __file = ::std::fopen(__path.string().c_str(), "rb");
+				if (__file == nullptr) {
+					return __last_errno_error();
+				}
+				unsigned char __block[1 << 16];
+				for (;;) {
+					::std::size_t __read = ::std::fread(__block, 1, sizeof(__block), __file);
+					this->_M_storage.insert(this->_M_storage.end(), __block, __block + __read);
+					if (__read < sizeof(__block)) {
+						break;
+					}
+				}
+				::std::error_code __error;
+				if (::std::ferror(__file)) {
+					__error = __last_errno_error();
+				}
+				::std::fclose(__file);
+				this->_M_data = this->_M_storage.data();
+				this->_M_size = this->_M_storage.size();
+				return __error;
+#endif
+			}
+
+			const unsigned char* data() const noexcept {
+				return this->_M_data;
+			}
+
+			::std::size_t size() const noexcept {
+				return this->_M_size;
+			}
+
+		private:
+			void _M_close() noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+				if (this->_M_data != nullptr) {
+					::UnmapViewOfFile(this->_M_data);
+				}
+#elif ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_UNIX_I_)
+				if (this->_M_data != nullptr) {
+					::munmap(const_cast<unsigned char*>(this->_M_data), this->_M_size);
+				}
+#else
+				this->_M_storage.clear();
+#endif
+				this->_M_data = nullptr;
+				this->_M_size = 0;
+			}
+
+			const unsigned char* _M_data;
+			::std::size_t _M_size;
+#if ZTD_TEXT_IS_OFF(ZTD_TEXT_PLATFORM_WINDOWS_I_) && ZTD_TEXT_IS_OFF(ZTD_TEXT_PLATFORM_UNIX_I_)
+			::std::vector<unsigned char> _M_storage;
+#endif
+		};
+
+		//////
+		/// @brief A file opened for writing, which is written to in large blocks and so does not need the C library's
+		/// own buffering.
+		//////
+		class __output_file {
+		public:
+			__output_file() noexcept : _M_file(nullptr) {
+			}
+
+			__output_file(const __output_file&) = delete;
+			__output_file& operator=(const __output_file&) = delete;
+
+			~__output_file() {
+				(void)this->close();
+			}
+
+			::std::error_code open(const ::std::filesystem::path& __path) noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+				this->_M_file = ::_wfopen(__path.c_str(), L"wb");
+#else
+				this->_M_file = ::std::fopen(__path.string().c_str(), "wb");
+#endif
+				if (this->_M_file == nullptr) {
+					return __last_errno_error();
+				}
+				::std::setvbuf(this->_M_file, nullptr, _IONBF, 0);
+				return ::std::error_code();
+			}
+
+			::std::error_code write(const void* __data, ::std::size_t __size) noexcept {
+				if (__size == 0) {
+					return ::std::error_code();
+				}
+				if (::std::fwrite(__data, 1, __size, this->_M_file) != __size) {
+					return __last_errno_error();
+				}
+				return ::std::error_code();
+			}
+
+			::std::error_code close() noexcept {
+				if (this->_M_file == nullptr) {
+					return ::std::error_code();
+				}
+				int __result  = ::std::fclose(this->_M_file);
+				this->_M_file = nullptr;
+				if (__result != 0) {
+					return __last_errno_error();
+				}
+				return ::std::error_code();
+			}
+
+		private:
+			::std::FILE* _M_file;
+		};
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_MAPPED_FILE_HPP
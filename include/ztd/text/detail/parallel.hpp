@@ -0,0 +1,351 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_PARALLEL_HPP
+#define ZTD_TEXT_DETAIL_PARALLEL_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/code_point.hpp>
+#include <ztd/text/count_code_points.hpp>
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/error_handler.hpp>
+#include <ztd/text/is_self_synchronizing_code.hpp>
+#include <ztd/text/state.hpp>
+#include <ztd/text/transcode.hpp>
+#include <ztd/text/validate_code_units.hpp>
+#include <ztd/text/detail/transcode_one.hpp>
+#include <ztd/text/detail/adl.hpp>
+#include <ztd/text/detail/range.hpp>
+#include <ztd/text/detail/reconstruct.hpp>
+#include <ztd/text/detail/type_traits.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		//////
+		/// @brief The fewest code units a chunk of input is given when it is split up for the parallel functions
+		/// (e.g. ztd::text::transcode_to_parallel). Inputs smaller than two such chunks are not split at all.
+		//////
+		inline constexpr ::std::size_t __parallel_minimum_chunk_size = static_cast<::std::size_t>(1) << 16;
+
+		//////
+		/// @brief Whether @p _WorkingInput can be split into chunks that are then decoded by @p _Encoding
+		/// separately: it has to be sized and contiguous, and the encoding has to be self-synchronizing with an empty
+		/// decode state, so that every chunk can start from a fresh state at a code point boundary found locally.
+		//////
+		template <typename _WorkingInput, typename _Encoding>
+		inline constexpr bool __is_parallel_splittable_v = __is_sized_contiguous_range_v<_WorkingInput>
+			&& is_self_synchronizing_code_v<__remove_cvref_t<_Encoding>>
+			&& ::std::is_empty_v<decode_state_t<__remove_cvref_t<_Encoding>>>;
+
+		//////
+		/// @brief Whether @p _ErrorHandler can be used for a split input: every chunk works with its own copy of it.
+		//////
+		template <typename _ErrorHandler>
+		inline constexpr bool __is_parallel_error_handler_v
+			= ::std::is_copy_constructible_v<__remove_cvref_t<_ErrorHandler>>;
+
+		//////
+		/// @brief One chunk of a split input, along with what was computed from it.
+		///
+		/// @remarks After the chunk has been processed, @c __input is what is left of it: empty, unless there was an
+		/// error. If processing it threw, the exception is kept in @c __exception instead, so that it can be rethrown
+		/// after all of the chunks are done (an exception escaping an execution policy's algorithm terminates).
+		//////
+		template <typename _WorkingInput, typename _Output>
+		struct __parallel_chunk {
+			_WorkingInput __input;
+			_Output __output {};
+			::std::size_t __output_offset = 0;
+			encoding_error __error_code   = encoding_error::ok;
+			bool __handled_error          = false;
+			::std::exception_ptr __exception {};
+		};
+
+		//////
+		/// @brief Whether decoding the whole input from its start always stops at @p __boundary, so that the input
+		/// can be split there and both sides decoded separately with the same results.
+		///
+		/// @param[in] __first The start of the input.
+		/// @param[in] __boundary The place to split the input at.
+		/// @param[in] __last The end of the input.
+		/// @param[in] __known_index The index of a place the decoding of the whole input is known to stop at (e.g.,
+		/// the start of the chunk before), which is less than the index of @p __boundary.
+		/// @param[in] __encoding The encoding to check with.
+		///
+		/// @remarks It is not enough that a code point starts at @p __boundary: an ill-formed sequence can swallow
+		/// the code unit after it (a truncated sequence followed by anything), so an error just before the boundary
+		/// may be decoded differently once it is cut off. Instead, the code units right before @p __boundary must
+		/// be well-formed code points that end exactly at it. There must be at least ztd::text::max_code_units_v of
+		/// them (unless they start at @p __known_index): a single decode step, well-formed or not, never reads more
+		/// than that, so decoding lands inside of them; and in a self-synchronizing code, decoding from inside of
+		/// well-formed code points can only step onto the start of the next one, and so onto @p __boundary.
+		//////
+		template <typename _WorkingInput, typename _Encoding>
+		bool __is_parallel_boundary(__range_iterator_t<_WorkingInput> __first,
+			__range_iterator_t<_WorkingInput> __boundary, __range_sentinel_t<_WorkingInput> __last,
+			::std::size_t __known_index, const _Encoding& __encoding) {
+			using _UEncoding               = __remove_cvref_t<_Encoding>;
+			using _CodePoint               = code_point_t<_UEncoding>;
+			using _InputIterator           = __range_iterator_t<_WorkingInput>;
+			constexpr ::std::size_t _Units = max_code_units_v<_UEncoding>;
+
+			const ::std::size_t __index = static_cast<::std::size_t>(__boundary - __first);
+			const ::std::size_t __start_first_index
+				= __index - __known_index < (_Units * 2) ? __known_index : __index - (_Units * 2) + 1;
+			// try the latest starts first: in well-formed input, one of the first few of them works
+			for (::std::size_t __start_index = __index; __start_index-- > __start_first_index;) {
+				if (__index - __start_index < _Units && __start_index != __known_index) {
+					continue;
+				}
+				_InputIterator __current = __first + __start_index;
+				bool __well_formed       = true;
+				while (__current < __boundary) {
+					_CodePoint __code_point_buf[max_code_points_v<_UEncoding>] {};
+					decode_state_t<_UEncoding> __state = make_decode_state(__encoding);
+					pass_handler __error_handler {};
+					auto __result = __basic_decode_one<__consume::__no>(
+						__reconstruct(::std::in_place_type<_WorkingInput>, __current, __last), __encoding,
+						__code_point_buf, __error_handler, __state);
+					if (__result.error_code != encoding_error::ok) {
+						__well_formed = false;
+						break;
+					}
+					__current = __adl::__adl_begin(__result.input);
+				}
+				if (__well_formed && __current == __boundary) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		//////
+		/// @brief Splits @p __input into roughly equal chunks, each starting at a place decoding the whole input
+		/// would stop at, for processing on multiple threads.
+		///
+		/// @returns The chunks, or nothing at all if the input is too small to be worth splitting.
+		///
+		/// @remarks A chunk boundary is moved forward, by at most ztd::text::max_code_units_v code units, to the
+		/// next place that is right after well-formed code points (see ztd::text::__detail::__is_parallel_boundary).
+		/// If there is none that close (because the input is ill-formed there), that boundary is dropped and its
+		/// chunk merged into the next one, so that no error is ever split in two.
+		//////
+		template <typename _Chunk, typename _WorkingInput, typename _Encoding>
+		::std::vector<_Chunk> __parallel_split(const _WorkingInput& __input, const _Encoding& __encoding) {
+			using _UEncoding     = __remove_cvref_t<_Encoding>;
+			using _InputIterator = __range_iterator_t<_WorkingInput>;
+
+			::std::vector<_Chunk> __chunks;
+			const ::std::size_t __size = static_cast<::std::size_t>(__adl::__adl_size(__input));
+			const unsigned int __threads          = ::std::thread::hardware_concurrency();
+			const ::std::size_t __max_chunk_count = static_cast<::std::size_t>(__threads == 0 ? 1 : __threads) * 4;
+			const ::std::size_t __chunk_count
+				= ::std::min(__size / __parallel_minimum_chunk_size, __max_chunk_count);
+			if (__chunk_count < 2) {
+				return __chunks;
+			}
+			const ::std::size_t __chunk_size = __size / __chunk_count;
+			_InputIterator __first           = __adl::__adl_begin(__input);
+			_InputIterator __chunk_first     = __first;
+			::std::size_t __chunk_first_index = 0;
+			__chunks.reserve(__chunk_count);
+			for (::std::size_t __chunk_index = 1; __chunk_index < __chunk_count; ++__chunk_index) {
+				const ::std::size_t __nominal_index = __chunk_index * __chunk_size;
+				const ::std::size_t __search_last_index
+					= ::std::min(__nominal_index + max_code_units_v<_UEncoding>, __size);
+				for (::std::size_t __index = ::std::max(__nominal_index, __chunk_first_index + 1);
+					__index < __search_last_index; ++__index) {
+					_InputIterator __boundary = __first + __index;
+					if (__is_parallel_boundary<_WorkingInput>(
+						     __first, __boundary, __adl::__adl_end(__input), __chunk_first_index, __encoding)) {
+						__chunks.push_back(_Chunk { __reconstruct(
+							::std::in_place_type<_WorkingInput>, __chunk_first, __boundary) });
+						__chunk_first       = __boundary;
+						__chunk_first_index = __index;
+						break;
+					}
+				}
+			}
+			__chunks.push_back(_Chunk { __reconstruct(
+				::std::in_place_type<_WorkingInput>, __chunk_first, __adl::__adl_end(__input)) });
+			return __chunks;
+		}
+
+		//////
+		/// @brief Transcodes one chunk into its own @p _OutputContainer, with fresh states and its own copies of the
+		/// error handlers.
+		//////
+		template <typename _OutputContainer, typename _FromEncoding, typename _ToEncoding, typename _FromErrorHandler,
+			typename _ToErrorHandler>
+		class __parallel_transcode_task {
+		public:
+			__parallel_transcode_task(_FromEncoding& __from_encoding, _ToEncoding& __to_encoding,
+				const _FromErrorHandler& __from_error_handler, const _ToErrorHandler& __to_error_handler) noexcept
+			: _M_from_encoding(::std::addressof(__from_encoding))
+			, _M_to_encoding(::std::addressof(__to_encoding))
+			, _M_from_error_handler(::std::addressof(__from_error_handler))
+			, _M_to_error_handler(::std::addressof(__to_error_handler)) {
+			}
+
+			template <typename _Chunk>
+			void operator()(_Chunk& __chunk) const {
+				using _WorkingInput = decltype(__chunk.__input);
+
+				try {
+					_FromErrorHandler __from_error_handler(*_M_from_error_handler);
+					_ToErrorHandler __to_error_handler(*_M_to_error_handler);
+					auto __from_state = make_decode_state(*_M_from_encoding);
+					auto __to_state   = make_encode_state(*_M_to_encoding);
+					auto __result     = transcode_to<_OutputContainer>(__chunk.__input, *_M_from_encoding,
+                              *_M_to_encoding, __from_error_handler, __to_error_handler, __from_state, __to_state);
+					__chunk.__input   = __reconstruct(::std::in_place_type<_WorkingInput>,
+                              __adl::__adl_begin(__result.input), __adl::__adl_end(__result.input));
+					__chunk.__output        = ::std::move(__result.output);
+					__chunk.__error_code    = __result.error_code;
+					__chunk.__handled_error = __result.handled_error;
+				}
+				catch (...) {
+					__chunk.__exception = ::std::current_exception();
+				}
+			}
+
+		private:
+			_FromEncoding* _M_from_encoding;
+			_ToEncoding* _M_to_encoding;
+			const _FromErrorHandler* _M_from_error_handler;
+			const _ToErrorHandler* _M_to_error_handler;
+		};
+
+		//////
+		/// @brief Copies the output of one transcoded chunk to its place in the output of the whole input.
+		//////
+		template <typename _OutputValueType>
+		class __parallel_copy_task {
+		public:
+			__parallel_copy_task(_OutputValueType* __output_first) noexcept : _M_output_first(__output_first) {
+			}
+
+			template <typename _Chunk>
+			void operator()(_Chunk& __chunk) const {
+				::std::copy(__adl::__adl_begin(__chunk.__output), __adl::__adl_end(__chunk.__output),
+					_M_output_first + __chunk.__output_offset);
+			}
+
+		private:
+			_OutputValueType* _M_output_first;
+		};
+
+		//////
+		/// @brief Counts the code points of one chunk, with a fresh state and its own copy of the error handler.
+		//////
+		template <typename _Encoding, typename _ErrorHandler>
+		class __parallel_count_code_points_task {
+		public:
+			__parallel_count_code_points_task(_Encoding& __encoding, const _ErrorHandler& __error_handler) noexcept
+			: _M_encoding(::std::addressof(__encoding)), _M_error_handler(::std::addressof(__error_handler)) {
+			}
+
+			template <typename _Chunk>
+			void operator()(_Chunk& __chunk) const {
+				using _WorkingInput = decltype(__chunk.__input);
+
+				try {
+					_ErrorHandler __error_handler(*_M_error_handler);
+					auto __state  = make_decode_state(*_M_encoding);
+					auto __result = count_code_points(__chunk.__input, *_M_encoding, __error_handler, __state);
+					__chunk.__input = __reconstruct(::std::in_place_type<_WorkingInput>,
+						__adl::__adl_begin(__result.input), __adl::__adl_end(__result.input));
+					__chunk.__output        = __result.count;
+					__chunk.__error_code    = __result.error_code;
+					__chunk.__handled_error = __result.handled_error;
+				}
+				catch (...) {
+					__chunk.__exception = ::std::current_exception();
+				}
+			}
+
+		private:
+			_Encoding* _M_encoding;
+			const _ErrorHandler* _M_error_handler;
+		};
+
+		//////
+		/// @brief Validates the code units of one chunk, with fresh states.
+		//////
+		template <typename _Encoding>
+		class __parallel_validate_code_units_task {
+		public:
+			__parallel_validate_code_units_task(_Encoding& __encoding) noexcept
+			: _M_encoding(::std::addressof(__encoding)) {
+			}
+
+			template <typename _Chunk>
+			void operator()(_Chunk& __chunk) const {
+				using _WorkingInput = decltype(__chunk.__input);
+
+				try {
+					auto __decode_state = make_decode_state(*_M_encoding);
+					auto __encode_state = make_encode_state(*_M_encoding);
+					auto __result
+						= validate_code_units(__chunk.__input, *_M_encoding, __decode_state, __encode_state);
+					__chunk.__input = __reconstruct(::std::in_place_type<_WorkingInput>,
+						__adl::__adl_begin(__result.input), __adl::__adl_end(__result.input));
+					__chunk.__output = __result.valid;
+				}
+				catch (...) {
+					__chunk.__exception = ::std::current_exception();
+				}
+			}
+
+		private:
+			_Encoding* _M_encoding;
+		};
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_PARALLEL_HPP
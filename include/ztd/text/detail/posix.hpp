@@ -55,6 +55,15 @@ extern "C" {
 #include <clocale>
 #endif
 
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_LOCALE_T_I_)
+extern "C" {
+#include <locale.h>
+#if ZTD_TEXT_HAS_INCLUDE_I_(<xlocale.h>)
+#include <xlocale.h>
+#endif
+}
+#endif
+
 // clang-format on
 
 namespace ztd { namespace text {
@@ -65,7 +74,7 @@ namespace ztd { namespace text {
 
 		inline __encoding_id __determine_active_code_page() noexcept {
 #if ZTD_TEXT_IS_ON(ZTD_TEXT_LANGINFO_I_) || ZTD_TEXT_IS_ON(ZTD_TEXT_NL_LANGINFO_I_)
-			const char* __name = nl_langinfo(LC_CTYPE);
+			const char* __name = nl_langinfo(CODESET);
 			return __to_encoding_id(__name);
 #else
 			// fallback to stdlib I guess?
@@ -74,6 +83,33 @@ namespace ztd { namespace text {
 #endif
 		}
 
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_LOCALE_T_I_)
+		inline __encoding_id __determine_code_page(::locale_t __locale) noexcept {
+			const char* __name = nl_langinfo_l(CODESET, __locale);
+			return __to_encoding_id(__name);
+		}
+
+		//////
+		/// @brief Makes @p __locale the current thread's locale for as long as it lives, without touching the
+		/// process-wide locale.
+		//////
+		class __locale_scope {
+		private:
+			::locale_t _M_previous;
+
+		public:
+			explicit __locale_scope(::locale_t __locale) noexcept : _M_previous(::uselocale(__locale)) {
+			}
+
+			__locale_scope(const __locale_scope&) = delete;
+			__locale_scope& operator=(const __locale_scope&) = delete;
+
+			~__locale_scope() {
+				::uselocale(this->_M_previous);
+			}
+		};
+#endif
+
 	}} // namespace __detail::__posix
 
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
@@ -97,11 +97,22 @@ namespace ztd { namespace text {
 			typename ::std::iterator_traits<::std::remove_reference_t<_It>>::iterator_category;
 
 		template <typename _It, typename = void>
-		struct __iterator_concept_or_fallback {
+		struct __iterator_member_concept_or_fallback {
 			using type = ::std::conditional_t<::std::is_pointer_v<__remove_cvref_t<_It>>, contiguous_iterator_tag,
 				__iterator_category_t<_It>>;
 		};
 
+		template <typename _It>
+		struct __iterator_member_concept_or_fallback<_It,
+			::std::void_t<typename __remove_cvref_t<_It>::iterator_concept>> {
+			// the standard library's own iterators (e.g. for std::basic_string or std::span) only advertise their
+			// contiguity this way, as std::iterator_traits does not forward the member
+			using type = typename __remove_cvref_t<_It>::iterator_concept;
+		};
+
+		template <typename _It, typename = void>
+		struct __iterator_concept_or_fallback : __iterator_member_concept_or_fallback<_It> { };
+
 		template <typename _It>
 		struct __iterator_concept_or_fallback<_It,
 			::std::void_t<typename ::std::iterator_traits<::std::remove_reference_t<_It>>::iterator_concept>> {
@@ -157,6 +168,12 @@ namespace ztd { namespace text {
 		inline constexpr bool __is_range_iterator_concept_or_better_v
 			= ::std::is_base_of_v<_Tag, __range_iterator_concept_t<_Range>>;
 
+		template <typename _Range>
+		inline constexpr bool __is_sized_contiguous_range_v
+			= __is_range_iterator_concept_or_better_v<contiguous_iterator_tag,
+			       _Range> && ::std::is_same_v<__remove_cvref_t<__range_iterator_t<_Range>>,
+			       __remove_cvref_t<__range_sentinel_t<_Range>>>;
+
 		template <typename _Range, typename _Element>
 		using __detect_push_back = decltype(::std::declval<_Range>().push_back(::std::declval<_Element>()));
 
@@ -82,7 +82,7 @@ namespace ztd { namespace text {
 					return ::std::basic_string_view<_Ty, _Traits>(__empty_str + 0, 0);
 				}
 #endif
-				return ::std::basic_string_view<_Ty, _Traits>(::std::addressof(*__iterator), __ptr_size);
+				return ::std::basic_string_view<_Ty, _Traits>(__adl::__adl_to_address(__iterator), __ptr_size);
 			}
 			else {
 #if defined(_ITERATOR_DEBUG_LEVEL) && _ITERATOR_DEBUG_LEVEL >= 1
@@ -92,7 +92,7 @@ namespace ztd { namespace text {
 				}
 #endif
 				return ::std::basic_string_view<_Ty, _Traits>(
-					::std::addressof(*__iterator), static_cast<_SizeType>(__sentinel));
+					__adl::__adl_to_address(__iterator), static_cast<_SizeType>(__sentinel));
 			}
 		}
 
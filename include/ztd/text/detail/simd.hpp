@@ -0,0 +1,155 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_SIMD_HPP
+#define ZTD_TEXT_DETAIL_SIMD_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/simd_level.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_VCXX_I_) && ZTD_TEXT_IS_OFF(ZTD_TEXT_COMPILER_CLANG_I_)
+#include <intrin.h>
+#endif
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+#include <emmintrin.h>
+#endif
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE4_2_I_)
+#include <nmmintrin.h>
+#endif
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+#include <immintrin.h>
+#endif
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		inline constexpr ::std::uint_least64_t __swar_high_bits = 0x8080808080808080ull;
+
+		inline int __count_trailing_zeros(::std::uint_least32_t __value) noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_GCC_I_) || ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_CLANG_I_)
+			return __builtin_ctz(static_cast<unsigned int>(__value));
+#elif ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_VCXX_I_)
+			unsigned long __index = 0;
+			_BitScanForward(&__index, static_cast<unsigned long>(__value));
+			return static_cast<int>(__index);
+#else
+			int __count = 0;
+			for (; (__value & 1u) == 0u; __value >>= 1) {
+				++__count;
+			}
+			return __count;
+#endif
+		}
+
+		inline int __popcount(::std::uint_least32_t __value) noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_GCC_I_) || ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_CLANG_I_)
+			return __builtin_popcount(static_cast<unsigned int>(__value));
+#else
+			int __count = 0;
+			for (; __value != 0; __value &= __value - 1) {
+				++__count;
+			}
+			return __count;
+#endif
+		}
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+		// Returns the offset of the first code unit with its high bit set, or of the first block of 32 code units
+		// that is not all there.
+		ZTD_TEXT_SIMD_TARGET_AVX2_I_ inline ::std::size_t __ascii_prefix_length_avx2(
+			const unsigned char* __first, ::std::size_t __size) noexcept {
+			::std::size_t __index = 0;
+			for (; __index + 32 <= __size; __index += 32) {
+				const __m256i __block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(__first + __index));
+				const ::std::uint_least32_t __mask
+					= static_cast<::std::uint_least32_t>(_mm256_movemask_epi8(__block));
+				if (__mask != 0) {
+					return __index + static_cast<::std::size_t>(__count_trailing_zeros(__mask));
+				}
+			}
+			return __index;
+		}
+#endif
+
+		//////
+		/// @brief Returns the number of leading code units in [ __first, __first + __size ) which have their high bit
+		/// clear (i.e., the length of the leading ASCII run for byte-based encodings).
+		///
+		/// @remarks This is a run-time only function: the constexpr paths of the library never call it.
+		//////
+		inline ::std::size_t __ascii_prefix_length(const unsigned char* __first, ::std::size_t __size) noexcept {
+			::std::size_t __index = 0;
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+			if (active_simd_level() >= simd_level::avx2) {
+				__index = __ascii_prefix_length_avx2(__first, __size);
+				if (__index + 32 <= __size) {
+					return __index;
+				}
+			}
+#endif
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+			for (; __index + 16 <= __size; __index += 16) {
+				const __m128i __block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__first + __index));
+				const ::std::uint_least32_t __mask = static_cast<::std::uint_least32_t>(_mm_movemask_epi8(__block));
+				if (__mask != 0) {
+					return __index + static_cast<::std::size_t>(__count_trailing_zeros(__mask));
+				}
+			}
+#endif
+			for (; __index + 8 <= __size; __index += 8) {
+				::std::uint_least64_t __word;
+				::std::memcpy(&__word, __first + __index, sizeof(__word));
+				if ((__word & __swar_high_bits) != 0) {
+					break;
+				}
+			}
+			for (; __index < __size; ++__index) {
+				if (__first[__index] >= 0x80) {
+					break;
+				}
+			}
+			return __index;
+		}
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_SIMD_HPP
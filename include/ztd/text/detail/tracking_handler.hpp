@@ -0,0 +1,106 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_TRACKING_HANDLER_HPP
+#define ZTD_TEXT_DETAIL_TRACKING_HANDLER_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/is_ignorable_error_handler.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		//////
+		/// @brief Forwards to another error handler and notes down whether it was invoked for an actual error.
+		/// Running out of output space is not counted: callers that convert a block of output at a time expect it.
+		///
+		/// @tparam _AssumeValid Whether this handler lets the encoding skip its checks. Wrappers for the encoding
+		/// ("to") side pass @c false, so a trusted input never turns into unchecked writes into a bounded output.
+		//////
+		template <typename _ErrorHandler, bool _AssumeValid = is_ignorable_error_handler_v<_ErrorHandler>>
+		class __tracking_handler {
+		public:
+			using assume_valid = ::std::integral_constant<bool, _AssumeValid>;
+
+			_ErrorHandler* _M_error_handler;
+			bool* _M_handled_error;
+
+			template <typename _Encoding, typename _Result, typename _Progress>
+			constexpr auto operator()(
+				const _Encoding& __encoding, _Result __result, const _Progress& __progress) const {
+				if (__result.error_code != encoding_error::insufficient_output_space) {
+					*this->_M_handled_error = true;
+				}
+				return (*this->_M_error_handler)(__encoding, ::std::move(__result), __progress);
+			}
+		};
+
+		//////
+		/// @brief Like ztd::text::__detail::__tracking_handler, but running out of output space is not passed on at
+		/// all: a preflighting conversion reports it through its result instead, even with an error handler that
+		/// would throw.
+		///
+		/// @tparam _AssumeValid Whether this handler lets the encoding skip its checks, as for
+		/// ztd::text::__detail::__tracking_handler.
+		//////
+		template <typename _ErrorHandler, bool _AssumeValid = is_ignorable_error_handler_v<_ErrorHandler>>
+		class __preflight_handler {
+		public:
+			using assume_valid = ::std::integral_constant<bool, _AssumeValid>;
+
+			_ErrorHandler* _M_error_handler;
+			bool* _M_handled_error;
+
+			template <typename _Encoding, typename _Result, typename _Progress>
+			constexpr _Result operator()(
+				const _Encoding& __encoding, _Result __result, const _Progress& __progress) const {
+				if (__result.error_code == encoding_error::insufficient_output_space) {
+					return __result;
+				}
+				*this->_M_handled_error = true;
+				return (*this->_M_error_handler)(__encoding, ::std::move(__result), __progress);
+			}
+		};
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_TRACKING_HANDLER_HPP
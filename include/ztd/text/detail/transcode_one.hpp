@@ -326,10 +326,27 @@ namespace ztd { namespace text {
 				__adl::__adl_begin(__intermediate), __adl::__adl_begin(__intermediate_result.output));
 			auto __end_result = __basic_encode_one<_ConsumeIntoTheNothingness>(__intermediate_view, __to_encoding,
 				::std::forward<_Output>(__output), __to_error_handler, __to_state);
+			// one decode step may produce more than one code point (e.g. a base character and a combining mark
+			// that a legacy encoding stores together): every one of them has to be encoded, not just the first
+			_OutputView __end_output(::std::move(__end_result.output));
+			__intermediate_view = __reconstruct(::std::in_place_type<_WorkingIntermediate>,
+				__adl::__adl_begin(__end_result.input), __adl::__adl_end(__end_result.input));
+			encoding_error __end_error_code = __end_result.error_code;
+			bool __end_handled_error        = __end_result.handled_error;
+			while (__end_error_code == encoding_error::ok && !__adl::__adl_empty(__intermediate_view)) {
+				auto __next_result = __basic_encode_one<_ConsumeIntoTheNothingness>(__intermediate_view,
+					__to_encoding, ::std::move(__end_output), __to_error_handler, __to_state);
+				__end_output = __reconstruct(::std::in_place_type<_OutputView>,
+					__adl::__adl_begin(__next_result.output), __adl::__adl_end(__next_result.output));
+				__intermediate_view = __reconstruct(::std::in_place_type<_WorkingIntermediate>,
+					__adl::__adl_begin(__next_result.input), __adl::__adl_end(__next_result.input));
+				__end_error_code = __next_result.error_code;
+				__end_handled_error |= __next_result.handled_error;
+			}
 
-			return _Result(::std::move(__intermediate_result.input), ::std::move(__end_result.output),
-				__intermediate_result.state, __end_result.state, __end_result.error_code,
-				__end_result.handled_error);
+			return _Result(::std::move(__intermediate_result.input), ::std::move(__end_output),
+				__intermediate_result.state, __to_state, __end_error_code,
+				__intermediate_result.handled_error || __end_handled_error);
 		}
 
 		template <__consume _ConsumeIntoTheNothingness, typename _Input, typename _FromEncoding, typename _Output,
@@ -540,7 +557,8 @@ namespace ztd { namespace text {
 			::std::size_t __written    = static_cast<::std::size_t>(
                     __adl::__adl_cbegin(__intermediate_result.output) - __adl::__adl_cbegin(__output));
 
-			return _Result(::std::move(__intermediate_result.input), __written, __intermediate_result.state);
+			return _Result(::std::move(__intermediate_result.input), __written, __intermediate_result.state,
+				__intermediate_result.error_code, __intermediate_result.handled_error);
 		}
 
 		template <typename _Input, typename _Encoding, typename _ErrorHandler, typename _State>
@@ -164,6 +164,21 @@ namespace ztd { namespace text {
 		using __detect_reserve_with_size_type
 			= decltype(::std::declval<_Type>().reserve(::std::declval<_SizeType>()));
 
+		template <typename _Type, typename _SizeType = ::std::size_t>
+		using __detect_resize_with_size_type
+			= decltype(::std::declval<_Type>().resize(::std::declval<_SizeType>()));
+
+		// whether the encoding is one of the ones this library provides: the UTF encodings are known by their tags,
+		// and every other one is marked with a specialization next to its definition
+		template <typename _Encoding>
+		class __is_library_encoding
+		: public ::std::integral_constant<bool,
+			  ::std::is_base_of_v<__impl::__utf8_tag, _Encoding> || ::std::is_base_of_v<__impl::__utf16_tag, _Encoding>
+			       || ::std::is_base_of_v<__impl::__utf32_tag, _Encoding>> { };
+
+		template <typename _Encoding>
+		inline constexpr bool __is_library_encoding_v = __is_library_encoding<__remove_cvref_t<_Encoding>>::value;
+
 	} // namespace __detail
 
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
@@ -0,0 +1,208 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_DETAIL_UTF8_DFA_HPP
+#define ZTD_TEXT_DETAIL_UTF8_DFA_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/char8_t.hpp>
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/detail/unicode.hpp>
+
+#include <cstddef>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		// A deterministic finite automaton which validates UTF-8 and accumulates the code point in the same step, one
+		// code unit at a time. Code units are first sorted into classes: the continuation units are split into the
+		// 3 ranges that the unit after an E0, ED, F0 or F4 lead has to be checked against. States are stored
+		// pre-multiplied by the (padded) number of classes, so that a transition is a single lookup.
+		//
+		// A sequence which is malformed only because of its value (overlong, a surrogate, or past U+10FFFF) does not
+		// reject right away: it goes through the "bad" states, which still expect the rest of its continuation
+		// units. This gives the same errors, after reading the same number of code units, as checking the decoded
+		// value at the end does.
+		inline constexpr ::std::size_t __utf8_dfa_class_count = 16;
+
+		inline constexpr unsigned char __utf8_dfa_class_ascii         = 0;
+		inline constexpr unsigned char __utf8_dfa_class_continuation0 = 1; // 80 to 8F
+		inline constexpr unsigned char __utf8_dfa_class_continuation1 = 2; // 90 to 9F
+		inline constexpr unsigned char __utf8_dfa_class_continuation2 = 3; // A0 to BF
+		inline constexpr unsigned char __utf8_dfa_class_overlong_2    = 4; // C0, C1
+		inline constexpr unsigned char __utf8_dfa_class_lead_2        = 5; // C2 to DF
+		inline constexpr unsigned char __utf8_dfa_class_e0            = 6;
+		inline constexpr unsigned char __utf8_dfa_class_lead_3        = 7; // E1 to EC, EE, EF
+		inline constexpr unsigned char __utf8_dfa_class_ed            = 8;
+		inline constexpr unsigned char __utf8_dfa_class_f0            = 9;
+		inline constexpr unsigned char __utf8_dfa_class_lead_4        = 10; // F1 to F3
+		inline constexpr unsigned char __utf8_dfa_class_f4            = 11;
+		inline constexpr unsigned char __utf8_dfa_class_invalid       = 12; // F5 to FF
+
+		inline constexpr unsigned char __utf8_dfa_accept = 0 * __utf8_dfa_class_count;
+		inline constexpr unsigned char __utf8_dfa_reject = 1 * __utf8_dfa_class_count;
+		inline constexpr unsigned char __utf8_dfa_need_1 = 2 * __utf8_dfa_class_count;
+		inline constexpr unsigned char __utf8_dfa_need_2 = 3 * __utf8_dfa_class_count;
+		inline constexpr unsigned char __utf8_dfa_need_3 = 4 * __utf8_dfa_class_count;
+		inline constexpr unsigned char __utf8_dfa_e0     = 5 * __utf8_dfa_class_count;
+		inline constexpr unsigned char __utf8_dfa_ed     = 6 * __utf8_dfa_class_count;
+		inline constexpr unsigned char __utf8_dfa_f0     = 7 * __utf8_dfa_class_count;
+		inline constexpr unsigned char __utf8_dfa_f4     = 8 * __utf8_dfa_class_count;
+		inline constexpr unsigned char __utf8_dfa_bad_1  = 9 * __utf8_dfa_class_count;
+		inline constexpr unsigned char __utf8_dfa_bad_2  = 10 * __utf8_dfa_class_count;
+
+		inline constexpr ::std::size_t __utf8_dfa_state_count = 11;
+
+		struct __utf8_dfa_tables {
+			unsigned char __classes[256];
+			unsigned char __lead_masks[__utf8_dfa_class_count];
+			unsigned char __transitions[__utf8_dfa_state_count * __utf8_dfa_class_count];
+		};
+
+		inline constexpr unsigned char __utf8_dfa_unit_class(uchar8_t __unit) noexcept {
+			return __unit < 0x80 ? __utf8_dfa_class_ascii
+				: __unit < 0x90  ? __utf8_dfa_class_continuation0
+				: __unit < 0xA0  ? __utf8_dfa_class_continuation1
+				: __unit < 0xC0  ? __utf8_dfa_class_continuation2
+				: __unit < 0xC2  ? __utf8_dfa_class_overlong_2
+				: __unit < 0xE0  ? __utf8_dfa_class_lead_2
+				: __unit == 0xE0 ? __utf8_dfa_class_e0
+				: __unit == 0xED ? __utf8_dfa_class_ed
+				: __unit < 0xF0  ? __utf8_dfa_class_lead_3
+				: __unit == 0xF0 ? __utf8_dfa_class_f0
+				: __unit < 0xF4  ? __utf8_dfa_class_lead_4
+				: __unit == 0xF4 ? __utf8_dfa_class_f4
+				                 : __utf8_dfa_class_invalid;
+		}
+
+		// Builds the tables for strict UTF-8, or for a variant which allows overlong sequences (Modified UTF-8, where
+		// U+0000 is C0 80) and/or encoded surrogates (WTF-8).
+		inline constexpr __utf8_dfa_tables __utf8_dfa_make(
+			bool __overlong_allowed, bool __surrogates_allowed) noexcept {
+			__utf8_dfa_tables __dfa {};
+			for (::std::size_t __unit = 0; __unit < 256; ++__unit) {
+				__dfa.__classes[__unit] = __utf8_dfa_unit_class(static_cast<uchar8_t>(__unit));
+			}
+			__dfa.__lead_masks[__utf8_dfa_class_ascii]      = 0x7F;
+			__dfa.__lead_masks[__utf8_dfa_class_overlong_2] = 0x1F;
+			__dfa.__lead_masks[__utf8_dfa_class_lead_2]     = 0x1F;
+			__dfa.__lead_masks[__utf8_dfa_class_e0]         = 0x0F;
+			__dfa.__lead_masks[__utf8_dfa_class_lead_3]     = 0x0F;
+			__dfa.__lead_masks[__utf8_dfa_class_ed]         = 0x0F;
+			__dfa.__lead_masks[__utf8_dfa_class_f0]         = 0x07;
+			__dfa.__lead_masks[__utf8_dfa_class_lead_4]     = 0x07;
+			__dfa.__lead_masks[__utf8_dfa_class_f4]         = 0x07;
+			for (unsigned char& __next : __dfa.__transitions) {
+				__next = __utf8_dfa_reject;
+			}
+			unsigned char* __accept = __dfa.__transitions + __utf8_dfa_accept;
+			__accept[__utf8_dfa_class_ascii] = __utf8_dfa_accept;
+			__accept[__utf8_dfa_class_overlong_2] = __overlong_allowed ? __utf8_dfa_need_1 : __utf8_dfa_reject;
+			__accept[__utf8_dfa_class_lead_2]     = __utf8_dfa_need_1;
+			__accept[__utf8_dfa_class_e0]         = __overlong_allowed ? __utf8_dfa_need_2 : __utf8_dfa_e0;
+			__accept[__utf8_dfa_class_lead_3]     = __utf8_dfa_need_2;
+			__accept[__utf8_dfa_class_ed]         = __surrogates_allowed ? __utf8_dfa_need_2 : __utf8_dfa_ed;
+			__accept[__utf8_dfa_class_f0]         = __overlong_allowed ? __utf8_dfa_need_3 : __utf8_dfa_f0;
+			__accept[__utf8_dfa_class_lead_4]     = __utf8_dfa_need_3;
+			__accept[__utf8_dfa_class_f4]         = __utf8_dfa_f4;
+			const unsigned char __continuations[3] = { __utf8_dfa_class_continuation0,
+				__utf8_dfa_class_continuation1, __utf8_dfa_class_continuation2 };
+			for (::std::size_t __index = 0; __index < 3; ++__index) {
+				const unsigned char __class = __continuations[__index];
+				const bool __low            = __class == __utf8_dfa_class_continuation0;
+				const bool __high           = __class == __utf8_dfa_class_continuation2;
+				__dfa.__transitions[__utf8_dfa_need_1 + __class] = __utf8_dfa_accept;
+				__dfa.__transitions[__utf8_dfa_need_2 + __class] = __utf8_dfa_need_1;
+				__dfa.__transitions[__utf8_dfa_need_3 + __class] = __utf8_dfa_need_2;
+				// E0 80 to E0 9F are overlong, ED A0 to ED BF are surrogates
+				__dfa.__transitions[__utf8_dfa_e0 + __class] = __high ? __utf8_dfa_need_1 : __utf8_dfa_bad_1;
+				__dfa.__transitions[__utf8_dfa_ed + __class] = __high ? __utf8_dfa_bad_1 : __utf8_dfa_need_1;
+				// F0 80 to F0 8F are overlong, F4 90 to F4 BF are past U+10FFFF
+				__dfa.__transitions[__utf8_dfa_f0 + __class] = __low ? __utf8_dfa_bad_2 : __utf8_dfa_need_2;
+				__dfa.__transitions[__utf8_dfa_f4 + __class] = __low ? __utf8_dfa_need_2 : __utf8_dfa_bad_2;
+				__dfa.__transitions[__utf8_dfa_bad_1 + __class] = __utf8_dfa_reject;
+				__dfa.__transitions[__utf8_dfa_bad_2 + __class] = __utf8_dfa_bad_1;
+			}
+			return __dfa;
+		}
+
+		template <bool _OverlongAllowed = false, bool _SurrogatesAllowed = false>
+		inline constexpr __utf8_dfa_tables __utf8_dfa = __utf8_dfa_make(_OverlongAllowed, _SurrogatesAllowed);
+
+		//////
+		/// @brief Feeds one code unit to the UTF-8 automaton, returning the next state.
+		///
+		/// @remarks Starting from ztd::text::__detail::__utf8_dfa_accept, a sequence is complete (and @p
+		/// __code_point holds its value) when this returns that state again. It is malformed once this returns
+		/// ztd::text::__detail::__utf8_dfa_reject, which it never leaves.
+		//////
+		template <bool _OverlongAllowed = false, bool _SurrogatesAllowed = false>
+		constexpr unsigned char __utf8_dfa_step(
+			unsigned char __state, uchar8_t __unit, char32_t& __code_point) noexcept {
+			constexpr const __utf8_dfa_tables& __dfa = __utf8_dfa<_OverlongAllowed, _SurrogatesAllowed>;
+			const unsigned char __class              = __dfa.__classes[__unit];
+			__code_point                             = __state == __utf8_dfa_accept
+				                            ? static_cast<char32_t>(__unit & __dfa.__lead_masks[__class])
+				                            : static_cast<char32_t>((__code_point << 6) | (__unit & 0x3F));
+			return __dfa.__transitions[__state + __class];
+		}
+
+		// Decodes the strict UTF-8 sequence starting at __first[__index] into __code_point, giving the same error
+		// (if any) as ztd::text::basic_utf8::decode_one. On success, __index is moved past the sequence.
+		template <typename _It>
+		constexpr encoding_error __utf8_decode_sequence(const _It& __first, ::std::size_t __size,
+			::std::size_t& __index, char32_t& __code_point) noexcept {
+			unsigned char __state = __utf8_dfa_accept;
+			::std::size_t __next  = __index;
+			do {
+				if (__next == __size) {
+					return encoding_error::incomplete_sequence;
+				}
+				__state = __utf8_dfa_step(__state, static_cast<uchar8_t>(__first[__next]), __code_point);
+				++__next;
+				if (__state == __utf8_dfa_reject) {
+					return encoding_error::invalid_sequence;
+				}
+			} while (__state != __utf8_dfa_accept);
+			__index = __next;
+			return encoding_error::ok;
+		}
+
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_DETAIL_UTF8_DFA_HPP
@@ -52,6 +52,18 @@ namespace ztd { namespace text {
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
 	namespace __detail {
 
+		template <typename _Value>
+		constexpr _Value __reverse_bytes(_Value __value) noexcept {
+			using _UValue      = ::std::make_unsigned_t<_Value>;
+			_UValue __bits     = static_cast<_UValue>(__value);
+			_UValue __reversed = 0;
+			for (::std::size_t __index = 0; __index < sizeof(_UValue); ++__index) {
+				__reversed = static_cast<_UValue>((__reversed << CHAR_BIT) | (__bits & UCHAR_MAX));
+				__bits     = static_cast<_UValue>(__bits >> CHAR_BIT);
+			}
+			return static_cast<_Value>(__reversed);
+		}
+
 		template <typename _It, typename _Word, endian _Endian>
 		class __word_reference {
 		public:
@@ -67,12 +79,24 @@ namespace ztd { namespace text {
 			using __underlying_value_type      = decltype(__any_to_underlying(value_type {}));
 			inline static constexpr ::std::size_t __base_values_per_word
 				= sizeof(value_type) / sizeof(__base_value_type);
+			// each base value already holds a whole word (e.g. wchar_t), so the byte order only says how the bytes
+			// of that one value sit in memory
+			inline static constexpr bool __is_whole_word
+				= __base_values_per_word == 1 && sizeof(__base_value_type) > 1;
 
 		public:
 			constexpr __word_reference(__base_iterator __it) : _M_base_it(::std::move(__it)) {
 			}
 
 			constexpr __word_reference& operator=(value_type __val) noexcept {
+				if constexpr (__is_whole_word) {
+					__underlying_value_type __bits = __any_to_underlying(__val);
+					if constexpr (_Endian != endian::native) {
+						__bits = __reverse_bytes(__bits);
+					}
+					*this->_M_base_it = static_cast<__base_value_type>(__bits);
+					return *this;
+				}
 #if ZTD_TEXT_IS_ON(ZTD_TEXT_STD_LIBRARY_IS_CONSTANT_EVALUATED_I_)
 				if (::std::is_constant_evaluated()) {
 					// God's given, handwritten, bit-splittin'
@@ -120,6 +144,13 @@ namespace ztd { namespace text {
 						"read value from byte stream to native endianness that is neither little nor big (byte "
 						"order is impossible to infer from the standard)");
 				}
+				if constexpr (__is_whole_word) {
+					__underlying_base_value_type __bits = __any_to_underlying(*this->_M_base_it);
+					if constexpr (_Endian != endian::native) {
+						__bits = __reverse_bytes(__bits);
+					}
+					return static_cast<value_type>(__bits);
+				}
 #if ZTD_TEXT_IS_ON(ZTD_TEXT_STD_LIBRARY_IS_CONSTANT_EVALUATED_I_)
 				if (::std::is_constant_evaluated()) {
 					__base_value_type __storage[__base_values_per_word] {};
@@ -35,6 +35,8 @@
 
 #include <ztd/text/code_unit.hpp>
 #include <ztd/text/encode_result.hpp>
+#include <ztd/text/count_code_units.hpp>
+#include <ztd/text/preflight_result.hpp>
 #include <ztd/text/error_handler.hpp>
 #include <ztd/text/default_encoding.hpp>
 #include <ztd/text/state.hpp>
@@ -46,10 +48,13 @@
 #include <ztd/text/detail/type_traits.hpp>
 #include <ztd/text/detail/span.hpp>
 #include <ztd/text/detail/transcode_one.hpp>
+#include <ztd/text/detail/exact_size.hpp>
+#include <ztd/text/detail/tracking_handler.hpp>
 
 #include <string>
 #include <vector>
 #include <string_view>
+#include <memory>
 
 namespace ztd { namespace text {
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
@@ -114,7 +119,7 @@ namespace ztd { namespace text {
 			__detail::__reconstruct(::std::in_place_type<_WorkingOutput>, ::std::forward<_Output>(__output)));
 		bool __handled_error = false;
 
-		for (;;) {
+		while (!__detail::__adl::__adl_empty(__working_input)) {
 			auto __result = __encoding.encode_one(
 				::std::move(__working_input), ::std::move(__working_output), __error_handler, __state);
 			if (__result.error_code != encoding_error::ok) {
@@ -123,12 +128,9 @@ namespace ztd { namespace text {
 			__handled_error |= __result.handled_error;
 			__working_input  = ::std::move(__result.input);
 			__working_output = ::std::move(__result.output);
-			if (__detail::__adl::__adl_empty(__result.input)) {
-				break;
-			}
 		}
-		return _Result(
-			::std::move(__working_input), ::std::move(__working_output), __state, encoding_error::ok, false);
+		return _Result(::std::move(__working_input), ::std::move(__working_output), __state, encoding_error::ok,
+			__handled_error);
 	}
 
 	//////
@@ -320,29 +322,181 @@ namespace ztd { namespace text {
 	}
 
 	//////
-	/// @brief Converts the code points of the given @p __input view through the encoding to code units in the
-	/// specified @p _OutputContainer type.
+	/// @brief Converts the code points of the given @p __input view through the encoding to code units into the @p
+	/// __output view, and counts how many code units the whole input needs even if the output is too small to hold
+	/// them.
 	///
-	/// @tparam _OutputContainer The container type to serialize data into.
+	/// @param[in]     __input An input_view to read code points from and use in the encode operation that will
+	/// produce code units.
+	/// @param[in]     __encoding The encoding that will be used to encode the input's code points into code units.
+	/// @param[in]     __output A sized output_view to write code units to. It may be empty, to only ask for the size.
+	/// @param[in]     __error_handler The error handler to invoke when an encode operation fails.
+	/// @param[in,out] __state A reference to the associated state for the @p __encoding 's encode step.
+	///
+	/// @result A ztd::text::preflight_result of a ztd::text::encode_result like the one from ztd::text::encode_into,
+	/// with the total number of code units needed in @c required_size .
+	///
+	/// @remarks This works like ztd::text::encode_into, except that running out of output space is not given to the @p
+	/// __error_handler (it only shows up as ztd::text::encoding_error::insufficient_output_space in the result, which
+	/// also does not count as a handled error). The output is written one @c encode_one step at a time, and the input
+	/// and output returned on that error are the ones from before the step that did not fit; if the output is empty,
+	/// nothing is written at all. Once out of space, the rest of the input is counted with
+	/// ztd::text::count_code_units on a copy of @p __state , without writing anything, so that the returned input and
+	/// state can still be used to resume. The error handler is called for errors in the rest of the input just as it
+	/// would be if the output were large enough, so that replacement characters are counted too; @c required_size
+	/// stops short if the rest of the input has an error that is not corrected. If @p __state cannot be copied, the
+	/// rest of the input is not counted at all and @c required_size is ztd::text::preflight_result::unknown_size .
+	//////
+	template <typename _Input, typename _Encoding, typename _Output, typename _ErrorHandler, typename _State>
+	constexpr auto encode_into_preflight(_Input&& __input, _Encoding&& __encoding, _Output&& __output,
+		_ErrorHandler&& __error_handler, _State& __state) {
+		using _UInput             = __detail::__remove_cvref_t<_Input>;
+		using _UOutput            = __detail::__remove_cvref_t<_Output>;
+		using _InputValueType     = __detail::__range_value_type_t<_UInput>;
+		using _IntermediateInput  = __detail::__reconstruct_t<::std::conditional_t<::std::is_array_v<_UInput>,
+               ::std::conditional_t<__detail::__is_character_v<_InputValueType>,
+                    ::std::basic_string_view<_InputValueType>, ::ztd::text::span<const _InputValueType>>,
+               _UInput>>;
+		using _IntermediateOutput = __detail::__reconstruct_t<_UOutput>;
+		using _UEncoding          = __detail::__remove_cvref_t<_Encoding>;
+		using _UErrorHandler      = __detail::__remove_cvref_t<_ErrorHandler>;
+		using _Tracker            = __detail::__preflight_handler<_UErrorHandler>;
+		using _Result             = decltype(__encoding.encode_one(::std::declval<_IntermediateInput>(),
+               ::std::declval<_IntermediateOutput>(), ::std::declval<_Tracker&>(), __state));
+		using _WorkingInput       = __detail::__remove_cvref_t<decltype(::std::declval<_Result>().input)>;
+		using _WorkingOutput      = __detail::__remove_cvref_t<decltype(::std::declval<_Result>().output)>;
+
+		static_assert(__detail::__is_detected_v<__detail::__detect_adl_size, _Output>,
+			"the output of encode_into_preflight must be a sized range (e.g. a ztd::text::span), so that the number "
+			"of code units written into it can be known");
+		static_assert(__detail::__is_encode_lossless_or_deliberate_v<_UEncoding, _UErrorHandler>,
+			"This encode is a lossy, non-injective operation. This means you may lose data that you did not intend "
+			"to lose; specify a 'handler' error handler parameter to encode_into_preflight(in, encoding, out, "
+			"handler, ...) explicitly in order to bypass this.");
+
+		const ::std::size_t __output_size = static_cast<::std::size_t>(__detail::__adl::__adl_size(__output));
+		bool __handled_error              = false;
+		_Tracker __tracker { ::std::addressof(__error_handler), ::std::addressof(__handled_error) };
+		_WorkingInput __working_input(
+			__detail::__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
+		_WorkingOutput __working_output(
+			__detail::__reconstruct(::std::in_place_type<_WorkingOutput>, ::std::forward<_Output>(__output)));
+		encoding_error __error_code = encoding_error::ok;
+		if (__output_size == 0) {
+			// only the size was asked for: do not even try to write
+			if (!__detail::__adl::__adl_empty(__working_input)) {
+				__error_code = encoding_error::insufficient_output_space;
+			}
+		}
+		else {
+			while (!__detail::__adl::__adl_empty(__working_input)) {
+				auto __result = __encoding.encode_one(__working_input, __working_output, __tracker, __state);
+				if (__result.error_code == encoding_error::insufficient_output_space) {
+					// keep the input and output from before this encoding step, so that counting picks up
+					// exactly where writing stopped
+					__error_code = __result.error_code;
+					break;
+				}
+				__working_input  = ::std::move(__result.input);
+				__working_output = ::std::move(__result.output);
+				if (__result.error_code != encoding_error::ok) {
+					__error_code = __result.error_code;
+					break;
+				}
+			}
+		}
+		::std::size_t __required_size
+			= __output_size - static_cast<::std::size_t>(__detail::__adl::__adl_size(__working_output));
+		if (__error_code == encoding_error::insufficient_output_space) {
+			if constexpr (::std::is_copy_constructible_v<_State>) {
+				_State __count_state = __state;
+				__required_size
+					+= count_code_units(__working_input, __encoding, __error_handler, __count_state).count;
+			}
+			else {
+				// counting would disturb the only state the caller can resume with
+				__required_size = preflight_result<_Result>::unknown_size;
+			}
+		}
+		return preflight_result<_Result>(_Result(::std::move(__working_input), ::std::move(__working_output),
+			                                 __state, __error_code, __handled_error),
+			__required_size);
+	}
+
+	//////
+	/// @brief Converts the code points of the given @p __input view through the encoding to code units into the @p
+	/// __output view, and counts how many code units the whole input needs even if the output is too small to hold
+	/// them.
+	///
+	/// @param[in]     __input An input_view to read code points from and use in the encode operation that will
+	/// produce code units.
+	/// @param[in]     __encoding The encoding that will be used to encode the input's code points into code units.
+	/// @param[in]     __output A sized output_view to write code units to. It may be empty, to only ask for the size.
+	/// @param[in]     __error_handler The error handler to invoke when an encode operation fails.
+	///
+	/// @result A ztd::text::preflight_result of a ztd::text::stateless_encode_result.
+	///
+	/// @remarks Creates a default @c state using ztd::text::make_encode_state.
+	//////
+	template <typename _Input, typename _Encoding, typename _Output, typename _ErrorHandler>
+	constexpr auto encode_into_preflight(
+		_Input&& __input, _Encoding&& __encoding, _Output&& __output, _ErrorHandler&& __error_handler) {
+		using _UEncoding = __detail::__remove_cvref_t<_Encoding>;
+		using _State     = encode_state_t<_UEncoding>;
+
+		_State __state         = make_encode_state(__encoding);
+		auto __stateful_result = encode_into_preflight(::std::forward<_Input>(__input),
+			::std::forward<_Encoding>(__encoding), ::std::forward<_Output>(__output),
+			::std::forward<_ErrorHandler>(__error_handler), __state);
+		return __detail::__slice_to_stateless(::std::move(__stateful_result));
+	}
+
+	//////
+	/// @brief Converts the code points of the given @p __input view through the encoding to code units into the @p
+	/// __output view, and counts how many code units the whole input needs even if the output is too small to hold
+	/// them.
+	///
+	/// @param[in]     __input An input_view to read code points from and use in the encode operation that will
+	/// produce code units.
+	/// @param[in]     __encoding The encoding that will be used to encode the input's code points into code units.
+	/// @param[in]     __output A sized output_view to write code units to. It may be empty, to only ask for the size.
+	///
+	/// @result A ztd::text::preflight_result of a ztd::text::stateless_encode_result.
+	///
+	/// @remarks Creates a default @c error_handler that is similar to ztd::text::default_handler, but marked as
+	/// careless.
+	//////
+	template <typename _Input, typename _Encoding, typename _Output>
+	constexpr auto encode_into_preflight(_Input&& __input, _Encoding&& __encoding, _Output&& __output) {
+		__detail::__careless_handler __handler {};
+		return encode_into_preflight(::std::forward<_Input>(__input), ::std::forward<_Encoding>(__encoding),
+			::std::forward<_Output>(__output), __handler);
+	}
+
+	//////
+	/// @brief Converts the code points of the given @p __input view through the encoding to code units, appending
+	/// them to the end of the given @p __output container.
 	///
 	/// @param[in]     __input An input_view to read code points from and use in the encode operation that will
 	/// produce code units.
 	/// @param[in]     __encoding The encoding that will be used to encode the input's code points into
 	/// output code units.
-	/// @param[in]     __error_handler The error handlers for the from and to encodings,
-	/// respectively.
+	/// @param[in,out] __output The container to append the code units to. Its existing contents, capacity and
+	/// allocator are kept.
+	/// @param[in]     __error_handler The error handler to invoke when an encode operation fails.
 	/// @param[in,out] __state A reference to the associated state for the @p __encoding 's encode step.
 	///
-	/// @result A ztd::text::encode_result object that contains references to @p __state and an output of type @p
-	/// _OutputContainer.
+	/// @result A ztd::text::encode_result object that contains references to @p __state and whose @c ".output" is a
+	/// reference to @p __output.
 	///
-	/// @remarks This function detects creates a container of type @p _OutputContainer and uses a typical @c
-	/// std::back_inserter or @c std::push_back_inserter to fill in elements as it is written to. The result is
-	/// then returned, with the @c .output value put into the container.
+	/// @remarks If the container has a @c ".reserve" function and the input is sized, it is reserved once with its
+	/// current size plus the input's size times ztd::text::max_code_units_v. A container that already has that much
+	/// capacity (for example, one that is cleared and reused across calls) therefore does not allocate at all. To use
+	/// a specific allocator, pass in a container constructed with it.
 	//////
-	template <typename _OutputContainer, typename _Input, typename _Encoding, typename _ErrorHandler, typename _State>
-	constexpr auto encode_to(
-		_Input&& __input, _Encoding&& __encoding, _ErrorHandler&& __error_handler, _State& __state) {
+	template <typename _Input, typename _Encoding, typename _OutputContainer, typename _ErrorHandler, typename _State>
+	constexpr auto encode_append(_Input&& __input, _Encoding&& __encoding, _OutputContainer& __output,
+		_ErrorHandler&& __error_handler, _State& __state) {
 		using _UEncoding            = __detail::__remove_cvref_t<_Encoding>;
 		using _BackInserterIterator = decltype(::std::back_inserter(::std::declval<_OutputContainer&>()));
 		using _Unbounded            = unbounded_view<_BackInserterIterator>;
@@ -353,13 +507,13 @@ namespace ztd { namespace text {
                     ::std::basic_string_view<_InputValueType>, ::ztd::text::span<const _InputValueType>>,
                _UInput>>;
 
-		_OutputContainer __output {};
 		if constexpr (__detail::__is_detected_v<__detail::__detect_adl_size, _Input>) {
 			using _SizeType = decltype(__detail::__adl::__adl_size(__input));
 			if constexpr (__detail::__is_detected_v<__detail::__detect_reserve_with_size_type, _OutputContainer,
 				              _SizeType>) {
 				auto __output_size_hint = __detail::__adl::__adl_size(__input);
-				__output_size_hint *= max_code_points_v<_UEncoding>;
+				__output_size_hint *= max_code_units_v<_UEncoding>;
+				__output_size_hint += static_cast<_SizeType>(__detail::__adl::__adl_size(__output));
 				__output.reserve(__output_size_hint);
 			}
 		}
@@ -370,16 +524,115 @@ namespace ztd { namespace text {
 			auto __stateful_result
 				= encode_into(::std::forward<_Input>(__input), ::std::forward<_Encoding>(__encoding),
 				     ::std::move(__insert_view), ::std::forward<_ErrorHandler>(__error_handler), __state);
-			return __detail::__replace_result_output(::std::move(__stateful_result), ::std::move(__output));
+			return __detail::__replace_result_output(::std::move(__stateful_result), __output);
 		}
 		else {
 			auto __stateful_result = __detail::__intermediate_encode_to_storage(::std::forward<_Input>(__input),
 				::std::forward<_Encoding>(__encoding), __output, ::std::forward<_ErrorHandler>(__error_handler),
 				__state);
-			return __detail::__replace_result_output(::std::move(__stateful_result), ::std::move(__output));
+			return __detail::__replace_result_output(::std::move(__stateful_result), __output);
 		}
 	}
 
+	//////
+	/// @brief Converts the code points of the given @p __input view through the encoding to code units, appending
+	/// them to the end of the given @p __output container.
+	///
+	/// @param[in]     __input An input_view to read code points from and use in the encode operation that will
+	/// produce code units.
+	/// @param[in]     __encoding The encoding that will be used to encode the input's code points into
+	/// output code units.
+	/// @param[in,out] __output The container to append the code units to.
+	/// @param[in]     __error_handler The error handler to invoke when an encode operation fails.
+	///
+	/// @result A ztd::text::stateless_encode_result object whose @c ".output" is a reference to @p __output.
+	///
+	/// @remarks This function creates a @c state using ztd::text::make_encode_state.
+	//////
+	template <typename _Input, typename _Encoding, typename _OutputContainer, typename _ErrorHandler>
+	constexpr auto encode_append(
+		_Input&& __input, _Encoding&& __encoding, _OutputContainer& __output, _ErrorHandler&& __error_handler) {
+		using _UEncoding = __detail::__remove_cvref_t<_Encoding>;
+		using _State     = encode_state_t<_UEncoding>;
+
+		_State __state = make_encode_state(__encoding);
+
+		return __detail::__slice_to_stateless(encode_append(::std::forward<_Input>(__input),
+			::std::forward<_Encoding>(__encoding), __output, ::std::forward<_ErrorHandler>(__error_handler),
+			__state));
+	}
+
+	//////
+	/// @brief Converts the code points of the given @p __input view through the encoding to code units, appending
+	/// them to the end of the given @p __output container.
+	///
+	/// @param[in]     __input An input_view to read code points from and use in the encode operation that will
+	/// produce code units.
+	/// @param[in]     __encoding The encoding that will be used to encode the input's code points into
+	/// output code units.
+	/// @param[in,out] __output The container to append the code units to.
+	///
+	/// @result A ztd::text::stateless_encode_result object whose @c ".output" is a reference to @p __output.
+	///
+	/// @remarks This function creates a @c handler using ztd::text::default_handler, but marks it as careless.
+	//////
+	template <typename _Input, typename _Encoding, typename _OutputContainer>
+	constexpr auto encode_append(_Input&& __input, _Encoding&& __encoding, _OutputContainer& __output) {
+		__detail::__careless_handler __handler {};
+		return encode_append(
+			::std::forward<_Input>(__input), ::std::forward<_Encoding>(__encoding), __output, __handler);
+	}
+
+	//////
+	/// @brief Converts the code points of the given @p __input view through the encoding to code units, appending
+	/// them to the end of the given @p __output container.
+	///
+	/// @param[in]     __input An input_view to read code points from and use in the encode operation that will
+	/// produce code units.
+	/// @param[in,out] __output The container to append the code units to.
+	///
+	/// @result A ztd::text::stateless_encode_result object whose @c ".output" is a reference to @p __output.
+	///
+	/// @remarks This function creates an @c encoding by using the @c value_type of the @p __input which is then passed
+	/// through the ztd::text::default_code_point_encoding type to get the default desired encoding.
+	//////
+	template <typename _Input, typename _OutputContainer>
+	constexpr auto encode_append(_Input&& __input, _OutputContainer& __output) {
+		using _UInput   = __detail::__remove_cvref_t<_Input>;
+		using _Encoding = default_code_point_encoding_t<__detail::__range_value_type_t<_UInput>>;
+		return encode_append(::std::forward<_Input>(__input), _Encoding {}, __output);
+	}
+
+	//////
+	/// @brief Converts the code points of the given @p __input view through the encoding to code units in the
+	/// specified @p _OutputContainer type.
+	///
+	/// @tparam _OutputContainer The container type to serialize data into.
+	///
+	/// @param[in]     __input An input_view to read code points from and use in the encode operation that will
+	/// produce code units.
+	/// @param[in]     __encoding The encoding that will be used to encode the input's code points into
+	/// output code units.
+	/// @param[in]     __error_handler The error handlers for the from and to encodings,
+	/// respectively.
+	/// @param[in,out] __state A reference to the associated state for the @p __encoding 's encode step.
+	///
+	/// @result A ztd::text::encode_result object that contains references to @p __state and an output of type @p
+	/// _OutputContainer.
+	///
+	/// @remarks This function detects creates a container of type @p _OutputContainer and uses a typical @c
+	/// std::back_inserter or @c std::push_back_inserter to fill in elements as it is written to. The result is
+	/// then returned, with the @c .output value put into the container.
+	//////
+	template <typename _OutputContainer, typename _Input, typename _Encoding, typename _ErrorHandler, typename _State>
+	constexpr auto encode_to(
+		_Input&& __input, _Encoding&& __encoding, _ErrorHandler&& __error_handler, _State& __state) {
+		_OutputContainer __output {};
+		auto __stateful_result = encode_append(::std::forward<_Input>(__input), ::std::forward<_Encoding>(__encoding),
+			__output, ::std::forward<_ErrorHandler>(__error_handler), __state);
+		return __detail::__replace_result_output(::std::move(__stateful_result), ::std::move(__output));
+	}
+
 	//////
 	/// @brief Converts the code points of the given @p __input view through the encoding to code units in the
 	/// specified @p _OutputContainer type.
@@ -452,6 +705,104 @@ namespace ztd { namespace text {
 		return encode_to<_OutputContainer>(::std::forward<_Input>(__input), __encoding);
 	}
 
+	//////
+	/// @brief Converts the code points of the given @p __input view through the encoding to code units in the
+	/// specified @p _OutputContainer type, allocating its storage only once and at exactly the right size.
+	///
+	/// @tparam _OutputContainer The container type to serialize data into.
+	///
+	/// @param[in]     __input An input_view to read code points from and use in the encode operation that will
+	/// produce code units.
+	/// @param[in]     __encoding The encoding that will be used to encode the input's code points into
+	/// output code units.
+	/// @param[in]     __error_handler The error handler to invoke when an encode operation fails.
+	/// @param[in,out] __state A reference to the associated state for the @p __encoding 's encode step.
+	///
+	/// @result A ztd::text::encode_result object that contains references to @p __state and an output of type @p
+	/// _OutputContainer, exactly like the one from ztd::text::encode_to.
+	///
+	/// @remarks If @p __input is a sized range that can be read more than once and @p _OutputContainer is a
+	/// contiguous container with a @c resize member function, the input is first encoded into an output that only
+	/// counts the code units (with a copy of @p __state ). The container is then resized once, to the exact count,
+	/// and encoded into directly rather than through a @c std::back_inserter. The counting pass never calls @p
+	/// __error_handler: if it finds an error, or if the input or container do not qualify, this does exactly what
+	/// ztd::text::encode_to does.
+	//////
+	template <typename _OutputContainer, typename _Input, typename _Encoding, typename _ErrorHandler, typename _State>
+	constexpr auto encode_to_exact(
+		_Input&& __input, _Encoding&& __encoding, _ErrorHandler&& __error_handler, _State& __state) {
+		if constexpr (__detail::__is_exact_size_capable_v<_Input,
+			              _OutputContainer> && ::std::is_copy_constructible_v<_State>) {
+			using _CountErrorHandler = __detail::__exact_size_count_handler_t<_ErrorHandler>;
+			using _OutputValueType   = __detail::__range_value_type_t<_OutputContainer>;
+
+			_State __count_state = __state;
+			_CountErrorHandler __count_error_handler {};
+			auto __count_result = encode_into(__input, __encoding,
+				unbounded_view<__detail::__counting_iterator>(__detail::__counting_iterator {}),
+				__count_error_handler, __count_state);
+			if (__count_result.error_code == encoding_error::ok && !__count_result.handled_error) {
+				const ::std::size_t __count = __detail::__adl::__adl_begin(__count_result.output).count();
+				_OutputContainer __output {};
+				__output.resize(__count);
+				::ztd::text::span<_OutputValueType> __output_view(__detail::__adl::__adl_data(__output), __count);
+				auto __stateful_result
+					= encode_into(::std::forward<_Input>(__input), ::std::forward<_Encoding>(__encoding),
+					     __output_view, ::std::forward<_ErrorHandler>(__error_handler), __state);
+				return __detail::__replace_result_output(::std::move(__stateful_result), ::std::move(__output));
+			}
+		}
+		return encode_to<_OutputContainer>(::std::forward<_Input>(__input), ::std::forward<_Encoding>(__encoding),
+			::std::forward<_ErrorHandler>(__error_handler), __state);
+	}
+
+	//////
+	/// @brief Converts the code points of the given @p __input view through the encoding to code units in the
+	/// specified @p _OutputContainer type, allocating its storage only once and at exactly the right size.
+	///
+	/// @tparam _OutputContainer The container type to serialize data into.
+	///
+	/// @param[in]     __input An input_view to read code points from and use in the encode operation that will
+	/// produce code units.
+	/// @param[in]     __encoding The encoding that will be used to encode the input's code points into
+	/// output code units.
+	/// @param[in]     __error_handler The error handler to invoke when an encode operation fails.
+	///
+	/// @result A ztd::text::stateless_encode_result object whose output is of type @p _OutputContainer.
+	///
+	/// @remarks This function creates a @c state using ztd::text::make_encode_state.
+	//////
+	template <typename _OutputContainer, typename _Input, typename _Encoding, typename _ErrorHandler>
+	constexpr auto encode_to_exact(_Input&& __input, _Encoding&& __encoding, _ErrorHandler&& __error_handler) {
+		using _UEncoding = __detail::__remove_cvref_t<_Encoding>;
+		using _State     = encode_state_t<_UEncoding>;
+		_State __state   = make_encode_state(__encoding);
+		return encode_to_exact<_OutputContainer>(::std::forward<_Input>(__input),
+			::std::forward<_Encoding>(__encoding), ::std::forward<_ErrorHandler>(__error_handler), __state);
+	}
+
+	//////
+	/// @brief Converts the code points of the given @p __input view through the encoding to code units in the
+	/// specified @p _OutputContainer type, allocating its storage only once and at exactly the right size.
+	///
+	/// @tparam _OutputContainer The container type to serialize data into.
+	///
+	/// @param[in]     __input An input_view to read code points from and use in the encode operation that will
+	/// produce code units.
+	/// @param[in]     __encoding The encoding that will be used to encode the input's code points into
+	/// output code units.
+	///
+	/// @result A ztd::text::stateless_encode_result object whose output is of type @p _OutputContainer.
+	///
+	/// @remarks This function creates a @c handler using ztd::text::default_handler, but marks it as careless.
+	//////
+	template <typename _OutputContainer, typename _Input, typename _Encoding>
+	constexpr auto encode_to_exact(_Input&& __input, _Encoding&& __encoding) {
+		__detail::__careless_handler __handler {};
+		return encode_to_exact<_OutputContainer>(
+			::std::forward<_Input>(__input), ::std::forward<_Encoding>(__encoding), __handler);
+	}
+
 	//////
 	/// @brief Converts the code points of the given @p __input view through the encoding to code units in the
 	/// specified @p _OutputContainer type.
@@ -489,7 +840,7 @@ namespace ztd { namespace text {
 			if constexpr (__detail::__is_detected_v<__detail::__detect_reserve_with_size_type, _OutputContainer,
 				              _SizeType>) {
 				auto __output_size_hint = __detail::__adl::__adl_size(__input);
-				__output_size_hint *= max_code_points_v<_UEncoding>;
+				__output_size_hint *= max_code_units_v<_UEncoding>;
 				__output.reserve(__output_size_hint);
 			}
 		}
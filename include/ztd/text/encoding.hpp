@@ -35,7 +35,9 @@
 
 #include <ztd/text/execution.hpp>
 #include <ztd/text/wide_execution.hpp>
+#include <ztd/text/locale_execution.hpp>
 #include <ztd/text/ascii.hpp>
+#include <ztd/text/single_byte_encoding.hpp>
 #include <ztd/text/utf8.hpp>
 #include <ztd/text/utf16.hpp>
 #include <ztd/text/utf32.hpp>
@@ -43,6 +45,7 @@
 #include <ztd/text/literal.hpp>
 #include <ztd/text/wide_literal.hpp>
 #include <ztd/text/any_encoding.hpp>
+#include <ztd/text/iconv_encoding.hpp>
 
 namespace ztd { namespace text {
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
@@ -43,6 +43,7 @@
 #include <ztd/text/is_ignorable_error_handler.hpp>
 #include <ztd/text/is_bidirectional_encoding.hpp>
 #include <ztd/text/is_full_range_representable.hpp>
+#include <ztd/text/is_self_synchronizing_code.hpp>
 #include <ztd/text/is_unicode_encoding.hpp>
 #include <ztd/text/subrange.hpp>
 #include <ztd/text/encode_result.hpp>
@@ -338,6 +339,14 @@ namespace ztd { namespace text {
 		//////
 		using is_decode_injective = ::std::integral_constant<bool, is_decode_injective_v<_UBaseEncoding>>;
 		//////
+		/// @brief Whether or not a code point boundary can be found from anywhere in the middle of the input.
+		///
+		/// @remarks Only when the underlying @c encoding_type is self-synchronizing and its code units are single
+		/// bytes already: otherwise, a sequence of bytes can be started from the wrong byte of a code unit.
+		//////
+		using is_self_synchronizing_code = ::std::integral_constant<bool,
+			is_self_synchronizing_code_v<_UBaseEncoding> && sizeof(code_unit_t<_UBaseEncoding>) == sizeof(_Byte)>;
+		//////
 		/// @brief The maximum number of code points a single complete operation of decoding can produce. This is
 		/// 1 for all Unicode Transformation Format (UTF) encodings.
 		//////
@@ -466,6 +475,13 @@ namespace ztd { namespace text {
 		}
 	};
 
+	namespace __detail {
+		// a scheme only splits up (or puts together) the code units of the encoding it wraps
+		template <typename _Encoding, endian _Endian, typename _Byte>
+		class __is_library_encoding<encoding_scheme<_Encoding, _Endian, _Byte>>
+		: public __is_library_encoding<__remove_cvref_t<__unwrap_t<_Encoding>>> { };
+	} // namespace __detail
+
 	//////
 	/// @brief A UTF-16 encoding, in Little Endian format, with inputs as a sequence of bytes.
 	///
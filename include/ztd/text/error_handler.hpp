@@ -172,7 +172,9 @@ namespace ztd { namespace text {
 	///
 	/// @remarks This error handler is useful in conjunction with a ztd::text::unbounded_view for the fastest possible
 	/// encoding and decoding in a general sense. However: IT IS ALSO EXTREMELY DANGEROUS AND CAN INVOKE UNDEFINED
-	/// BEHAVIOR IF YOUR TEXT IS, IN FACT, MESSED UP. PLEASE DO NOT USE THIS WITHOUT A GOOD REASON!
+	/// BEHAVIOR IF YOUR TEXT IS, IN FACT, MESSED UP. PLEASE DO NOT USE THIS WITHOUT A GOOD REASON! Only the
+	/// validity checks are skipped: running out of room in the output is still reported as
+	/// ztd::text::encoding_error::insufficient_output_space.
 	//////
 	class assume_valid_handler : public __detail::__pass_through_handler_with<true> { };
 
@@ -52,14 +52,34 @@
 #include <ztd/text/detail/posix.hpp>
 #include <ztd/text/detail/assert.hpp>
 #include <ztd/text/detail/encoding_name.hpp>
+#include <ztd/text/detail/bulk_execution.hpp>
+#include <ztd/text/detail/execution_snapshot.hpp>
+#include <ztd/text/detail/bulk_transcode.hpp>
 
 #include <cuchar>
 #include <cwchar>
 #include <cstdint>
+#include <memory>
 
 namespace ztd { namespace text {
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
 
+	//////
+	/// @brief Detects the encoding of the current C locale again, for ztd::text::execution and
+	/// ztd::text::wide_execution.
+	///
+	/// @remarks The encoding is detected once, the first time it is needed, and kept from then on. Call this after
+	/// changing @c LC_CTYPE with @c setlocale, before converting text with the new locale. It is safe to call from any
+	/// thread, but conversions already running on other threads may still use what was detected before.
+	///
+	/// @remarks Bulk conversions check the kept encoding against the calling thread's locale (including one set with
+	/// @c uselocale) before using it, and convert one code point at a time when the two differ. Their results never
+	/// depend on whether this was called; calling it only brings back the faster paths.
+	//////
+	inline void refresh_execution_encoding() noexcept {
+		__detail::__refresh_execution_snapshot();
+	}
+
 	//////
 	/// @addtogroup ztd_text_encodings Encodings
 	/// @{
@@ -73,6 +93,10 @@ namespace ztd { namespace text {
 	/// Supplementary Character Set (Big5-HKSCS)) are broken when accessed without @c ZTD_TEXT_USE_CUNEICODE is not
 	/// defined, due to fundamental design issues in the C Standard Library and bugs in glibc/musl libc's current
 	/// locale encoding support.
+	///
+	/// @remarks Which encoding the locale uses is detected the first time it is needed and then kept, so that hot
+	/// paths do not ask the C library over and over. If @c LC_CTYPE is changed with @c setlocale after that, call
+	/// ztd::text::refresh_execution_encoding.
 	//////
 	class execution {
 	private:
@@ -83,11 +107,9 @@ namespace ztd { namespace text {
 			unsigned char __padding_please_stop_warning_me_about_this_complete_nonsense_msvc
 				[sizeof(::std::mbstate_t) - sizeof(bool) < 1 ? 1 : sizeof(::std::mbstate_t) - sizeof(bool)];
 
+			// a zero-valued std::mbstate_t is already the initial conversion state, so there is no need to prime
+			// it with a conversion
 			__decode_state() noexcept : __narrow_state(), __output_pending(false) {
-				char32_t __ghost_space[2];
-				::std::size_t __init_result = ::std::mbrtoc32(__ghost_space, "\0", 1, &__narrow_state);
-				// make sure it is initialized
-				ZTD_TEXT_ASSERT_I_(__init_result == 0 && __ghost_space[0] == U'\0');
 				ZTD_TEXT_ASSERT_I_(::std::mbsinit(&__narrow_state) != 0);
 			}
 		};
@@ -100,10 +122,6 @@ namespace ztd { namespace text {
 				[sizeof(::std::mbstate_t) - sizeof(bool) < 1 ? 1 : sizeof(::std::mbstate_t) - sizeof(bool)];
 
 			__encode_state() noexcept : __narrow_state(), __output_pending(false) {
-				char __ghost_space[MB_LEN_MAX];
-				::std::size_t __init_result = ::std::c32rtomb(__ghost_space, U'\0', &__narrow_state);
-				// make sure it is initialized
-				ZTD_TEXT_ASSERT_I_(__init_result == 1 && __ghost_space[0] == '\0');
 				ZTD_TEXT_ASSERT_I_(::std::mbsinit(&__narrow_state) != 0);
 			}
 		};
@@ -184,19 +202,11 @@ namespace ztd { namespace text {
 		///
 		/// @remarks This function operates at runtime and queries the existing locale through a variety of
 		/// platform-specific means (such as @c nl_langinfo for POSIX, ACP probing on Windows, or fallin back to @c
-		/// std::setlocale name checking otherwise).
+		/// std::setlocale name checking otherwise). The answer is kept from the first query until
+		/// ztd::text::refresh_execution_encoding is called.
 		//////
 		static bool contains_unicode_encoding() noexcept {
-#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
-			int __codepage_id = __detail::__windows::__determine_active_code_page();
-			return __detail::__windows::__is_unicode_code_page(__codepage_id);
-#elif ZTD_TEXT_IS_ON(ZTD_TEXT_NL_LANGINFO_I_) || ZTD_TEXT_IS_ON(ZTD_TEXT_LANGINFO_I_)
-			const char* __ctype_name = nl_langinfo(CODESET);
-			return __detail::__is_unicode_encoding_name(__ctype_name);
-#else
-				const char* __ctype_name = setlocale(LC_CTYPE, nullptr);
-				return __detail::__is_encoding_name_unicode(__ctype_name);
-#endif
+			return __detail::__current_execution_snapshot().__is_unicode;
 		}
 
 		//////
@@ -233,7 +243,7 @@ namespace ztd { namespace text {
 			constexpr bool __call_error_handler = !is_ignorable_error_handler_v<_UErrorHandler>;
 
 #if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
-			if (__detail::__windows::__determine_active_code_page() == CP_UTF8) {
+			if (__detail::__current_execution_snapshot().__is_utf8) {
 				// just go straight to UTF8
 				using __exec_utf8 = __impl::__utf8_with<void, code_unit, code_point>;
 				__exec_utf8 __u8enc {};
@@ -261,13 +271,11 @@ namespace ztd { namespace text {
 			auto __outit   = __detail::__adl::__adl_begin(__output);
 			auto __outlast = __detail::__adl::__adl_end(__output);
 
-			if constexpr (__call_error_handler) {
-				if (__outit == __outlast) {
-					return __error_handler(execution {},
-						_Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
-						     encoding_error::insufficient_output_space),
-						::ztd::text::span<code_point, 0>());
-				}
+			if (__outit == __outlast) {
+				return __error_handler(execution {},
+					_Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
+					     encoding_error::insufficient_output_space),
+					::ztd::text::span<code_point, 0>());
 			}
 
 			using __u16e               = __impl::__utf16_with<void, wchar_t, code_point, false>;
@@ -313,19 +321,17 @@ namespace ztd { namespace text {
 				}
 			}
 			for (auto __intermediary_it = __intermediary_output; __res-- > 0;) {
-				if constexpr (__call_error_handler) {
-					if (__outit == __outlast) {
-						execution __self {};
-						return __error_handler(__self,
-							_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>,
-							             __detail::__adl::__adl_begin(__intermediate_result.input),
-							             __detail::__adl::__adl_end(__intermediate_result.input)),
-							     __detail::__reconstruct(
-							          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-							     __s, encoding_error::insufficient_output_space),
-							::ztd::text::span<code_point>(__intermediate_handler._M_code_points.data(),
-							     __intermediate_handler._M_code_points_size));
-					}
+				if (__outit == __outlast) {
+					execution __self {};
+					return __error_handler(__self,
+						_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>,
+						             __detail::__adl::__adl_begin(__intermediate_result.input),
+						             __detail::__adl::__adl_end(__intermediate_result.input)),
+						     __detail::__reconstruct(
+						          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
+						     __s, encoding_error::insufficient_output_space),
+						::ztd::text::span<code_point>(__intermediate_handler._M_code_points.data(),
+						     __intermediate_handler._M_code_points_size));
 				}
 				__detail::__dereference(__outit) = __detail::__dereference(__intermediary_it);
 				__outit                          = __detail::__next(__outit);
@@ -347,14 +353,12 @@ namespace ztd { namespace text {
 			auto __outit   = __detail::__adl::__adl_begin(__output);
 			auto __outlast = __detail::__adl::__adl_end(__output);
 
-			if constexpr (__call_error_handler) {
-				if (__outit == __outlast) {
-					execution __self {};
-					return __error_handler(__self,
-						_Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
-						     encoding_error::insufficient_output_space),
-						::ztd::text::span<code_point, 0>());
-				}
+			if (__outit == __outlast) {
+				execution __self {};
+				return __error_handler(__self,
+					_Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
+					     encoding_error::insufficient_output_space),
+					::ztd::text::span<code_point, 0>());
 			}
 
 			code_point __codepoint = __detail::__dereference(__init);
@@ -374,17 +378,15 @@ namespace ztd { namespace text {
 			}
 
 			for (auto __intermediary_it = __intermediary_output; __res-- > 0; ++__intermediary_it) {
-				if constexpr (__call_error_handler) {
-					if (__outit == __outlast) {
-						execution __self {};
-						return __error_handler(__self,
-							_Result(
-							     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-							     __detail::__reconstruct(
-							          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-							     __s, encoding_error::insufficient_output_space),
-							::ztd::text::span<code_point, 1>(&__codepoint, 1));
-					}
+				if (__outit == __outlast) {
+					execution __self {};
+					return __error_handler(__self,
+						_Result(
+						     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+						     __detail::__reconstruct(
+						          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
+						     __s, encoding_error::insufficient_output_space),
+						::ztd::text::span<code_point, 1>(&__codepoint, 1));
 				}
 				__detail::__dereference(__outit) = __detail::__dereference(__intermediary_it);
 				__outit                          = __detail::__next(__outit);
@@ -430,7 +432,7 @@ namespace ztd { namespace text {
 			constexpr bool __call_error_handler = !is_ignorable_error_handler_v<_UErrorHandler>;
 
 #if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_WINDOWS_I_)
-			if (__detail::__windows::__determine_active_code_page() == CP_UTF8) {
+			if (__detail::__current_execution_snapshot().__is_utf8) {
 				// just use utf8 directly
 				// just go straight to UTF8
 				using __char_utf8 = __impl::__utf8_with<void, code_unit, code_point>;
@@ -467,14 +469,12 @@ namespace ztd { namespace text {
 			auto __outit   = __detail::__adl::__adl_begin(__output);
 			auto __outlast = __detail::__adl::__adl_end(__output);
 
-			if constexpr (__call_error_handler) {
-				if (__outit == __outlast) {
-					execution __self {};
-					return __error_handler(__self,
-						_Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
-						     encoding_error::insufficient_output_space),
-						::ztd::text::span<code_unit, 0>());
-				}
+			if (__outit == __outlast) {
+				execution __self {};
+				return __error_handler(__self,
+					_Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
+					     encoding_error::insufficient_output_space),
+					::ztd::text::span<code_unit, 0>());
 			}
 
 			code_unit __intermediary_input[max_code_units] {};
@@ -651,13 +651,67 @@ namespace ztd { namespace text {
 			else {
 				// ... I mean.
 				// You asked for it???
-				_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+				return _Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
 					__detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast), __s,
 					encoding_error::ok);
 			}
 		}
 	};
 
+	namespace __detail {
+		template <>
+		class __is_library_encoding<execution> : public ::std::true_type { };
+	} // namespace __detail
+
+	//////
+	/// @brief Decodes a contiguous range of execution encoding code units in bulk, rather than one code point at a
+	/// time.
+	///
+	/// @remarks This is found by ztd::text::decode_into through argument-dependent lookup, for contiguous outputs and
+	/// ztd::text::unbounded_view outputs. The kernel is picked from the kept snapshot of the locale's encoding (see
+	/// ztd::text::refresh_execution_encoding), rather than for every code point, and only if the snapshot was taken
+	/// for the encoding the calling thread's locale uses right now; otherwise no kernel runs and every code point goes
+	/// through ztd::text::execution::decode_one. A UTF-8 locale is decoded with the UTF-8 kernels, and on POSIX (where
+	/// @c wchar_t holds code points) any other locale without shift states is decoded a buffer at a time with @c
+	/// mbsnrtowcs. Errors, truncated input and whatever does not fit still go through
+	/// ztd::text::execution::decode_one, so the results and error handler calls are the same as with the plain loop.
+	//////
+	template <typename _Input, typename _Output, typename _ErrorHandler,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<execution::code_point, 4>
+		     && __detail::__is_bulk_transcodable_v<_Input, 1, _Output, execution::code_point>>* = nullptr>
+	auto __text_decode(_Input&& __input, const execution& __encoding, _Output&& __output,
+		_ErrorHandler&& __error_handler, execution::decode_state& __state) {
+		using _Kernel = __detail::__execution_decode_kernel<execution::decode_state,
+			is_ignorable_error_handler_v<__detail::__remove_cvref_t<_ErrorHandler>>>;
+		// __bulk_decode and __bulk_encode only run the kernel at run time
+		const __detail::__execution_bulk_kind __kind = __detail::__current_execution_bulk_snapshot().__bulk_kind;
+		return __detail::__bulk_decode<execution::code_point>(::std::forward<_Input>(__input), __encoding,
+			::std::forward<_Output>(__output), __error_handler, __state,
+			_Kernel { __kind, ::std::addressof(__state) });
+	}
+
+	//////
+	/// @brief Encodes a contiguous range of code points to the execution encoding in bulk, rather than one code point
+	/// at a time.
+	///
+	/// @remarks This is found by ztd::text::encode_into through argument-dependent lookup. As with the decoding
+	/// counterpart, the kernel is picked once: a UTF-8 locale is encoded with the UTF-8 kernels, and on POSIX any
+	/// other locale without shift states is encoded a buffer at a time with @c wcsnrtombs. Code points that cannot be
+	/// represented, and whatever does not fit, still go through ztd::text::execution::encode_one.
+	//////
+	template <typename _Input, typename _Output, typename _ErrorHandler,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<execution::code_point, 4>
+		     && __detail::__is_bulk_transcodable_v<_Input, 4, _Output, execution::code_unit>>* = nullptr>
+	auto __text_encode(_Input&& __input, const execution& __encoding, _Output&& __output,
+		_ErrorHandler&& __error_handler, execution::encode_state& __state) {
+		using _Kernel = __detail::__execution_encode_kernel<execution::encode_state>;
+		// __bulk_decode and __bulk_encode only run the kernel at run time
+		const __detail::__execution_bulk_kind __kind = __detail::__current_execution_bulk_snapshot().__bulk_kind;
+		return __detail::__bulk_encode<execution::code_unit>(::std::forward<_Input>(__input), __encoding,
+			::std::forward<_Output>(__output), __error_handler, __state,
+			_Kernel { __kind, ::std::addressof(__state) });
+	}
+
 	//////
 	/// @}
 	//////
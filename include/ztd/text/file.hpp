@@ -0,0 +1,450 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_FILE_HPP
+#define ZTD_TEXT_FILE_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/code_point.hpp>
+#include <ztd/text/code_unit.hpp>
+#include <ztd/text/count_code_points.hpp>
+#include <ztd/text/encode.hpp>
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/error_handler.hpp>
+#include <ztd/text/is_unicode_encoding.hpp>
+#include <ztd/text/state.hpp>
+#include <ztd/text/subrange.hpp>
+#include <ztd/text/transcode.hpp>
+#include <ztd/text/validate_code_units.hpp>
+
+#include <ztd/text/detail/adl.hpp>
+#include <ztd/text/detail/is_lossless.hpp>
+#include <ztd/text/detail/mapped_file.hpp>
+#include <ztd/text/detail/span.hpp>
+#include <ztd/text/detail/tracking_handler.hpp>
+#include <ztd/text/detail/type_traits.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		// bytes of output that are converted before being written out in one go
+		inline constexpr ::std::size_t __file_block_size = static_cast<::std::size_t>(1) << 18;
+
+		template <typename _CodeUnit>
+		::ztd::text::span<const _CodeUnit> __mapped_code_units(const __mapped_file& __file) noexcept {
+			// a mapping always starts on a page boundary, which is aligned well enough for any code unit type
+			return ::ztd::text::span<const _CodeUnit>(
+				reinterpret_cast<const _CodeUnit*>(__file.data()), __file.size() / sizeof(_CodeUnit));
+		}
+
+		template <typename _Encoding>
+		::std::size_t __byte_order_mark_size(
+			::ztd::text::span<const code_unit_t<_Encoding>> __input, _Encoding& __encoding) {
+			if constexpr (is_unicode_encoding_v<_Encoding>) {
+				using _CodeUnit                       = code_unit_t<_Encoding>;
+				using _CodePoint                      = code_point_t<_Encoding>;
+				constexpr ::std::size_t _MaxCodeUnits = max_code_units_v<_Encoding>;
+				const _CodePoint __byte_order_mark[1] = { static_cast<_CodePoint>(0xFEFF) };
+				_CodeUnit __byte_order_mark_units[_MaxCodeUnits] {};
+				encode_state_t<_Encoding> __state = make_encode_state(__encoding);
+				auto __result = encode_into(::ztd::text::span<const _CodePoint>(__byte_order_mark), __encoding,
+					subrange<_CodeUnit*>(__byte_order_mark_units, __byte_order_mark_units + _MaxCodeUnits),
+					pass_handler {}, __state);
+				if (__result.error_code != encoding_error::ok) {
+					return 0;
+				}
+				const ::std::size_t __size = _MaxCodeUnits - __adl::__adl_size(__result.output);
+				if (__input.size() < __size) {
+					return 0;
+				}
+				for (::std::size_t __index = 0; __index < __size; ++__index) {
+					if (__input[__index] != __byte_order_mark_units[__index]) {
+						return 0;
+					}
+				}
+				return __size;
+			}
+			else {
+				(void)__input;
+				(void)__encoding;
+				return 0;
+			}
+		}
+
+	} // namespace __detail
+
+	//////
+	/// @addtogroup ztd_text_file ztd::text::transcode_file, ztd::text::validate_file, and ztd::text::count_file
+	/// @brief These functions work on files directly. The source file is mapped into memory rather than read into
+	/// a container, and the output is converted in bounded blocks that are written out as they fill up, so the
+	/// memory used stays small no matter how large the files are.
+	///
+	/// @remarks The source file's bytes are looked at as the code units of the encoding, in the machine's byte
+	/// order (use a ztd::text::encoding_scheme for a fixed byte order). A byte order mark at the very start of the
+	/// source, as the encoding would write U+FEFF, is skipped; none is written to the output. Bytes left over at the
+	/// end that do not make up a whole code unit are reported as ztd::text::encoding_error::incomplete_sequence
+	/// without invoking any error handler.
+	/// @{
+	//////
+
+	//////
+	/// @brief The result of ztd::text::transcode_file.
+	///
+	//////
+	class file_transcode_result {
+	public:
+		//////
+		/// @brief The number of code units read from the source file, including a skipped byte order mark.
+		///
+		//////
+		::std::size_t code_units_read;
+		//////
+		/// @brief The number of code units written to the destination file.
+		///
+		//////
+		::std::size_t code_units_written;
+		//////
+		/// @brief The kind of encoding error that occured, if any.
+		///
+		//////
+		encoding_error error_code;
+		//////
+		/// @brief Whether or not an error handler was invoked.
+		///
+		//////
+		bool handled_error;
+		//////
+		/// @brief The error from opening, mapping, or writing the files, if any.
+		///
+		//////
+		::std::error_code file_error;
+	};
+
+	//////
+	/// @brief The result of ztd::text::validate_file.
+	///
+	//////
+	class file_validate_result {
+	public:
+		//////
+		/// @brief The number of code units of the source file that were found to be valid, including a skipped byte
+		/// order mark.
+		//////
+		::std::size_t code_units_read;
+		//////
+		/// @brief Whether or not the whole file is valid.
+		///
+		//////
+		bool valid;
+		//////
+		/// @brief The error from opening or mapping the file, if any.
+		///
+		//////
+		::std::error_code file_error;
+
+		//////
+		/// @brief A conversion for use in if statements and conditional operators.
+		///
+		//////
+		constexpr explicit operator bool() const noexcept {
+			return valid && !file_error;
+		}
+	};
+
+	//////
+	/// @brief The result of ztd::text::count_file.
+	///
+	//////
+	class file_count_result {
+	public:
+		//////
+		/// @brief The number of code points in the source file, not counting a skipped byte order mark.
+		///
+		//////
+		::std::size_t count;
+		//////
+		/// @brief The number of code units read from the source file, including a skipped byte order mark.
+		///
+		//////
+		::std::size_t code_units_read;
+		//////
+		/// @brief The kind of encoding error that occured, if any.
+		///
+		//////
+		encoding_error error_code;
+		//////
+		/// @brief Whether or not an error handler was invoked.
+		///
+		//////
+		bool handled_error;
+		//////
+		/// @brief The error from opening or mapping the file, if any.
+		///
+		//////
+		::std::error_code file_error;
+	};
+
+	//////
+	/// @brief Converts the contents of the file at @p __source_path from @p __from_encoding to @p __to_encoding ,
+	/// and writes them to the file at @p __destination_path .
+	///
+	/// @param[in] __source_path The file to read code units from.
+	/// @param[in] __from_encoding The encoding of the source file.
+	/// @param[in] __destination_path The file to write code units to. It is created or truncated.
+	/// @param[in] __to_encoding The encoding to write the destination file in.
+	/// @param[in] __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	/// @param[in] __to_error_handler The error handler for the @p __to_encoding 's encode step.
+	///
+	/// @remarks The conversion is done with ztd::text::transcode_into, a block of output at a time. It stops at the
+	/// first error that the error handlers do not recover from; whatever was converted before that point is still
+	/// written to the destination file. Filling up a block of output is not an error: the error handlers are never
+	/// called for it.
+	//////
+	template <typename _FromEncoding, typename _ToEncoding, typename _FromErrorHandler, typename _ToErrorHandler>
+	file_transcode_result transcode_file(const ::std::filesystem::path& __source_path, _FromEncoding&& __from_encoding,
+		const ::std::filesystem::path& __destination_path, _ToEncoding&& __to_encoding,
+		_FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler) {
+		using _UFromEncoding   = __detail::__remove_cvref_t<_FromEncoding>;
+		using _UToEncoding     = __detail::__remove_cvref_t<_ToEncoding>;
+		using _InputCodeUnit   = code_unit_t<_UFromEncoding>;
+		using _OutputCodeUnit  = code_unit_t<_UToEncoding>;
+		using _OutputBlockView = subrange<_OutputCodeUnit*>;
+		using _FromTracker     = __detail::__tracking_handler<::std::remove_reference_t<_FromErrorHandler>>;
+		// the block loop counts on insufficient_output_space, so the encoding side always checks its output, and
+		// never passes that on to the caller's error handler
+		using _ToTracker = __detail::__preflight_handler<::std::remove_reference_t<_ToErrorHandler>, false>;
+		constexpr ::std::size_t _BlockSize
+			= (::std::max)(__detail::__file_block_size / sizeof(_OutputCodeUnit), max_code_units_v<_UToEncoding>);
+
+		static_assert(__detail::__is_decode_lossless_or_deliberate_v<_UFromEncoding,
+			              __detail::__remove_cvref_t<_FromErrorHandler>>,
+			"The decode (input) portion of this transcode is a lossy, non-injective operation. This means you may "
+			"lose data that you did not intend to lose; specify an 'in_handler' error handler parameter to "
+			"transcode_file(in_path, in_encoding, out_path, out_encoding, in_handler, ...) explicitly in order to "
+			"bypass this.");
+		static_assert(__detail::__is_encode_lossless_or_deliberate_v<_UToEncoding,
+			              __detail::__remove_cvref_t<_ToErrorHandler>>,
+			"The encode (output) portion of this transcode is a lossy, non-injective operation. This means you may "
+			"lose data that you did not intend to lose; specify an 'out_handler' error handler parameter to "
+			"transcode_file(in_path, in_encoding, out_path, out_encoding, in_handler, out_handler) explicitly in "
+			"order to bypass this.");
+
+		file_transcode_result __result { 0, 0, encoding_error::ok, false, ::std::error_code() };
+		__detail::__mapped_file __source;
+		__result.file_error = __source.open(__source_path);
+		if (__result.file_error) {
+			return __result;
+		}
+		__detail::__output_file __destination;
+		__result.file_error = __destination.open(__destination_path);
+		if (__result.file_error) {
+			return __result;
+		}
+
+		::ztd::text::span<const _InputCodeUnit> __all_input
+			= __detail::__mapped_code_units<_InputCodeUnit>(__source);
+		::ztd::text::span<const _InputCodeUnit> __input
+			= __all_input.subspan(__detail::__byte_order_mark_size(__all_input, __from_encoding));
+		decode_state_t<_UFromEncoding> __from_state = make_decode_state(__from_encoding);
+		encode_state_t<_UToEncoding> __to_state     = make_encode_state(__to_encoding);
+		// the block loop stops every time the output fills up, so which errors were handled is noted down here
+		_FromTracker __from_tracker { ::std::addressof(__from_error_handler),
+			::std::addressof(__result.handled_error) };
+		_ToTracker __to_tracker { ::std::addressof(__to_error_handler), ::std::addressof(__result.handled_error) };
+		::std::vector<_OutputCodeUnit> __block(_BlockSize);
+		for (;;) {
+			auto __block_result = transcode_into(__input, __from_encoding,
+				_OutputBlockView(__block.data(), __block.data() + __block.size()), __to_encoding,
+				__from_tracker, __to_tracker, __from_state, __to_state);
+			const ::std::size_t __written = __block.size() - __detail::__adl::__adl_size(__block_result.output);
+			__result.file_error = __destination.write(__block.data(), __written * sizeof(_OutputCodeUnit));
+			if (__result.file_error) {
+				break;
+			}
+			__result.code_units_written += __written;
+			__input = ::ztd::text::span<const _InputCodeUnit>(__block_result.input);
+			if (__block_result.error_code != encoding_error::insufficient_output_space) {
+				__result.error_code = __block_result.error_code;
+				break;
+			}
+		}
+		__result.code_units_read = __all_input.size() - __input.size();
+		if (__result.error_code == encoding_error::ok && (__source.size() % sizeof(_InputCodeUnit)) != 0) {
+			__result.error_code = encoding_error::incomplete_sequence;
+		}
+		::std::error_code __close_error = __destination.close();
+		if (!__result.file_error) {
+			__result.file_error = __close_error;
+		}
+		return __result;
+	}
+
+	//////
+	/// @brief Converts the contents of the file at @p __source_path from @p __from_encoding to @p __to_encoding ,
+	/// and writes them to the file at @p __destination_path .
+	///
+	/// @param[in] __source_path The file to read code units from.
+	/// @param[in] __from_encoding The encoding of the source file.
+	/// @param[in] __destination_path The file to write code units to. It is created or truncated.
+	/// @param[in] __to_encoding The encoding to write the destination file in.
+	/// @param[in] __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	///
+	/// @remarks Calls ztd::text::transcode_file with a ztd::text::default_handler for the encode step.
+	//////
+	template <typename _FromEncoding, typename _ToEncoding, typename _FromErrorHandler>
+	file_transcode_result transcode_file(const ::std::filesystem::path& __source_path, _FromEncoding&& __from_encoding,
+		const ::std::filesystem::path& __destination_path, _ToEncoding&& __to_encoding,
+		_FromErrorHandler&& __from_error_handler) {
+		return transcode_file(__source_path, ::std::forward<_FromEncoding>(__from_encoding), __destination_path,
+			::std::forward<_ToEncoding>(__to_encoding), ::std::forward<_FromErrorHandler>(__from_error_handler),
+			default_handler {});
+	}
+
+	//////
+	/// @brief Converts the contents of the file at @p __source_path from @p __from_encoding to @p __to_encoding ,
+	/// and writes them to the file at @p __destination_path .
+	///
+	/// @param[in] __source_path The file to read code units from.
+	/// @param[in] __from_encoding The encoding of the source file.
+	/// @param[in] __destination_path The file to write code units to. It is created or truncated.
+	/// @param[in] __to_encoding The encoding to write the destination file in.
+	///
+	/// @remarks Calls ztd::text::transcode_file with a ztd::text::default_handler for both steps.
+	//////
+	template <typename _FromEncoding, typename _ToEncoding>
+	file_transcode_result transcode_file(const ::std::filesystem::path& __source_path, _FromEncoding&& __from_encoding,
+		const ::std::filesystem::path& __destination_path, _ToEncoding&& __to_encoding) {
+		return transcode_file(__source_path, ::std::forward<_FromEncoding>(__from_encoding), __destination_path,
+			::std::forward<_ToEncoding>(__to_encoding), default_handler {}, default_handler {});
+	}
+
+	//////
+	/// @brief Checks whether the contents of the file at @p __source_path are valid code units of @p __encoding .
+	///
+	/// @param[in] __source_path The file to read code units from.
+	/// @param[in] __encoding The encoding of the file.
+	///
+	/// @remarks The check is done with ztd::text::validate_code_units, over the whole mapped file at once.
+	//////
+	template <typename _Encoding>
+	file_validate_result validate_file(const ::std::filesystem::path& __source_path, _Encoding&& __encoding) {
+		using _UEncoding     = __detail::__remove_cvref_t<_Encoding>;
+		using _InputCodeUnit = code_unit_t<_UEncoding>;
+
+		file_validate_result __result { 0, false, ::std::error_code() };
+		__detail::__mapped_file __source;
+		__result.file_error = __source.open(__source_path);
+		if (__result.file_error) {
+			return __result;
+		}
+
+		::ztd::text::span<const _InputCodeUnit> __all_input = __detail::__mapped_code_units<_InputCodeUnit>(__source);
+		::ztd::text::span<const _InputCodeUnit> __input
+			= __all_input.subspan(__detail::__byte_order_mark_size(__all_input, __encoding));
+		decode_state_t<_UEncoding> __state = make_decode_state(__encoding);
+		auto __validate_result             = validate_code_units(__input, __encoding, __state);
+		__result.code_units_read
+			= __all_input.size() - ::ztd::text::span<const _InputCodeUnit>(__validate_result.input).size();
+		__result.valid = __validate_result.valid && (__source.size() % sizeof(_InputCodeUnit)) == 0;
+		return __result;
+	}
+
+	//////
+	/// @brief Counts the code points in the file at @p __source_path .
+	///
+	/// @param[in] __source_path The file to read code units from.
+	/// @param[in] __encoding The encoding of the file.
+	/// @param[in] __error_handler The error handler to invoke when the file's code units cannot be decoded.
+	///
+	/// @remarks The count is done with ztd::text::count_code_points, over the whole mapped file at once.
+	//////
+	template <typename _Encoding, typename _ErrorHandler>
+	file_count_result count_file(
+		const ::std::filesystem::path& __source_path, _Encoding&& __encoding, _ErrorHandler&& __error_handler) {
+		using _UEncoding     = __detail::__remove_cvref_t<_Encoding>;
+		using _InputCodeUnit = code_unit_t<_UEncoding>;
+
+		file_count_result __result { 0, 0, encoding_error::ok, false, ::std::error_code() };
+		__detail::__mapped_file __source;
+		__result.file_error = __source.open(__source_path);
+		if (__result.file_error) {
+			return __result;
+		}
+
+		::ztd::text::span<const _InputCodeUnit> __all_input = __detail::__mapped_code_units<_InputCodeUnit>(__source);
+		::ztd::text::span<const _InputCodeUnit> __input
+			= __all_input.subspan(__detail::__byte_order_mark_size(__all_input, __encoding));
+		decode_state_t<_UEncoding> __state = make_decode_state(__encoding);
+		auto __count_result                = count_code_points(__input, __encoding, __error_handler, __state);
+		__result.count                     = __count_result.count;
+		__result.code_units_read
+			= __all_input.size() - ::ztd::text::span<const _InputCodeUnit>(__count_result.input).size();
+		__result.error_code    = __count_result.error_code;
+		__result.handled_error = __count_result.handled_error;
+		if (__result.error_code == encoding_error::ok && (__source.size() % sizeof(_InputCodeUnit)) != 0) {
+			__result.error_code = encoding_error::incomplete_sequence;
+		}
+		return __result;
+	}
+
+	//////
+	/// @brief Counts the code points in the file at @p __source_path .
+	///
+	/// @param[in] __source_path The file to read code units from.
+	/// @param[in] __encoding The encoding of the file.
+	///
+	/// @remarks Calls ztd::text::count_file with a ztd::text::default_handler.
+	//////
+	template <typename _Encoding>
+	file_count_result count_file(const ::std::filesystem::path& __source_path, _Encoding&& __encoding) {
+		return count_file(__source_path, ::std::forward<_Encoding>(__encoding), default_handler {});
+	}
+
+	//////
+	/// @}
+	//////
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_FILE_HPP
@@ -0,0 +1,661 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_ICONV_ENCODING_HPP
+#define ZTD_TEXT_ICONV_ENCODING_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/ascii.hpp>
+#include <ztd/text/code_point.hpp>
+#include <ztd/text/code_unit.hpp>
+#include <ztd/text/decode_result.hpp>
+#include <ztd/text/encode_result.hpp>
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/unicode_code_point.hpp>
+
+#include <ztd/text/detail/bulk.hpp>
+#include <ztd/text/detail/bulk_transcode.hpp>
+#include <ztd/text/detail/encoding_name.hpp>
+#include <ztd/text/detail/iconv.hpp>
+#include <ztd/text/detail/range.hpp>
+#include <ztd/text/detail/span.hpp>
+#include <ztd/text/detail/type_traits.hpp>
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_USE_ICONV_I_)
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		inline constexpr ::std::size_t __iconv_max_code_points = 8;
+		inline constexpr ::std::size_t __iconv_max_code_units  = 16;
+
+		//////
+		/// @brief When an ztd::text::__detail::__iconv_kernel flushes its descriptor, for what it may still be
+		/// holding on to: never; once the input has all been read, if the output filled up while doing so; once
+		/// the input has all been read; or wherever the conversion stops.
+		//////
+		enum class __iconv_flush : unsigned char { __never, __at_end_if_full, __at_end, __always };
+
+		//////
+		/// @brief Hands a whole buffer to a single call to @c iconv and reports how much of it was converted. Any
+		/// problem @c iconv stops at (an invalid or incomplete sequence, a full output) is left behind for the
+		/// encoding's own @c decode_one / @c encode_one to report.
+		///
+		/// @remarks A descriptor can keep output for itself after reading the input it belongs to: a character
+		/// held back to see whether the next one combines with it, or the rest of a character that produces
+		/// several code points and did not fit. If the descriptor is flushed, room is kept at the end of the
+		/// output for that, so that it never makes it out of the kernel without being written.
+		//////
+		struct __iconv_kernel {
+			const __iconv::__descriptor* _M_descriptor;
+			__iconv_flush _M_flush;
+
+			template <typename _InputUnit, typename _OutputUnit>
+			__bulk_io operator()(const _InputUnit* __input, ::std::size_t __input_size, _OutputUnit* __output,
+				::std::size_t __output_size) const noexcept {
+				constexpr ::std::size_t _FlushBytes = __iconv_max_code_points * sizeof(char32_t);
+				if (_M_descriptor == nullptr) {
+					return __bulk_io { 0, 0 };
+				}
+				const ::std::size_t __input_bytes  = __input_size * sizeof(_InputUnit);
+				const ::std::size_t __output_bytes = __output_size * sizeof(_OutputUnit);
+				const ::std::size_t __kept_bytes   = _M_flush == __iconv_flush::__never ? 0 : _FlushBytes;
+				if (__output_bytes <= __kept_bytes) {
+					return __bulk_io { 0, 0 };
+				}
+				const char* __input_pointer = reinterpret_cast<const char*>(__input);
+				char* __output_pointer      = reinterpret_cast<char*>(__output);
+				::std::size_t __input_left  = __input_bytes;
+				::std::size_t __output_left = __output_bytes - __kept_bytes;
+				const int __conversion_error
+					= _M_descriptor->__convert(__input_pointer, __input_left, __output_pointer, __output_left);
+				__output_left += __kept_bytes;
+				const bool __at_end = __input_left == 0;
+				if (_M_flush == __iconv_flush::__always || (_M_flush == __iconv_flush::__at_end && __at_end)
+					|| (_M_flush == __iconv_flush::__at_end_if_full && __at_end
+					     && __conversion_error == E2BIG)) {
+					(void)_M_descriptor->__flush(__output_pointer, __output_left);
+				}
+				// iconv only ever stops between complete characters, so these divide evenly
+				return __bulk_io { (__input_bytes - __input_left) / sizeof(_InputUnit),
+					(__output_bytes - __output_left) / sizeof(_OutputUnit) };
+			}
+		};
+
+	} // namespace __detail
+
+	//////
+	/// @addtogroup ztd_text_encodings Encodings
+	/// @{
+	//////
+
+	//////
+	/// @brief An encoding for any character set the iconv library knows about, picked by name at run time.
+	///
+	/// @remarks iconv is not linked against: it is looked up in the program (e.g. inside glibc) or loaded from the
+	/// system the first time it is needed. Every state holds its own iconv conversion descriptor, which also keeps
+	/// that conversion's shift state; as descriptors cannot be copied, neither can the states. Only available when
+	/// @c ZTD_TEXT_USE_ICONV is turned on.
+	//////
+	class iconv_encoding {
+	private:
+		::std::string _M_name;
+		bool _M_has_shift_states;
+		bool _M_holds_back;
+
+		void _M_check(::std::error_code& __error) {
+			__detail::__iconv::__descriptor __decoder(
+				__detail::__iconv::__utf32_name(), this->_M_name.c_str(), __error);
+			if (__error) {
+				return;
+			}
+			__detail::__iconv::__descriptor __encoder(
+				this->_M_name.c_str(), __detail::__iconv::__utf32_name(), __error);
+			if (__error) {
+				return;
+			}
+			this->_M_has_shift_states = __detail::__iconv::__has_shift_states(this->_M_name.c_str());
+			this->_M_holds_back       = __detail::__iconv::__holds_back_characters(this->_M_name.c_str());
+		}
+
+	public:
+		//////
+		/// @brief The state used between decode calls: a conversion descriptor from the character set to UTF-32.
+		//////
+		class decode_state {
+		private:
+			friend iconv_encoding;
+
+			__detail::__iconv::__descriptor _M_descriptor;
+			// code points the descriptor already gave out for the code units in front of the input, which did not
+			// fit in the output: they are written out before anything else is read
+			::std::array<char32_t, __detail::__iconv_max_code_points * 2> _M_pending_points;
+			::std::size_t _M_pending_points_size;
+			::std::array<char, __detail::__iconv_max_code_units> _M_pending_units;
+			::std::size_t _M_pending_units_size;
+
+		public:
+			//////
+			/// @brief Opens a conversion descriptor for @p __encoding 's character set. If it cannot be opened,
+			/// every conversion with this state fails with ztd::text::encoding_error::invalid_sequence.
+			//////
+			explicit decode_state(const iconv_encoding& __encoding) noexcept
+			: _M_descriptor()
+			, _M_pending_points()
+			, _M_pending_points_size(0)
+			, _M_pending_units()
+			, _M_pending_units_size(0) {
+				::std::error_code __error;
+				this->_M_descriptor = __detail::__iconv::__descriptor(
+					__detail::__iconv::__utf32_name(), __encoding.name(), __error);
+			}
+		};
+
+		//////
+		/// @brief The state used between encode calls: a conversion descriptor from UTF-32 to the character set.
+		//////
+		class encode_state {
+		private:
+			friend iconv_encoding;
+
+			__detail::__iconv::__descriptor _M_descriptor;
+
+		public:
+			//////
+			/// @brief Opens a conversion descriptor for @p __encoding 's character set. If it cannot be opened,
+			/// every conversion with this state fails with ztd::text::encoding_error::invalid_sequence.
+			//////
+			explicit encode_state(const iconv_encoding& __encoding) noexcept : _M_descriptor() {
+				::std::error_code __error;
+				this->_M_descriptor = __detail::__iconv::__descriptor(
+					__encoding.name(), __detail::__iconv::__utf32_name(), __error);
+			}
+		};
+
+	private:
+		static const __detail::__iconv::__descriptor* _S_descriptor(const decode_state& __state) noexcept {
+			return ::std::addressof(__state._M_descriptor);
+		}
+
+		static const __detail::__iconv::__descriptor* _S_descriptor(const encode_state& __state) noexcept {
+			return ::std::addressof(__state._M_descriptor);
+		}
+
+		static bool _S_has_pending_points(const decode_state& __state) noexcept {
+			return __state._M_pending_points_size != 0;
+		}
+
+	public:
+		//////
+		/// @brief The individual units that result from an encode operation or are used as input to a decode
+		/// operation.
+		//////
+		using code_unit = char;
+		//////
+		/// @brief The individual units that result from a decode operation or as used as input to an encode
+		/// operation.
+		//////
+		using code_point = unicode_code_point;
+		//////
+		/// @brief Whether or not the decode operation can process all forms of input into code point values. Not
+		/// known for an arbitrary character set, so it is assumed not to.
+		//////
+		using is_decode_injective = ::std::false_type;
+		//////
+		/// @brief Whether or not the encode operation can process all forms of input into code unit values. Most
+		/// character sets cannot represent every code point.
+		//////
+		using is_encode_injective = ::std::false_type;
+		//////
+		/// @brief The maximum code points a single complete operation of decoding can produce.
+		//////
+		inline static constexpr ::std::size_t max_code_points = __detail::__iconv_max_code_points;
+		//////
+		/// @brief The maximum number of code units a single complete operation of encoding can produce.
+		//////
+		inline static constexpr ::std::size_t max_code_units = __detail::__iconv_max_code_units;
+		//////
+		/// @brief A range of code unit values that can be used as a replacement value, as @c ? is in nearly every
+		/// character set iconv knows (and U+FFFD is in very few of them).
+		//////
+		static constexpr const ::std::array<code_unit, 1>& replacement_code_units() noexcept {
+			return __detail::__question_mark_replacement_units<code_unit>;
+		}
+
+	private:
+		template <typename _OutputIterator, typename _OutputSentinel>
+		static bool _S_fits(_OutputIterator __outit, const _OutputSentinel& __outlast, ::std::size_t __size) {
+			for (::std::size_t __index = 0; __index < __size; ++__index) {
+				if (__outit == __outlast) {
+					return false;
+				}
+				__outit = __detail::__next(__outit);
+			}
+			return true;
+		}
+
+		//////
+		/// @brief Writes the code points one step of decoding produced; or, if they do not all fit, writes none of
+		/// them and keeps them in @p __s along with the code units they came from. Returns whether they were
+		/// written.
+		//////
+		template <typename _OutputIterator, typename _OutputSentinel>
+		static bool _S_write_points(const char32_t* __points, ::std::size_t __points_size, const code_unit* __units,
+			::std::size_t __units_size, _OutputIterator& __outit, const _OutputSentinel& __outlast,
+			decode_state& __s) {
+			if (!_S_fits(__outit, __outlast, __points_size)) {
+				// the descriptor has already moved past these code units, so they cannot just be read again
+				::std::copy(__points, __points + __points_size, __s._M_pending_points.data());
+				__s._M_pending_points_size = __points_size;
+				::std::copy(__units, __units + __units_size, __s._M_pending_units.data());
+				__s._M_pending_units_size = __units_size;
+				return false;
+			}
+			for (::std::size_t __index = 0; __index < __points_size; ++__index) {
+				__detail::__dereference(__outit) = static_cast<code_point>(__points[__index]);
+				__outit                          = __detail::__next(__outit);
+			}
+			return true;
+		}
+
+	public:
+		//////
+		/// @brief Creates an encoding for the character set named @p __name .
+		///
+		/// @param[in] __name A character set name iconv understands (e.g. @c "KOI8-R", @c "SHIFT_JIS").
+		///
+		/// @remarks Throws a @c std::system_error if iconv cannot be loaded or does not know the character set.
+		//////
+		explicit iconv_encoding(const char* __name)
+		: _M_name(__name), _M_has_shift_states(true), _M_holds_back(false) {
+			::std::error_code __error;
+			this->_M_check(__error);
+			if (__error) {
+				throw ::std::system_error(__error, __name);
+			}
+		}
+
+		//////
+		/// @brief Creates an encoding for the character set named @p __name , reporting failure through @p
+		/// __error .
+		///
+		/// @param[in] __name A character set name iconv understands (e.g. @c "KOI8-R", @c "SHIFT_JIS").
+		/// @param[out] __error Set to the reason the character set cannot be used, or cleared on success. On
+		/// failure, every conversion fails with ztd::text::encoding_error::invalid_sequence.
+		//////
+		iconv_encoding(const char* __name, ::std::error_code& __error)
+		: _M_name(__name), _M_has_shift_states(true), _M_holds_back(false) {
+			this->_M_check(__error);
+		}
+
+		//////
+		/// @brief The name of the character set, as it was given.
+		//////
+		const char* name() const noexcept {
+			return this->_M_name.c_str();
+		}
+
+		//////
+		/// @brief Returns whether or not this encoding is a unicode encoding.
+		//////
+		bool contains_unicode_encoding() const noexcept {
+			return __detail::__is_unicode_encoding_id(__detail::__to_encoding_id(this->_M_name));
+		}
+
+		//////
+		/// @brief Whether or not what this encoding writes depends on what it wrote before (shift sequences, byte
+		/// order marks and the like), as far as could be told when the object was made.
+		///
+		/// @remarks Encoding does not go back to the initial shift state at the end: for such character sets, the
+		/// output may need to be finished off by whoever knows it has ended.
+		//////
+		bool has_shift_states() const noexcept {
+			return this->_M_has_shift_states;
+		}
+
+		//////
+		/// @brief Decodes a single complete unit of information as code points and produces a result with the
+		/// input and output ranges moved past what was successfully read and written; or, produces an error and
+		/// returns the input and output ranges untouched.
+		///
+		/// @param[in] __input The input view to read code uunits from.
+		/// @param[in] __output The output view to write code points into.
+		/// @param[in] __error_handler The error handler to invoke if encoding fails.
+		/// @param[in, out] __s The necessary state information. Holds the conversion descriptor, and with it any
+		/// shift state.
+		///
+		/// @returns A ztd::text::decode_result object that contains the reconstructed input range,
+		/// reconstructed output range, error handler, and a reference to the passed-in state.
+		///
+		/// @remarks A code unit at a time is handed to @c iconv until it makes out a complete character (which may
+		/// be a shift sequence that produces no code points at all). A character set that holds a character back
+		/// to see whether the next one combines with it has that character flushed out at the end of the input, and
+		/// before an error is handled. If the code points do not all fit in the output, nothing is written and the
+		/// input is left as it was, but the code points are kept in the state: the next call with the same input
+		/// writes them without converting it again.
+		//////
+		template <typename _InputRange, typename _OutputRange, typename _ErrorHandler>
+		auto decode_one(_InputRange&& __input, _OutputRange&& __output, _ErrorHandler&& __error_handler,
+			decode_state& __s) const {
+			using _UInputRange  = __detail::__remove_cvref_t<_InputRange>;
+			using _UOutputRange = __detail::__remove_cvref_t<_OutputRange>;
+			using _Result = __detail::__reconstruct_decode_result_t<_UInputRange, _UOutputRange, decode_state>;
+
+			auto __init   = __detail::__adl::__adl_cbegin(__input);
+			auto __inlast = __detail::__adl::__adl_cend(__input);
+
+			if (__s._M_pending_points_size != 0) {
+				auto __outit   = __detail::__adl::__adl_begin(__output);
+				auto __outlast = __detail::__adl::__adl_end(__output);
+				// the output ran out last time: the code units converted then should still be in front
+				auto __pending_init = __init;
+				bool __resumed      = true;
+				for (::std::size_t __index = 0; __index < __s._M_pending_units_size; ++__index) {
+					if (__pending_init == __inlast
+						|| static_cast<code_unit>(__detail::__dereference(__pending_init))
+						     != __s._M_pending_units[__index]) {
+						__resumed = false;
+						break;
+					}
+					__pending_init = __detail::__next(__pending_init);
+				}
+				if (__resumed) {
+					if (!_S_fits(__outit, __outlast, __s._M_pending_points_size)) {
+						return __error_handler(*this,
+							_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+							     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+							     __s, encoding_error::insufficient_output_space),
+							::ztd::text::span<code_unit>(__s._M_pending_units.data(), __s._M_pending_units_size));
+					}
+					for (::std::size_t __index = 0; __index < __s._M_pending_points_size; ++__index) {
+						__detail::__dereference(__outit) = static_cast<code_point>(__s._M_pending_points[__index]);
+						__outit                          = __detail::__next(__outit);
+					}
+					__s._M_pending_points_size = 0;
+					return _Result(
+						__detail::__reconstruct(::std::in_place_type<_UInputRange>, __pending_init, __inlast),
+						__detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast), __s,
+						encoding_error::ok);
+				}
+				// something else is being decoded now: start over
+				__s._M_pending_points_size = 0;
+				__s._M_descriptor.__reset();
+			}
+
+			if (__init == __inlast) {
+				// an exhausted sequence is fine
+				return _Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
+					encoding_error::ok);
+			}
+
+			auto __outit   = __detail::__adl::__adl_begin(__output);
+			auto __outlast = __detail::__adl::__adl_end(__output);
+
+			const auto __first = __init;
+			code_unit __units[max_code_units] {};
+			::std::size_t __units_size = 0;
+			for (;;) {
+				auto __previous_init  = __init;
+				__units[__units_size] = static_cast<code_unit>(__detail::__dereference(__init));
+				__init                = __detail::__next(__init);
+				++__units_size;
+
+				// the back half is kept for whatever a flush brings out
+				char32_t __points[max_code_points * 2] {};
+				const char* __unit_pointer = __units;
+				::std::size_t __unit_left  = __units_size;
+				char* __point_pointer      = reinterpret_cast<char*>(__points);
+				::std::size_t __point_left = sizeof(__points) / 2;
+				const int __conversion_error
+					= __s._M_descriptor.__convert(__unit_pointer, __unit_left, __point_pointer, __point_left);
+				__point_left += sizeof(__points) / 2;
+				if (__conversion_error == 0) {
+					if (__init == __inlast && this->_M_holds_back) {
+						// nothing is left that could combine with a character held back, so it comes out now
+						(void)__s._M_descriptor.__flush(__point_pointer, __point_left);
+					}
+					const ::std::size_t __points_size = (sizeof(__points) - __point_left) / sizeof(char32_t);
+					if (!_S_write_points(__points, __points_size, __units, __units_size, __outit, __outlast, __s)) {
+						return __error_handler(*this,
+							_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __first, __inlast),
+							     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+							     __s, encoding_error::insufficient_output_space),
+							::ztd::text::span<code_unit>(__units, __units_size));
+					}
+					return _Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+						__detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast), __s,
+						encoding_error::ok);
+				}
+				if (__conversion_error == EINVAL && __init != __inlast && __units_size < max_code_units) {
+					// not a complete character yet: the descriptor is left as it was, so try again with one more
+					continue;
+				}
+				if (__conversion_error == EILSEQ && __units_size > 1) {
+					// what came before was the start of a character that this unit cannot continue, so it is the
+					// invalid sequence: this unit is left to start the next one
+					__init = ::std::move(__previous_init);
+					--__units_size;
+				}
+				const encoding_error __error = __conversion_error == EINVAL
+					? encoding_error::incomplete_sequence
+					: (__conversion_error == E2BIG ? encoding_error::insufficient_output_space
+					                               : encoding_error::invalid_sequence);
+				if (this->_M_holds_back && __conversion_error != E2BIG) {
+					// a character held back came before the error, so it is written before the error is handled
+					char* __flush_pointer      = reinterpret_cast<char*>(__points);
+					::std::size_t __flush_left = sizeof(__points);
+					(void)__s._M_descriptor.__flush(__flush_pointer, __flush_left);
+					const ::std::size_t __points_size = (sizeof(__points) - __flush_left) / sizeof(char32_t);
+					if (!_S_write_points(__points, __points_size, __units, 0, __outit, __outlast, __s)) {
+						return __error_handler(*this,
+							_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __first, __inlast),
+							     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+							     __s, encoding_error::insufficient_output_space),
+							::ztd::text::span<code_unit>(__units, 0));
+					}
+				}
+				return __error_handler(*this,
+					_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+					     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast), __s,
+					     __error),
+					::ztd::text::span<code_unit>(__units, __units_size));
+			}
+		}
+
+		//////
+		/// @brief Encodes a single complete unit of information as code units and produces a result with the
+		/// input and output ranges moved past what was successfully read and written; or, produces an error and
+		/// returns the input and output ranges untouched.
+		///
+		/// @param[in] __input The input view to read code points from.
+		/// @param[in] __output The output view to write code units into.
+		/// @param[in] __error_handler The error handler to invoke if encoding fails.
+		/// @param[in, out] __s The necessary state information. Holds the conversion descriptor, and with it any
+		/// shift state.
+		///
+		/// @returns A ztd::text::encode_result object that contains the reconstructed input range,
+		/// reconstructed output range, error handler, and a reference to the passed-in state.
+		//////
+		template <typename _InputRange, typename _OutputRange, typename _ErrorHandler>
+		auto encode_one(_InputRange&& __input, _OutputRange&& __output, _ErrorHandler&& __error_handler,
+			encode_state& __s) const {
+			using _UInputRange  = __detail::__remove_cvref_t<_InputRange>;
+			using _UOutputRange = __detail::__remove_cvref_t<_OutputRange>;
+			using _Result = __detail::__reconstruct_encode_result_t<_UInputRange, _UOutputRange, encode_state>;
+
+			auto __init   = __detail::__adl::__adl_cbegin(__input);
+			auto __inlast = __detail::__adl::__adl_cend(__input);
+
+			if (__init == __inlast) {
+				// an exhausted sequence is fine
+				return _Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
+					encoding_error::ok);
+			}
+
+			auto __outit   = __detail::__adl::__adl_begin(__output);
+			auto __outlast = __detail::__adl::__adl_end(__output);
+
+			code_point __point = __detail::__dereference(__init);
+			__init             = __detail::__next(__init);
+
+			const char32_t __point_value = static_cast<char32_t>(__point);
+			code_unit __units[max_code_units] {};
+			const char* __point_pointer = reinterpret_cast<const char*>(::std::addressof(__point_value));
+			::std::size_t __point_left  = sizeof(__point_value);
+			char* __unit_pointer        = __units;
+			::std::size_t __unit_left   = sizeof(__units);
+			const int __conversion_error
+				= __s._M_descriptor.__convert(__point_pointer, __point_left, __unit_pointer, __unit_left);
+			if (__conversion_error != 0) {
+				return __error_handler(*this,
+					_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+					     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast), __s,
+					     __conversion_error == E2BIG ? encoding_error::insufficient_output_space
+					                                 : encoding_error::invalid_sequence),
+					::ztd::text::span<code_point>(::std::addressof(__point), 1));
+			}
+			const ::std::size_t __units_size = sizeof(__units) - __unit_left;
+			for (::std::size_t __index = 0; __index < __units_size; ++__index) {
+				if (__outit == __outlast) {
+					return __error_handler(*this,
+						_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+						     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+						     __s, encoding_error::insufficient_output_space),
+						::ztd::text::span<code_point>(::std::addressof(__point), 1));
+				}
+				__detail::__dereference(__outit) = __units[__index];
+				__outit                          = __detail::__next(__outit);
+			}
+			return _Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+				__detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast), __s,
+				encoding_error::ok);
+		}
+
+		//////
+		/// @brief Decodes a contiguous range of code units in bulk, rather than one code point at a time.
+		///
+		/// @remarks This is found by ztd::text::decode_into through argument-dependent lookup. The whole input is
+		/// handed to a single @c iconv call; wherever that stops (an invalid or incomplete sequence, a full output),
+		/// ztd::text::iconv_encoding::decode_one takes over for one step before the next call, so errors are
+		/// reported (@c EILSEQ as ztd::text::encoding_error::invalid_sequence, @c EINVAL as
+		/// ztd::text::encoding_error::incomplete_sequence, @c E2BIG as
+		/// ztd::text::encoding_error::insufficient_output_space) exactly as they are with the plain loop. Once
+		/// the call has read all of the input, the descriptor is flushed of anything it still holds (see
+		/// ztd::text::iconv_encoding::decode_one), into room kept free at the end of the output for it.
+		//////
+		template <typename _Input, typename _Output, typename _ErrorHandler,
+			::std::enable_if_t<__detail::__is_bulk_unit_v<code_point, 4>
+			     && __detail::__is_bulk_transcodable_v<_Input, 1, _Output, code_point>>* = nullptr>
+		friend auto __text_decode(_Input&& __input, const iconv_encoding& __encoding, _Output&& __output,
+			_ErrorHandler&& __error_handler, decode_state& __state) {
+			// code points kept from a full output have to be written by decode_one before anything else is read
+			const __detail::__iconv::__descriptor* __descriptor
+				= _S_has_pending_points(__state) ? nullptr : _S_descriptor(__state);
+			return __detail::__bulk_decode<code_point>(::std::forward<_Input>(__input), __encoding,
+				::std::forward<_Output>(__output), __error_handler, __state,
+				__detail::__iconv_kernel { __descriptor,
+				     __encoding._M_holds_back ? __detail::__iconv_flush::__at_end
+				                              : __detail::__iconv_flush::__at_end_if_full });
+		}
+
+		//////
+		/// @brief Encodes a contiguous range of code points in bulk, rather than one code point at a time. See the
+		/// decoding counterpart.
+		//////
+		template <typename _Input, typename _Output, typename _ErrorHandler,
+			::std::enable_if_t<__detail::__is_bulk_unit_v<code_point, 4>
+			     && __detail::__is_bulk_transcodable_v<_Input, 4, _Output, code_unit>>* = nullptr>
+		friend auto __text_encode(_Input&& __input, const iconv_encoding& __encoding, _Output&& __output,
+			_ErrorHandler&& __error_handler, encode_state& __state) {
+			return __detail::__bulk_encode<code_unit>(::std::forward<_Input>(__input), __encoding,
+				::std::forward<_Output>(__output), __error_handler, __state,
+				__detail::__iconv_kernel { _S_descriptor(__state), __detail::__iconv_flush::__never });
+		}
+
+		//////
+		/// @brief Transcodes a contiguous range of code units from one iconv character set to another in bulk.
+		///
+		/// @remarks This is found by ztd::text::transcode_into through argument-dependent lookup. When neither
+		/// character set has shift states, the input is handed to a single @c iconv call that converts straight
+		/// from one to the other, without going through code points here at all; as with decoding, whatever it
+		/// stops at is transcoded a step at a time through the states before the next call. Character sets with
+		/// shift states always go a step at a time, so that the states stay in step with the text. The direct
+		/// descriptor is flushed wherever it stops, so that a character it holds back (or the rest of one that did
+		/// not fit) is written before the states take over.
+		//////
+		template <typename _Input, typename _Output, typename _FromErrorHandler, typename _ToErrorHandler,
+			::std::enable_if_t<__detail::__is_bulk_transcodable_v<_Input, 1, _Output, code_unit>>* = nullptr>
+		friend auto __text_transcode(_Input&& __input, const iconv_encoding& __from_encoding, _Output&& __output,
+			const iconv_encoding& __to_encoding, _FromErrorHandler&& __from_error_handler,
+			_ToErrorHandler&& __to_error_handler, decode_state& __from_state, encode_state& __to_state) {
+			__detail::__iconv::__descriptor __direct;
+			if (!__from_encoding._M_has_shift_states && !__to_encoding._M_has_shift_states
+				&& !_S_has_pending_points(__from_state)) {
+				::std::error_code __error;
+				__direct = __detail::__iconv::__descriptor(__to_encoding.name(), __from_encoding.name(), __error);
+			}
+			return __detail::__bulk_transcode<code_unit>(::std::forward<_Input>(__input), __from_encoding,
+				::std::forward<_Output>(__output), __to_encoding, __from_error_handler, __to_error_handler,
+				__from_state, __to_state,
+				__detail::__iconv_kernel { __direct.__is_valid() ? ::std::addressof(__direct) : nullptr,
+				     __detail::__iconv_flush::__always });
+		}
+	};
+
+	namespace __detail {
+		template <>
+		class __is_library_encoding<iconv_encoding> : public ::std::true_type { };
+	} // namespace __detail
+
+	//////
+	/// @}
+	//////
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // iconv
+
+#endif // ZTD_TEXT_ICONV_ENCODING_HPP
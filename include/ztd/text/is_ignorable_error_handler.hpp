@@ -45,7 +45,7 @@ namespace ztd { namespace text {
 	namespace __detail {
 
 		template <typename _Type>
-		using __detect_is_ignorable_error_handler = decltype(_Type::assume_valid);
+		using __detect_is_ignorable_error_handler = typename _Type::assume_valid;
 
 		template <typename, typename = void>
 		struct __is_ignorable_error_handler_sfinae : ::std::false_type { };
@@ -35,6 +35,7 @@
 
 #include <ztd/text/version.hpp>
 
+#include <ztd/text/state.hpp>
 #include <ztd/text/detail/type_traits.hpp>
 
 #include <type_traits>
@@ -53,7 +54,7 @@ namespace ztd { namespace text {
 		template <typename _Type>
 		struct __is_self_synchronizing_code_sfinae<_Type,
 			::std::enable_if_t<__is_detected_v<__detect_is_self_synchronizing_code, _Type>>>
-		: ::std::integral_constant<bool, _Type::self_synchronizing_code::value> { };
+		: ::std::integral_constant<bool, _Type::is_self_synchronizing_code::value> { };
 	} // namespace __detail
 
 	template <typename _Type>
@@ -254,6 +254,11 @@ namespace ztd { namespace text {
 		}
 	};
 
+	namespace __detail {
+		template <>
+		class __is_library_encoding<literal> : public ::std::true_type { };
+	} // namespace __detail
+
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
 }} // namespace ztd::text
 
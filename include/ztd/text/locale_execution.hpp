@@ -0,0 +1,402 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_LOCALE_EXECUTION_HPP
+#define ZTD_TEXT_LOCALE_EXECUTION_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/execution.hpp>
+#include <ztd/text/encode_result.hpp>
+#include <ztd/text/decode_result.hpp>
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/is_ignorable_error_handler.hpp>
+#include <ztd/text/utf8.hpp>
+
+#include <ztd/text/detail/type_traits.hpp>
+#include <ztd/text/detail/span.hpp>
+#include <ztd/text/detail/progress_handler.hpp>
+#include <ztd/text/detail/forwarding_handler.hpp>
+#include <ztd/text/detail/posix.hpp>
+#include <ztd/text/detail/encoding_name.hpp>
+#include <ztd/text/detail/bulk_execution.hpp>
+#include <ztd/text/detail/bulk_transcode.hpp>
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_LOCALE_T_I_)
+
+#include <cerrno>
+#include <memory>
+#include <system_error>
+#include <utility>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	//////
+	/// @addtogroup ztd_text_encodings Encodings
+	/// @{
+	//////
+
+	//////
+	/// @brief The Encoding that represents the narrow encoding of a specific C locale object (a POSIX @c locale_t),
+	/// rather than of the process-wide locale set with @c setlocale.
+	///
+	/// @remarks This behaves like ztd::text::execution, except that every conversion runs with this object's locale
+	/// installed for the calling thread only (through @c uselocale), so different threads can convert with different
+	/// locales at the same time and nothing ever reads or changes the global locale. The locale's encoding is
+	/// detected once, when the object is made: a UTF-8 locale never calls into the C library at all. Only available
+	/// where POSIX 2008 locale objects are, as controlled by @c ZTD_TEXT_LOCALE_T.
+	//////
+	class locale_execution {
+	private:
+		::locale_t _M_locale;
+		__detail::__encoding_id _M_id;
+		__detail::__execution_bulk_kind _M_bulk_kind;
+
+		void _M_detect() noexcept {
+			// not mblen under this locale: its hidden state is shared with every other thread
+			this->_M_id        = __detail::__posix::__determine_code_page(this->_M_locale);
+			this->_M_bulk_kind = __detail::__execution_bulk_kind_for(this->_M_id == __detail::__encoding_id::__utf8,
+				__detail::__is_shift_state_encoding_id(this->_M_id));
+		}
+
+		static ::locale_t _S_duplicate(::locale_t __locale) {
+			::locale_t __duplicate = ::duplocale(__locale);
+			if (__duplicate == static_cast<::locale_t>(0)) {
+				throw ::std::system_error(errno, ::std::generic_category(), "ztd::text::locale_execution");
+			}
+			return __duplicate;
+		}
+
+	public:
+		//////
+		/// @brief The state used between decode calls. It is the same as ztd::text::execution's.
+		//////
+		using decode_state = execution::decode_state;
+		//////
+		/// @brief The state used between encode calls. It is the same as ztd::text::execution's.
+		//////
+		using encode_state = execution::encode_state;
+		//////
+		/// @brief The individual units that result from an encode operation or are used as input to a decode
+		/// operation.
+		//////
+		using code_unit = execution::code_unit;
+		//////
+		/// @brief The individual units that result from a decode operation or as used as input to an encode
+		/// operation.
+		//////
+		using code_point = execution::code_point;
+		//////
+		/// @brief Whether or not the decode operation can process all forms of input into code point values. See
+		/// ztd::text::execution::is_decode_injective.
+		//////
+		using is_decode_injective = execution::is_decode_injective;
+		//////
+		/// @brief Whether or not the encode operation can process all forms of input into code unit values. See
+		/// ztd::text::execution::is_encode_injective.
+		//////
+		using is_encode_injective = execution::is_encode_injective;
+		//////
+		/// @brief The maximum code points a single complete operation of decoding can produce.
+		//////
+		inline static constexpr ::std::size_t max_code_points = execution::max_code_points;
+		//////
+		/// @brief The maximum number of code units a single complete operation of encoding can produce.
+		//////
+		inline static constexpr ::std::size_t max_code_units = execution::max_code_units;
+
+		//////
+		/// @brief Creates a locale object for @p __locale_name 's character classification and conversion (@c
+		/// LC_CTYPE) alone.
+		///
+		/// @param[in] __locale_name A locale name, as given to @c setlocale (e.g. @c "ru_RU.KOI8-R").
+		///
+		/// @remarks Throws a @c std::system_error if the locale cannot be made.
+		//////
+		explicit locale_execution(const char* __locale_name)
+		: _M_locale(::newlocale(LC_CTYPE_MASK, __locale_name, static_cast<::locale_t>(0)))
+		, _M_id(__detail::__encoding_id::__unknown)
+		, _M_bulk_kind(__detail::__execution_bulk_kind::__none) {
+			if (this->_M_locale == static_cast<::locale_t>(0)) {
+				throw ::std::system_error(errno, ::std::generic_category(), __locale_name);
+			}
+			this->_M_detect();
+		}
+
+		//////
+		/// @brief Creates a locale object for @p __locale_name 's character classification and conversion (@c
+		/// LC_CTYPE) alone, reporting failure through @p __error.
+		///
+		/// @param[in] __locale_name A locale name, as given to @c setlocale (e.g. @c "ru_RU.KOI8-R").
+		/// @param[out] __error Set to the reason the locale could not be made, or cleared on success. On failure,
+		/// the encoding converts with the calling thread's current locale.
+		//////
+		locale_execution(const char* __locale_name, ::std::error_code& __error) noexcept
+		: _M_locale(::newlocale(LC_CTYPE_MASK, __locale_name, static_cast<::locale_t>(0)))
+		, _M_id(__detail::__encoding_id::__unknown)
+		, _M_bulk_kind(__detail::__execution_bulk_kind::__none) {
+			if (this->_M_locale == static_cast<::locale_t>(0)) {
+				__error = ::std::error_code(errno, ::std::generic_category());
+				return;
+			}
+			__error.clear();
+			this->_M_detect();
+		}
+
+		//////
+		/// @brief Creates an encoding from a copy of @p __locale, which stays owned by the caller.
+		///
+		/// @remarks Throws a @c std::system_error if the locale cannot be copied.
+		//////
+		explicit locale_execution(::locale_t __locale)
+		: _M_locale(_S_duplicate(__locale))
+		, _M_id(__detail::__encoding_id::__unknown)
+		, _M_bulk_kind(__detail::__execution_bulk_kind::__none) {
+			this->_M_detect();
+		}
+
+		//////
+		/// @brief Copy constructs a ztd::text::locale_execution, with its own copy of the locale object.
+		//////
+		locale_execution(const locale_execution& __other)
+		: _M_locale(__other._M_locale == static_cast<::locale_t>(0) ? __other._M_locale
+		                                                           : _S_duplicate(__other._M_locale))
+		, _M_id(__other._M_id)
+		, _M_bulk_kind(__other._M_bulk_kind) {
+		}
+
+		//////
+		/// @brief Move constructs a ztd::text::locale_execution, taking over the locale object.
+		//////
+		locale_execution(locale_execution&& __other) noexcept
+		: _M_locale(::std::exchange(__other._M_locale, static_cast<::locale_t>(0)))
+		, _M_id(__other._M_id)
+		, _M_bulk_kind(__other._M_bulk_kind) {
+		}
+
+		//////
+		/// @brief Copy assigns into a ztd::text::locale_execution object.
+		//////
+		locale_execution& operator=(const locale_execution& __other) {
+			locale_execution __copy(__other);
+			return *this = ::std::move(__copy);
+		}
+
+		//////
+		/// @brief Move assigns into a ztd::text::locale_execution object.
+		//////
+		locale_execution& operator=(locale_execution&& __other) noexcept {
+			::std::swap(this->_M_locale, __other._M_locale);
+			this->_M_id        = __other._M_id;
+			this->_M_bulk_kind = __other._M_bulk_kind;
+			return *this;
+		}
+
+		//////
+		/// @brief Frees the locale object.
+		//////
+		~locale_execution() {
+			if (this->_M_locale != static_cast<::locale_t>(0)) {
+				::freelocale(this->_M_locale);
+			}
+		}
+
+		//////
+		/// @brief The locale object this encoding converts with.
+		//////
+		::locale_t native_handle() const noexcept {
+			return this->_M_locale;
+		}
+
+		//////
+		/// @brief Returns whether or not this encoding is a unicode encoding.
+		///
+		/// @remarks Unlike ztd::text::execution::contains_unicode_encoding, this is answered from what was detected
+		/// when the object was made, without asking the C library again.
+		//////
+		bool contains_unicode_encoding() const noexcept {
+			return __detail::__is_unicode_encoding_id(this->_M_id);
+		}
+
+		//////
+		/// @brief Encodes a single complete unit of information as code units and produces a result with the
+		/// input and output ranges moved past what was successfully read and written; or, produces an error and
+		/// returns the input and output ranges untouched.
+		///
+		/// @param[in] __input The input view to read code points from.
+		/// @param[in] __output The output view to write code units into.
+		/// @param[in] __error_handler The error handler to invoke if encoding fails.
+		/// @param[in, out] __s The necessary state information. See ztd::text::execution::encode_one.
+		///
+		/// @returns A ztd::text::encode_result object that contains the reconstructed input range,
+		/// reconstructed output range, error handler, and a reference to the passed-in state.
+		//////
+		template <typename _InputRange, typename _OutputRange, typename _ErrorHandler>
+		auto encode_one(_InputRange&& __input, _OutputRange&& __output, _ErrorHandler&& __error_handler,
+			encode_state& __s) const {
+			using _UInputRange   = __detail::__remove_cvref_t<_InputRange>;
+			using _UOutputRange  = __detail::__remove_cvref_t<_OutputRange>;
+			using _UErrorHandler = __detail::__remove_cvref_t<_ErrorHandler>;
+			using _Result = __detail::__reconstruct_encode_result_t<_UInputRange, _UOutputRange, encode_state>;
+			constexpr bool __call_error_handler = !is_ignorable_error_handler_v<_UErrorHandler>;
+
+			if (this->_M_id == __detail::__encoding_id::__utf8) {
+				// just go straight to UTF8
+				using __exec_utf8 = __impl::__utf8_with<void, code_unit, code_point>;
+				__exec_utf8 __u8enc {};
+				encode_state_t<__exec_utf8> __intermediate_s {};
+				__detail::__progress_handler<!__call_error_handler, locale_execution> __intermediate_handler {};
+				auto __intermediate_result = __u8enc.encode_one(::std::forward<_InputRange>(__input),
+					::std::forward<_OutputRange>(__output), __intermediate_handler, __intermediate_s);
+				if constexpr (__call_error_handler) {
+					if (__intermediate_result.error_code != encoding_error::ok) {
+						return __error_handler(*this,
+							_Result(::std::move(__intermediate_result.input),
+							     ::std::move(__intermediate_result.output), __s,
+							     __intermediate_result.error_code),
+							::ztd::text::span<code_point>(__intermediate_handler._M_code_points.data(),
+							     __intermediate_handler._M_code_points_size));
+					}
+				}
+				return _Result(::std::move(__intermediate_result.input), ::std::move(__intermediate_result.output),
+					__s, __intermediate_result.error_code);
+			}
+			__detail::__posix::__locale_scope __scope(this->_M_locale);
+			__detail::__forwarding_handler<const locale_execution, _UErrorHandler> __underlying_handler(
+				*this, __error_handler);
+			return execution::encode_one(::std::forward<_InputRange>(__input),
+				::std::forward<_OutputRange>(__output), __underlying_handler, __s);
+		}
+
+		//////
+		/// @brief Decodes a single complete unit of information as code points and produces a result with the
+		/// input and output ranges moved past what was successfully read and written; or, produces an error and
+		/// returns the input and output ranges untouched.
+		///
+		/// @param[in] __input The input view to read code uunits from.
+		/// @param[in] __output The output view to write code points into.
+		/// @param[in] __error_handler The error handler to invoke if encoding fails.
+		/// @param[in, out] __s The necessary state information. See ztd::text::execution::decode_one.
+		///
+		/// @returns A ztd::text::decode_result object that contains the reconstructed input range,
+		/// reconstructed output range, error handler, and a reference to the passed-in state.
+		//////
+		template <typename _InputRange, typename _OutputRange, typename _ErrorHandler>
+		auto decode_one(_InputRange&& __input, _OutputRange&& __output, _ErrorHandler&& __error_handler,
+			decode_state& __s) const {
+			using _UInputRange   = __detail::__remove_cvref_t<_InputRange>;
+			using _UOutputRange  = __detail::__remove_cvref_t<_OutputRange>;
+			using _UErrorHandler = __detail::__remove_cvref_t<_ErrorHandler>;
+			using _Result = __detail::__reconstruct_decode_result_t<_UInputRange, _UOutputRange, decode_state>;
+			constexpr bool __call_error_handler = !is_ignorable_error_handler_v<_UErrorHandler>;
+
+			if (this->_M_id == __detail::__encoding_id::__utf8) {
+				// just go straight to UTF8
+				using __char_utf8 = __impl::__utf8_with<void, code_unit, code_point>;
+				__char_utf8 __u8enc {};
+				decode_state_t<__char_utf8> __intermediate_s {};
+				__detail::__progress_handler<!__call_error_handler, locale_execution> __intermediate_handler {};
+				auto __intermediate_result = __u8enc.decode_one(::std::forward<_InputRange>(__input),
+					::std::forward<_OutputRange>(__output), __intermediate_handler, __intermediate_s);
+				if constexpr (__call_error_handler) {
+					if (__intermediate_result.error_code != encoding_error::ok) {
+						return __error_handler(*this,
+							_Result(::std::move(__intermediate_result.input),
+							     ::std::move(__intermediate_result.output), __s,
+							     __intermediate_result.error_code),
+							::ztd::text::span<code_unit>(__intermediate_handler._M_code_units.data(),
+							     __intermediate_handler._M_code_units_size));
+					}
+				}
+				return _Result(::std::move(__intermediate_result.input), ::std::move(__intermediate_result.output),
+					__s, __intermediate_result.error_code);
+			}
+			__detail::__posix::__locale_scope __scope(this->_M_locale);
+			__detail::__forwarding_handler<const locale_execution, _UErrorHandler> __underlying_handler(
+				*this, __error_handler);
+			return execution::decode_one(::std::forward<_InputRange>(__input),
+				::std::forward<_OutputRange>(__output), __underlying_handler, __s);
+		}
+
+		//////
+		/// @brief Decodes a contiguous range of code units in bulk, rather than one code point at a time.
+		///
+		/// @remarks This is found by ztd::text::decode_into through argument-dependent lookup. It works as
+		/// ztd::text::execution's does, except that the kernel was picked when the object was made and the locale is
+		/// installed for the calling thread once for the whole call.
+		//////
+		template <typename _Input, typename _Output, typename _ErrorHandler,
+			::std::enable_if_t<__detail::__is_bulk_unit_v<code_point, 4>
+			     && __detail::__is_bulk_transcodable_v<_Input, 1, _Output, code_point>>* = nullptr>
+		friend auto __text_decode(_Input&& __input, const locale_execution& __encoding, _Output&& __output,
+			_ErrorHandler&& __error_handler, decode_state& __state) {
+			using _Kernel = __detail::__execution_decode_kernel<decode_state,
+				is_ignorable_error_handler_v<__detail::__remove_cvref_t<_ErrorHandler>>>;
+			__detail::__posix::__locale_scope __scope(__encoding._M_locale);
+			return __detail::__bulk_decode<code_point>(::std::forward<_Input>(__input), __encoding,
+				::std::forward<_Output>(__output), __error_handler, __state,
+				_Kernel { __encoding._M_bulk_kind, ::std::addressof(__state) });
+		}
+
+		//////
+		/// @brief Encodes a contiguous range of code points in bulk, rather than one code point at a time. See the
+		/// decoding counterpart.
+		//////
+		template <typename _Input, typename _Output, typename _ErrorHandler,
+			::std::enable_if_t<__detail::__is_bulk_unit_v<code_point, 4>
+			     && __detail::__is_bulk_transcodable_v<_Input, 4, _Output, code_unit>>* = nullptr>
+		friend auto __text_encode(_Input&& __input, const locale_execution& __encoding, _Output&& __output,
+			_ErrorHandler&& __error_handler, encode_state& __state) {
+			using _Kernel = __detail::__execution_encode_kernel<encode_state>;
+			__detail::__posix::__locale_scope __scope(__encoding._M_locale);
+			return __detail::__bulk_encode<code_unit>(::std::forward<_Input>(__input), __encoding,
+				::std::forward<_Output>(__output), __error_handler, __state,
+				_Kernel { __encoding._M_bulk_kind, ::std::addressof(__state) });
+		}
+	};
+
+	namespace __detail {
+		template <>
+		class __is_library_encoding<locale_execution> : public ::std::true_type { };
+	} // namespace __detail
+
+	//////
+	/// @}
+	//////
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // POSIX 2008 locale_t
+
+#endif // ZTD_TEXT_LOCALE_EXECUTION_HPP
@@ -0,0 +1,122 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_MAX_TRANSCODE_EXPANSION_HPP
+#define ZTD_TEXT_MAX_TRANSCODE_EXPANSION_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/code_point.hpp>
+#include <ztd/text/code_unit.hpp>
+#include <ztd/text/forward.hpp>
+
+#include <ztd/text/detail/type_traits.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		template <typename _Encoding>
+		class __is_ascii_encoding : public ::std::false_type { };
+
+		template <typename _CodeUnit, typename _CodePoint>
+		class __is_ascii_encoding<basic_ascii<_CodeUnit, _CodePoint>> : public ::std::true_type { };
+
+		// clang-format off
+		// decodes one code point at a time, and needs at least 2 code units for anything outside of the Basic
+		// Multilingual Plane (or cannot represent it at all)
+		template <typename _Encoding>
+		inline constexpr bool __is_bmp_compact_decode_v
+			= ::std::is_base_of_v<__impl::__utf8_tag, _Encoding>
+			|| ::std::is_base_of_v<__impl::__utf16_tag, _Encoding>
+			|| __is_ascii_encoding<_Encoding>::value;
+
+		// only needs its longest sequence for code points outside of the Basic Multilingual Plane; everything else
+		// (including U+FFFD, the replacement character) takes at least 1 code unit less
+		template <typename _Encoding>
+		inline constexpr bool __is_bmp_compact_encode_v
+			= (::std::is_base_of_v<__impl::__utf8_tag, _Encoding> && max_code_units_v<_Encoding> == 4)
+			|| (::std::is_base_of_v<__impl::__utf16_tag, _Encoding> && max_code_units_v<_Encoding> == 2);
+		// clang-format on
+
+		template <typename _From, typename _To>
+		inline constexpr ::std::size_t __max_transcode_expansion_v
+			= (__is_bmp_compact_decode_v<_From> && __is_bmp_compact_encode_v<_To>)
+			? max_code_units_v<_To> - 1
+			: max_code_points_v<_From> * max_code_units_v<_To>;
+
+	} // namespace __detail
+
+	//////
+	/// @addtogroup ztd_text_properties Property and Trait Helpers
+	///
+	/// @{
+	/////
+
+	//////
+	/// @brief The most code units of the @p _To encoding that transcoding a single code unit of the @p _From encoding
+	/// can produce. An input of @c N code units therefore never needs more than @c N times this many code units of
+	/// output.
+	///
+	/// @tparam _From The encoding that is going to decode the input code units into the intermediate code points.
+	/// @tparam _To The encoding that is going to encode the intermediate code points into the final code units.
+	///
+	/// @remarks The bound also holds for ill-formed input, so long as every error is either stopped at or replaced
+	/// with a single replacement character (e.g. with ztd::text::replacement_handler). For the Unicode encodings, it
+	/// is 1 going to UTF-32 and going from UTF-8, UTF-16 or ASCII to UTF-16; 2 from UTF-32 to UTF-16; 3 from UTF-8,
+	/// UTF-16 or ASCII to UTF-8 (U+FFFD takes 3 UTF-8 code units, even if it replaces only one); and 4 from UTF-32 to
+	/// UTF-8. Any other pair uses @c max_code_points_v<_From> @c * @c max_code_units_v<_To>.
+	//////
+	template <typename _From, typename _To>
+	class max_transcode_expansion
+	: public ::std::integral_constant<::std::size_t, __detail::__max_transcode_expansion_v<_From, _To>> { };
+
+	//////
+	/// @brief A @c "::value" alias for ztd::text::max_transcode_expansion.
+	///
+	//////
+	template <typename _From, typename _To>
+	inline constexpr ::std::size_t max_transcode_expansion_v
+		= max_transcode_expansion<__detail::__remove_cvref_t<_From>, __detail::__remove_cvref_t<_To>>::value;
+
+	//////
+	/// @}
+	/////
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_MAX_TRANSCODE_EXPANSION_HPP
@@ -122,11 +122,9 @@ namespace ztd { namespace text {
 		template <typename _InputRange, typename _OutputRange, typename _ErrorHandler>
 		static constexpr auto decode_one(
 			_InputRange&& __input, _OutputRange&& __output, _ErrorHandler&& __error_handler, state& __s) {
-			using _UInputRange   = __detail::__remove_cvref_t<_InputRange>;
-			using _UOutputRange  = __detail::__remove_cvref_t<_OutputRange>;
-			using _UErrorHandler = __detail::__remove_cvref_t<_ErrorHandler>;
-			using _Result        = __detail::__reconstruct_decode_result_t<_UInputRange, _UOutputRange, state>;
-			constexpr bool __call_error_handler = !is_ignorable_error_handler_v<_UErrorHandler>;
+			using _UInputRange  = __detail::__remove_cvref_t<_InputRange>;
+			using _UOutputRange = __detail::__remove_cvref_t<_OutputRange>;
+			using _Result       = __detail::__reconstruct_decode_result_t<_UInputRange, _UOutputRange, state>;
 
 			auto __init   = __detail::__adl::__adl_cbegin(__input);
 			auto __inlast = __detail::__adl::__adl_cend(__input);
@@ -139,18 +137,13 @@ namespace ztd { namespace text {
 			auto __outit   = __detail::__adl::__adl_begin(__output);
 			auto __outlast = __detail::__adl::__adl_end(__output);
 
-			if constexpr (__call_error_handler) {
-				if (__outit == __outlast) {
-					basic_no_encoding __self {};
-					return __error_handler(__self,
-						_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-						     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
-						     __s, encoding_error::insufficient_output_space),
-						::ztd::text::span<code_unit, 0>());
-				}
-			}
-			else {
-				(void)__outlast;
+			if (__outit == __outlast) {
+				basic_no_encoding __self {};
+				return __error_handler(__self,
+					_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+					     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+					     __s, encoding_error::insufficient_output_space),
+					::ztd::text::span<code_unit, 0>());
 			}
 
 			code_unit __unit = __detail::__dereference(__init);
@@ -185,11 +178,9 @@ namespace ztd { namespace text {
 		template <typename _InputRange, typename _OutputRange, typename _ErrorHandler>
 		static constexpr auto encode_one(
 			_InputRange&& __input, _OutputRange&& __output, _ErrorHandler&& __error_handler, state& __s) {
-			using _UInputRange   = __detail::__remove_cvref_t<_InputRange>;
-			using _UOutputRange  = __detail::__remove_cvref_t<_OutputRange>;
-			using _UErrorHandler = __detail::__remove_cvref_t<_ErrorHandler>;
-			using _Result        = __detail::__reconstruct_encode_result_t<_UInputRange, _UOutputRange, state>;
-			constexpr bool __call_error_handler = !is_ignorable_error_handler_v<_UErrorHandler>;
+			using _UInputRange  = __detail::__remove_cvref_t<_InputRange>;
+			using _UOutputRange = __detail::__remove_cvref_t<_OutputRange>;
+			using _Result       = __detail::__reconstruct_encode_result_t<_UInputRange, _UOutputRange, state>;
 
 			auto __init   = __detail::__adl::__adl_cbegin(__input);
 			auto __inlast = __detail::__adl::__adl_cend(__input);
@@ -202,18 +193,13 @@ namespace ztd { namespace text {
 			auto __outit   = __detail::__adl::__adl_begin(__output);
 			auto __outlast = __detail::__adl::__adl_end(__output);
 
-			if constexpr (__call_error_handler) {
-				if (__outit == __outlast) {
-					basic_no_encoding __self {};
-					return __error_handler(__self,
-						_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-						     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
-						     __s, encoding_error::insufficient_output_space),
-						::ztd::text::span<code_point, 0>());
-				}
-			}
-			else {
-				(void)__outlast;
+			if (__outit == __outlast) {
+				basic_no_encoding __self {};
+				return __error_handler(__self,
+					_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+					     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+					     __s, encoding_error::insufficient_output_space),
+					::ztd::text::span<code_point, 0>());
 			}
 
 			code_point __points[1] {};
@@ -230,6 +216,11 @@ namespace ztd { namespace text {
 		}
 	};
 
+	namespace __detail {
+		template <typename _CodeUnit, typename _CodePoint>
+		class __is_library_encoding<basic_no_encoding<_CodeUnit, _CodePoint>> : public ::std::true_type { };
+	} // namespace __detail
+
 	//////
 	/// @brief A do-nothing encoding for @c char types of input.
 	///
@@ -0,0 +1,505 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_PARALLEL_HPP
+#define ZTD_TEXT_PARALLEL_HPP
+
+#include <ztd/text/version.hpp>
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_STD_LIBRARY_EXECUTION_I_)
+
+#include <ztd/text/count_code_points.hpp>
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/error_handler.hpp>
+#include <ztd/text/state.hpp>
+#include <ztd/text/transcode.hpp>
+#include <ztd/text/validate_code_units.hpp>
+#include <ztd/text/detail/adl.hpp>
+#include <ztd/text/detail/exact_size.hpp>
+#include <ztd/text/detail/parallel.hpp>
+#include <ztd/text/detail/range.hpp>
+#include <ztd/text/detail/reconstruct.hpp>
+#include <ztd/text/detail/span.hpp>
+#include <ztd/text/detail/type_traits.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <execution>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	//////
+	/// @addtogroup ztd_text_parallel ztd::text::transcode_to_parallel, ztd::text::count_code_points_parallel, and
+	/// ztd::text::validate_code_units_parallel
+	/// @brief These functions split a large input into chunks and work on each of them with a C++17 execution
+	/// policy (e.g. @c std::execution::par), which can spread the work out over all of the machine's cores.
+	///
+	/// @remarks The input is only split if it is a sized, contiguous range of at least a hundred thousand or so code
+	/// units, and its encoding is self-synchronizing (see ztd::text::is_self_synchronizing_code) with empty states:
+	/// then a place right after some well-formed code points can be found close to wherever a chunk ought to end,
+	/// which decoding the whole input would also stop at, and every chunk can be worked on with a fresh state.
+	/// Otherwise, these functions do exactly what their one-threaded counterparts do.
+	/// The results are always identical to theirs: if any chunk has an error, only the chunks before it and the
+	/// part of it before the error are reported, so errors are reported at the earliest place in the whole input.
+	/// Likewise, an exception thrown while working on a chunk (e.g. by ztd::text::throw_handler) is held until all of
+	/// the chunks are done, and then the one from the earliest chunk is rethrown, unless an error in an even earlier
+	/// chunk already stopped the work.
+	///
+	/// The input is also only split if the error handlers can be copied: every chunk is worked on with its own copy
+	/// of them, so whatever a handler changes in itself is not seen by the handler that was passed in. Those copies
+	/// are called from several threads at once, so anything they share (e.g. through a pointer) has to be safe to use
+	/// that way. They are also called for errors in chunks after the first error that stops the work, because later
+	/// chunks are worked on at the same time: what they do for those errors is thrown away.
+	/// @{
+	//////
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding for the output, working on chunks of the input with the given execution policy.
+	///
+	/// @tparam _OutputContainer The container to default-construct and serialize data into. Typically, a @c
+	/// std::basic_string or a @c std::vector of some sort.
+	///
+	/// @param[in]     __policy The execution policy (such as @c std::execution::par) to work on the chunks with.
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	/// @param[in]     __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	/// @param[in]     __to_error_handler The error handler for the @p __to_encoding 's encode step.
+	/// @param[in,out] __from_state A reference to the associated state for the @p __from_encoding 's decode step.
+	/// @param[in,out] __to_state A reference to the associated state for the @p __to_encoding 's encode step.
+	///
+	/// @returns A ztd::text::transcode_result object, exactly like the one from ztd::text::transcode_to.
+	///
+	/// @remarks Every chunk is transcoded with ztd::text::transcode_to into its own @p _OutputContainer. These are
+	/// then put together: if @p _OutputContainer is a contiguous container with a @c resize member function, it is
+	/// resized once to the sum of their sizes and each one is copied to its place with the execution policy too. See
+	/// the remarks of this group for how the error handlers are called.
+	//////
+	template <typename _OutputContainer, typename _ExecutionPolicy, typename _Input, typename _FromEncoding,
+		typename _ToEncoding, typename _FromErrorHandler, typename _ToErrorHandler, typename _FromState,
+		typename _ToState>
+	auto transcode_to_parallel(_ExecutionPolicy&& __policy, _Input&& __input, _FromEncoding&& __from_encoding,
+		_ToEncoding&& __to_encoding, _FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler,
+		_FromState& __from_state, _ToState& __to_state) {
+		static_assert(::std::is_execution_policy_v<__detail::__remove_cvref_t<_ExecutionPolicy>>,
+			"the first argument must be an execution policy, such as std::execution::par");
+		using _UInput         = __detail::__remove_cvref_t<_Input>;
+		using _InputValueType = __detail::__range_value_type_t<_UInput>;
+		using _WorkingInput   = __detail::__reconstruct_t<::std::conditional_t<::std::is_array_v<_UInput>,
+               ::std::conditional_t<__detail::__is_character_v<_InputValueType>,
+                    ::std::basic_string_view<_InputValueType>, ::ztd::text::span<const _InputValueType>>,
+               _UInput>>;
+
+		_WorkingInput __working_input(
+			__detail::__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
+
+		if constexpr (__detail::__is_parallel_splittable_v<_WorkingInput, _FromEncoding>
+			&& ::std::is_empty_v<_FromState> && ::std::is_empty_v<_ToState>
+			&& __detail::__is_parallel_error_handler_v<_FromErrorHandler>
+			&& __detail::__is_parallel_error_handler_v<_ToErrorHandler>) {
+			using _Result = decltype(transcode_to<_OutputContainer>(__working_input, __from_encoding, __to_encoding,
+				__from_error_handler, __to_error_handler, __from_state, __to_state));
+			using _ResultInput = __detail::__remove_cvref_t<decltype(::std::declval<_Result&>().input)>;
+			using _Chunk       = __detail::__parallel_chunk<_WorkingInput, _OutputContainer>;
+			using _Task        = __detail::__parallel_transcode_task<_OutputContainer,
+                    ::std::remove_reference_t<_FromEncoding>, ::std::remove_reference_t<_ToEncoding>,
+                    __detail::__remove_cvref_t<_FromErrorHandler>, __detail::__remove_cvref_t<_ToErrorHandler>>;
+
+			::std::vector<_Chunk> __chunks = __detail::__parallel_split<_Chunk>(__working_input, __from_encoding);
+			if (!__chunks.empty()) {
+				::std::for_each(__policy, __chunks.begin(), __chunks.end(),
+					_Task(__from_encoding, __to_encoding, __from_error_handler, __to_error_handler));
+
+				// stop at the first chunk with an error, just like one long conversion would have
+				auto __chunks_last          = __chunks.begin();
+				::std::size_t __output_size = 0;
+				encoding_error __error_code = encoding_error::ok;
+				bool __handled_error        = false;
+				while (__chunks_last != __chunks.end() && __error_code == encoding_error::ok) {
+					if (__chunks_last->__exception) {
+						::std::rethrow_exception(__chunks_last->__exception);
+					}
+					__chunks_last->__output_offset = __output_size;
+					__output_size
+						+= static_cast<::std::size_t>(__detail::__adl::__adl_size(__chunks_last->__output));
+					__error_code = __chunks_last->__error_code;
+					__handled_error |= __chunks_last->__handled_error;
+					++__chunks_last;
+				}
+
+				_OutputContainer __output {};
+				if constexpr (__detail::__is_exact_size_capable_v<_WorkingInput, _OutputContainer>) {
+					using _OutputValueType = __detail::__range_value_type_t<_OutputContainer>;
+					__output.resize(__output_size);
+					::std::for_each(__policy, __chunks.begin(), __chunks_last,
+						__detail::__parallel_copy_task<_OutputValueType>(__detail::__adl::__adl_data(__output)));
+				}
+				else {
+					for (auto __chunk_it = __chunks.begin(); __chunk_it != __chunks_last; ++__chunk_it) {
+						::std::copy(__detail::__adl::__adl_begin(__chunk_it->__output),
+							__detail::__adl::__adl_end(__chunk_it->__output), ::std::back_inserter(__output));
+					}
+				}
+				auto __input_first = __error_code == encoding_error::ok
+					? __detail::__adl::__adl_end(__working_input)
+					: __detail::__adl::__adl_begin(::std::prev(__chunks_last)->__input);
+				return _Result(__detail::__reconstruct(::std::in_place_type<_ResultInput>, __input_first,
+					               __detail::__adl::__adl_end(__working_input)),
+					::std::move(__output), __from_state, __to_state, __error_code, __handled_error);
+			}
+		}
+		(void)__policy;
+		return transcode_to<_OutputContainer>(__working_input, ::std::forward<_FromEncoding>(__from_encoding),
+			::std::forward<_ToEncoding>(__to_encoding), ::std::forward<_FromErrorHandler>(__from_error_handler),
+			::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding for the output, working on chunks of the input with the given execution policy.
+	///
+	/// @tparam _OutputContainer The container to default-construct and serialize data into. Typically, a @c
+	/// std::basic_string or a @c std::vector of some sort.
+	///
+	/// @param[in]     __policy The execution policy (such as @c std::execution::par) to work on the chunks with.
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	/// @param[in]     __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	/// @param[in]     __to_error_handler The error handler for the @p __to_encoding 's encode step.
+	///
+	/// @returns A ztd::text::stateless_transcode_result object that contains the @p _OutputContainer specified.
+	///
+	/// @remarks Both states are created using ztd::text::make_decode_state and ztd::text::make_encode_state.
+	//////
+	template <typename _OutputContainer, typename _ExecutionPolicy, typename _Input, typename _FromEncoding,
+		typename _ToEncoding, typename _FromErrorHandler, typename _ToErrorHandler>
+	auto transcode_to_parallel(_ExecutionPolicy&& __policy, _Input&& __input, _FromEncoding&& __from_encoding,
+		_ToEncoding&& __to_encoding, _FromErrorHandler&& __from_error_handler,
+		_ToErrorHandler&& __to_error_handler) {
+		using _UFromEncoding = __detail::__remove_cvref_t<_FromEncoding>;
+		using _UToEncoding   = __detail::__remove_cvref_t<_ToEncoding>;
+		using _FromState     = decode_state_t<_UFromEncoding>;
+		using _ToState       = encode_state_t<_UToEncoding>;
+
+		_FromState __from_state = make_decode_state(__from_encoding);
+		_ToState __to_state     = make_encode_state(__to_encoding);
+
+		auto __stateful_result = transcode_to_parallel<_OutputContainer>(::std::forward<_ExecutionPolicy>(__policy),
+			::std::forward<_Input>(__input), ::std::forward<_FromEncoding>(__from_encoding),
+			::std::forward<_ToEncoding>(__to_encoding), ::std::forward<_FromErrorHandler>(__from_error_handler),
+			::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
+		return __detail::__slice_to_stateless(::std::move(__stateful_result));
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding for the output, working on chunks of the input with the given execution policy.
+	///
+	/// @tparam _OutputContainer The container to default-construct and serialize data into. Typically, a @c
+	/// std::basic_string or a @c std::vector of some sort.
+	///
+	/// @param[in]     __policy The execution policy (such as @c std::execution::par) to work on the chunks with.
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	///
+	/// @returns A ztd::text::stateless_transcode_result object that contains the @p _OutputContainer specified.
+	///
+	/// @remarks Both error handlers are created using default construction of a ztd::text::default_handler that is
+	/// marked as careless.
+	//////
+	template <typename _OutputContainer, typename _ExecutionPolicy, typename _Input, typename _FromEncoding,
+		typename _ToEncoding>
+	auto transcode_to_parallel(
+		_ExecutionPolicy&& __policy, _Input&& __input, _FromEncoding&& __from_encoding, _ToEncoding&& __to_encoding) {
+		__detail::__careless_handler __from_handler {};
+		__detail::__careless_handler __to_handler {};
+
+		return transcode_to_parallel<_OutputContainer>(::std::forward<_ExecutionPolicy>(__policy),
+			::std::forward<_Input>(__input), ::std::forward<_FromEncoding>(__from_encoding),
+			::std::forward<_ToEncoding>(__to_encoding), __from_handler, __to_handler);
+	}
+
+	//////
+	/// @brief Counts the number of code points in the input, working on chunks of the input with the given
+	/// execution policy.
+	///
+	/// @param[in]     __policy The execution policy (such as @c std::execution::par) to work on the chunks with.
+	/// @param[in]     __input The input range (of code units) to count the code points of.
+	/// @param[in]     __encoding The encoding to count the input with.
+	/// @param[in]     __error_handler The error handler to invoke when a decode operation fails.
+	/// @param[in,out] __state The state that will be used to count code points.
+	///
+	/// @returns A ztd::text::count_result, exactly like the one from ztd::text::count_code_points.
+	///
+	/// @remarks Every chunk is counted with ztd::text::count_code_points, and the counts are added up. See the remarks
+	/// of this group for how the error handler is called.
+	//////
+	template <typename _ExecutionPolicy, typename _Input, typename _Encoding, typename _ErrorHandler,
+		typename _State>
+	auto count_code_points_parallel(_ExecutionPolicy&& __policy, _Input&& __input, _Encoding&& __encoding,
+		_ErrorHandler&& __error_handler, _State& __state) {
+		static_assert(::std::is_execution_policy_v<__detail::__remove_cvref_t<_ExecutionPolicy>>,
+			"the first argument must be an execution policy, such as std::execution::par");
+		using _UInput         = __detail::__remove_cvref_t<_Input>;
+		using _InputValueType = __detail::__range_value_type_t<_UInput>;
+		using _WorkingInput   = __detail::__reconstruct_t<::std::conditional_t<::std::is_array_v<_UInput>,
+               ::std::conditional_t<__detail::__is_character_v<_InputValueType>,
+                    ::std::basic_string_view<_InputValueType>, ::ztd::text::span<const _InputValueType>>,
+               _UInput>>;
+
+		_WorkingInput __working_input(
+			__detail::__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
+
+		if constexpr (__detail::__is_parallel_splittable_v<_WorkingInput, _Encoding> && ::std::is_empty_v<_State>
+			&& __detail::__is_parallel_error_handler_v<_ErrorHandler>) {
+			using _Result = decltype(count_code_points(__working_input, __encoding, __error_handler, __state));
+			using _ResultInput = __detail::__remove_cvref_t<decltype(::std::declval<_Result&>().input)>;
+			using _Chunk       = __detail::__parallel_chunk<_WorkingInput, ::std::size_t>;
+			using _Task        = __detail::__parallel_count_code_points_task<::std::remove_reference_t<_Encoding>,
+                    __detail::__remove_cvref_t<_ErrorHandler>>;
+
+			::std::vector<_Chunk> __chunks = __detail::__parallel_split<_Chunk>(__working_input, __encoding);
+			if (!__chunks.empty()) {
+				::std::for_each(__policy, __chunks.begin(), __chunks.end(), _Task(__encoding, __error_handler));
+
+				// stop at the first chunk with an error, just like one long count would have
+				auto __chunks_last          = __chunks.begin();
+				::std::size_t __count       = 0;
+				encoding_error __error_code = encoding_error::ok;
+				bool __handled_error        = false;
+				while (__chunks_last != __chunks.end() && __error_code == encoding_error::ok) {
+					if (__chunks_last->__exception) {
+						::std::rethrow_exception(__chunks_last->__exception);
+					}
+					__count += __chunks_last->__output;
+					__error_code = __chunks_last->__error_code;
+					__handled_error |= __chunks_last->__handled_error;
+					++__chunks_last;
+				}
+				auto __input_first = __error_code == encoding_error::ok
+					? __detail::__adl::__adl_end(__working_input)
+					: __detail::__adl::__adl_begin(::std::prev(__chunks_last)->__input);
+				return _Result(__detail::__reconstruct(::std::in_place_type<_ResultInput>, __input_first,
+					               __detail::__adl::__adl_end(__working_input)),
+					__count, __state, __error_code, __handled_error);
+			}
+		}
+		(void)__policy;
+		return count_code_points(__working_input, ::std::forward<_Encoding>(__encoding),
+			::std::forward<_ErrorHandler>(__error_handler), __state);
+	}
+
+	//////
+	/// @brief Counts the number of code points in the input, working on chunks of the input with the given
+	/// execution policy.
+	///
+	/// @param[in] __policy The execution policy (such as @c std::execution::par) to work on the chunks with.
+	/// @param[in] __input The input range (of code units) to count the code points of.
+	/// @param[in] __encoding The encoding to count the input with.
+	/// @param[in] __error_handler The error handler to invoke when a decode operation fails.
+	///
+	/// @returns A ztd::text::stateless_count_result, exactly like the one from ztd::text::count_code_points.
+	///
+	/// @remarks The state is created using ztd::text::make_decode_state.
+	//////
+	template <typename _ExecutionPolicy, typename _Input, typename _Encoding, typename _ErrorHandler>
+	auto count_code_points_parallel(
+		_ExecutionPolicy&& __policy, _Input&& __input, _Encoding&& __encoding, _ErrorHandler&& __error_handler) {
+		using _UEncoding = __detail::__remove_cvref_t<_Encoding>;
+		using _State     = decode_state_t<_UEncoding>;
+
+		_State __state         = make_decode_state(__encoding);
+		auto __stateful_result = count_code_points_parallel(::std::forward<_ExecutionPolicy>(__policy),
+			::std::forward<_Input>(__input), ::std::forward<_Encoding>(__encoding),
+			::std::forward<_ErrorHandler>(__error_handler), __state);
+		return __detail::__slice_to_stateless(::std::move(__stateful_result));
+	}
+
+	//////
+	/// @brief Counts the number of code points in the input, working on chunks of the input with the given
+	/// execution policy.
+	///
+	/// @param[in] __policy The execution policy (such as @c std::execution::par) to work on the chunks with.
+	/// @param[in] __input The input range (of code units) to count the code points of.
+	/// @param[in] __encoding The encoding to count the input with.
+	///
+	/// @returns A ztd::text::stateless_count_result, exactly like the one from ztd::text::count_code_points.
+	///
+	/// @remarks The error handler is a default-constructed ztd::text::default_handler.
+	//////
+	template <typename _ExecutionPolicy, typename _Input, typename _Encoding>
+	auto count_code_points_parallel(_ExecutionPolicy&& __policy, _Input&& __input, _Encoding&& __encoding) {
+		default_handler __handler {};
+		return count_code_points_parallel(::std::forward<_ExecutionPolicy>(__policy), ::std::forward<_Input>(__input),
+			::std::forward<_Encoding>(__encoding), __handler);
+	}
+
+	//////
+	/// @brief Validates the code units of the @p __input according to the @p __encoding, working on chunks of the
+	/// input with the given execution policy.
+	///
+	/// @param[in]     __policy The execution policy (such as @c std::execution::par) to work on the chunks with.
+	/// @param[in]     __input The input range of code units to validate.
+	/// @param[in]     __encoding The encoding to validate the input of code units with.
+	/// @param[in,out] __decode_state The state to use for the decoding portion of the validation check.
+	/// @param[in,out] __encode_state The state to use for the encoding portion of the validation check.
+	///
+	/// @returns A ztd::text::validate_result, exactly like the one from ztd::text::validate_code_units.
+	///
+	/// @remarks Every chunk is validated with ztd::text::validate_code_units.
+	//////
+	template <typename _ExecutionPolicy, typename _Input, typename _Encoding, typename _DecodeState,
+		typename _EncodeState>
+	auto validate_code_units_parallel(_ExecutionPolicy&& __policy, _Input&& __input, _Encoding&& __encoding,
+		_DecodeState& __decode_state, _EncodeState& __encode_state) {
+		static_assert(::std::is_execution_policy_v<__detail::__remove_cvref_t<_ExecutionPolicy>>,
+			"the first argument must be an execution policy, such as std::execution::par");
+		using _UInput         = __detail::__remove_cvref_t<_Input>;
+		using _InputValueType = __detail::__range_value_type_t<_UInput>;
+		using _WorkingInput   = __detail::__reconstruct_t<::std::conditional_t<::std::is_array_v<_UInput>,
+               ::std::conditional_t<__detail::__is_character_v<_InputValueType>,
+                    ::std::basic_string_view<_InputValueType>, ::ztd::text::span<const _InputValueType>>,
+               _UInput>>;
+
+		_WorkingInput __working_input(
+			__detail::__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
+
+		if constexpr (__detail::__is_parallel_splittable_v<_WorkingInput, _Encoding>
+			&& ::std::is_empty_v<_DecodeState> && ::std::is_empty_v<_EncodeState>) {
+			using _Result
+				= decltype(validate_code_units(__working_input, __encoding, __decode_state, __encode_state));
+			using _ResultInput = __detail::__remove_cvref_t<decltype(::std::declval<_Result&>().input)>;
+			using _Chunk       = __detail::__parallel_chunk<_WorkingInput, bool>;
+			using _Task = __detail::__parallel_validate_code_units_task<::std::remove_reference_t<_Encoding>>;
+
+			::std::vector<_Chunk> __chunks = __detail::__parallel_split<_Chunk>(__working_input, __encoding);
+			if (!__chunks.empty()) {
+				::std::for_each(__policy, __chunks.begin(), __chunks.end(), _Task(__encoding));
+
+				auto __invalid_chunk = __chunks.begin();
+				for (; __invalid_chunk != __chunks.end(); ++__invalid_chunk) {
+					if (__invalid_chunk->__exception) {
+						::std::rethrow_exception(__invalid_chunk->__exception);
+					}
+					if (!__invalid_chunk->__output) {
+						break;
+					}
+				}
+				const bool __valid = __invalid_chunk == __chunks.end();
+				auto __input_first = __valid ? __detail::__adl::__adl_end(__working_input)
+				                             : __detail::__adl::__adl_begin(__invalid_chunk->__input);
+				return _Result(__detail::__reconstruct(::std::in_place_type<_ResultInput>, __input_first,
+					               __detail::__adl::__adl_end(__working_input)),
+					__valid, __decode_state);
+			}
+		}
+		(void)__policy;
+		return validate_code_units(
+			__working_input, ::std::forward<_Encoding>(__encoding), __decode_state, __encode_state);
+	}
+
+	//////
+	/// @brief Validates the code units of the @p __input according to the @p __encoding, working on chunks of the
+	/// input with the given execution policy.
+	///
+	/// @param[in]     __policy The execution policy (such as @c std::execution::par) to work on the chunks with.
+	/// @param[in]     __input The input range of code units to validate.
+	/// @param[in]     __encoding The encoding to validate the input of code units with.
+	/// @param[in,out] __decode_state The state to use for the decoding portion of the validation check.
+	///
+	/// @returns A ztd::text::validate_result, exactly like the one from ztd::text::validate_code_units.
+	///
+	/// @remarks The encode state is created using ztd::text::make_encode_state.
+	//////
+	template <typename _ExecutionPolicy, typename _Input, typename _Encoding, typename _DecodeState>
+	auto validate_code_units_parallel(
+		_ExecutionPolicy&& __policy, _Input&& __input, _Encoding&& __encoding, _DecodeState& __decode_state) {
+		using _UEncoding   = __detail::__remove_cvref_t<_Encoding>;
+		using _EncodeState = encode_state_t<_UEncoding>;
+
+		_EncodeState __encode_state = make_encode_state(__encoding);
+		return validate_code_units_parallel(::std::forward<_ExecutionPolicy>(__policy),
+			::std::forward<_Input>(__input), ::std::forward<_Encoding>(__encoding), __decode_state, __encode_state);
+	}
+
+	//////
+	/// @brief Validates the code units of the @p __input according to the @p __encoding, working on chunks of the
+	/// input with the given execution policy.
+	///
+	/// @param[in] __policy The execution policy (such as @c std::execution::par) to work on the chunks with.
+	/// @param[in] __input The input range of code units to validate.
+	/// @param[in] __encoding The encoding to validate the input of code units with.
+	///
+	/// @returns A ztd::text::stateless_validate_result, exactly like the one from ztd::text::validate_code_units.
+	///
+	/// @remarks The decode state is created using ztd::text::make_decode_state.
+	//////
+	template <typename _ExecutionPolicy, typename _Input, typename _Encoding>
+	auto validate_code_units_parallel(_ExecutionPolicy&& __policy, _Input&& __input, _Encoding&& __encoding) {
+		using _UEncoding   = __detail::__remove_cvref_t<_Encoding>;
+		using _DecodeState = decode_state_t<_UEncoding>;
+
+		_DecodeState __decode_state = make_decode_state(__encoding);
+		auto __stateful_result      = validate_code_units_parallel(::std::forward<_ExecutionPolicy>(__policy),
+               ::std::forward<_Input>(__input), ::std::forward<_Encoding>(__encoding), __decode_state);
+		return __detail::__slice_to_stateless(::std::move(__stateful_result));
+	}
+
+	//////
+	/// @}
+	//////
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_STD_LIBRARY_EXECUTION_I_
+
+#endif // ZTD_TEXT_PARALLEL_HPP
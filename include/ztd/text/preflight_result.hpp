@@ -0,0 +1,107 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_PREFLIGHT_RESULT_HPP
+#define ZTD_TEXT_PREFLIGHT_RESULT_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/decode_result.hpp>
+#include <ztd/text/encode_result.hpp>
+#include <ztd/text/transcode_result.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	//////
+	/// @addtogroup ztd_text_result Result Types
+	/// @{
+	/////
+
+	//////
+	/// @brief The result of the preflighting conversion functions (such as ztd::text::transcode_into_preflight): the
+	/// result of the conversion itself, plus the number of code units or code points the whole input needs.
+	///
+	/// @tparam _Result The result type of the conversion that was run, such as a ztd::text::transcode_result.
+	//////
+	template <typename _Result>
+	class preflight_result : public _Result {
+	public:
+		//////
+		/// @brief The total number of code units (or code points, for a decode) that converting all of the input
+		/// produces. When the output was large enough, this is exactly how much was written into it. It is
+		/// ztd::text::preflight_result::unknown_size if the output was too small and the rest of the input could not
+		/// be counted.
+		//////
+		::std::size_t required_size;
+
+		//////
+		/// @brief The value of @c required_size when the size is not known: the output was too small, and the states
+		/// cannot be copied to count the rest of the input without disturbing the ones used to resume.
+		//////
+		static constexpr ::std::size_t unknown_size = (::std::numeric_limits<::std::size_t>::max)();
+
+		//////
+		/// @brief Constructs a ztd::text::preflight_result from the result of the conversion and the total required
+		/// size.
+		///
+		/// @param[in] __result The result of the conversion.
+		/// @param[in] __required_size The number of elements the whole input converts to.
+		//////
+		constexpr preflight_result(_Result&& __result, ::std::size_t __required_size) noexcept(
+			::std::is_nothrow_move_constructible_v<_Result>)
+		: _Result(::std::move(__result)), required_size(__required_size) {
+		}
+	};
+
+	//////
+	/// @}
+	/////
+
+	namespace __detail {
+		template <typename _Result>
+		constexpr auto __slice_to_stateless(preflight_result<_Result>&& __result) {
+			auto __stateless_result = __slice_to_stateless(static_cast<_Result&&>(__result));
+			return preflight_result<decltype(__stateless_result)>(
+				::std::move(__stateless_result), __result.required_size);
+		}
+	} // namespace __detail
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_PREFLIGHT_RESULT_HPP
@@ -0,0 +1,241 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+#pragma once
+
+#ifndef ZTD_TEXT_SIMD_LEVEL_HPP
+#define ZTD_TEXT_SIMD_LEVEL_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/detail/to_underlying.hpp>
+
+#include <cstddef>
+#include <string_view>
+#include <array>
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_CPUID_I_)
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_VCXX_I_)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	//////
+	/// @addtogroup ztd_text_simd_level ztd::text::simd_level
+	/// @brief The vector instruction sets that the bulk kernels of this library can pick from, and which one of them
+	/// is in use.
+	/// @{
+	//////
+
+	//////
+	/// @brief A family of vector instructions, from least to most capable.
+	///
+	/// @remarks Each level implies every level before it. The values can be compared with each other.
+	//////
+	enum class simd_level : unsigned char {
+		//////
+		/// No vector instructions: the bulk kernels use plain (or word-at-a-time) code.
+		//////
+		scalar = 0,
+		//////
+		/// SSE2, which every x86-64 processor has.
+		//////
+		sse2 = 1,
+		//////
+		/// SSE4.2, along with the SSSE3 and SSE4.1 instructions that come before it.
+		//////
+		sse4_2 = 2,
+		//////
+		/// AVX2, and an operating system which saves the 256-bit registers.
+		//////
+		avx2 = 3,
+		//////
+		/// AVX-512 with the F, BW, and VL extensions, and an operating system which saves the 512-bit registers.
+		//////
+		avx512 = 4
+	};
+
+	//////
+	/// @brief Converts a simd_level to a string value.
+	///
+	/// @returns A null-terminated string_view to the data.
+	///
+	/// @remarks If a value outside of the allowed simd_level is passed, then undefined behavior happens.
+	//////
+	inline constexpr ::std::string_view to_name(simd_level __level) {
+		constexpr ::std::array<::std::string_view, 5> __translation { { "scalar", "sse2", "sse4_2", "avx2",
+			"avx512" } };
+		return __translation[static_cast<::std::size_t>(__detail::__to_underlying(__level))];
+	}
+
+	namespace __detail {
+
+		// The most capable level the bulk kernels have been compiled for.
+		inline constexpr simd_level __simd_compiled_level
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_AVX2_I_)
+			= simd_level::avx2;
+#elif ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE4_2_I_)
+			= simd_level::sse4_2;
+#elif ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_)
+			= simd_level::sse2;
+#else
+			= simd_level::scalar;
+#endif
+
+		// The level the bulk kernels may use without asking the CPU first: whatever the compiler was told every
+		// target has, or whatever ZTD_TEXT_SIMD_LEVEL promises.
+		inline constexpr simd_level __simd_assumed_level
+			= static_cast<simd_level>(ZTD_TEXT_SIMD_LEVEL_I_) < __simd_compiled_level
+			? static_cast<simd_level>(ZTD_TEXT_SIMD_LEVEL_I_)
+			: __simd_compiled_level;
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_CPUID_I_)
+		inline void __cpu_id_query(
+			unsigned int __leaf, unsigned int __subleaf, unsigned int (&__registers)[4]) noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_VCXX_I_)
+			int __values[4] = {};
+			__cpuidex(__values, static_cast<int>(__leaf), static_cast<int>(__subleaf));
+			for (::std::size_t __index = 0; __index < 4; ++__index) {
+				__registers[__index] = static_cast<unsigned int>(__values[__index]);
+			}
+#else
+			__cpuid_count(__leaf, __subleaf, __registers[0], __registers[1], __registers[2], __registers[3]);
+#endif
+		}
+
+		// Which of the extended register states the operating system saves on a context switch (XCR0).
+		inline unsigned int __cpu_saved_states() noexcept {
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_VCXX_I_)
+			return static_cast<unsigned int>(_xgetbv(0));
+#else
+			unsigned int __low = 0, __high = 0;
+			__asm__ __volatile__("xgetbv" : "=a"(__low), "=d"(__high) : "c"(0));
+			return __low;
+#endif
+		}
+
+		inline simd_level __probe_simd_level() noexcept {
+			unsigned int __registers[4] = {};
+			__cpu_id_query(0, 0, __registers);
+			const unsigned int __max_leaf = __registers[0];
+			if (__max_leaf < 1) {
+				return simd_level::scalar;
+			}
+			__cpu_id_query(1, 0, __registers);
+			const unsigned int __features_c = __registers[2];
+			const unsigned int __features_d = __registers[3];
+			if ((__features_d & (1u << 26)) == 0) {
+				return simd_level::scalar;
+			}
+			// SSSE3, SSE4.1, SSE4.2
+			constexpr unsigned int __sse4_2_bits = (1u << 9) | (1u << 19) | (1u << 20);
+			if ((__features_c & __sse4_2_bits) != __sse4_2_bits) {
+				return simd_level::sse2;
+			}
+			// OSXSAVE and AVX: without the former, the operating system might not save the wider registers
+			constexpr unsigned int __avx_bits = (1u << 27) | (1u << 28);
+			if ((__features_c & __avx_bits) != __avx_bits || __max_leaf < 7) {
+				return simd_level::sse4_2;
+			}
+			// the SSE and AVX (YMM) register states
+			const unsigned int __saved_states = __cpu_saved_states();
+			if ((__saved_states & 0x06u) != 0x06u) {
+				return simd_level::sse4_2;
+			}
+			__cpu_id_query(7, 0, __registers);
+			const unsigned int __extended_features_b = __registers[1];
+			if ((__extended_features_b & (1u << 5)) == 0) {
+				return simd_level::sse4_2;
+			}
+			// AVX-512 F, BW, and VL, along with the opmask and ZMM register states
+			constexpr unsigned int __avx512_bits = (1u << 16) | (1u << 30) | (1u << 31);
+			if ((__extended_features_b & __avx512_bits) != __avx512_bits || (__saved_states & 0xE6u) != 0xE6u) {
+				return simd_level::avx2;
+			}
+			return simd_level::avx512;
+		}
+#else
+		inline simd_level __probe_simd_level() noexcept {
+			return simd_level::scalar;
+		}
+#endif
+
+		inline simd_level __cached_simd_level() noexcept {
+			static const simd_level __level = __probe_simd_level();
+			return __level;
+		}
+
+	} // namespace __detail
+
+	//////
+	/// @brief Returns the most capable vector instructions that the processor (and the operating system) this is
+	/// running on supports.
+	///
+	/// @remarks The processor is only asked once; later calls return the same answer. This says nothing about which
+	/// instructions the library actually uses: see ztd::text::active_simd_level for that.
+	//////
+	inline simd_level detected_simd_level() noexcept {
+		return __detail::__cached_simd_level();
+	}
+
+	//////
+	/// @brief Returns which vector instructions the bulk kernels of this library (e.g., for
+	/// ztd::text::validate_code_units or transcoding between UTF-8, UTF-16, and UTF-32) use.
+	///
+	/// @remarks This is the smaller of what the kernels were compiled for and what the processor supports, but never
+	/// less than what the compiler was told to assume. If ZTD_TEXT_SIMD_LEVEL is defined, or run-time dispatch is
+	/// turned off with ZTD_TEXT_SIMD_DISPATCH, this is decided entirely at compile-time and the processor is never
+	/// asked. There are no AVX-512 kernels at the moment, so this never returns ztd::text::simd_level::avx512.
+	//////
+	inline simd_level active_simd_level() noexcept {
+		if constexpr (__detail::__simd_assumed_level == __detail::__simd_compiled_level) {
+			return __detail::__simd_compiled_level;
+		}
+		else {
+			const simd_level __detected = __detail::__cached_simd_level();
+			if (__detected < __detail::__simd_assumed_level) {
+				return __detail::__simd_assumed_level;
+			}
+			return __detected < __detail::__simd_compiled_level ? __detected : __detail::__simd_compiled_level;
+		}
+	}
+
+	//////
+	/// @}
+	//////
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_SIMD_LEVEL_HPP
@@ -0,0 +1,491 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_SINGLE_BYTE_ENCODING_HPP
+#define ZTD_TEXT_SINGLE_BYTE_ENCODING_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/code_point.hpp>
+#include <ztd/text/code_unit.hpp>
+#include <ztd/text/unicode_code_point.hpp>
+#include <ztd/text/encode_result.hpp>
+#include <ztd/text/decode_result.hpp>
+#include <ztd/text/error_handler.hpp>
+#include <ztd/text/is_ignorable_error_handler.hpp>
+#include <ztd/text/ascii.hpp>
+#include <ztd/text/utf8.hpp>
+
+#include <ztd/text/detail/empty_state.hpp>
+#include <ztd/text/detail/range.hpp>
+#include <ztd/text/detail/bulk_transcode.hpp>
+#include <ztd/text/detail/bulk_single_byte.hpp>
+#include <ztd/text/detail/single_byte_tables.hpp>
+
+#include <array>
+#include <type_traits>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	//////
+	/// @addtogroup ztd_text_encodings Encodings
+	/// @{
+	//////
+
+	//////
+	/// @brief A single-byte code page, where every byte is one complete character, driven entirely by a table.
+	///
+	/// @tparam _Table A type with a static, constexpr @c code_points member: a @c std::array of 256 @c char32_t ,
+	/// holding the code point each byte decodes to, or a value past the last Unicode code point for a byte the code
+	/// page leaves undefined. Every code point in it must be in the Basic Multilingual Plane.
+	/// @tparam _CodeUnit The code unit type to work over.
+	/// @tparam _CodePoint The code point type to work over.
+	///
+	/// @remarks Decoding is one table lookup per byte. Encoding goes through a two-level table built from @p _Table
+	/// at compile time, which only stores the 256-code point blocks that the code page actually draws from. Both
+	/// directions (and transcoding from the code page to UTF-8) are also done in bulk, a vector at a time where the
+	/// CPU allows it, for contiguous inputs and outputs. See ztd::text::windows_1252, ztd::text::koi8_r and the
+	/// other aliases below for the code pages that come with the library.
+	//////
+	template <typename _Table, typename _CodeUnit = char, typename _CodePoint = unicode_code_point>
+	class basic_single_byte_encoding {
+	private:
+		static_assert(__detail::__is_single_byte_bmp_only(_Table::code_points),
+			"every code point of a single-byte code page's table must be in the Basic Multilingual Plane");
+
+	public:
+		//////
+		/// @brief The table describing the code page.
+		//////
+		using table_type = _Table;
+		//////
+		/// @brief The individual units that result from an encode operation or are used as input to a decode
+		/// operation.
+		//////
+		using code_unit = _CodeUnit;
+		//////
+		/// @brief The individual units that result from a decode operation or as used as input to an encode
+		/// operation.
+		//////
+		using code_point = _CodePoint;
+		//////
+		/// @brief The state that can be used between calls to the encoder and decoder.
+		///
+		/// @remarks It is an empty struct because every byte stands on its own: there is no shift state to preserve.
+		//////
+		using state = __detail::__empty_state;
+		//////
+		/// @brief Whether or not the decode operation can process all forms of input into code point values. This is
+		/// only true for code pages which give every byte a meaning.
+		//////
+		using is_decode_injective
+			= ::std::integral_constant<bool, __detail::__is_single_byte_total(_Table::code_points)>;
+		//////
+		/// @brief Whether or not the encode operation can process all forms of input into code unit values. This is
+		/// never true: a code page only has room for 256 characters.
+		//////
+		using is_encode_injective = ::std::false_type;
+		//////
+		/// @brief The maximum code units a single complete operation of encoding can produce.
+		//////
+		inline static constexpr const ::std::size_t max_code_units = 1;
+		//////
+		/// @brief The maximum number of code points a single complete operation of decoding can produce.
+		//////
+		inline static constexpr const ::std::size_t max_code_points = 1;
+		//////
+		/// @brief A range of code units representing the values to use when a replacement happen. Like for ASCII,
+		/// this is '?', since few code pages have anything like the Unicode Replacement Character U'�'.
+		//////
+		static constexpr const ::std::array<code_unit, 1>& replacement_code_units() noexcept {
+			return __detail::__question_mark_replacement_units<code_unit>;
+		}
+
+		//////
+		/// @brief Decodes a single complete unit of information as code points and produces a result with the
+		/// input and output ranges moved past what was successfully read and written; or, produces an error and
+		/// returns the input and output ranges untouched.
+		///
+		/// @param[in] __input The input view to read code uunits from.
+		/// @param[in] __output The output view to write code points into.
+		/// @param[in] __error_handler The error handler to invoke if decoding fails.
+		/// @param[in, out] __s The necessary state information. For this encoding, the state is empty and means
+		/// very little.
+		///
+		/// @returns A ztd::text::decode_result object that contains the reconstructed input range,
+		/// reconstructed output range, error handler, and a reference to the passed-in state.
+		//////
+		template <typename _InputRange, typename _OutputRange, typename _ErrorHandler>
+		static constexpr auto decode_one(
+			_InputRange&& __input, _OutputRange&& __output, _ErrorHandler&& __error_handler, state& __s) {
+			using _UInputRange   = __detail::__remove_cvref_t<_InputRange>;
+			using _UOutputRange  = __detail::__remove_cvref_t<_OutputRange>;
+			using _UErrorHandler = __detail::__remove_cvref_t<_ErrorHandler>;
+			using _Result        = __detail::__reconstruct_decode_result_t<_UInputRange, _UOutputRange, state>;
+			constexpr bool __call_error_handler = !is_ignorable_error_handler_v<_UErrorHandler>;
+
+			auto __init   = __detail::__adl::__adl_cbegin(__input);
+			auto __inlast = __detail::__adl::__adl_cend(__input);
+			if (__init == __inlast) {
+				// an exhausted sequence is fine
+				return _Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
+					encoding_error::ok);
+			}
+
+			auto __outit   = __detail::__adl::__adl_begin(__output);
+			auto __outlast = __detail::__adl::__adl_end(__output);
+
+			if (__outit == __outlast) {
+				basic_single_byte_encoding __self {};
+				return __error_handler(__self,
+					_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+					     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+					     __s, encoding_error::insufficient_output_space),
+					::ztd::text::span<code_unit, 0>());
+			}
+
+			code_unit __units[1] {};
+			__units[0] = __detail::__dereference(__init);
+			__init     = __detail::__next(__init);
+			const char32_t __code_point
+				= _Table::code_points[static_cast<unsigned char>(__units[0])];
+
+			if constexpr (__call_error_handler) {
+				if (!__detail::__is_single_byte_mapped(__code_point)) {
+					basic_single_byte_encoding __self {};
+					return __error_handler(__self,
+						_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+						     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+						     __s, encoding_error::invalid_sequence),
+						::ztd::text::span<code_unit, 1>(::std::addressof(__units[0]), 1));
+				}
+			}
+
+			__detail::__dereference(__outit) = static_cast<code_point>(__code_point);
+			__outit                          = __detail::__next(__outit);
+
+			return _Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+				__detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast), __s,
+				encoding_error::ok);
+		}
+
+		//////
+		/// @brief Encodes a single complete unit of information as code units and produces a result with the
+		/// input and output ranges moved past what was successfully read and written; or, produces an error and
+		/// returns the input and output ranges untouched.
+		///
+		/// @param[in] __input The input view to read code points from.
+		/// @param[in] __output The output view to write code units into.
+		/// @param[in] __error_handler The error handler to invoke if encoding fails.
+		/// @param[in, out] __s The necessary state information. For this encoding, the state is empty and means
+		/// very little.
+		///
+		/// @returns A ztd::text::encode_result object that contains the reconstructed input range,
+		/// reconstructed output range, error handler, and a reference to the passed-in state.
+		//////
+		template <typename _InputRange, typename _OutputRange, typename _ErrorHandler>
+		static constexpr auto encode_one(
+			_InputRange&& __input, _OutputRange&& __output, _ErrorHandler&& __error_handler, state& __s) {
+			using _UInputRange   = __detail::__remove_cvref_t<_InputRange>;
+			using _UOutputRange  = __detail::__remove_cvref_t<_OutputRange>;
+			using _UErrorHandler = __detail::__remove_cvref_t<_ErrorHandler>;
+			using _Result        = __detail::__reconstruct_encode_result_t<_UInputRange, _UOutputRange, state>;
+			constexpr bool __call_error_handler = !is_ignorable_error_handler_v<_UErrorHandler>;
+
+			auto __init   = __detail::__adl::__adl_cbegin(__input);
+			auto __inlast = __detail::__adl::__adl_cend(__input);
+			if (__init == __inlast) {
+				// an exhausted sequence is fine
+				return _Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
+					encoding_error::ok);
+			}
+
+			auto __outit   = __detail::__adl::__adl_begin(__output);
+			auto __outlast = __detail::__adl::__adl_end(__output);
+
+			if (__outit == __outlast) {
+				basic_single_byte_encoding __self {};
+				return __error_handler(__self,
+					_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+					     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+					     __s, encoding_error::insufficient_output_space),
+					::ztd::text::span<code_point, 0>());
+			}
+
+			code_point __points[1] {};
+			__points[0] = __detail::__dereference(__init);
+			__init      = __detail::__next(__init);
+
+			unsigned char __unit = 0;
+			const bool __mapped  = __detail::__single_byte_encode_one<_Table>(
+				static_cast<char32_t>(__points[0]), __unit);
+			if constexpr (__call_error_handler) {
+				if (!__mapped) {
+					basic_single_byte_encoding __self {};
+					return __error_handler(__self,
+						_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+						     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast),
+						     __s, encoding_error::invalid_sequence),
+						::ztd::text::span<code_point, 1>(::std::addressof(__points[0]), 1));
+				}
+			}
+			else {
+				(void)__mapped;
+			}
+
+			__detail::__dereference(__outit) = static_cast<code_unit>(__unit);
+			__outit                          = __detail::__next(__outit);
+
+			return _Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+				__detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast), __s,
+				encoding_error::ok);
+		}
+	};
+
+	namespace __detail {
+		template <typename _Table, typename _CodeUnit, typename _CodePoint>
+		class __is_library_encoding<basic_single_byte_encoding<_Table, _CodeUnit, _CodePoint>>
+		: public ::std::true_type { };
+	} // namespace __detail
+
+	//////
+	/// @brief ISO-8859-1 (Latin-1), the Western European code page.
+	//////
+	using iso_8859_1 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_1>;
+
+	//////
+	/// @brief ISO-8859-2 (Latin-2), the Central European code page.
+	//////
+	using iso_8859_2 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_2>;
+
+	//////
+	/// @brief ISO-8859-3 (Latin-3), the South European code page.
+	//////
+	using iso_8859_3 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_3>;
+
+	//////
+	/// @brief ISO-8859-4 (Latin-4), the North European code page.
+	//////
+	using iso_8859_4 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_4>;
+
+	//////
+	/// @brief ISO-8859-5, the Latin/Cyrillic code page.
+	//////
+	using iso_8859_5 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_5>;
+
+	//////
+	/// @brief ISO-8859-6, the Latin/Arabic code page.
+	//////
+	using iso_8859_6 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_6>;
+
+	//////
+	/// @brief ISO-8859-7, the Latin/Greek code page.
+	//////
+	using iso_8859_7 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_7>;
+
+	//////
+	/// @brief ISO-8859-8, the Latin/Hebrew code page.
+	//////
+	using iso_8859_8 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_8>;
+
+	//////
+	/// @brief ISO-8859-9 (Latin-5), the Turkish code page.
+	//////
+	using iso_8859_9 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_9>;
+
+	//////
+	/// @brief ISO-8859-10 (Latin-6), the Nordic code page.
+	//////
+	using iso_8859_10 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_10>;
+
+	//////
+	/// @brief ISO-8859-13 (Latin-7), the Baltic Rim code page.
+	//////
+	using iso_8859_13 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_13>;
+
+	//////
+	/// @brief ISO-8859-14 (Latin-8), the Celtic code page.
+	//////
+	using iso_8859_14 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_14>;
+
+	//////
+	/// @brief ISO-8859-15 (Latin-9), the Western European code page with the euro sign.
+	//////
+	using iso_8859_15 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_15>;
+
+	//////
+	/// @brief ISO-8859-16 (Latin-10), the South-Eastern European code page.
+	//////
+	using iso_8859_16 = basic_single_byte_encoding<__detail::__single_byte_tables::__iso_8859_16>;
+
+	//////
+	/// @brief Windows-1250, the Windows Central European code page.
+	//////
+	using windows_1250 = basic_single_byte_encoding<__detail::__single_byte_tables::__windows_1250>;
+
+	//////
+	/// @brief Windows-1251, the Windows Cyrillic code page.
+	//////
+	using windows_1251 = basic_single_byte_encoding<__detail::__single_byte_tables::__windows_1251>;
+
+	//////
+	/// @brief Windows-1252, the Windows Western European code page.
+	//////
+	using windows_1252 = basic_single_byte_encoding<__detail::__single_byte_tables::__windows_1252>;
+
+	//////
+	/// @brief Windows-1253, the Windows Greek code page.
+	//////
+	using windows_1253 = basic_single_byte_encoding<__detail::__single_byte_tables::__windows_1253>;
+
+	//////
+	/// @brief Windows-1254, the Windows Turkish code page.
+	//////
+	using windows_1254 = basic_single_byte_encoding<__detail::__single_byte_tables::__windows_1254>;
+
+	//////
+	/// @brief Windows-1255, the Windows Hebrew code page.
+	//////
+	using windows_1255 = basic_single_byte_encoding<__detail::__single_byte_tables::__windows_1255>;
+
+	//////
+	/// @brief Windows-1256, the Windows Arabic code page.
+	//////
+	using windows_1256 = basic_single_byte_encoding<__detail::__single_byte_tables::__windows_1256>;
+
+	//////
+	/// @brief Windows-1257, the Windows Baltic code page.
+	//////
+	using windows_1257 = basic_single_byte_encoding<__detail::__single_byte_tables::__windows_1257>;
+
+	//////
+	/// @brief Windows-1258, the Windows Vietnamese code page.
+	//////
+	using windows_1258 = basic_single_byte_encoding<__detail::__single_byte_tables::__windows_1258>;
+
+	//////
+	/// @brief KOI8-R, the Russian code page.
+	//////
+	using koi8_r = basic_single_byte_encoding<__detail::__single_byte_tables::__koi8_r>;
+
+	//////
+	/// @brief KOI8-U, the Ukrainian code page.
+	//////
+	using koi8_u = basic_single_byte_encoding<__detail::__single_byte_tables::__koi8_u>;
+
+	//////
+	/// @brief IBM code page 437, the character set of the original IBM PC.
+	//////
+	using cp437 = basic_single_byte_encoding<__detail::__single_byte_tables::__cp437>;
+
+	//////
+	/// @brief IBM code page 850, the DOS Western European code page.
+	//////
+	using cp850 = basic_single_byte_encoding<__detail::__single_byte_tables::__cp850>;
+
+	//////
+	/// @brief IBM code page 866, the DOS Cyrillic code page.
+	//////
+	using cp866 = basic_single_byte_encoding<__detail::__single_byte_tables::__cp866>;
+
+	//////
+	/// @}
+	//////
+
+	//////
+	/// @brief Decodes a contiguous range of a single-byte code page to UTF-32 in bulk, rather than one byte at a time.
+	///
+	/// @remarks This is found by ztd::text::decode_into through argument-dependent lookup, for contiguous outputs and
+	/// ztd::text::unbounded_view outputs. Bytes which do not decode and running out of output space are left to
+	/// ztd::text::basic_single_byte_encoding::decode_one, so the results and error handler calls are the same as
+	/// with the plain loop.
+	//////
+	template <typename _Input, typename _Table, typename _CodeUnit, typename _CodePoint, typename _Output,
+		typename _ErrorHandler, typename _State,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<_CodePoint, 4>
+		     && __detail::__is_bulk_transcodable_v<_Input, 1, _Output, _CodePoint>>* = nullptr>
+	constexpr auto __text_decode(_Input&& __input,
+		const basic_single_byte_encoding<_Table, _CodeUnit, _CodePoint>& __encoding, _Output&& __output,
+		_ErrorHandler&& __error_handler, _State& __state) {
+		return __detail::__bulk_decode<_CodePoint>(::std::forward<_Input>(__input), __encoding,
+			::std::forward<_Output>(__output), __error_handler, __state,
+			__detail::__single_byte_decode_kernel<_Table> {});
+	}
+
+	//////
+	/// @brief Encodes a contiguous range of UTF-32 code points to a single-byte code page in bulk, rather than one
+	/// code point at a time.
+	///
+	/// @remarks This is found by ztd::text::encode_into through argument-dependent lookup, for contiguous outputs and
+	/// ztd::text::unbounded_view outputs. Code points the code page has no byte for and running out of output space
+	/// are left to ztd::text::basic_single_byte_encoding::encode_one.
+	//////
+	template <typename _Input, typename _Table, typename _CodeUnit, typename _CodePoint, typename _Output,
+		typename _ErrorHandler, typename _State,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<_CodeUnit, 1> && __detail::__is_bulk_unit_v<_CodePoint, 4>
+		     && __detail::__is_bulk_transcodable_v<_Input, 4, _Output, _CodeUnit>>* = nullptr>
+	constexpr auto __text_encode(_Input&& __input,
+		const basic_single_byte_encoding<_Table, _CodeUnit, _CodePoint>& __encoding, _Output&& __output,
+		_ErrorHandler&& __error_handler, _State& __state) {
+		return __detail::__bulk_encode<_CodeUnit>(::std::forward<_Input>(__input), __encoding,
+			::std::forward<_Output>(__output), __error_handler, __state,
+			__detail::__single_byte_encode_kernel<_Table> {});
+	}
+
+	//////
+	/// @brief Transcodes a contiguous range of a single-byte code page directly to UTF-8, without stopping at every
+	/// code point.
+	///
+	/// @remarks This is found by ztd::text::transcode_into through argument-dependent lookup. Every byte is written
+	/// out from a table of the code page already encoded as UTF-8; bytes which do not decode, and whatever does not
+	/// fit in the output, are left to the regular ztd::text::basic_single_byte_encoding::decode_one and
+	/// ztd::text::basic_utf8::encode_one functions.
+	//////
+	template <typename _Input, typename _Table, typename _FromCodeUnit, typename _FromCodePoint, typename _Output,
+		typename _ToCodeUnit, typename _ToCodePoint, typename _FromErrorHandler, typename _ToErrorHandler,
+		typename _FromState, typename _ToState,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<_ToCodeUnit, 1>
+		     && __detail::__is_bulk_transcodable_v<_Input, 1, _Output, _ToCodeUnit>>* = nullptr>
+	constexpr auto __text_transcode(_Input&& __input,
+		const basic_single_byte_encoding<_Table, _FromCodeUnit, _FromCodePoint>& __from_encoding, _Output&& __output,
+		const basic_utf8<_ToCodeUnit, _ToCodePoint>& __to_encoding, _FromErrorHandler&& __from_error_handler,
+		_ToErrorHandler&& __to_error_handler, _FromState& __from_state, _ToState& __to_state) {
+		return __detail::__bulk_transcode<_ToCodeUnit>(::std::forward<_Input>(__input), __from_encoding,
+			::std::forward<_Output>(__output), __to_encoding, __from_error_handler, __to_error_handler, __from_state,
+			__to_state, __detail::__single_byte_to_utf8_kernel<_Table> {});
+	}
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_SINGLE_BYTE_ENCODING_HPP
@@ -0,0 +1,430 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_STREAMING_TRANSCODER_HPP
+#define ZTD_TEXT_STREAMING_TRANSCODER_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/transcode.hpp>
+#include <ztd/text/transcode_result.hpp>
+#include <ztd/text/decode_result.hpp>
+#include <ztd/text/error_handler.hpp>
+#include <ztd/text/state.hpp>
+#include <ztd/text/code_unit.hpp>
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/subrange.hpp>
+
+#include <ztd/text/detail/ebco.hpp>
+#include <ztd/text/detail/adl.hpp>
+#include <ztd/text/detail/span.hpp>
+#include <ztd/text/detail/type_traits.hpp>
+#include <ztd/text/detail/is_lossless.hpp>
+#include <ztd/text/detail/tracking_handler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	namespace __detail {
+
+		template <typename _ErrorHandler, typename _CodeUnit, ::std::size_t _MaxCodeUnits>
+		class __streaming_decode_handler {
+		public:
+			_ErrorHandler* _M_error_handler;
+			bool* _M_handled_error;
+			_CodeUnit* _M_code_units;
+			::std::size_t* _M_code_units_size;
+
+			template <typename _Encoding, typename _Result, typename _Progress>
+			constexpr auto operator()(
+				const _Encoding& __encoding, _Result __result, const _Progress& __progress) const {
+				if constexpr (__is_specialization_of_v<_Result, decode_result>) {
+					if (__result.error_code == encoding_error::incomplete_sequence
+						&& __adl::__adl_empty(__result.input)
+						&& __adl::__adl_size(__progress) <= _MaxCodeUnits) {
+						// the sequence was only cut off by the end of this chunk: hold on to it for the next one
+						::std::size_t __size = 0;
+						for (auto __it = __adl::__adl_cbegin(__progress); __it != __adl::__adl_cend(__progress);
+							(void)++__it, (void)++__size) {
+							this->_M_code_units[__size] = *__it;
+						}
+						*this->_M_code_units_size = __size;
+						return __result;
+					}
+				}
+				if (__result.error_code == encoding_error::insufficient_output_space) {
+					// the caller gets more room and pushes again: not an error to report
+					return __result;
+				}
+				*this->_M_handled_error = true;
+				return (*this->_M_error_handler)(__encoding, ::std::move(__result), __progress);
+			}
+		};
+
+	} // namespace __detail
+
+	//////
+	/// @brief A transcoder that converts input which arrives in arbitrarily-sized pieces, such as network frames or
+	/// blocks read from a file, without requiring the pieces to line up with code point boundaries.
+	///
+	/// @tparam _FromEncoding The encoding the pushed code units are in.
+	/// @tparam _ToEncoding The encoding to write the output code units in.
+	/// @tparam _FromErrorHandler The error handler for any decode-step failures.
+	/// @tparam _ToErrorHandler The error handler for any encode-step failures.
+	///
+	/// @remarks A sequence that is cut off by the end of a pushed chunk is not an error: its code units are kept in
+	/// a small buffer inside of this object (at most ztd::text::max_code_units_v of the @p _FromEncoding) and are
+	/// completed by the code units of the next push. The decode and encode states also live in this object and
+	/// carry over from one push to the next. Once the last chunk is pushed, call finish() so that a sequence that
+	/// will never be completed is given to the @p _FromErrorHandler .
+	//////
+	template <typename _FromEncoding, typename _ToEncoding, typename _FromErrorHandler = default_handler,
+		typename _ToErrorHandler = default_handler>
+	class streaming_transcoder : private __detail::__ebco<_FromEncoding, 0>,
+		                        private __detail::__ebco<_ToEncoding, 1>,
+		                        private __detail::__ebco<_FromErrorHandler, 2>,
+		                        private __detail::__ebco<_ToErrorHandler, 3> {
+	private:
+		using __base_from_encoding_t      = __detail::__ebco<_FromEncoding, 0>;
+		using __base_to_encoding_t        = __detail::__ebco<_ToEncoding, 1>;
+		using __base_from_error_handler_t = __detail::__ebco<_FromErrorHandler, 2>;
+		using __base_to_error_handler_t   = __detail::__ebco<_ToErrorHandler, 3>;
+
+		static constexpr ::std::size_t _MaxCodeUnits = max_code_units_v<_FromEncoding>;
+
+	public:
+		//////
+		/// @brief The encoding type used for decoding to intermediate code points.
+		///
+		//////
+		using from_encoding_type = _FromEncoding;
+		//////
+		/// @brief The encoding type used for encoding to the final code units.
+		///
+		//////
+		using to_encoding_type = _ToEncoding;
+		//////
+		/// @brief The error handler when a decode operation fails.
+		///
+		//////
+		using from_error_handler_type = _FromErrorHandler;
+		//////
+		/// @brief The error handler when an encode operation fails.
+		///
+		//////
+		using to_error_handler_type = _ToErrorHandler;
+		//////
+		/// @brief The state type used for decode operations.
+		///
+		//////
+		using from_state_type = decode_state_t<_FromEncoding>;
+		//////
+		/// @brief The state type used for encode operations.
+		///
+		//////
+		using to_state_type = encode_state_t<_ToEncoding>;
+		//////
+		/// @brief The code unit type that is pushed into this transcoder.
+		///
+		//////
+		using from_code_unit_type = code_unit_t<_FromEncoding>;
+		//////
+		/// @brief The code unit type that is written out by this transcoder.
+		///
+		//////
+		using to_code_unit_type = code_unit_t<_ToEncoding>;
+		//////
+		/// @brief The view of code units that is pushed into this transcoder.
+		///
+		//////
+		using input_type = ::ztd::text::span<const from_code_unit_type>;
+		//////
+		/// @brief The view of code units that is written into by this transcoder.
+		///
+		//////
+		using output_type = ::ztd::text::span<to_code_unit_type>;
+		//////
+		/// @brief The type returned from push() and finish().
+		///
+		//////
+		using result_type = stateless_transcode_result<input_type, output_type>;
+
+		//////
+		/// @brief Constructs a ztd::text::streaming_transcoder with the given encodings and error handlers, and fresh
+		/// states made with ztd::text::make_decode_state and ztd::text::make_encode_state.
+		///
+		//////
+		constexpr streaming_transcoder(_FromEncoding __from_encoding = _FromEncoding {},
+			_ToEncoding __to_encoding = _ToEncoding {},
+			_FromErrorHandler __from_error_handler = _FromErrorHandler {},
+			_ToErrorHandler __to_error_handler = _ToErrorHandler {})
+		: __base_from_encoding_t(::std::move(__from_encoding))
+		, __base_to_encoding_t(::std::move(__to_encoding))
+		, __base_from_error_handler_t(::std::move(__from_error_handler))
+		, __base_to_error_handler_t(::std::move(__to_error_handler))
+		, _M_from_state(make_decode_state(this->__base_from_encoding_t::get_value()))
+		, _M_to_state(make_encode_state(this->__base_to_encoding_t::get_value()))
+		, _M_code_units()
+		, _M_code_units_size(0) {
+		}
+
+		//////
+		/// @brief The decoding ("from") encoding object.
+		///
+		//////
+		constexpr const from_encoding_type& from_encoding() const noexcept {
+			return this->__base_from_encoding_t::get_value();
+		}
+
+		//////
+		/// @brief The encoding ("to") encoding object.
+		///
+		//////
+		constexpr const to_encoding_type& to_encoding() const noexcept {
+			return this->__base_to_encoding_t::get_value();
+		}
+
+		//////
+		/// @brief The decoding ("from") error handler object.
+		///
+		//////
+		constexpr const from_error_handler_type& from_handler() const noexcept {
+			return this->__base_from_error_handler_t::get_value();
+		}
+
+		//////
+		/// @brief The encoding ("to") error handler object.
+		///
+		//////
+		constexpr const to_error_handler_type& to_handler() const noexcept {
+			return this->__base_to_error_handler_t::get_value();
+		}
+
+		//////
+		/// @brief The decoding ("from") state object, as it stands after the last push.
+		///
+		//////
+		constexpr const from_state_type& from_state() const noexcept {
+			return this->_M_from_state;
+		}
+
+		//////
+		/// @brief The encoding ("to") state object, as it stands after the last push.
+		///
+		//////
+		constexpr const to_state_type& to_state() const noexcept {
+			return this->_M_to_state;
+		}
+
+		//////
+		/// @brief The code units of an incomplete sequence that are held back until the next push() or finish().
+		///
+		//////
+		constexpr input_type pending_code_units() const noexcept {
+			return input_type(this->_M_code_units.data(), this->_M_code_units_size);
+		}
+
+		//////
+		/// @brief Converts as much of @p __input as fits into @p __output .
+		///
+		/// @param[in] __input The next chunk of code units. It does not have to start or end on a code point
+		/// boundary.
+		/// @param[in] __output The code units to write into.
+		///
+		/// @returns A ztd::text::stateless_transcode_result whose @c input is the part of @p __input that was not
+		/// used and whose @c output is the part of @p __output that was not written to. On success, @c input is
+		/// empty: a trailing incomplete sequence has been moved into this object rather than being left behind.
+		///
+		/// @remarks If @p __output runs out, the error code is ztd::text::encoding_error::insufficient_output_space
+		/// and the returned @c input should be pushed again with more room; the error handlers are not called for
+		/// it. Any other error is whatever the error handlers left in place.
+		//////
+		constexpr result_type push(input_type __input, output_type __output) {
+			static_assert(__detail::__is_decode_lossless_or_deliberate_v<_FromEncoding, _FromErrorHandler>,
+				"The decode (input) portion of this transcode is a lossy, non-injective operation. This means you "
+				"may lose data that you did not intend to lose; specify a _FromErrorHandler explicitly in order to "
+				"bypass this.");
+			static_assert(__detail::__is_encode_lossless_or_deliberate_v<_ToEncoding, _ToErrorHandler>,
+				"The encode (output) portion of this transcode is a lossy, non-injective operation. This means you "
+				"may lose data that you did not intend to lose; specify a _ToErrorHandler explicitly in order to "
+				"bypass this.");
+
+			bool __handled_error = false;
+			_DecodeHandler __from_error_handler { ::std::addressof(this->__base_from_error_handler_t::get_value()),
+				::std::addressof(__handled_error), this->_M_code_units.data(),
+				::std::addressof(this->_M_code_units_size) };
+			_EncodeHandler __to_error_handler { ::std::addressof(this->__base_to_error_handler_t::get_value()),
+				::std::addressof(__handled_error) };
+			if (this->_M_code_units_size != 0) {
+				// complete the sequence held back from the last push with the first few code units of this one
+				::std::array<from_code_unit_type, _MaxCodeUnits * 2> __units {};
+				const ::std::size_t __pending_size = this->_M_code_units_size;
+				const ::std::size_t __taken        = (::std::min)(_MaxCodeUnits, __input.size());
+				for (::std::size_t __index = 0; __index < __pending_size; ++__index) {
+					__units[__index] = this->_M_code_units[__index];
+				}
+				for (::std::size_t __index = 0; __index < __taken; ++__index) {
+					__units[__pending_size + __index] = __input[__index];
+				}
+				const ::std::size_t __units_size = __pending_size + __taken;
+				this->_M_code_units_size         = 0;
+				auto __result = transcode_into(input_type(__units.data(), __units_size), this->from_encoding(),
+					_S_working_output(__output), this->to_encoding(), __from_error_handler, __to_error_handler,
+					this->_M_from_state, this->_M_to_state);
+				__output = _S_output(__result.output);
+				if (this->_M_code_units_size != 0) {
+					// still incomplete: either the input ran out, or the kept units belong to the input anyway
+					if (__taken == __input.size()) {
+						return result_type(__input.subspan(__input.size()), __output, encoding_error::ok,
+							__handled_error);
+					}
+					if (this->_M_code_units_size > __taken) {
+						return result_type(__input, __output, encoding_error::incomplete_sequence, true);
+					}
+					__input                  = __input.subspan(__taken - this->_M_code_units_size);
+					this->_M_code_units_size = 0;
+				}
+				else if (__result.error_code != encoding_error::ok) {
+					const ::std::size_t __used = __units_size - __detail::__adl::__adl_size(__result.input);
+					if (__used < __pending_size) {
+						for (::std::size_t __index = __used; __index < __pending_size; ++__index) {
+							this->_M_code_units[__index - __used] = __units[__index];
+						}
+						this->_M_code_units_size = __pending_size - __used;
+						return result_type(__input, __output, __result.error_code, __handled_error);
+					}
+					return result_type(__input.subspan(__used - __pending_size), __output, __result.error_code,
+						__handled_error);
+				}
+				else {
+					__input = __input.subspan(__taken);
+				}
+			}
+			if (__input.empty()) {
+				return result_type(__input, __output, encoding_error::ok, __handled_error);
+			}
+			auto __result = transcode_into(__input, this->from_encoding(), _S_working_output(__output),
+				this->to_encoding(), __from_error_handler, __to_error_handler, this->_M_from_state,
+				this->_M_to_state);
+			if (this->_M_code_units_size != 0) {
+				return result_type(__input.subspan(__input.size()), _S_output(__result.output), encoding_error::ok,
+					__handled_error);
+			}
+			return result_type(
+				input_type(__result.input), _S_output(__result.output), __result.error_code, __handled_error);
+		}
+
+		//////
+		/// @brief Ends the input, giving any held back, incomplete sequence to the decode error handler.
+		///
+		/// @param[in] __output The code units to write into.
+		///
+		/// @returns A ztd::text::stateless_transcode_result whose @c input is what is still held back (empty on
+		/// success) and whose @c output is the part of @p __output that was not written to.
+		///
+		/// @remarks On success, this object is reset() and can be used for a new stream. On failure, the held back
+		/// code units are kept so that finish() can be called again (e.g., with a larger @p __output ). Running out
+		/// of @p __output is not passed on to the error handlers.
+		//////
+		constexpr result_type finish(output_type __output) {
+			if (this->_M_code_units_size == 0) {
+				this->reset();
+				return result_type(this->pending_code_units(), __output, encoding_error::ok, false);
+			}
+			::std::array<from_code_unit_type, _MaxCodeUnits> __units = this->_M_code_units;
+			const ::std::size_t __units_size                         = this->_M_code_units_size;
+			bool __handled_error                                     = false;
+			_FinishDecodeHandler __from_error_handler { ::std::addressof(
+				                                            this->__base_from_error_handler_t::get_value()),
+				::std::addressof(__handled_error) };
+			_EncodeHandler __to_error_handler { ::std::addressof(this->__base_to_error_handler_t::get_value()),
+				::std::addressof(__handled_error) };
+			auto __result = transcode_into(input_type(__units.data(), __units_size), this->from_encoding(),
+				_S_working_output(__output), this->to_encoding(), __from_error_handler, __to_error_handler,
+				this->_M_from_state, this->_M_to_state);
+			if (__result.error_code != encoding_error::ok) {
+				const ::std::size_t __left = __detail::__adl::__adl_size(__result.input);
+				for (::std::size_t __index = 0; __index < __left; ++__index) {
+					this->_M_code_units[__index] = __units[__units_size - __left + __index];
+				}
+				this->_M_code_units_size = __left;
+				return result_type(
+					this->pending_code_units(), _S_output(__result.output), __result.error_code, __handled_error);
+			}
+			this->reset();
+			return result_type(
+				this->pending_code_units(), _S_output(__result.output), encoding_error::ok, __handled_error);
+		}
+
+		//////
+		/// @brief Drops any held back code units and starts over with fresh states.
+		///
+		//////
+		constexpr void reset() {
+			this->_M_from_state      = make_decode_state(this->__base_from_encoding_t::get_value());
+			this->_M_to_state        = make_encode_state(this->__base_to_encoding_t::get_value());
+			this->_M_code_units_size = 0;
+		}
+
+	private:
+		using _DecodeHandler = __detail::__streaming_decode_handler<_FromErrorHandler, from_code_unit_type,
+			_MaxCodeUnits>;
+		// a full output is reported through the result, never to the caller's error handlers
+		using _FinishDecodeHandler = __detail::__preflight_handler<_FromErrorHandler>;
+		using _EncodeHandler       = __detail::__preflight_handler<_ToErrorHandler, false>;
+		// pointer-based, so that every transcode_into loop (including the bulk ones) hands the same type back
+		using _WorkingOutput = subrange<to_code_unit_type*>;
+
+		static constexpr _WorkingOutput _S_working_output(output_type __output) noexcept {
+			return _WorkingOutput(__output.data(), __output.data() + __output.size());
+		}
+
+		static constexpr output_type _S_output(const _WorkingOutput& __output) noexcept {
+			return output_type(__output.begin(), __output.end());
+		}
+
+		from_state_type _M_from_state;
+		to_state_type _M_to_state;
+		::std::array<from_code_unit_type, _MaxCodeUnits> _M_code_units;
+		::std::size_t _M_code_units_size;
+	};
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_STREAMING_TRANSCODER_HPP
@@ -40,6 +40,9 @@
 #include <ztd/text/encoding.hpp>
 
 #include <string>
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_STD_LIBRARY_MEMORY_RESOURCE_I_)
+#include <memory_resource>
+#endif
 
 namespace ztd { namespace text {
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
@@ -80,6 +83,57 @@ namespace ztd { namespace text {
 	//////
 	using u32text = basic_text<utf32>;
 
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_STD_LIBRARY_MEMORY_RESOURCE_I_)
+	namespace pmr {
+		//////
+		/// @brief A ztd::text::basic_text whose storage is a @c std::pmr::basic_string, so that its memory comes
+		/// from a @c std::pmr::memory_resource (for example, a @c std::pmr::monotonic_buffer_resource over a stack
+		/// buffer) rather than the global allocator.
+		///
+		//////
+		template <typename _Encoding, typename _NormalizationForm = nfkc,
+			typename _ErrorHandler = __detail::__careless_handler>
+		using basic_text = ::ztd::text::basic_text<_Encoding, _NormalizationForm,
+			::std::pmr::basic_string<code_unit_t<_Encoding>>, _ErrorHandler>;
+
+		//////
+		/// @brief A ztd::text::pmr::basic_text for the locale, runtime-based execution encoding.
+		///
+		//////
+		using text = basic_text<execution>;
+		//////
+		/// @brief A ztd::text::pmr::basic_text for the locale, runtime-based wide execution encoding.
+		///
+		//////
+		using wtext = basic_text<wide_execution>;
+		//////
+		/// @brief A ztd::text::pmr::basic_text for the string literal encoding.
+		///
+		//////
+		using ltext = basic_text<literal>;
+		//////
+		/// @brief A ztd::text::pmr::basic_text for the wide string literal encoding.
+		///
+		//////
+		using wltext = basic_text<wide_literal>;
+		//////
+		/// @brief A ztd::text::pmr::basic_text for the UTF-8 encoding.
+		///
+		//////
+		using u8text = basic_text<utf8>;
+		//////
+		/// @brief A ztd::text::pmr::basic_text for the UTF-16 encoding.
+		///
+		//////
+		using u16text = basic_text<utf16>;
+		//////
+		/// @brief A ztd::text::pmr::basic_text for the UTF-32 encoding.
+		///
+		//////
+		using u32text = basic_text<utf32>;
+	} // namespace pmr
+#endif
+
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
 }} // namespace ztd::text
 
@@ -40,9 +40,15 @@
 #include <ztd/text/state.hpp>
 #include <ztd/text/default_encoding.hpp>
 #include <ztd/text/transcode_result.hpp>
+#include <ztd/text/preflight_result.hpp>
 #include <ztd/text/is_unicode_code_point.hpp>
+#include <ztd/text/max_transcode_expansion.hpp>
 
 #include <ztd/text/detail/transcode_one.hpp>
+#include <ztd/text/detail/exact_size.hpp>
+#include <ztd/text/detail/tracking_handler.hpp>
+#include <ztd/text/detail/bulk_copy.hpp>
+#include <ztd/text/detail/blocked_transcode.hpp>
 #include <ztd/text/detail/encoding_range.hpp>
 #include <ztd/text/unbounded.hpp>
 #include <ztd/text/detail/type_traits.hpp>
@@ -51,6 +57,7 @@
 #include <string>
 #include <vector>
 #include <string_view>
+#include <memory>
 
 namespace ztd { namespace text {
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
@@ -91,29 +98,37 @@ namespace ztd { namespace text {
 	/// @remark This function detects whether or not the ADL extension point @c text_transcode can be called with the
 	/// provided parameters. If so, it will use that ADL extension point over the default implementation. Otherwise, it
 	/// will loop over the two encodings and attempt to transcode by first decoding the input code units to code
-	/// points, then encoding the intermediate code points to the desired, output code units.
+	/// points, then encoding the intermediate code points to the desired, output code units. If the two encodings
+	/// are ztd::text::is_bitwise_transcoding_compatible, the input and output are contiguous and the @p
+	/// __from_error_handler is ignorable (e.g. ztd::text::assume_valid_handler), the input is copied as-is instead.
 	//////
 	template <typename _Input, typename _Output, typename _FromEncoding, typename _ToEncoding,
 		typename _FromErrorHandler, typename _ToErrorHandler, typename _FromState, typename _ToState>
 	constexpr auto transcode_into(_Input&& __input, _FromEncoding&& __from_encoding, _Output&& __output,
 		_ToEncoding&& __to_encoding, _FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler,
 		_FromState& __from_state, _ToState& __to_state) {
-		if constexpr (__detail::__is_detected_v<__detail::__detect_adl_text_transcode, _Input, _Output, _FromEncoding,
+		if constexpr (__detail::__is_detected_v<__detail::__detect_adl_text_transcode, _Input, _FromEncoding, _Output,
 			              _ToEncoding, _FromErrorHandler, _ToErrorHandler, _FromState, _ToState>) {
 			return text_transcode(::std::forward<_Input>(__input), ::std::forward<_FromEncoding>(__from_encoding),
-				::std::forward<_Output>(__output), ::std::forward<_FromEncoding>(__to_encoding),
+				::std::forward<_Output>(__output), ::std::forward<_ToEncoding>(__to_encoding),
 				::std::forward<_FromErrorHandler>(__from_error_handler),
-				::std::forward<_ToErrorHandler>(__to_error_handler), ::std::forward<_FromState>(__from_state),
-				::std::forward<_ToState>(__to_state));
+				::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
 		}
 		else if constexpr (__detail::__is_detected_v<__detail::__detect_adl_internal_text_transcode, _Input,
 			                   _FromEncoding, _Output, _ToEncoding, _FromErrorHandler, _ToErrorHandler, _FromState,
 			                   _ToState>) {
 			return __text_transcode(::std::forward<_Input>(__input), ::std::forward<_FromEncoding>(__from_encoding),
-				::std::forward<_Output>(__output), ::std::forward<_FromEncoding>(__to_encoding),
+				::std::forward<_Output>(__output), ::std::forward<_ToEncoding>(__to_encoding),
 				::std::forward<_FromErrorHandler>(__from_error_handler),
-				::std::forward<_ToErrorHandler>(__to_error_handler), ::std::forward<_FromState>(__from_state),
-				::std::forward<_ToState>(__to_state));
+				::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
+		}
+		else if constexpr (__detail::__is_bulk_copyable_v<_Input, _FromEncoding, _Output, _ToEncoding,
+			                   _FromErrorHandler>) {
+			using _UFromEncoding = __detail::__remove_cvref_t<_FromEncoding>;
+			using _ToCodeUnit    = code_unit_t<__detail::__remove_cvref_t<_ToEncoding>>;
+			return __detail::__bulk_transcode<_ToCodeUnit>(::std::forward<_Input>(__input), __from_encoding,
+				::std::forward<_Output>(__output), __to_encoding, __from_error_handler, __to_error_handler,
+				__from_state, __to_state, __detail::__bitwise_copy_kernel<_UFromEncoding> {});
 		}
 		else {
 			using _UInput                = __detail::__remove_cvref_t<_Input>;
@@ -137,10 +152,10 @@ namespace ztd { namespace text {
 			if constexpr (__detail::__is_detected_v<__detail::__detect_adl_text_transcode_one, _Input, _FromEncoding,
 				              _Output, _ToEncoding, _FromErrorHandler, _ToErrorHandler, _FromState, _ToState>) {
 				bool __handled_error = false;
-				for (;;) {
-					auto __transcode_result = text_transcode_one(::std::forward<_Input>(__input), __from_encoding,
-						::std::forward<_Output>(__output), __to_encoding, __from_error_handler,
-						__to_error_handler, __from_state, __to_state);
+				while (!__detail::__adl::__adl_empty(__working_input)) {
+					auto __transcode_result = text_transcode_one(::std::move(__working_input), __from_encoding,
+						::std::move(__working_output), __to_encoding, __from_error_handler, __to_error_handler,
+						__from_state, __to_state);
 					if (__transcode_result.error_code != encoding_error::ok) {
 						return _Result(::std::move(__working_input), ::std::move(__working_output), __from_state,
 							__to_state, __transcode_result.error_code, __transcode_result.handled_error);
@@ -148,17 +163,20 @@ namespace ztd { namespace text {
 					__handled_error |= __transcode_result.handled_error;
 					__working_input  = ::std::move(__transcode_result.input);
 					__working_output = ::std::move(__transcode_result.output);
-					if (__detail::__adl::__adl_empty(__working_input)) {
-						break;
-					}
 				}
 				return _Result(::std::move(__working_input), ::std::move(__working_output), __from_state,
 					__to_state, encoding_error::ok, __handled_error);
 			}
+			else if constexpr (__detail::__is_blocked_transcodable_v<_WorkingInput, _FromEncoding,
+				                   _WorkingOutput, _ToEncoding, _FromState, _ToState>) {
+				return __detail::__blocked_transcode(::std::move(__working_input), __from_encoding,
+					::std::move(__working_output), __to_encoding, __from_error_handler, __to_error_handler,
+					__from_state, __to_state);
+			}
 			else {
 				_IntermediateCodePoint __intermediate[max_code_points_v<_UFromEncoding>];
 				bool __handled_error = false;
-				for (;;) {
+				while (!__detail::__adl::__adl_empty(__working_input)) {
 					auto __transcode_result
 						= __detail::__basic_transcode_one<__detail::__consume::__no>(::std::move(__working_input),
 						     __from_encoding, __intermediate, ::std::move(__working_output), __to_encoding,
@@ -168,11 +186,13 @@ namespace ztd { namespace text {
 							__to_state, __transcode_result.error_code, __transcode_result.handled_error);
 					}
 					__handled_error |= __transcode_result.handled_error;
-					__working_input  = ::std::move(__transcode_result.input);
-					__working_output = ::std::move(__transcode_result.output);
-					if (__detail::__adl::__adl_empty(__working_input)) {
-						break;
-					}
+					// the step may hand back a different (but equivalent) range type, e.g. a subrange for a span
+					__working_input = __detail::__reconstruct(::std::in_place_type<_WorkingInput>,
+						__detail::__adl::__adl_begin(__transcode_result.input),
+						__detail::__adl::__adl_end(__transcode_result.input));
+					__working_output = __detail::__reconstruct(::std::in_place_type<_WorkingOutput>,
+						__detail::__adl::__adl_begin(__transcode_result.output),
+						__detail::__adl::__adl_end(__transcode_result.output));
 				}
 				return _Result(::std::move(__working_input), ::std::move(__working_output), __from_state,
 					__to_state, encoding_error::ok, __handled_error);
@@ -215,10 +235,10 @@ namespace ztd { namespace text {
 
 		_ToState __to_state = make_encode_state(__to_encoding);
 
-		auto __stateful_result
-			= transcode_into(::std::forward<_Input>(__input), ::std::forward<_FromEncoding>(__from_encoding),
-			     ::std::forward<_ToEncoding>(__to_encoding), ::std::forward<_FromErrorHandler>(__from_error_handler),
-			     ::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
+		auto __stateful_result = transcode_into(::std::forward<_Input>(__input),
+			::std::forward<_FromEncoding>(__from_encoding), ::std::forward<_Output>(__output),
+			::std::forward<_ToEncoding>(__to_encoding), ::std::forward<_FromErrorHandler>(__from_error_handler),
+			::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
 
 		return __detail::__slice_to_stateless(::std::move(__stateful_result));
 	}
@@ -254,7 +274,8 @@ namespace ztd { namespace text {
 		_FromState __from_state = make_decode_state(__from_encoding);
 
 		return transcode_into(::std::forward<_Input>(__input), ::std::forward<_FromEncoding>(__from_encoding),
-			::std::forward<_ToEncoding>(__to_encoding), ::std::forward<_FromErrorHandler>(__from_error_handler),
+			::std::forward<_Output>(__output), ::std::forward<_ToEncoding>(__to_encoding),
+			::std::forward<_FromErrorHandler>(__from_error_handler),
 			::std::forward<_ToErrorHandler>(__to_error_handler), __from_state);
 	}
 
@@ -352,16 +373,167 @@ namespace ztd { namespace text {
 
 	//////
 	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
-	/// encoding for the output, which is then returned in a result structure with additional information about
-	/// success.
+	/// encoding into the output view, and counts how many code units the whole input needs even if the output is too
+	/// small to hold them.
 	///
-	/// @tparam _OutputContainer The container to default-construct and serialize data into. Typically, a @c
-	/// std::basic_string or a @c std::vector of some sort.
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in]     __output A sized output_view to write code units to. It may be empty, to only ask for the size.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	/// @param[in]     __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	/// @param[in]     __to_error_handler The error handler for the @p __to_encoding 's encode step.
+	/// @param[in,out] __from_state A reference to the associated state for the @p __from_encoding 's decode step.
+	/// @param[in,out] __to_state A reference to the associated state for the @p __to_encoding 's encode step.
+	///
+	/// @returns A ztd::text::preflight_result of the ztd::text::transcode_result from ztd::text::transcode_into, with
+	/// the total number of code units needed in @c required_size .
+	///
+	/// @remarks This works like ztd::text::transcode_into, except that running out of output space is not given to
+	/// the @p __to_error_handler (it only shows up as ztd::text::encoding_error::insufficient_output_space in the
+	/// result, which also does not count as a handled error). In that case, the rest of the input is transcoded into
+	/// an output that only counts code units and never writes anything, with copies of both states so that the
+	/// returned input and states can still be used to resume. The error handlers are called for errors in the rest of
+	/// the input just as they would be if the output were large enough, so that replacement characters are counted
+	/// too; @c required_size stops short if the rest of the input has an error that is not corrected. If either state
+	/// cannot be copied, the rest of the input is not counted at all (that would disturb the states needed to resume)
+	/// and @c required_size is ztd::text::preflight_result::unknown_size .
+	//////
+	template <typename _Input, typename _FromEncoding, typename _Output, typename _ToEncoding,
+		typename _FromErrorHandler, typename _ToErrorHandler, typename _FromState, typename _ToState>
+	constexpr auto transcode_into_preflight(_Input&& __input, _FromEncoding&& __from_encoding, _Output&& __output,
+		_ToEncoding&& __to_encoding, _FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler,
+		_FromState& __from_state, _ToState& __to_state) {
+		using _UFromErrorHandler = __detail::__remove_cvref_t<_FromErrorHandler>;
+		using _UToErrorHandler   = __detail::__remove_cvref_t<_ToErrorHandler>;
+		static_assert(__detail::__is_detected_v<__detail::__detect_adl_size, _Output>,
+			"the output of transcode_into_preflight must be a sized range (e.g. a ztd::text::span), so that the "
+			"number of code units written into it can be known");
+		static_assert(__detail::__is_decode_lossless_or_deliberate_v<__detail::__remove_cvref_t<_FromEncoding>,
+			              _UFromErrorHandler>,
+			"The decode (input) portion of this transcode is a lossy, non-injective operation. This means you may "
+			"lose data that you did not intend to lose; specify an 'in_handler' error handler parameter to "
+			"transcode_into_preflight(in, in_encoding, out, out_encoding, in_handler, ...) explicitly in order to "
+			"bypass this.");
+		static_assert(__detail::__is_encode_lossless_or_deliberate_v<__detail::__remove_cvref_t<_ToEncoding>,
+			              _UToErrorHandler>,
+			"The encode (output) portion of this transcode is a lossy, non-injective operation. This means you may "
+			"lose data that you did not intend to lose; specify an 'out_handler' error handler parameter to "
+			"transcode_into_preflight(in, in_encoding, out, out_encoding, in_handler, out_handler, ...) explicitly "
+			"in order to bypass this.");
+
+		using _FromTracker = __detail::__tracking_handler<_UFromErrorHandler>;
+		// the encode step writes into the caller's sized output, so it must always check for room
+		using _ToTracker   = __detail::__preflight_handler<_UToErrorHandler, false>;
+
+		const ::std::size_t __output_size = static_cast<::std::size_t>(__detail::__adl::__adl_size(__output));
+		bool __handled_error              = false;
+		_FromTracker __from_tracker { ::std::addressof(__from_error_handler), ::std::addressof(__handled_error) };
+		_ToTracker __to_tracker { ::std::addressof(__to_error_handler), ::std::addressof(__handled_error) };
+		auto __result = transcode_into(::std::forward<_Input>(__input), __from_encoding,
+			::std::forward<_Output>(__output), __to_encoding, __from_tracker, __to_tracker, __from_state,
+			__to_state);
+		__result.handled_error = __handled_error;
+		using _Preflight = preflight_result<decltype(__result)>;
+		::std::size_t __required_size
+			= __output_size - static_cast<::std::size_t>(__detail::__adl::__adl_size(__result.output));
+		if (__result.error_code == encoding_error::insufficient_output_space) {
+			if constexpr (::std::is_copy_constructible_v<_FromState> && ::std::is_copy_constructible_v<_ToState>) {
+				subrange<__detail::__counting_iterator, infinity_sentinel_t> __count_output(
+					__detail::__counting_iterator {}, infinity_sentinel);
+				_FromState __count_from_state = __from_state;
+				_ToState __count_to_state     = __to_state;
+				auto __count_result = transcode_into(__result.input, __from_encoding, __count_output, __to_encoding,
+					__from_error_handler, __to_error_handler, __count_from_state, __count_to_state);
+				__required_size += __detail::__adl::__adl_begin(__count_result.output).count();
+			}
+			else {
+				__required_size = _Preflight::unknown_size;
+			}
+		}
+		return _Preflight(::std::move(__result), __required_size);
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding into the output view, and counts how many code units the whole input needs even if the output is too
+	/// small to hold them.
+	///
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in]     __output A sized output_view to write code units to. It may be empty, to only ask for the size.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	/// @param[in]     __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	/// @param[in]     __to_error_handler The error handler for the @p __to_encoding 's encode step.
+	///
+	/// @returns A ztd::text::preflight_result of a ztd::text::stateless_transcode_result.
+	///
+	/// @remarks Both states are created using ztd::text::make_decode_state and ztd::text::make_encode_state.
+	//////
+	template <typename _Input, typename _FromEncoding, typename _Output, typename _ToEncoding,
+		typename _FromErrorHandler, typename _ToErrorHandler>
+	constexpr auto transcode_into_preflight(_Input&& __input, _FromEncoding&& __from_encoding, _Output&& __output,
+		_ToEncoding&& __to_encoding, _FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler) {
+		using _UFromEncoding = __detail::__remove_cvref_t<_FromEncoding>;
+		using _UToEncoding   = __detail::__remove_cvref_t<_ToEncoding>;
+		using _FromState     = decode_state_t<_UFromEncoding>;
+		using _ToState       = encode_state_t<_UToEncoding>;
+
+		_FromState __from_state = make_decode_state(__from_encoding);
+		_ToState __to_state     = make_encode_state(__to_encoding);
+
+		auto __stateful_result = transcode_into_preflight(::std::forward<_Input>(__input),
+			::std::forward<_FromEncoding>(__from_encoding), ::std::forward<_Output>(__output),
+			::std::forward<_ToEncoding>(__to_encoding), ::std::forward<_FromErrorHandler>(__from_error_handler),
+			::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
+
+		return __detail::__slice_to_stateless(::std::move(__stateful_result));
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding into the output view, and counts how many code units the whole input needs even if the output is too
+	/// small to hold them.
+	///
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in]     __output A sized output_view to write code units to. It may be empty, to only ask for the size.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	///
+	/// @returns A ztd::text::preflight_result of a ztd::text::stateless_transcode_result.
+	///
+	/// @remarks Both error handlers are created using default construction of a ztd::text::default_handler that is
+	/// marked as careless.
+	//////
+	template <typename _Input, typename _FromEncoding, typename _Output, typename _ToEncoding>
+	constexpr auto transcode_into_preflight(
+		_Input&& __input, _FromEncoding&& __from_encoding, _Output&& __output, _ToEncoding&& __to_encoding) {
+		__detail::__careless_handler __from_handler {};
+		__detail::__careless_handler __to_handler {};
+
+		return transcode_into_preflight(::std::forward<_Input>(__input),
+			::std::forward<_FromEncoding>(__from_encoding), ::std::forward<_Output>(__output),
+			::std::forward<_ToEncoding>(__to_encoding), __from_handler, __to_handler);
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding, appending them to the end of the given @p __output container.
 	///
 	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
 	/// produce intermediate code points.
 	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
 	/// intermediate code points.
+	/// @param[in,out] __output The container to append the code units to. Its existing contents, capacity and
+	/// allocator are kept.
 	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
 	/// final code units.
 	/// @param[in]     __from_error_handler The error handler for the @p __from_encoding 's decode step.
@@ -370,23 +542,56 @@ namespace ztd { namespace text {
 	/// @param[in,out] __to_state A reference to the associated state for the @p __to_encoding 's encode step.
 	///
 	/// @returns A ztd::text::transcode_result object that contains references to @p __from_state and @p __to_state and
-	/// an @c ".output" parameter that contains the @p _OutputContainer specified. If the container has a @c ".reserve"
-	/// function, it is and some multiple of the input's size is used to pre-size the container, to aid with @c
-	/// "push_back"/@c "insert" reallocation pains.
+	/// whose @c ".output" is a reference to @p __output.
+	///
+	/// @remarks If the container has a @c ".reserve" function and the input is sized, it is reserved once with its
+	/// current size plus the input's size times ztd::text::max_transcode_expansion_v, so that a container which
+	/// already has that much capacity (for example, one that is cleared and reused across calls) does not allocate at
+	/// all. When ztd::text::transcode_into would only copy the input (see its remarks) and the container is contiguous
+	/// with a @c resize member function, it is instead grown by the input's size and copied into directly. To use a
+	/// specific allocator, pass in a container constructed with it.
 	//////
-	template <typename _OutputContainer, typename _Input, typename _FromEncoding, typename _ToEncoding,
+	template <typename _Input, typename _FromEncoding, typename _OutputContainer, typename _ToEncoding,
 		typename _FromErrorHandler, typename _ToErrorHandler, typename _FromState, typename _ToState>
-	constexpr auto transcode_to(_Input&& __input, _FromEncoding&& __from_encoding, _ToEncoding&& __to_encoding,
-		_FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler, _FromState& __from_state,
-		_ToState& __to_state) {
+	constexpr auto transcode_append(_Input&& __input, _FromEncoding&& __from_encoding, _OutputContainer& __output,
+		_ToEncoding&& __to_encoding, _FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler,
+		_FromState& __from_state, _ToState& __to_state) {
+		if constexpr (__detail::__is_exact_size_capable_v<_Input, _OutputContainer>) {
+			using _OutputValueType = __detail::__range_value_type_t<_OutputContainer>;
+			if constexpr (__detail::__is_bulk_copyable_v<_Input, _FromEncoding, subrange<_OutputValueType*>,
+				              _ToEncoding, _FromErrorHandler>) {
+				if (__detail::__is_bulk_allowed()) {
+					// a bitwise copy writes exactly as many code units as it reads: grow the container once and
+					// copy straight into it, rather than through a std::back_inserter
+					const ::std::size_t __initial_size
+						= static_cast<::std::size_t>(__detail::__adl::__adl_size(__output));
+					const ::std::size_t __size = static_cast<::std::size_t>(__detail::__adl::__adl_size(__input));
+					__output.resize(__initial_size + __size);
+					_OutputValueType* __output_first = __detail::__adl::__adl_data(__output) + __initial_size;
+					subrange<_OutputValueType*> __output_view(__output_first, __output_first + __size);
+					auto __stateful_result = transcode_into(::std::forward<_Input>(__input),
+						::std::forward<_FromEncoding>(__from_encoding), __output_view,
+						::std::forward<_ToEncoding>(__to_encoding),
+						::std::forward<_FromErrorHandler>(__from_error_handler),
+						::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
+					__output.resize(__initial_size
+						+ static_cast<::std::size_t>(
+						     __detail::__adl::__adl_begin(__stateful_result.output) - __output_first));
+					return __detail::__replace_result_output(::std::move(__stateful_result), __output);
+				}
+			}
+		}
 
-		_OutputContainer __output {};
 		if constexpr (__detail::__is_detected_v<__detail::__detect_adl_size, _Input>) {
 			using _SizeType = decltype(__detail::__adl::__adl_size(__input));
 			if constexpr (__detail::__is_detected_v<__detail::__detect_reserve_with_size_type, _OutputContainer,
 				              _SizeType>) {
-				// TODO: better estimates
-				__output.reserve(__detail::__adl::__adl_size(__input));
+				using _UFromEncoding    = __detail::__remove_cvref_t<_FromEncoding>;
+				using _UToEncoding      = __detail::__remove_cvref_t<_ToEncoding>;
+				auto __output_size_hint = __detail::__adl::__adl_size(__input);
+				__output_size_hint *= max_transcode_expansion_v<_UFromEncoding, _UToEncoding>;
+				__output_size_hint += static_cast<_SizeType>(__detail::__adl::__adl_size(__output));
+				__output.reserve(__output_size_hint);
 			}
 		}
 
@@ -395,6 +600,197 @@ namespace ztd { namespace text {
 			::std::forward<_FromEncoding>(__from_encoding), ::std::move(__insert_view),
 			::std::forward<_ToEncoding>(__to_encoding), ::std::forward<_FromErrorHandler>(__from_error_handler),
 			::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
+		return __detail::__replace_result_output(::std::move(__stateful_result), __output);
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding, appending them to the end of the given @p __output container.
+	///
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in,out] __output The container to append the code units to.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	/// @param[in]     __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	/// @param[in]     __to_error_handler The error handler for the @p __to_encoding 's encode step.
+	/// @param[in,out] __from_state A reference to the associated state for the @p __from_encoding 's decode step.
+	///
+	/// @returns A ztd::text::stateless_transcode_result object whose @c ".output" is a reference to @p __output.
+	///
+	/// @remarks A default state for the encode step of the operation is create using ztd::text::make_encode_state.
+	//////
+	template <typename _Input, typename _FromEncoding, typename _OutputContainer, typename _ToEncoding,
+		typename _FromErrorHandler, typename _ToErrorHandler, typename _FromState>
+	constexpr auto transcode_append(_Input&& __input, _FromEncoding&& __from_encoding, _OutputContainer& __output,
+		_ToEncoding&& __to_encoding, _FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler,
+		_FromState& __from_state) {
+		using _UToEncoding = __detail::__remove_cvref_t<_ToEncoding>;
+		using _ToState     = encode_state_t<_UToEncoding>;
+
+		_ToState __to_state = make_encode_state(__to_encoding);
+
+		return __detail::__slice_to_stateless(transcode_append(::std::forward<_Input>(__input),
+			::std::forward<_FromEncoding>(__from_encoding), __output, ::std::forward<_ToEncoding>(__to_encoding),
+			::std::forward<_FromErrorHandler>(__from_error_handler),
+			::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state));
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding, appending them to the end of the given @p __output container.
+	///
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in,out] __output The container to append the code units to.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	/// @param[in]     __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	/// @param[in]     __to_error_handler The error handler for the @p __to_encoding 's encode step.
+	///
+	/// @returns A ztd::text::stateless_transcode_result object whose @c ".output" is a reference to @p __output.
+	///
+	/// @remarks A default state for the decode step of the operation is create using ztd::text::make_decode_state.
+	//////
+	template <typename _Input, typename _FromEncoding, typename _OutputContainer, typename _ToEncoding,
+		typename _FromErrorHandler, typename _ToErrorHandler>
+	constexpr auto transcode_append(_Input&& __input, _FromEncoding&& __from_encoding, _OutputContainer& __output,
+		_ToEncoding&& __to_encoding, _FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler) {
+		using _UFromEncoding = __detail::__remove_cvref_t<_FromEncoding>;
+		using _FromState     = decode_state_t<_UFromEncoding>;
+
+		_FromState __from_state = make_decode_state(__from_encoding);
+
+		return transcode_append(::std::forward<_Input>(__input), ::std::forward<_FromEncoding>(__from_encoding),
+			__output, ::std::forward<_ToEncoding>(__to_encoding),
+			::std::forward<_FromErrorHandler>(__from_error_handler),
+			::std::forward<_ToErrorHandler>(__to_error_handler), __from_state);
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding, appending them to the end of the given @p __output container.
+	///
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in,out] __output The container to append the code units to.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	/// @param[in]     __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	///
+	/// @returns A ztd::text::stateless_transcode_result object whose @c ".output" is a reference to @p __output.
+	///
+	/// @remarks A @c to_error_handler for the encode step of the operation is created using default construction of a
+	/// ztd::text::default_handler that is marked as careless.
+	//////
+	template <typename _Input, typename _FromEncoding, typename _OutputContainer, typename _ToEncoding,
+		typename _FromErrorHandler>
+	constexpr auto transcode_append(_Input&& __input, _FromEncoding&& __from_encoding, _OutputContainer& __output,
+		_ToEncoding&& __to_encoding, _FromErrorHandler&& __from_error_handler) {
+		auto __handler = __detail::__duplicate_or_be_careless(__from_error_handler);
+
+		return transcode_append(::std::forward<_Input>(__input), ::std::forward<_FromEncoding>(__from_encoding),
+			__output, ::std::forward<_ToEncoding>(__to_encoding),
+			::std::forward<_FromErrorHandler>(__from_error_handler), __handler);
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding, appending them to the end of the given @p __output container.
+	///
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in,out] __output The container to append the code units to.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	///
+	/// @returns A ztd::text::stateless_transcode_result object whose @c ".output" is a reference to @p __output.
+	///
+	/// @remarks A @c from_error_handler for the decode step of the operation is created using default construction of
+	/// a ztd::text::default_handler that is marked as careless.
+	//////
+	template <typename _Input, typename _FromEncoding, typename _OutputContainer, typename _ToEncoding>
+	constexpr auto transcode_append(_Input&& __input, _FromEncoding&& __from_encoding, _OutputContainer& __output,
+		_ToEncoding&& __to_encoding) {
+		__detail::__careless_handler __handler {};
+
+		return transcode_append(::std::forward<_Input>(__input), ::std::forward<_FromEncoding>(__from_encoding),
+			__output, ::std::forward<_ToEncoding>(__to_encoding), __handler);
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding, appending them to the end of the given @p __output container.
+	///
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	/// @param[in,out] __output The container to append the code units to.
+	///
+	/// @returns A ztd::text::stateless_transcode_result object whose @c ".output" is a reference to @p __output.
+	///
+	/// @remarks The from encoding is picked from the input's @c value_type using
+	/// ztd::text::default_code_unit_encoding, and a careless ztd::text::default_handler is used for the decode step.
+	//////
+	template <typename _Input, typename _ToEncoding, typename _OutputContainer>
+	constexpr auto transcode_append(_Input&& __input, _ToEncoding&& __to_encoding, _OutputContainer& __output) {
+		using _UInput        = __detail::__remove_cvref_t<_Input>;
+		using _UFromEncoding = default_code_unit_encoding_t<__detail::__range_value_type_t<_UInput>>;
+
+		__detail::__careless_handler __handler {};
+		_UFromEncoding __from_encoding {};
+
+		return transcode_append(::std::forward<_Input>(__input), __from_encoding, __output,
+			::std::forward<_ToEncoding>(__to_encoding), __handler);
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding for the output, which is then returned in a result structure with additional information about
+	/// success.
+	///
+	/// @tparam _OutputContainer The container to default-construct and serialize data into. Typically, a @c
+	/// std::basic_string or a @c std::vector of some sort.
+	///
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	/// @param[in]     __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	/// @param[in]     __to_error_handler The error handler for the @p __to_encoding 's encode step.
+	/// @param[in,out] __from_state A reference to the associated state for the @p __from_encoding 's decode step.
+	/// @param[in,out] __to_state A reference to the associated state for the @p __to_encoding 's encode step.
+	///
+	/// @returns A ztd::text::transcode_result object that contains references to @p __from_state and @p __to_state and
+	/// an @c ".output" parameter that contains the @p _OutputContainer specified. If the container has a @c ".reserve"
+	/// function and the input is sized, it is reserved once with the input's size times
+	/// ztd::text::max_transcode_expansion_v, so that @c "push_back"/@c "insert" does not have to reallocate.
+	///
+	/// @remarks When ztd::text::transcode_into would only copy the input (see its remarks) and @p _OutputContainer is
+	/// a contiguous container with a @c resize member function, the container is instead resized to the input's size
+	/// and copied into directly.
+	//////
+	template <typename _OutputContainer, typename _Input, typename _FromEncoding, typename _ToEncoding,
+		typename _FromErrorHandler, typename _ToErrorHandler, typename _FromState, typename _ToState>
+	constexpr auto transcode_to(_Input&& __input, _FromEncoding&& __from_encoding, _ToEncoding&& __to_encoding,
+		_FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler, _FromState& __from_state,
+		_ToState& __to_state) {
+		_OutputContainer __output {};
+		auto __stateful_result = transcode_append(::std::forward<_Input>(__input),
+			::std::forward<_FromEncoding>(__from_encoding), __output, ::std::forward<_ToEncoding>(__to_encoding),
+			::std::forward<_FromErrorHandler>(__from_error_handler),
+			::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
 		return __detail::__replace_result_output(::std::move(__stateful_result), ::std::move(__output));
 	}
 
@@ -576,6 +972,144 @@ namespace ztd { namespace text {
 			::std::forward<_Input>(__input), __from_encoding, ::std::forward<_ToEncoding>(__to_encoding), __handler);
 	}
 
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding, in an @p _OutputContainer whose storage is allocated only once and at exactly the right size.
+	///
+	/// @tparam _OutputContainer The container to default-construct and serialize data into. Typically, a @c
+	/// std::basic_string or a @c std::vector of some sort.
+	///
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	/// @param[in]     __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	/// @param[in]     __to_error_handler The error handler for the @p __to_encoding 's encode step.
+	/// @param[in,out] __from_state A reference to the associated state for the @p __from_encoding 's decode step.
+	/// @param[in,out] __to_state A reference to the associated state for the @p __to_encoding 's encode step.
+	///
+	/// @returns A ztd::text::transcode_result object, exactly like the one from ztd::text::transcode_to.
+	///
+	/// @remarks If @p __input is a sized range that can be read more than once and @p _OutputContainer is a
+	/// contiguous container with a @c resize member function, the input is first transcoded into an output that only
+	/// counts the code units (with copies of both states). The container is then resized once, to the exact count,
+	/// and transcoded into directly rather than through a @c std::back_inserter. The counting pass never calls
+	/// either error handler: if it finds an error, or if the input or container do not qualify, this does exactly
+	/// what ztd::text::transcode_to does.
+	//////
+	template <typename _OutputContainer, typename _Input, typename _FromEncoding, typename _ToEncoding,
+		typename _FromErrorHandler, typename _ToErrorHandler, typename _FromState, typename _ToState>
+	constexpr auto transcode_to_exact(_Input&& __input, _FromEncoding&& __from_encoding,
+		_ToEncoding&& __to_encoding, _FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler,
+		_FromState& __from_state, _ToState& __to_state) {
+		if constexpr (__detail::__is_exact_size_capable_v<_Input, _OutputContainer>
+			&& ::std::is_copy_constructible_v<_FromState> && ::std::is_copy_constructible_v<_ToState>) {
+			using _CountFromErrorHandler = __detail::__exact_size_count_handler_t<_FromErrorHandler>;
+			using _CountToErrorHandler   = __detail::__exact_size_count_handler_t<_ToErrorHandler>;
+			using _OutputValueType       = __detail::__range_value_type_t<_OutputContainer>;
+
+			_FromState __count_from_state = __from_state;
+			_ToState __count_to_state     = __to_state;
+			_CountFromErrorHandler __count_from_error_handler {};
+			_CountToErrorHandler __count_to_error_handler {};
+			auto __count_result = transcode_into(__input, __from_encoding,
+				subrange<__detail::__counting_iterator, infinity_sentinel_t>(
+				     __detail::__counting_iterator {}, infinity_sentinel),
+				__to_encoding,
+				__count_from_error_handler, __count_to_error_handler, __count_from_state, __count_to_state);
+			if (__count_result.error_code == encoding_error::ok && !__count_result.handled_error) {
+				const ::std::size_t __count = __detail::__adl::__adl_begin(__count_result.output).count();
+				_OutputContainer __output {};
+				__output.resize(__count);
+				_OutputValueType* __output_first = __detail::__adl::__adl_data(__output);
+				subrange<_OutputValueType*> __output_view(__output_first, __output_first + __count);
+				auto __stateful_result = transcode_into(::std::forward<_Input>(__input),
+					::std::forward<_FromEncoding>(__from_encoding), __output_view,
+					::std::forward<_ToEncoding>(__to_encoding),
+					::std::forward<_FromErrorHandler>(__from_error_handler),
+					::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
+				return __detail::__replace_result_output(::std::move(__stateful_result), ::std::move(__output));
+			}
+		}
+		return transcode_to<_OutputContainer>(::std::forward<_Input>(__input),
+			::std::forward<_FromEncoding>(__from_encoding), ::std::forward<_ToEncoding>(__to_encoding),
+			::std::forward<_FromErrorHandler>(__from_error_handler),
+			::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding, in an @p _OutputContainer whose storage is allocated only once and at exactly the right size.
+	///
+	/// @tparam _OutputContainer The container to default-construct and serialize data into. Typically, a @c
+	/// std::basic_string or a @c std::vector of some sort.
+	///
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	/// @param[in]     __from_error_handler The error handler for the @p __from_encoding 's decode step.
+	/// @param[in]     __to_error_handler The error handler for the @p __to_encoding 's encode step.
+	///
+	/// @returns A ztd::text::stateless_transcode_result object that contains references to an @c ".output" parameter
+	/// that contains the @p _OutputContainer specified.
+	///
+	/// @remarks Both states are created using ztd::text::make_decode_state and ztd::text::make_encode_state.
+	//////
+	template <typename _OutputContainer, typename _Input, typename _FromEncoding, typename _ToEncoding,
+		typename _FromErrorHandler, typename _ToErrorHandler>
+	constexpr auto transcode_to_exact(_Input&& __input, _FromEncoding&& __from_encoding,
+		_ToEncoding&& __to_encoding, _FromErrorHandler&& __from_error_handler,
+		_ToErrorHandler&& __to_error_handler) {
+		using _UFromEncoding = __detail::__remove_cvref_t<_FromEncoding>;
+		using _UToEncoding   = __detail::__remove_cvref_t<_ToEncoding>;
+		using _FromState     = decode_state_t<_UFromEncoding>;
+		using _ToState       = encode_state_t<_UToEncoding>;
+
+		_FromState __from_state = make_decode_state(__from_encoding);
+		_ToState __to_state     = make_encode_state(__to_encoding);
+
+		return transcode_to_exact<_OutputContainer>(::std::forward<_Input>(__input),
+			::std::forward<_FromEncoding>(__from_encoding), ::std::forward<_ToEncoding>(__to_encoding),
+			::std::forward<_FromErrorHandler>(__from_error_handler),
+			::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state);
+	}
+
+	//////
+	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
+	/// encoding, in an @p _OutputContainer whose storage is allocated only once and at exactly the right size.
+	///
+	/// @tparam _OutputContainer The container to default-construct and serialize data into. Typically, a @c
+	/// std::basic_string or a @c std::vector of some sort.
+	///
+	/// @param[in]     __input An input_view to read code units from and use in the decode operation that will
+	/// produce intermediate code points.
+	/// @param[in]     __from_encoding The encoding that will be used to decode the input's code units into
+	/// intermediate code points.
+	/// @param[in]     __to_encoding The encoding that will be used to encode the intermediate code points into the
+	/// final code units.
+	///
+	/// @returns A ztd::text::stateless_transcode_result object that contains references to an @c ".output" parameter
+	/// that contains the @p _OutputContainer specified.
+	///
+	/// @remarks Both error handlers are created using default construction of a ztd::text::default_handler that is
+	/// marked as careless.
+	//////
+	template <typename _OutputContainer, typename _Input, typename _FromEncoding, typename _ToEncoding>
+	constexpr auto transcode_to_exact(
+		_Input&& __input, _FromEncoding&& __from_encoding, _ToEncoding&& __to_encoding) {
+		__detail::__careless_handler __from_handler {};
+		__detail::__careless_handler __to_handler {};
+
+		return transcode_to_exact<_OutputContainer>(::std::forward<_Input>(__input),
+			::std::forward<_FromEncoding>(__from_encoding), ::std::forward<_ToEncoding>(__to_encoding),
+			__from_handler, __to_handler);
+	}
+
 	//////
 	/// @brief Converts the code units of the given input view through the from encoding to code units of the to
 	/// encoding for the output, which is then returned in a result structure with additional information about
@@ -604,14 +1138,32 @@ namespace ztd { namespace text {
 	constexpr auto transcode(_Input&& __input, _FromEncoding&& __from_encoding, _ToEncoding&& __to_encoding,
 		_FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler, _FromState& __from_state,
 		_ToState& __to_state) {
+		if constexpr (__detail::__is_exact_size_capable_v<_Input, _OutputContainer>) {
+			using _OutputValueType = __detail::__range_value_type_t<_OutputContainer>;
+			if constexpr (__detail::__is_bulk_copyable_v<_Input, _FromEncoding, subrange<_OutputValueType*>,
+				              _ToEncoding, _FromErrorHandler>) {
+				if (__detail::__is_bulk_allowed()) {
+					// only a copy: see transcode_to
+					return transcode_to<_OutputContainer>(::std::forward<_Input>(__input),
+						::std::forward<_FromEncoding>(__from_encoding),
+						::std::forward<_ToEncoding>(__to_encoding),
+						::std::forward<_FromErrorHandler>(__from_error_handler),
+						::std::forward<_ToErrorHandler>(__to_error_handler), __from_state, __to_state)
+						.output;
+				}
+			}
+		}
 
 		_OutputContainer __output {};
 		if constexpr (__detail::__is_detected_v<__detail::__detect_adl_size, _Input>) {
 			using _SizeType = decltype(__detail::__adl::__adl_size(__input));
 			if constexpr (__detail::__is_detected_v<__detail::__detect_reserve_with_size_type, _OutputContainer,
 				              _SizeType>) {
-				// TODO: better estimates
-				__output.reserve(__detail::__adl::__adl_size(__input));
+				using _UFromEncoding    = __detail::__remove_cvref_t<_FromEncoding>;
+				using _UToEncoding      = __detail::__remove_cvref_t<_ToEncoding>;
+				auto __output_size_hint = __detail::__adl::__adl_size(__input);
+				__output_size_hint *= max_transcode_expansion_v<_UFromEncoding, _UToEncoding>;
+				__output.reserve(__output_size_hint);
 			}
 		}
 
@@ -208,13 +208,12 @@ namespace ztd { namespace text {
 		}
 
 		template <typename _Input, typename _Output, typename _FromState, typename _ToState, typename _DesiredOutput>
-		constexpr transcode_result<_Input, __detail::__remove_cvref_t<_DesiredOutput>, _FromState, _ToState>
+		constexpr transcode_result<_Input, _DesiredOutput, _FromState, _ToState>
 		__replace_result_output(transcode_result<_Input, _Output, _FromState, _ToState>&& __result,
 			_DesiredOutput&& __desired_output) noexcept(::std::
 			     is_nothrow_constructible_v<transcode_result<_Input, _Output, _FromState, _ToState>, _Input&&,
 			          _DesiredOutput, _FromState&, _ToState&, encoding_error, bool>) {
-			using _Result
-				= transcode_result<_Input, __detail::__remove_cvref_t<_DesiredOutput>, _FromState, _ToState>;
+			using _Result = transcode_result<_Input, _DesiredOutput, _FromState, _ToState>;
 			return _Result(::std::move(__result.input), ::std::forward<_DesiredOutput>(__desired_output),
 				__result.from_state, __result.to_state, __result.error_code, __result.handled_error);
 		}
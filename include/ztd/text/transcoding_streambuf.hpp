@@ -0,0 +1,349 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the 
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#pragma once
+
+#ifndef ZTD_TEXT_TRANSCODING_STREAMBUF_HPP
+#define ZTD_TEXT_TRANSCODING_STREAMBUF_HPP
+
+#include <ztd/text/version.hpp>
+
+#include <ztd/text/code_unit.hpp>
+#include <ztd/text/encoding_error.hpp>
+#include <ztd/text/error_handler.hpp>
+#include <ztd/text/streaming_transcoder.hpp>
+
+#include <ztd/text/detail/span.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ztd { namespace text {
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
+
+	//////
+	/// @brief A stream buffer whose characters are the code units of @p _FromEncoding , and which reads and writes
+	/// the code units of @p _ToEncoding from and to another, underlying stream buffer.
+	///
+	/// @tparam _FromEncoding The encoding of this stream buffer's own characters (e.g., what is written to a
+	/// @c std::basic_ostream using it).
+	/// @tparam _ToEncoding The encoding of the bytes in the underlying stream buffer (e.g., what ends up in a file).
+	/// @tparam _FromErrorHandler The error handler for failures in @p _FromEncoding , in either direction.
+	/// @tparam _ToErrorHandler The error handler for failures in @p _ToEncoding , in either direction.
+	///
+	/// @remarks Writes are collected in a buffer and converted one full buffer at a time with a
+	/// ztd::text::streaming_transcoder, then given to the underlying stream buffer in one call; reads fill a buffer
+	/// the same way. Each read takes what the underlying stream buffer reports as available (see
+	/// @c std::basic_streambuf::in_avail ), or asks it for a full buffer if it reports nothing: reading from an
+	/// interactive source that cannot say what it has may then wait for a full buffer (or the end), so give it a
+	/// small buffer size. A sequence split between two buffers is carried over to the next one. Code units of
+	/// @p _ToEncoding that are wider than a byte are read and written in the machine's byte order. Anything still
+	/// held back is written out when this object is destroyed. This can be used in place of the deprecated
+	/// @c std::wbuffer_convert .
+	//////
+	template <typename _FromEncoding, typename _ToEncoding, typename _FromErrorHandler = default_handler,
+		typename _ToErrorHandler = default_handler>
+	class basic_transcoding_streambuf : public ::std::basic_streambuf<code_unit_t<_FromEncoding>> {
+	private:
+		using __base_t          = ::std::basic_streambuf<code_unit_t<_FromEncoding>>;
+		using __writer_t = streaming_transcoder<_FromEncoding, _ToEncoding, _FromErrorHandler, _ToErrorHandler>;
+		using __reader_t = streaming_transcoder<_ToEncoding, _FromEncoding, _ToErrorHandler, _FromErrorHandler>;
+		using _ExternalCodeUnit = code_unit_t<_ToEncoding>;
+
+	public:
+		//////
+		/// @brief The character type of this stream buffer, which is the code unit type of @p _FromEncoding .
+		///
+		//////
+		using char_type = typename __base_t::char_type;
+		//////
+		/// @brief The character traits type of this stream buffer.
+		///
+		//////
+		using traits_type = typename __base_t::traits_type;
+		//////
+		/// @brief The integer type used to represent characters and end of file.
+		///
+		//////
+		using int_type = typename __base_t::int_type;
+		//////
+		/// @brief The stream position type.
+		///
+		//////
+		using pos_type = typename __base_t::pos_type;
+		//////
+		/// @brief The stream offset type.
+		///
+		//////
+		using off_type = typename __base_t::off_type;
+		//////
+		/// @brief The encoding of this stream buffer's characters.
+		///
+		//////
+		using from_encoding_type = _FromEncoding;
+		//////
+		/// @brief The encoding of the underlying stream buffer's bytes.
+		///
+		//////
+		using to_encoding_type = _ToEncoding;
+
+		//////
+		/// @brief The number of characters buffered in each direction if none is given.
+		///
+		//////
+		static constexpr ::std::size_t default_buffer_size = 8192;
+
+		//////
+		/// @brief Constructs a ztd::text::basic_transcoding_streambuf over @p __underlying .
+		///
+		/// @param[in] __underlying The stream buffer the @p _ToEncoding code units are read from and written to. It
+		/// is not owned, and must outlive this object.
+		/// @param[in] __buffer_size The number of characters to collect before converting them, and the number of
+		/// code units to read from @p __underlying at a time.
+		/// @param[in] __from_encoding The encoding of this stream buffer's characters.
+		/// @param[in] __to_encoding The encoding of the underlying stream buffer's bytes.
+		/// @param[in] __from_error_handler The error handler for failures in @p __from_encoding .
+		/// @param[in] __to_error_handler The error handler for failures in @p __to_encoding .
+		//////
+		explicit basic_transcoding_streambuf(::std::basic_streambuf<char>* __underlying,
+			::std::size_t __buffer_size = default_buffer_size, _FromEncoding __from_encoding = _FromEncoding {},
+			_ToEncoding __to_encoding = _ToEncoding {},
+			_FromErrorHandler __from_error_handler = _FromErrorHandler {},
+			_ToErrorHandler __to_error_handler     = _ToErrorHandler {})
+		: __base_t()
+		, _M_underlying(__underlying)
+		, _M_buffer_size((::std::max)({ __buffer_size, max_code_units_v<_FromEncoding>,
+			     max_code_units_v<_ToEncoding> }))
+		, _M_writer(__from_encoding, __to_encoding, __from_error_handler, __to_error_handler)
+		, _M_reader(::std::move(__to_encoding), ::std::move(__from_encoding), ::std::move(__to_error_handler),
+			     ::std::move(__from_error_handler))
+		, _M_put_buffer()
+		, _M_write_buffer()
+		, _M_get_buffer()
+		, _M_read_buffer()
+		, _M_read_first(0)
+		, _M_read_size(0) {
+		}
+
+		basic_transcoding_streambuf(const basic_transcoding_streambuf&) = delete;
+		basic_transcoding_streambuf& operator=(const basic_transcoding_streambuf&) = delete;
+
+		//////
+		/// @brief Writes out anything that is still buffered, including an incomplete sequence at the very end
+		/// (which goes through the @p _FromErrorHandler ).
+		///
+		/// @remarks Like @c std::basic_filebuf , any exception thrown while doing so (e.g., by an error handler) is
+		/// caught and not rethrown. Call @c pubsync() beforehand to see errors in what is still buffered.
+		//////
+		~basic_transcoding_streambuf() override {
+			try {
+				if (this->_M_sync_out()) {
+					this->_M_finish_out();
+				}
+			}
+			catch (...) {
+			}
+		}
+
+		//////
+		/// @brief The underlying stream buffer.
+		///
+		//////
+		::std::basic_streambuf<char>* rdbuf() const noexcept {
+			return this->_M_underlying;
+		}
+
+	protected:
+		int_type overflow(int_type __ch = traits_type::eof()) override {
+			if (this->_M_put_buffer.empty()) {
+				this->_M_put_buffer.resize(this->_M_buffer_size);
+				this->_M_write_buffer.resize(this->_M_buffer_size);
+				this->setp(this->_M_put_buffer.data(), this->_M_put_buffer.data() + this->_M_put_buffer.size());
+			}
+			else if (!this->_M_sync_out()) {
+				return traits_type::eof();
+			}
+			if (traits_type::eq_int_type(__ch, traits_type::eof())) {
+				return traits_type::not_eof(__ch);
+			}
+			*this->pptr() = traits_type::to_char_type(__ch);
+			this->pbump(1);
+			return __ch;
+		}
+
+		::std::streamsize xsputn(const char_type* __data, ::std::streamsize __size) override {
+			if (__size < static_cast<::std::streamsize>(this->_M_buffer_size)) {
+				return __base_t::xsputn(__data, __size);
+			}
+			// large enough to be its own block: convert it straight from the caller's memory
+			if (this->_M_write_buffer.empty()) {
+				this->_M_write_buffer.resize(this->_M_buffer_size);
+			}
+			if (!this->_M_sync_out()
+				|| !this->_M_transcode_out(
+				     ::ztd::text::span<const char_type>(__data, static_cast<::std::size_t>(__size)))) {
+				return 0;
+			}
+			return __size;
+		}
+
+		int sync() override {
+			if (!this->_M_sync_out()) {
+				return -1;
+			}
+			return this->_M_underlying->pubsync();
+		}
+
+		int_type underflow() override {
+			if (this->gptr() < this->egptr()) {
+				return traits_type::to_int_type(*this->gptr());
+			}
+			if (this->_M_get_buffer.empty()) {
+				this->_M_get_buffer.resize(this->_M_buffer_size);
+				this->_M_read_buffer.resize(this->_M_buffer_size);
+			}
+			const ::std::size_t __read_capacity = this->_M_read_buffer.size() * sizeof(_ExternalCodeUnit);
+			char* __read_bytes                  = reinterpret_cast<char*>(this->_M_read_buffer.data());
+			char_type* __get_first              = this->_M_get_buffer.data();
+			for (;;) {
+				const ::std::size_t __available
+					= this->_M_read_size / sizeof(_ExternalCodeUnit) - this->_M_read_first;
+				if (__available != 0) {
+					auto __result = this->_M_reader.push(
+						::ztd::text::span<const _ExternalCodeUnit>(
+						     this->_M_read_buffer.data() + this->_M_read_first, __available),
+						::ztd::text::span<char_type>(this->_M_get_buffer));
+					if (__result.error_code != encoding_error::ok
+						&& __result.error_code != encoding_error::insufficient_output_space) {
+						return traits_type::eof();
+					}
+					this->_M_read_first += __available - __result.input.size();
+					const ::std::size_t __produced = this->_M_get_buffer.size() - __result.output.size();
+					if (__produced != 0) {
+						this->setg(__get_first, __get_first, __get_first + __produced);
+						return traits_type::to_int_type(*__get_first);
+					}
+					// everything read so far is part of an unfinished sequence: read more
+				}
+				// move the bytes of a partially-read code unit to the front, and fill in the rest
+				const ::std::size_t __first_byte = this->_M_read_first * sizeof(_ExternalCodeUnit);
+				const ::std::size_t __left_over  = this->_M_read_size - __first_byte;
+				::std::memmove(__read_bytes, __read_bytes + __first_byte, __left_over);
+				this->_M_read_first = 0;
+				this->_M_read_size  = __left_over;
+				::std::streamsize __wanted = static_cast<::std::streamsize>(__read_capacity - __left_over);
+				// if the underlying buffer says how much it has ready, take no more than that; otherwise, ask for a
+				// full buffer rather than trickling in a byte at a time
+				const ::std::streamsize __in_underlying = this->_M_underlying->in_avail();
+				if (__in_underlying > 0) {
+					__wanted = (::std::min)(__wanted, __in_underlying);
+				}
+				const ::std::streamsize __read = this->_M_underlying->sgetn(__read_bytes + __left_over, __wanted);
+				if (__read <= 0) {
+					// the end: anything still held back can never be finished
+					auto __result = this->_M_reader.finish(::ztd::text::span<char_type>(this->_M_get_buffer));
+					const ::std::size_t __produced = this->_M_get_buffer.size() - __result.output.size();
+					if (__produced == 0) {
+						return traits_type::eof();
+					}
+					this->setg(__get_first, __get_first, __get_first + __produced);
+					return traits_type::to_int_type(*__get_first);
+				}
+				this->_M_read_size += static_cast<::std::size_t>(__read);
+			}
+		}
+
+	private:
+		bool _M_write_external(::std::size_t __size) {
+			const ::std::streamsize __bytes = static_cast<::std::streamsize>(__size * sizeof(_ExternalCodeUnit));
+			return this->_M_underlying->sputn(reinterpret_cast<const char*>(this->_M_write_buffer.data()), __bytes)
+				== __bytes;
+		}
+
+		bool _M_transcode_out(::ztd::text::span<const char_type> __input) {
+			for (;;) {
+				auto __result
+					= this->_M_writer.push(__input, ::ztd::text::span<_ExternalCodeUnit>(this->_M_write_buffer));
+				if (!this->_M_write_external(this->_M_write_buffer.size() - __result.output.size())) {
+					return false;
+				}
+				if (__result.error_code != encoding_error::insufficient_output_space) {
+					return __result.error_code == encoding_error::ok;
+				}
+				__input = __result.input;
+			}
+		}
+
+		bool _M_sync_out() {
+			if (this->pbase() == this->pptr()) {
+				return true;
+			}
+			bool __success = this->_M_transcode_out(::ztd::text::span<const char_type>(
+				this->pbase(), static_cast<::std::size_t>(this->pptr() - this->pbase())));
+			this->setp(this->_M_put_buffer.data(), this->_M_put_buffer.data() + this->_M_put_buffer.size());
+			return __success;
+		}
+
+		bool _M_finish_out() {
+			if (this->_M_writer.pending_code_units().empty()) {
+				return true;
+			}
+			for (;;) {
+				auto __result = this->_M_writer.finish(::ztd::text::span<_ExternalCodeUnit>(this->_M_write_buffer));
+				if (!this->_M_write_external(this->_M_write_buffer.size() - __result.output.size())) {
+					return false;
+				}
+				if (__result.error_code != encoding_error::insufficient_output_space) {
+					return __result.error_code == encoding_error::ok;
+				}
+			}
+		}
+
+		::std::basic_streambuf<char>* _M_underlying;
+		::std::size_t _M_buffer_size;
+		__writer_t _M_writer;
+		__reader_t _M_reader;
+		::std::vector<char_type> _M_put_buffer;
+		::std::vector<_ExternalCodeUnit> _M_write_buffer;
+		::std::vector<char_type> _M_get_buffer;
+		::std::vector<_ExternalCodeUnit> _M_read_buffer;
+		::std::size_t _M_read_first;
+		::std::size_t _M_read_size;
+	};
+
+	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
+}} // namespace ztd::text
+
+#endif // ZTD_TEXT_TRANSCODING_STREAMBUF_HPP
@@ -42,9 +42,14 @@
 #include <ztd/text/error_handler.hpp>
 #include <ztd/text/forward.hpp>
 #include <ztd/text/is_ignorable_error_handler.hpp>
+#include <ztd/text/is_transcoding_compatible.hpp>
+#include <ztd/text/utf8.hpp>
+#include <ztd/text/utf32.hpp>
 
 #include <ztd/text/detail/empty_state.hpp>
 #include <ztd/text/detail/range.hpp>
+#include <ztd/text/detail/bulk_transcode.hpp>
+#include <ztd/text/detail/bulk_utf16.hpp>
 
 namespace ztd { namespace text {
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
@@ -158,20 +163,15 @@ namespace ztd { namespace text {
 				auto __outit   = __detail::__adl::__adl_begin(__output);
 				auto __outlast = __detail::__adl::__adl_end(__output);
 
-				if constexpr (__call_error_handler) {
-					if (__outit == __outlast) {
-						__self_t __self {};
-						return __error_handler(__self,
-							_Result(
-							     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-							     __detail::__reconstruct(
-							          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-							     __s, encoding_error::insufficient_output_space),
-							::ztd::text::span<code_unit, 0>());
-					}
-				}
-				else {
-					(void)__outlast;
+				if (__outit == __outlast) {
+					__self_t __self {};
+					return __error_handler(__self,
+						_Result(
+						     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+						     __detail::__reconstruct(
+						          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
+						     __s, encoding_error::insufficient_output_space),
+						::ztd::text::span<code_unit, 0>());
 				}
 
 				::std::array<code_unit, 2> __units {};
@@ -276,20 +276,15 @@ namespace ztd { namespace text {
 				auto __outit   = __detail::__adl::__adl_begin(__output);
 				auto __outlast = __detail::__adl::__adl_end(__output);
 
-				if constexpr (__call_error_handler) {
-					if (__outit == __outlast) {
-						__self_t __self {};
-						return __error_handler(__self,
-							_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>,
-							             ::std::move(__init), ::std::move(__inlast)),
-							     __detail::__reconstruct(::std::in_place_type<_UOutputRange>,
-							          ::std::move(__outit), ::std::move(__outlast)),
-							     __s, encoding_error::insufficient_output_space),
-							::ztd::text::span<code_point, 0>());
-					}
-				}
-				else {
-					(void)__outlast;
+				if (__outit == __outlast) {
+					__self_t __self {};
+					return __error_handler(__self,
+						_Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>,
+						             ::std::move(__init), ::std::move(__inlast)),
+						     __detail::__reconstruct(::std::in_place_type<_UOutputRange>,
+						          ::std::move(__outit), ::std::move(__outlast)),
+						     __s, encoding_error::insufficient_output_space),
+						::ztd::text::span<code_point, 0>());
 				}
 
 
@@ -325,17 +320,15 @@ namespace ztd { namespace text {
 					__detail::__dereference(__outit) = static_cast<char16_t>(lead);
 					__outit                          = __detail::__next(__outit);
 
-					if constexpr (__call_error_handler) {
-						if (__outit == __outlast) {
-							__self_t __self {};
-							return __error_handler(__self,
-								_Result(__detail::__reconstruct(
-								             ::std::in_place_type<_UInputRange>, __init, __inlast),
-								     __detail::__reconstruct(
-								          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-								     __s, encoding_error::insufficient_output_space),
-								::ztd::text::span<code_point, 1>(::std::addressof(__points[0]), 1));
-						}
+					if (__outit == __outlast) {
+						__self_t __self {};
+						return __error_handler(__self,
+							_Result(__detail::__reconstruct(
+							             ::std::in_place_type<_UInputRange>, __init, __inlast),
+							     __detail::__reconstruct(
+							          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
+							     __s, encoding_error::insufficient_output_space),
+							::ztd::text::span<code_point, 1>(::std::addressof(__points[0]), 1));
 					}
 					__detail::__dereference(__outit) = static_cast<char16_t>(trail);
 					__outit                          = __detail::__next(__outit);
@@ -375,7 +368,131 @@ namespace ztd { namespace text {
 	/// @}
 	//////
 
+	//////
+	/// @brief Transcodes a contiguous range of UTF-8 directly to UTF-16, without stopping at every code point.
+	///
+	/// @remarks This is found by ztd::text::transcode_into through argument-dependent lookup. Valid input is
+	/// converted in bulk; errors, truncated input and running out of output space are left to the regular
+	/// ztd::text::basic_utf8::decode_one and ztd::text::basic_utf16::encode_one functions, so the result and any
+	/// error handler calls are identical to the ones the generic transcoding loop would produce. With an ignorable
+	/// error handler for the UTF-8 side (such as ztd::text::assume_valid_handler), the input is trusted to be valid
+	/// and is converted without being validated first.
+	//////
+	template <typename _Input, typename _FromCodeUnit, typename _FromCodePoint, typename _Output,
+		typename _ToCodeUnit, typename _ToCodePoint, typename _FromErrorHandler, typename _ToErrorHandler,
+		typename _FromState, typename _ToState,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<_ToCodeUnit, 2>
+		     && __detail::__is_bulk_transcodable_v<_Input, 1, _Output, _ToCodeUnit>>* = nullptr>
+	constexpr auto __text_transcode(_Input&& __input,
+		const basic_utf8<_FromCodeUnit, _FromCodePoint>& __from_encoding, _Output&& __output,
+		const basic_utf16<_ToCodeUnit, _ToCodePoint>& __to_encoding,
+		_FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler, _FromState& __from_state,
+		_ToState& __to_state) {
+		using _Kernel = __detail::__utf8_decode_kernel<2,
+			is_ignorable_error_handler_v<__detail::__remove_cvref_t<_FromErrorHandler>>>;
+		return __detail::__bulk_transcode<_ToCodeUnit>(::std::forward<_Input>(__input), __from_encoding,
+			::std::forward<_Output>(__output), __to_encoding, __from_error_handler, __to_error_handler, __from_state,
+			__to_state, _Kernel {});
+	}
+
+	//////
+	/// @brief Transcodes a contiguous range of UTF-16 directly to UTF-8, without stopping at every code point.
+	///
+	/// @remarks This is found by ztd::text::transcode_into through argument-dependent lookup. Valid input is
+	/// converted in bulk; errors, truncated input and running out of output space are left to the regular
+	/// ztd::text::basic_utf16::decode_one and ztd::text::basic_utf8::encode_one functions.
+	//////
+	template <typename _Input, typename _FromCodeUnit, typename _FromCodePoint, typename _Output,
+		typename _ToCodeUnit, typename _ToCodePoint, typename _FromErrorHandler, typename _ToErrorHandler,
+		typename _FromState, typename _ToState,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<_ToCodeUnit, 1>
+		     && __detail::__is_bulk_transcodable_v<_Input, 2, _Output, _ToCodeUnit>>* = nullptr>
+	constexpr auto __text_transcode(_Input&& __input,
+		const basic_utf16<_FromCodeUnit, _FromCodePoint>& __from_encoding, _Output&& __output,
+		const basic_utf8<_ToCodeUnit, _ToCodePoint>& __to_encoding,
+		_FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler, _FromState& __from_state,
+		_ToState& __to_state) {
+		return __detail::__bulk_transcode<_ToCodeUnit>(::std::forward<_Input>(__input), __from_encoding,
+			::std::forward<_Output>(__output), __to_encoding, __from_error_handler, __to_error_handler, __from_state,
+			__to_state, __detail::__utf16_to_utf8_kernel {});
+	}
+
+	//////
+	/// @brief Transcodes a contiguous range of UTF-16 directly to UTF-32, without stopping at every code point.
+	///
+	/// @remarks This is found by ztd::text::transcode_into through argument-dependent lookup. Stretches without
+	/// surrogates are widened a whole vector at a time, and surrogate pairs are combined where they occur; lone
+	/// surrogates, truncated input and running out of output space are left to the regular
+	/// ztd::text::basic_utf16::decode_one and ztd::text::basic_utf32::encode_one functions.
+	//////
+	template <typename _Input, typename _FromCodeUnit, typename _FromCodePoint, typename _Output,
+		typename _ToCodeUnit, typename _ToCodePoint, typename _FromErrorHandler, typename _ToErrorHandler,
+		typename _FromState, typename _ToState,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<_ToCodeUnit, 4>
+		     && __detail::__is_bulk_transcodable_v<_Input, 2, _Output, _ToCodeUnit>>* = nullptr>
+	constexpr auto __text_transcode(_Input&& __input,
+		const basic_utf16<_FromCodeUnit, _FromCodePoint>& __from_encoding, _Output&& __output,
+		const basic_utf32<_ToCodeUnit, _ToCodePoint>& __to_encoding,
+		_FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler, _FromState& __from_state,
+		_ToState& __to_state) {
+		return __detail::__bulk_transcode<_ToCodeUnit>(::std::forward<_Input>(__input), __from_encoding,
+			::std::forward<_Output>(__output), __to_encoding, __from_error_handler, __to_error_handler, __from_state,
+			__to_state, __detail::__utf16_to_utf32_kernel {});
+	}
 
+	//////
+	/// @brief Transcodes a contiguous range of UTF-32 directly to UTF-16, without stopping at every code point.
+	///
+	/// @remarks This is found by ztd::text::transcode_into through argument-dependent lookup. Code points in the
+	/// Basic Multilingual Plane are narrowed a whole vector at a time, and the others are split into surrogate
+	/// pairs where they occur; surrogates, values past the last code point and running out of output space are left
+	/// to the regular ztd::text::basic_utf32::decode_one and ztd::text::basic_utf16::encode_one functions.
+	//////
+	template <typename _Input, typename _FromCodeUnit, typename _FromCodePoint, typename _Output,
+		typename _ToCodeUnit, typename _ToCodePoint, typename _FromErrorHandler, typename _ToErrorHandler,
+		typename _FromState, typename _ToState,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<_ToCodeUnit, 2>
+		     && __detail::__is_bulk_transcodable_v<_Input, 4, _Output, _ToCodeUnit>>* = nullptr>
+	constexpr auto __text_transcode(_Input&& __input,
+		const basic_utf32<_FromCodeUnit, _FromCodePoint>& __from_encoding, _Output&& __output,
+		const basic_utf16<_ToCodeUnit, _ToCodePoint>& __to_encoding,
+		_FromErrorHandler&& __from_error_handler, _ToErrorHandler&& __to_error_handler, _FromState& __from_state,
+		_ToState& __to_state) {
+		return __detail::__bulk_transcode<_ToCodeUnit>(::std::forward<_Input>(__input), __from_encoding,
+			::std::forward<_Output>(__output), __to_encoding, __from_error_handler, __to_error_handler, __from_state,
+			__to_state, __detail::__utf32_to_utf16_kernel {});
+	}
+
+	//////
+	/// @brief Counts the code points in a contiguous range of UTF-16 code units in bulk, rather than one code point at
+	/// a time.
+	///
+	/// @remarks This is found by ztd::text::count_code_points through argument-dependent lookup. Everything but the
+	/// trail surrogates of valid input counts, a vector at a time; lone surrogates still go through
+	/// ztd::text::basic_utf16::decode_one, so the count, the position of the first error and the error handler calls
+	/// are the same as with the plain loop. With an ignorable error handler (such as
+	/// ztd::text::assume_valid_handler), the input is trusted to be valid and is not checked for lone surrogates.
+	//////
+	template <typename _Input, typename _CodeUnit, typename _CodePoint, typename _ErrorHandler, typename _State,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<_CodeUnit, 2>
+		     && __detail::__is_bulk_input_v<_Input, 2>>* = nullptr>
+	constexpr auto __text_count_code_points(_Input&& __input, const basic_utf16<_CodeUnit, _CodePoint>& __encoding,
+		_ErrorHandler&& __error_handler, _State& __state) {
+		using _Kernel = __detail::__utf16_count_kernel<
+			is_ignorable_error_handler_v<__detail::__remove_cvref_t<_ErrorHandler>>>;
+		return __detail::__bulk_count_code_points(
+			::std::forward<_Input>(__input), __encoding, __error_handler, __state, _Kernel {});
+	}
+
+	namespace __detail {
+
+		template <typename _FromUnit, typename _FromPoint, typename _ToUnit, typename _ToPoint>
+		struct __is_bitwise_transcoding_compatible<basic_utf16<_FromUnit, _FromPoint>,
+			basic_utf16<_ToUnit, _ToPoint>>
+		: std::integral_constant<bool,
+			  (sizeof(_FromUnit) == sizeof(_ToUnit)) && (alignof(_FromUnit) == alignof(_ToUnit))> { };
+
+	} // namespace __detail
 
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
 }} // namespace ztd::text
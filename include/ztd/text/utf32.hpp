@@ -42,6 +42,7 @@
 #include <ztd/text/error_handler.hpp>
 #include <ztd/text/forward.hpp>
 #include <ztd/text/is_ignorable_error_handler.hpp>
+#include <ztd/text/is_transcoding_compatible.hpp>
 
 #include <ztd/text/detail/empty_state.hpp>
 #include <ztd/text/detail/range.hpp>
@@ -153,20 +154,15 @@ namespace ztd { namespace text {
 				auto __outit   = __detail::__adl::__adl_begin(__output);
 				auto __outlast = __detail::__adl::__adl_end(__output);
 
-				if constexpr (__call_error_handler) {
-					if (__outit == __outlast) {
-						__self_t __self {};
-						return __error_handler(__self,
-							_Result(
-							     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-							     __detail::__reconstruct(
-							          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-							     __s, encoding_error::insufficient_output_space),
-							::ztd::text::span<code_unit, 0>());
-					}
-				}
-				else {
-					(void)__outlast;
+				if (__outit == __outlast) {
+					__self_t __self {};
+					return __error_handler(__self,
+						_Result(
+						     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+						     __detail::__reconstruct(
+						          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
+						     __s, encoding_error::insufficient_output_space),
+						::ztd::text::span<code_unit, 0>());
 				}
 
 				code_unit __unit = __detail::__dereference(__init);
@@ -232,20 +228,15 @@ namespace ztd { namespace text {
 				auto __outit   = __detail::__adl::__adl_begin(__output);
 				auto __outlast = __detail::__adl::__adl_end(__output);
 
-				if constexpr (__call_error_handler) {
-					if (__outit == __outlast) {
-						__self_t __self {};
-						return __error_handler(__self,
-							_Result(
-							     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-							     __detail::__reconstruct(
-							          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-							     __s, encoding_error::insufficient_output_space),
-							::ztd::text::span<code_point, 0>());
-					}
-				}
-				else {
-					(void)__outlast;
+				if (__outit == __outlast) {
+					__self_t __self {};
+					return __error_handler(__self,
+						_Result(
+						     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+						     __detail::__reconstruct(
+						          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
+						     __s, encoding_error::insufficient_output_space),
+						::ztd::text::span<code_point, 0>());
 				}
 
 				code_point __points[1] {};
@@ -303,6 +294,16 @@ namespace ztd { namespace text {
 	/// @}
 	//////
 
+	namespace __detail {
+
+		template <typename _FromUnit, typename _FromPoint, typename _ToUnit, typename _ToPoint>
+		struct __is_bitwise_transcoding_compatible<basic_utf32<_FromUnit, _FromPoint>,
+			basic_utf32<_ToUnit, _ToPoint>>
+		: std::integral_constant<bool,
+			  (sizeof(_FromUnit) == sizeof(_ToUnit)) && (alignof(_FromUnit) == alignof(_ToUnit))> { };
+
+	} // namespace __detail
+
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
 }} // namespace ztd::text
 
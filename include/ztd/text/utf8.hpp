@@ -38,17 +38,24 @@
 #include <ztd/text/char8_t.hpp>
 #include <ztd/text/encode_result.hpp>
 #include <ztd/text/decode_result.hpp>
+#include <ztd/text/validate_result.hpp>
 #include <ztd/text/unicode_code_point.hpp>
 #include <ztd/text/is_ignorable_error_handler.hpp>
 #include <ztd/text/is_transcoding_compatible.hpp>
 
 #include <ztd/text/detail/unicode.hpp>
+#include <ztd/text/detail/utf8_dfa.hpp>
 #include <ztd/text/detail/empty_state.hpp>
 #include <ztd/text/detail/range.hpp>
 #include <ztd/text/detail/type_traits.hpp>
 #include <ztd/text/detail/cast.hpp>
+#include <ztd/text/detail/span.hpp>
+#include <ztd/text/detail/reconstruct.hpp>
+#include <ztd/text/detail/bulk_utf8.hpp>
+#include <ztd/text/detail/bulk_transcode.hpp>
 
 #include <array>
+#include <string_view>
 
 namespace ztd { namespace text {
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_OPEN_I_
@@ -195,17 +202,15 @@ namespace ztd { namespace text {
 						// overlong MUTF-8
 						constexpr uchar8_t __payload[] = { 0b11000000u, 0b10000000u };
 						for (::std::size_t i = 0; i < static_cast<::std::size_t>(2); ++i) {
-							if constexpr (__call_error_handler) {
-								if (__outit == __outlast) {
-									__self_t __self {};
-									return __error_handler(__self,
-										_Result(__detail::__reconstruct(
-										             ::std::in_place_type<_UInputRange>, __init, __inlast),
-										     __detail::__reconstruct(
-										          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-										     __s, encoding_error::insufficient_output_space),
-										::ztd::text::span<code_point, 1>(::std::addressof(__points[0]), 1));
-								}
+							if (__outit == __outlast) {
+								__self_t __self {};
+								return __error_handler(__self,
+									_Result(__detail::__reconstruct(
+									             ::std::in_place_type<_UInputRange>, __init, __inlast),
+									     __detail::__reconstruct(
+									          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
+									     __s, encoding_error::insufficient_output_space),
+									::ztd::text::span<code_point, 1>(::std::addressof(__points[0]), 1));
 							}
 							__detail::__dereference(__outit) = static_cast<code_unit>(__payload[i]);
 							__outit                          = __detail::__next(__outit);
@@ -217,17 +222,15 @@ namespace ztd { namespace text {
 					}
 				}
 
-				if constexpr (__call_error_handler) {
-					if (__outit == __outlast) {
-						__self_t __self {};
-						return __error_handler(__self,
-							_Result(
-							     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-							     __detail::__reconstruct(
-							          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-							     __s, encoding_error::insufficient_output_space),
-							::ztd::text::span<code_point, 1>(::std::addressof(__points[0]), 1));
-					}
+				if (__outit == __outlast) {
+					__self_t __self {};
+					return __error_handler(__self,
+						_Result(
+						     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+						     __detail::__reconstruct(
+						          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
+						     __s, encoding_error::insufficient_output_space),
+						::ztd::text::span<code_point, 1>(::std::addressof(__points[0]), 1));
 				}
 				constexpr uchar8_t __first_mask_continuation_values[][2] = {
 					{ 0b01111111, __detail::__start_1byte_continuation },
@@ -252,17 +255,15 @@ namespace ztd { namespace text {
 				if (__lengthindex > 0) {
 					__current_shift -= 6;
 					for (; __current_shift >= 0; __current_shift -= 6) {
-						if constexpr (__call_error_handler) {
-							if (__outit == __outlast) {
-								__self_t __self {};
-								return __error_handler(__self,
-									_Result(__detail::__reconstruct(
-									             ::std::in_place_type<_UInputRange>, __init, __inlast),
-									     __detail::__reconstruct(
-									          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-									     __s, encoding_error::insufficient_output_space),
-									::ztd::text::span<code_point, 1>(::std::addressof(__points[0]), 1));
-							}
+						if (__outit == __outlast) {
+							__self_t __self {};
+							return __error_handler(__self,
+								_Result(__detail::__reconstruct(
+								             ::std::in_place_type<_UInputRange>, __init, __inlast),
+								     __detail::__reconstruct(
+								          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
+								     __s, encoding_error::insufficient_output_space),
+								::ztd::text::span<code_point, 1>(::std::addressof(__points[0]), 1));
 						}
 
 						__detail::__dereference(__outit)
@@ -299,11 +300,9 @@ namespace ztd { namespace text {
 			template <typename _InputRange, typename _OutputRange, typename _ErrorHandler>
 			static constexpr auto decode_one(
 				_InputRange&& __input, _OutputRange&& __output, _ErrorHandler&& __error_handler, state& __s) {
-				using _UInputRange   = __detail::__remove_cvref_t<_InputRange>;
-				using _UOutputRange  = __detail::__remove_cvref_t<_OutputRange>;
-				using _UErrorHandler = __detail::__remove_cvref_t<_ErrorHandler>;
-				using _Result        = __detail::__reconstruct_decode_result_t<_UInputRange, _UOutputRange, state>;
-				constexpr bool __call_error_handler = !is_ignorable_error_handler_v<_UErrorHandler>;
+				using _UInputRange  = __detail::__remove_cvref_t<_InputRange>;
+				using _UOutputRange = __detail::__remove_cvref_t<_OutputRange>;
+				using _Result       = __detail::__reconstruct_decode_result_t<_UInputRange, _UOutputRange, state>;
 
 				auto __init   = __detail::__adl::__adl_cbegin(__input);
 				auto __inlast = __detail::__adl::__adl_cend(__input);
@@ -316,83 +315,33 @@ namespace ztd { namespace text {
 
 				auto __outit   = __detail::__adl::__adl_begin(__output);
 				auto __outlast = __detail::__adl::__adl_end(__output);
-				if constexpr (__call_error_handler) {
-					if (__outit == __outlast) {
-						__self_t __self {};
-						return __error_handler(__self,
-							_Result(
-							     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-							     __detail::__reconstruct(
-							          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-							     __s, encoding_error::insufficient_output_space),
-							::ztd::text::span<code_unit, 0>());
-					}
-				}
-				else {
-					(void)__outlast;
+				if (__outit == __outlast) {
+					__self_t __self {};
+					return __error_handler(__self,
+						_Result(
+						     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
+						     __detail::__reconstruct(
+						          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
+						     __s, encoding_error::insufficient_output_space),
+						::ztd::text::span<code_unit, 0>());
 				}
 
+				// one lookup per code unit both checks it against everything seen so far and accumulates it
 				::std::array<code_unit, max_code_units> __units {};
-				__units[0] = __detail::static_cast_if_lossless<code_unit>(__detail::__dereference(__init));
-				const code_unit& __unit0 = __units[0];
-				__init                   = __detail::__next(__init);
-				::std::size_t __length
-					= static_cast<::std::size_t>(__detail::__sequence_length(static_cast<uchar8_t>(__unit0)));
-
-				if constexpr (!__overlong_allowed) {
-					if constexpr (__call_error_handler) {
-						if (__length > 4) {
-							__self_t __self {};
-							return __error_handler(__self,
-								_Result(__detail::__reconstruct(
-								             ::std::in_place_type<_UInputRange>, __init, __inlast),
-								     __detail::__reconstruct(
-								          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-								     __s, encoding_error::invalid_sequence),
-								::ztd::text::span<code_unit, 1>(__units.data(), __units.size()));
-						}
+				::std::size_t __length = 0;
+				unsigned char __state  = __detail::__utf8_dfa_accept;
+				char32_t __decoded     = 0;
+				for (;;) {
+					__units[__length]
+						= __detail::static_cast_if_lossless<code_unit>(__detail::__dereference(__init));
+					__init  = __detail::__next(__init);
+					__state = __detail::__utf8_dfa_step<__overlong_allowed, __surrogates_allowed>(
+						__state, static_cast<uchar8_t>(__units[__length]), __decoded);
+					++__length;
+					if (__state == __detail::__utf8_dfa_accept) {
+						break;
 					}
-				}
-
-				if (__length == 1) {
-					__detail::__dereference(__outit) = static_cast<code_point>(__unit0);
-					__outit                          = __detail::__next(__outit);
-					return _Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-						__detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast), __s);
-				}
-
-				if constexpr (__call_error_handler) {
-					const bool __is_invalid_cu = __detail::__utf8_is_invalid(static_cast<uchar8_t>(__unit0));
-					if (__is_invalid_cu || __detail::__utf8_is_continuation(static_cast<uchar8_t>(__unit0))) {
-						__self_t __self {};
-						return __error_handler(__self,
-							_Result(
-							     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
-							     __detail::__reconstruct(
-							          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-							     __s,
-							     __is_invalid_cu ? encoding_error::invalid_sequence
-							                     : encoding_error::invalid_sequence),
-							::ztd::text::span<code_unit, 1>(__units.data(), 1));
-					}
-				}
-
-				for (::std::size_t i = 1; i < __length; ++i) {
-					if constexpr (__call_error_handler) {
-						if (__init == __inlast) {
-							__self_t __self {};
-							return __error_handler(__self,
-								_Result(__detail::__reconstruct(
-								             ::std::in_place_type<_UInputRange>, __init, __inlast),
-								     __detail::__reconstruct(
-								          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-								     __s, encoding_error::incomplete_sequence),
-								::ztd::text::span<code_unit>(__units.data(), i));
-						}
-					}
-					__units[i] = __detail::static_cast_if_lossless<code_unit>(__detail::__dereference(__init));
-					__init     = __detail::__next(__init);
-					if (!__detail::__utf8_is_continuation(static_cast<uchar8_t>(__units[i]))) {
+					if (__state == __detail::__utf8_dfa_reject) {
 						__self_t __self {};
 						return __error_handler(__self,
 							_Result(
@@ -400,67 +349,22 @@ namespace ztd { namespace text {
 							     __detail::__reconstruct(
 							          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
 							     __s, encoding_error::invalid_sequence),
-							::ztd::text::span<code_unit>(__units.data(), i + 1));
-					}
-				}
-
-				code_point __decoded {};
-				switch (__length) {
-				case 2:
-					__decoded = __detail::__decode(
-						static_cast<uchar8_t>(__units[0]), static_cast<uchar8_t>(__units[1]));
-					break;
-				case 3:
-					__decoded = __detail::__decode(static_cast<uchar8_t>(__units[0]),
-						static_cast<uchar8_t>(__units[1]), static_cast<uchar8_t>(__units[2]));
-					break;
-				case 4:
-				default:
-					__decoded
-						= __detail::__decode(static_cast<uchar8_t>(__units[0]), static_cast<uchar8_t>(__units[1]),
-						     static_cast<uchar8_t>(__units[2]), static_cast<uchar8_t>(__units[3]));
-					break;
-				}
-
-				if constexpr (__call_error_handler) {
-					if constexpr (!__overlong_allowed) {
-						if (__detail::__utf8_is_overlong(__decoded, __length)) {
-							__self_t __self {};
-							return __error_handler(__self,
-								_Result(__detail::__reconstruct(
-								             ::std::in_place_type<_UInputRange>, __init, __inlast),
-								     __detail::__reconstruct(
-								          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-								     __s, encoding_error::invalid_sequence),
-								::ztd::text::span<code_unit>(__units.data(), __length));
-						}
-					}
-					if constexpr (!__surrogates_allowed) {
-						if (__detail::__is_surrogate(__decoded)) {
-							__self_t __self {};
-							return __error_handler(__self,
-								_Result(__detail::__reconstruct(
-								             ::std::in_place_type<_UInputRange>, __init, __inlast),
-								     __detail::__reconstruct(
-								          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-								     __s, encoding_error::invalid_sequence),
-								::ztd::text::span<code_unit>(__units.data(), __length));
-						}
+							::ztd::text::span<code_unit>(__units.data(), __length));
 					}
-					if (static_cast<char32_t>(__decoded) > __detail::__last_code_point) {
+					if (__init == __inlast) {
 						__self_t __self {};
 						return __error_handler(__self,
 							_Result(
 							     __detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
 							     __detail::__reconstruct(
 							          ::std::in_place_type<_UOutputRange>, __outit, __outlast),
-							     __s, encoding_error::invalid_sequence),
+							     __s, encoding_error::incomplete_sequence),
 							::ztd::text::span<code_unit>(__units.data(), __length));
 					}
 				}
 
 				// then everything is fine
-				__detail::__dereference(__outit) = __decoded;
+				__detail::__dereference(__outit) = static_cast<code_point>(__decoded);
 				__outit                          = __detail::__next(__outit);
 
 				return _Result(__detail::__reconstruct(::std::in_place_type<_UInputRange>, __init, __inlast),
@@ -547,6 +451,103 @@ namespace ztd { namespace text {
 	//////
 	using mutf8 = basic_mutf8<uchar8_t>;
 
+	//////
+	/// @brief Validates a contiguous range of UTF-8 code units in bulk, rather than one code point at a time.
+	///
+	/// @param[in] __input The input range of code units to validate.
+	/// @param[in] __decode_state The decode state, which is returned (unused) in the result.
+	///
+	/// @remarks This is found by ztd::text::validate_code_units through argument-dependent lookup. The result is
+	/// identical to the one produced by the per-code point loop: on failure, the returned input starts at the first
+	/// code unit of the first ill-formed sequence.
+	//////
+	template <typename _Input, typename _CodeUnit, typename _CodePoint, typename _DecodeState,
+		::std::enable_if_t<
+		     __detail::__is_bulk_utf8_input_v<__detail::__remove_cvref_t<_Input>, _CodeUnit>>* = nullptr>
+	constexpr auto __text_validate_code_units(
+		_Input&& __input, const basic_utf8<_CodeUnit, _CodePoint>&, _DecodeState& __decode_state) {
+		using _UInput         = __detail::__remove_cvref_t<_Input>;
+		using _InputValueType = __detail::__range_value_type_t<_UInput>;
+		using _WorkingInput   = __detail::__reconstruct_t<::std::conditional_t<::std::is_array_v<_UInput>,
+               ::std::conditional_t<__detail::__is_character_v<_InputValueType>,
+                    ::std::basic_string_view<_InputValueType>, ::ztd::text::span<const _InputValueType>>,
+               _UInput>>;
+		using _Difference     = __detail::__range_difference_type_t<_WorkingInput>;
+		using _Result         = validate_result<_WorkingInput, _DecodeState>;
+
+		_WorkingInput __working_input(
+			__detail::__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
+		auto __first = __detail::__adl::__adl_begin(__working_input);
+		auto __last  = __detail::__adl::__adl_end(__working_input);
+		const __detail::__bulk_result __r
+			= __detail::__utf8_validate(__first, static_cast<::std::size_t>(__last - __first));
+		return _Result(__detail::__reconstruct(::std::in_place_type<_WorkingInput>,
+			               __first + static_cast<_Difference>(__r.offset), __last),
+			__r.error == encoding_error::ok, __decode_state);
+	}
+
+	//////
+	/// @brief Decodes a contiguous range of UTF-8 code units to UTF-32 in bulk, rather than one code point at a time.
+	///
+	/// @remarks This is found by ztd::text::decode_into through argument-dependent lookup, for contiguous outputs and
+	/// ztd::text::unbounded_view outputs (such as the one ztd::text::decode_to uses). Valid input is decoded a block
+	/// at a time; ztd::text::basic_utf8::decode_one only runs for errors, truncated input and the last few code
+	/// points that fit in the output, so the results and error handler calls are the same as with the plain loop.
+	/// With an ignorable error handler (such as ztd::text::assume_valid_handler), the input is trusted to be valid
+	/// and is decoded without being validated first.
+	//////
+	template <typename _Input, typename _CodeUnit, typename _CodePoint, typename _Output, typename _ErrorHandler,
+		typename _State,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<_CodePoint, 4>
+		     && __detail::__is_bulk_transcodable_v<_Input, 1, _Output, _CodePoint>>* = nullptr>
+	constexpr auto __text_decode(_Input&& __input, const basic_utf8<_CodeUnit, _CodePoint>& __encoding,
+		_Output&& __output, _ErrorHandler&& __error_handler, _State& __state) {
+		using _Kernel = __detail::__utf8_decode_kernel<4,
+			is_ignorable_error_handler_v<__detail::__remove_cvref_t<_ErrorHandler>>>;
+		return __detail::__bulk_decode<_CodePoint>(::std::forward<_Input>(__input), __encoding,
+			::std::forward<_Output>(__output), __error_handler, __state, _Kernel {});
+	}
+
+	//////
+	/// @brief Encodes a contiguous range of UTF-32 code points to UTF-8 in bulk, rather than one code point at a time.
+	///
+	/// @remarks This is found by ztd::text::encode_into through argument-dependent lookup, for contiguous outputs and
+	/// ztd::text::unbounded_view outputs. The exact UTF-8 length of each stretch of input is computed up front, so the
+	/// code units are written without checking the output's bounds one at a time. Surrogates, values past the last
+	/// code point and anything that does not fit in the output still go through ztd::text::basic_utf8::encode_one, so
+	/// the results and error handler calls are the same as with the plain loop.
+	//////
+	template <typename _Input, typename _CodeUnit, typename _CodePoint, typename _Output, typename _ErrorHandler,
+		typename _State,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<_CodeUnit, 1> && __detail::__is_bulk_unit_v<_CodePoint, 4>
+		     && __detail::__is_bulk_transcodable_v<_Input, 4, _Output, _CodeUnit>>* = nullptr>
+	constexpr auto __text_encode(_Input&& __input, const basic_utf8<_CodeUnit, _CodePoint>& __encoding,
+		_Output&& __output, _ErrorHandler&& __error_handler, _State& __state) {
+		return __detail::__bulk_encode<_CodeUnit>(::std::forward<_Input>(__input), __encoding,
+			::std::forward<_Output>(__output), __error_handler, __state, __detail::__utf32_to_utf8_kernel {});
+	}
+
+	//////
+	/// @brief Counts the code points in a contiguous range of UTF-8 code units in bulk, rather than one code point at
+	/// a time.
+	///
+	/// @remarks This is found by ztd::text::count_code_points through argument-dependent lookup. Valid input is
+	/// validated and counted a vector at a time; errors still go through ztd::text::basic_utf8::decode_one, so the
+	/// count, the position of the first error and the error handler calls are the same as with the plain loop. With
+	/// an ignorable error handler (such as ztd::text::assume_valid_handler), the input is trusted to be valid and
+	/// only its lead code units are counted.
+	//////
+	template <typename _Input, typename _CodeUnit, typename _CodePoint, typename _ErrorHandler, typename _State,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<_CodeUnit, 1>
+		     && __detail::__is_bulk_input_v<_Input, 1>>* = nullptr>
+	constexpr auto __text_count_code_points(_Input&& __input, const basic_utf8<_CodeUnit, _CodePoint>& __encoding,
+		_ErrorHandler&& __error_handler, _State& __state) {
+		using _Kernel
+			= __detail::__utf8_count_kernel<is_ignorable_error_handler_v<__detail::__remove_cvref_t<_ErrorHandler>>>;
+		return __detail::__bulk_count_code_points(
+			::std::forward<_Input>(__input), __encoding, __error_handler, __state, _Kernel {});
+	}
+
 
 	namespace __detail {
 
@@ -556,11 +557,30 @@ namespace ztd { namespace text {
 		: std::integral_constant<bool,
 			  (sizeof(_UTF8Unit) == sizeof(_WTF8Unit)) && (alignof(_UTF8Unit) == alignof(_WTF8Unit))> { };
 
+		// MUTF-8 writes U+0000 as 0xC0 0x80, so neither UTF-8 nor ASCII can be copied into it as-is
 		template <typename _UTF8Unit, typename _UTF8Point, typename _MUTF8Unit, typename _MUTF8Point>
 		struct __is_bitwise_transcoding_compatible<basic_utf8<_UTF8Unit, _UTF8Point>,
-			basic_mutf8<_MUTF8Unit, _MUTF8Point>>
+			basic_mutf8<_MUTF8Unit, _MUTF8Point>> : std::false_type { };
+
+		template <typename _ASCIIUnit, typename _ASCIIPoint, typename _MUTF8Unit, typename _MUTF8Point>
+		struct __is_bitwise_transcoding_compatible<basic_ascii<_ASCIIUnit, _ASCIIPoint>,
+			basic_mutf8<_MUTF8Unit, _MUTF8Point>> : std::false_type { };
+
+		template <typename _FromUnit, typename _FromPoint, typename _ToUnit, typename _ToPoint>
+		struct __is_bitwise_transcoding_compatible<basic_utf8<_FromUnit, _FromPoint>, basic_utf8<_ToUnit, _ToPoint>>
+		: std::integral_constant<bool,
+			  (sizeof(_FromUnit) == sizeof(_ToUnit)) && (alignof(_FromUnit) == alignof(_ToUnit))> { };
+
+		template <typename _FromUnit, typename _FromPoint, typename _ToUnit, typename _ToPoint>
+		struct __is_bitwise_transcoding_compatible<basic_wtf8<_FromUnit, _FromPoint>, basic_wtf8<_ToUnit, _ToPoint>>
+		: std::integral_constant<bool,
+			  (sizeof(_FromUnit) == sizeof(_ToUnit)) && (alignof(_FromUnit) == alignof(_ToUnit))> { };
+
+		template <typename _FromUnit, typename _FromPoint, typename _ToUnit, typename _ToPoint>
+		struct __is_bitwise_transcoding_compatible<basic_mutf8<_FromUnit, _FromPoint>,
+			basic_mutf8<_ToUnit, _ToPoint>>
 		: std::integral_constant<bool,
-			  (sizeof(_UTF8Unit) == sizeof(_MUTF8Unit)) && (alignof(_UTF8Unit) == alignof(_MUTF8Unit))> { };
+			  (sizeof(_FromUnit) == sizeof(_ToUnit)) && (alignof(_FromUnit) == alignof(_ToUnit))> { };
 
 	} // namespace __detail
 
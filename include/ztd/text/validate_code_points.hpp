@@ -105,15 +105,12 @@ namespace ztd { namespace text {
 				_WorkingInput __working_input(
 					__detail::__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
 
-				for (;;) {
+				while (!__detail::__adl::__adl_empty(__working_input)) {
 					auto __result = __encoding.validate_code_points_one(__working_input, __encode_state);
 					if (!__result.valid) {
 						return _Result(::std::move(__result.input), false, __encode_state);
 					}
 					__working_input = ::std::move(__result.input);
-					if (__detail::__adl::__adl_empty(__working_input)) {
-						break;
-					}
 				}
 				return _Result(::std::move(__working_input), true, __encode_state);
 			}
@@ -130,7 +127,7 @@ namespace ztd { namespace text {
 				::ztd::text::span<_CodePoint, max_code_points_v<_UEncoding>> __code_point_view(__code_point_buf);
 				::ztd::text::span<_CodeUnit, max_code_units_v<_UEncoding>> __code_unit_view(__code_unit_buf);
 
-				for (;;) {
+				while (!__detail::__adl::__adl_empty(__working_input)) {
 					auto __validate_result = __detail::__basic_validate_code_points_one(__working_input,
 						__encoding, __code_point_view, __code_unit_view, __encode_state, __decode_state);
 					if (!__validate_result.valid) {
@@ -139,9 +136,6 @@ namespace ztd { namespace text {
 							false, __encode_state);
 					}
 					__working_input = ::std::move(__validate_result.input);
-					if (__detail::__adl::__adl_empty(__working_input)) {
-						break;
-					}
 				}
 				return _Result(
 					__detail::__reconstruct(::std::in_place_type<_WorkingInput>, ::std::move(__working_input)),
@@ -107,15 +107,12 @@ namespace ztd { namespace text {
 				_WorkingInput __working_input(
 					__detail::__reconstruct(::std::in_place_type<_WorkingInput>, ::std::forward<_Input>(__input)));
 
-				for (;;) {
+				while (!__detail::__adl::__adl_empty(__working_input)) {
 					auto __result = __encoding.validate_code_units_one(__working_input, __decode_state);
 					if (!__result.valid) {
 						return _Result(::std::move(__result.input), false, __decode_state);
 					}
 					__working_input = ::std::move(__result.input);
-					if (__detail::__adl::__adl_empty(__working_input)) {
-						break;
-					}
 				}
 				return _Result(::std::move(__working_input), true, __decode_state);
 			}
@@ -128,7 +125,7 @@ namespace ztd { namespace text {
 				_CodeUnit __code_unit_buf[max_code_units_v<_UEncoding>] {};
 				::ztd::text::span<_CodeUnit, max_code_units_v<_UEncoding>> __code_unit_view(__code_unit_buf);
 
-				for (;;) {
+				while (!__detail::__adl::__adl_empty(__working_input)) {
 					auto __validate_result = __detail::__basic_validate_code_units_one(
 						__working_input, __encoding, __code_unit_view, __decode_state, __encode_state);
 					if (!__validate_result.valid) {
@@ -137,9 +134,6 @@ namespace ztd { namespace text {
 							false, __decode_state);
 					}
 					__working_input = ::std::move(__validate_result.input);
-					if (__detail::__adl::__adl_empty(__working_input)) {
-						break;
-					}
 				}
 				return _Result(
 					__detail::__reconstruct(::std::in_place_type<_WorkingInput>, ::std::move(__working_input)),
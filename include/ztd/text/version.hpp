@@ -338,6 +338,30 @@
 	#endif
 #endif // nl_langinfo POSIX
 
+#if defined(ZTD_TEXT_LOCALE_T)
+	#if (ZTD_TEXT_LOCALE_T != 0)
+		#define ZTD_TEXT_LOCALE_T_I_ ZTD_TEXT_ON
+	#else
+		#define ZTD_TEXT_LOCALE_T_I_ ZTD_TEXT_OFF
+	#endif
+#else
+	#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_UNIX_I_) && ZTD_TEXT_IS_ON(ZTD_TEXT_LANGINFO_I_)
+		#define ZTD_TEXT_LOCALE_T_I_ ZTD_TEXT_DEFAULT_ON
+	#else
+		#define ZTD_TEXT_LOCALE_T_I_ ZTD_TEXT_DEFAULT_OFF
+	#endif
+#endif // POSIX 2008 locale_t (newlocale, uselocale, nl_langinfo_l)
+
+#if defined(ZTD_TEXT_USE_ICONV)
+	#if (ZTD_TEXT_USE_ICONV != 0)
+		#define ZTD_TEXT_USE_ICONV_I_ ZTD_TEXT_ON
+	#else
+		#define ZTD_TEXT_USE_ICONV_I_ ZTD_TEXT_OFF
+	#endif
+#else
+	#define ZTD_TEXT_USE_ICONV_I_ ZTD_TEXT_DEFAULT_OFF
+#endif // iconv, loaded at run time
+
 #if defined(ZTD_TEXT_LOCALE_DEPENDENT_WIDE_EXECUTION)
 	#if (ZTD_TEXT_LOCALE_DEPENDENT_WIDE_EXECUTION != 0)
 		#define ZTD_TEXT_LOCALE_DEPENDENT_WIDE_EXECUTION_I_ ZTD_TEXT_ON
@@ -387,6 +411,88 @@
 	#endif // MSVC vs. others
 #endif // Intermediate buffer sizing
 
+#if defined(ZTD_TEXT_SIMD)
+	#if (ZTD_TEXT_SIMD != 0)
+		#define ZTD_TEXT_SIMD_I_ ZTD_TEXT_ON
+	#else
+		#define ZTD_TEXT_SIMD_I_ ZTD_TEXT_OFF
+	#endif
+#else
+	#define ZTD_TEXT_SIMD_I_ ZTD_TEXT_DEFAULT_ON
+#endif // Vectorized bulk kernels
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+	#define ZTD_TEXT_PLATFORM_X86_I_ ZTD_TEXT_ON
+#else
+	#define ZTD_TEXT_PLATFORM_X86_I_ ZTD_TEXT_OFF
+#endif // x86 and x86-64
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_X86_I_) && (ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_GCC_I_) || ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_CLANG_I_) || ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_VCXX_I_))
+	#define ZTD_TEXT_CPUID_I_ ZTD_TEXT_DEFAULT_ON
+#else
+	#define ZTD_TEXT_CPUID_I_ ZTD_TEXT_DEFAULT_OFF
+#endif // Asking the processor which instructions it supports
+
+#if defined(ZTD_TEXT_SIMD_LEVEL)
+	#define ZTD_TEXT_SIMD_FORCED_LEVEL_I_ ZTD_TEXT_ON
+	#define ZTD_TEXT_SIMD_LEVEL_I_ ZTD_TEXT_SIMD_LEVEL
+#else
+	#define ZTD_TEXT_SIMD_FORCED_LEVEL_I_ ZTD_TEXT_DEFAULT_OFF
+	#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+		#define ZTD_TEXT_SIMD_LEVEL_I_ 4
+	#elif defined(__AVX2__)
+		#define ZTD_TEXT_SIMD_LEVEL_I_ 3
+	#elif defined(__SSE4_2__) || defined(__AVX__)
+		#define ZTD_TEXT_SIMD_LEVEL_I_ 2
+	#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define ZTD_TEXT_SIMD_LEVEL_I_ 1
+	#else
+		#define ZTD_TEXT_SIMD_LEVEL_I_ 0
+	#endif
+#endif // Vector instructions which can be used without checking the CPU first
+
+#if defined(ZTD_TEXT_SIMD_DISPATCH)
+	#if (ZTD_TEXT_SIMD_DISPATCH != 0)
+		#define ZTD_TEXT_SIMD_DISPATCH_I_ ZTD_TEXT_ON
+	#else
+		#define ZTD_TEXT_SIMD_DISPATCH_I_ ZTD_TEXT_OFF
+	#endif
+#elif ZTD_TEXT_IS_OFF(ZTD_TEXT_SIMD_FORCED_LEVEL_I_) && ZTD_TEXT_IS_ON(ZTD_TEXT_CPUID_I_)
+	#define ZTD_TEXT_SIMD_DISPATCH_I_ ZTD_TEXT_DEFAULT_ON
+#else
+	#define ZTD_TEXT_SIMD_DISPATCH_I_ ZTD_TEXT_DEFAULT_OFF
+#endif // Run-time selection of vector instructions
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_I_) && ZTD_TEXT_IS_ON(ZTD_TEXT_PLATFORM_X86_I_) && (ZTD_TEXT_SIMD_LEVEL_I_ >= 1) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define ZTD_TEXT_SIMD_SSE2_I_ ZTD_TEXT_DEFAULT_ON
+#else
+	#define ZTD_TEXT_SIMD_SSE2_I_ ZTD_TEXT_DEFAULT_OFF
+#endif // SSE2 instructions
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE2_I_) && ((ZTD_TEXT_SIMD_LEVEL_I_ >= 2) || ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_DISPATCH_I_))
+	#define ZTD_TEXT_SIMD_SSE4_2_I_ ZTD_TEXT_DEFAULT_ON
+#else
+	#define ZTD_TEXT_SIMD_SSE4_2_I_ ZTD_TEXT_DEFAULT_OFF
+#endif // SSE4.2 instructions (and, by extension, SSSE3 shuffles)
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_SSE4_2_I_) && ((ZTD_TEXT_SIMD_LEVEL_I_ >= 3) || ZTD_TEXT_IS_ON(ZTD_TEXT_SIMD_DISPATCH_I_))
+	#define ZTD_TEXT_SIMD_AVX2_I_ ZTD_TEXT_DEFAULT_ON
+#else
+	#define ZTD_TEXT_SIMD_AVX2_I_ ZTD_TEXT_DEFAULT_OFF
+#endif // AVX2 instructions
+
+#if (ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_GCC_I_) || ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_CLANG_I_)) && !(defined(__SSE4_2__) || defined(__AVX__))
+	#define ZTD_TEXT_SIMD_TARGET_SSE4_2_I_ __attribute__((target("sse4.2")))
+#else
+	#define ZTD_TEXT_SIMD_TARGET_SSE4_2_I_
+#endif // Compiling SSE4.2 functions for targets without it
+
+#if (ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_GCC_I_) || ZTD_TEXT_IS_ON(ZTD_TEXT_COMPILER_CLANG_I_)) && !defined(__AVX2__)
+	#define ZTD_TEXT_SIMD_TARGET_AVX2_I_ __attribute__((target("avx2")))
+#else
+	#define ZTD_TEXT_SIMD_TARGET_AVX2_I_
+#endif // Compiling AVX2 functions for targets without it
+
 #if defined (__has_cpp_attribute) && (__has_cpp_attribute(nodiscard) != 0L)
 	#if __has_cpp_attribute(nodiscard) >= 201907L
 		#define ZTD_TEXT_NODISCARD_MESSAGE_I_(__message) [[nodiscard(__message)]]
@@ -436,6 +542,30 @@
 	#define ZTD_TEXT_STD_LIBRARY_CONSTEXPR_ALGORITHMS_I_ ZTD_TEXT_DEFAULT_OFF
 #endif
 
+#if defined(ZTD_TEXT_STD_LIBRARY_EXECUTION)
+	#if (ZTD_TEXT_STD_LIBRARY_EXECUTION != 0)
+		#define ZTD_TEXT_STD_LIBRARY_EXECUTION_I_ ZTD_TEXT_ON
+	#else
+		#define ZTD_TEXT_STD_LIBRARY_EXECUTION_I_ ZTD_TEXT_OFF
+	#endif
+#elif defined(__cpp_lib_execution) || defined(__cpp_lib_parallel_algorithm)
+	#define ZTD_TEXT_STD_LIBRARY_EXECUTION_I_ ZTD_TEXT_DEFAULT_ON
+#else
+	#define ZTD_TEXT_STD_LIBRARY_EXECUTION_I_ ZTD_TEXT_DEFAULT_OFF
+#endif
+
+#if defined(ZTD_TEXT_STD_LIBRARY_MEMORY_RESOURCE)
+	#if (ZTD_TEXT_STD_LIBRARY_MEMORY_RESOURCE != 0)
+		#define ZTD_TEXT_STD_LIBRARY_MEMORY_RESOURCE_I_ ZTD_TEXT_ON
+	#else
+		#define ZTD_TEXT_STD_LIBRARY_MEMORY_RESOURCE_I_ ZTD_TEXT_OFF
+	#endif
+#elif defined(__cpp_lib_memory_resource)
+	#define ZTD_TEXT_STD_LIBRARY_MEMORY_RESOURCE_I_ ZTD_TEXT_DEFAULT_ON
+#else
+	#define ZTD_TEXT_STD_LIBRARY_MEMORY_RESOURCE_I_ ZTD_TEXT_DEFAULT_OFF
+#endif
+
 #if defined(ZTD_TEXT_COMPILE_TIME_ENCODING_NAME)
 	#define ZTD_TEXT_COMPILE_TIME_ENCODING_NAME_GET_I_() ZTD_TEXT_COMPILE_TIME_ENCODING_NAME
 	#define ZTD_TEXT_COMPILE_TIME_ENCODING_NAME_I_       ZTD_TEXT_DEFAULT_ON
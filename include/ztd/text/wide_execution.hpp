@@ -42,6 +42,7 @@
 #include <ztd/text/error_handler.hpp>
 #include <ztd/text/unicode_code_point.hpp>
 #include <ztd/text/is_ignorable_error_handler.hpp>
+#include <ztd/text/is_transcoding_compatible.hpp>
 
 #include <ztd/text/detail/empty_state.hpp>
 #include <ztd/text/detail/windows.hpp>
@@ -49,6 +50,8 @@
 #include <ztd/text/detail/type_traits.hpp>
 #include <ztd/text/detail/span.hpp>
 #include <ztd/text/detail/progress_handler.hpp>
+#include <ztd/text/detail/bulk_execution.hpp>
+#include <ztd/text/detail/bulk_transcode.hpp>
 
 #include <cuchar>
 #include <cwchar>
@@ -101,10 +104,7 @@ namespace ztd { namespace text {
 			// TODO: states need to be split into 2
 			// different states, optionally...
 			__wide_decode_state() noexcept : __wide_state(), __narrow_state() {
-				char __ghost_space[MB_LEN_MAX];
-				::std::size_t __init_result = ::std::wcrtomb(__ghost_space, L'\0', &__wide_state);
-				// make sure it is initialized
-				ZTD_TEXT_ASSERT_I_(__init_result == 1 && __ghost_space[0] == '\0');
+				// zero-valued, and so already in the initial conversion state
 				ZTD_TEXT_ASSERT_I_(::std::mbsinit(&__wide_state) != 0);
 			}
 		};
@@ -117,10 +117,7 @@ namespace ztd { namespace text {
 			// TODO: states need to be split into 2
 			// different states, optionally...
 			__wide_encode_state() noexcept : __wide_state(), __narrow_state() {
-				wchar_t __ghost_space[2];
-				::std::size_t __init_result = ::std::mbrtowc(__ghost_space, "", 1, &__wide_state);
-				// make sure it is initialized
-				ZTD_TEXT_ASSERT_I_(__init_result == 0 && __ghost_space[0] == L'\0');
+				// zero-valued, and so already in the initial conversion state
 				ZTD_TEXT_ASSERT_I_(::std::mbsinit(&__wide_state) != 0);
 			}
 		};
@@ -303,6 +300,15 @@ namespace ztd { namespace text {
 						     __intermediate_handler._M_code_points_size));
 				}
 			}
+			if (__outit == __outlast) {
+				wide_execution __self {};
+				return __error_handler(__self,
+					_Result(::std::move(__result.input),
+					     __detail::__reconstruct(::std::in_place_type<_UOutputRange>, __outit, __outlast), __s,
+					     encoding_error::insufficient_output_space),
+					::ztd::text::span<code_point>(__intermediate_handler._M_code_points.data(),
+					     __intermediate_handler._M_code_points_size));
+			}
 			__detail::__dereference(__outit) = __units[0];
 			__outit                          = __detail::__next(__outit);
 
@@ -380,14 +386,12 @@ namespace ztd { namespace text {
 			auto __outit   = __detail::__adl::__adl_begin(__output);
 			auto __outlast = __detail::__adl::__adl_end(__output);
 
-			if constexpr (__call_error_handler) {
-				if (__outit == __outlast) {
-					wide_execution __self {};
-					return __error_handler(__self,
-						_Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
-						     encoding_error::insufficient_output_space),
-						::ztd::text::span<code_unit, 0>());
-				}
+			if (__outit == __outlast) {
+				wide_execution __self {};
+				return __error_handler(__self,
+					_Result(::std::forward<_InputRange>(__input), ::std::forward<_OutputRange>(__output), __s,
+					     encoding_error::insufficient_output_space),
+					::ztd::text::span<code_unit, 0>());
 			}
 
 			constexpr const ::std::size_t __state_max = 32;
@@ -483,11 +487,67 @@ namespace ztd { namespace text {
 		}
 	};
 
+	namespace __detail {
+		template <>
+		class __is_library_encoding<wide_execution> : public ::std::true_type { };
+	} // namespace __detail
+
 	//////
 	/// @}
 	//////
 
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_WCHAR_T_UTF32_COMPATIBLE_I_) && ZTD_TEXT_IS_OFF(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+	namespace __detail {
+
+		// __STDC_ISO_10646__: every wchar_t value is the code point of the character it stands for
+		template <typename _CodeUnit, typename _CodePoint>
+		struct __is_bitwise_transcoding_compatible<wide_execution, basic_utf32<_CodeUnit, _CodePoint>>
+		: std::integral_constant<bool,
+			  (sizeof(wchar_t) == sizeof(_CodeUnit)) && (alignof(wchar_t) == alignof(_CodeUnit))> { };
+
+		template <typename _CodeUnit, typename _CodePoint>
+		struct __is_bitwise_transcoding_compatible<basic_utf32<_CodeUnit, _CodePoint>, wide_execution>
+		: std::integral_constant<bool,
+			  (sizeof(wchar_t) == sizeof(_CodeUnit)) && (alignof(wchar_t) == alignof(_CodeUnit))> { };
+
+	} // namespace __detail
+
+	//////
+	/// @brief Decodes a contiguous range of wide execution encoding code units in bulk, rather than one code point at
+	/// a time.
+	///
+	/// @remarks This is found by ztd::text::decode_into through argument-dependent lookup. Under a UTF-8 locale (as
+	/// kept by ztd::text::refresh_execution_encoding, and still used by the calling thread), every Unicode scalar
+	/// value converts to and from the narrow execution encoding unchanged, so valid input is copied over directly.
+	/// Under any other locale, and for surrogates and values past the last code point,
+	/// ztd::text::wide_execution::decode_one is used as before.
+	//////
+	template <typename _Input, typename _Output, typename _ErrorHandler,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<wide_execution::code_point, 4>
+		     && __detail::__is_bulk_transcodable_v<_Input, 4, _Output, wide_execution::code_point>>* = nullptr>
+	auto __text_decode(_Input&& __input, const wide_execution& __encoding, _Output&& __output,
+		_ErrorHandler&& __error_handler, wide_execution::decode_state& __state) {
+		const __detail::__wide_execution_utf8_kernel __kernel {
+			__detail::__current_execution_bulk_snapshot().__is_utf8 };
+		return __detail::__bulk_decode<wide_execution::code_point>(::std::forward<_Input>(__input), __encoding,
+			::std::forward<_Output>(__output), __error_handler, __state, __kernel);
+	}
 
+	//////
+	/// @brief Encodes a contiguous range of code points to the wide execution encoding in bulk, rather than one code
+	/// point at a time. See the decoding counterpart for when this applies.
+	//////
+	template <typename _Input, typename _Output, typename _ErrorHandler,
+		::std::enable_if_t<__detail::__is_bulk_unit_v<wide_execution::code_point, 4>
+		     && __detail::__is_bulk_transcodable_v<_Input, 4, _Output, wide_execution::code_unit>>* = nullptr>
+	auto __text_encode(_Input&& __input, const wide_execution& __encoding, _Output&& __output,
+		_ErrorHandler&& __error_handler, wide_execution::encode_state& __state) {
+		const __detail::__wide_execution_utf8_kernel __kernel {
+			__detail::__current_execution_bulk_snapshot().__is_utf8 };
+		return __detail::__bulk_encode<wide_execution::code_unit>(::std::forward<_Input>(__input), __encoding,
+			::std::forward<_Output>(__output), __error_handler, __state, __kernel);
+	}
+#endif
 
 	ZTD_TEXT_INLINE_ABI_NAMESPACE_CLOSE_I_
 }} // namespace ztd::text
@@ -0,0 +1,72 @@
+#include <ztd/text/encoding.hpp>
+
+#include <string_view>
+
+inline namespace ztd_text_tests_basic_compile_time_decode {
+
+	struct decode_one_result {
+		ztd::text::encoding_error error_code;
+		std::size_t read;
+		char32_t code_point;
+	};
+
+	template <typename Encoding>
+	constexpr decode_one_result decode_one(std::u8string_view input) {
+		char32_t output[1] {};
+		typename Encoding::state state {};
+		auto result = Encoding::decode_one(
+		     input, ztd::text::span<char32_t>(output, 1), ztd::text::pass_handler {}, state);
+		return decode_one_result { result.error_code, input.size() - result.input.size(), output[0] };
+	}
+
+	template <typename Encoding>
+	constexpr bool decodes_to(std::u8string_view input, char32_t code_point) {
+		const decode_one_result result = decode_one<Encoding>(input);
+		return result.error_code == ztd::text::encoding_error::ok && result.read == input.size()
+		     && result.code_point == code_point;
+	}
+
+	template <typename Encoding>
+	constexpr bool fails_with(std::u8string_view input, ztd::text::encoding_error error_code, std::size_t read) {
+		const decode_one_result result = decode_one<Encoding>(input);
+		return result.error_code == error_code && result.read == read;
+	}
+
+	template <typename T>
+	static void delayed() {
+		using ztd::text::encoding_error;
+
+		static_assert(decodes_to<ztd::text::utf8>(u8"\x41", U'\x41'));
+		static_assert(decodes_to<ztd::text::utf8>(u8"\xC3\xA9", U'\xE9'));
+		static_assert(decodes_to<ztd::text::utf8>(u8"\xE4\xB8\xAD", U'\x4E2D'));
+		static_assert(decodes_to<ztd::text::utf8>(u8"\xF0\x9F\x98\x80", U'\x1F600'));
+		static_assert(decodes_to<ztd::text::utf8>(u8"\xF4\x8F\xBF\xBF", U'\x10FFFF'));
+		// a bad lead is 1 code unit, a bad continuation is read along with everything before it, and a bad value
+		// is only found once the whole sequence is read
+		static_assert(fails_with<ztd::text::utf8>(u8"\x80", encoding_error::invalid_sequence, 1));
+		static_assert(fails_with<ztd::text::utf8>(u8"\xC0\x80", encoding_error::invalid_sequence, 1));
+		static_assert(fails_with<ztd::text::utf8>(u8"\xF5\x80\x80\x80", encoding_error::invalid_sequence, 1));
+		static_assert(fails_with<ztd::text::utf8>(u8"\xE4\x41", encoding_error::invalid_sequence, 2));
+		static_assert(fails_with<ztd::text::utf8>(u8"\xE4\xB8", encoding_error::incomplete_sequence, 2));
+		static_assert(fails_with<ztd::text::utf8>(u8"\xE0\x80\x80", encoding_error::invalid_sequence, 3));
+		static_assert(fails_with<ztd::text::utf8>(u8"\xE0\x80", encoding_error::incomplete_sequence, 2));
+		static_assert(fails_with<ztd::text::utf8>(u8"\xED\xA0\x80", encoding_error::invalid_sequence, 3));
+		static_assert(fails_with<ztd::text::utf8>(u8"\xF0\x8F\xBF\xBF", encoding_error::invalid_sequence, 4));
+		static_assert(fails_with<ztd::text::utf8>(u8"\xF4\x90\x80\x80", encoding_error::invalid_sequence, 4));
+
+		// WTF-8 allows (only) encoded surrogates
+		static_assert(decodes_to<ztd::text::wtf8>(u8"\xED\xA0\x80", U'\xD800'));
+		static_assert(fails_with<ztd::text::wtf8>(u8"\xE0\x80\x80", encoding_error::invalid_sequence, 3));
+
+		// Modified UTF-8 allows overlong sequences, which is how it writes U+0000
+		static_assert(decodes_to<ztd::text::mutf8>(u8"\xC0\x80", U'\x0'));
+		static_assert(decodes_to<ztd::text::mutf8>(u8"\xE0\x80\x80", U'\x0'));
+		static_assert(fails_with<ztd::text::mutf8>(u8"\xED\xA0\x80", encoding_error::invalid_sequence, 3));
+		static_assert(fails_with<ztd::text::mutf8>(u8"\xF4\x90\x80\x80", encoding_error::invalid_sequence, 4));
+	}
+
+	void instantiate() {
+		delayed<void>();
+	}
+
+} // namespace ztd_text_tests_basic_compile_time_decode
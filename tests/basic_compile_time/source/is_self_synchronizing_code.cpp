@@ -0,0 +1,15 @@
+#include <ztd/text/is_self_synchronizing_code.hpp>
+#include <ztd/text/encoding.hpp>
+
+inline namespace ztd_text_tests_basic_compile_time_is_self_synchronizing_code {
+
+	static_assert(ztd::text::is_self_synchronizing_code_v<ztd::text::ascii>);
+	static_assert(ztd::text::is_self_synchronizing_code_v<ztd::text::utf8>);
+	static_assert(ztd::text::is_self_synchronizing_code_v<ztd::text::utf16>);
+	static_assert(ztd::text::is_self_synchronizing_code_v<ztd::text::utf32>);
+	static_assert(ztd::text::is_self_synchronizing_code_v<ztd::text::encoding_scheme<ztd::text::utf8>>);
+	// a byte in the middle of a UTF-16 or UTF-32 code unit cannot be told apart from the first one
+	static_assert(!ztd::text::is_self_synchronizing_code_v<ztd::text::utf16_le>);
+	static_assert(!ztd::text::is_self_synchronizing_code_v<ztd::text::utf32_be>);
+
+} // namespace ztd_text_tests_basic_compile_time_is_self_synchronizing_code
@@ -0,0 +1,33 @@
+#include <ztd/text/is_transcoding_compatible.hpp>
+#include <ztd/text/encoding.hpp>
+
+inline namespace ztd_text_tests_basic_compile_time_is_transcoding_compatible {
+
+	static_assert(ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::utf8, ztd::text::utf8>);
+	static_assert(ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::compat_utf8, ztd::text::utf8>);
+	static_assert(ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::utf8, ztd::text::compat_utf8>);
+	static_assert(
+	     ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::basic_utf8<unsigned char>, ztd::text::utf8>);
+	static_assert(ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::ascii, ztd::text::utf8>);
+	static_assert(ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::utf8, ztd::text::wtf8>);
+	static_assert(!ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::wtf8, ztd::text::utf8>);
+	// Modified UTF-8 writes U+0000 as 2 code units, unlike UTF-8 and ASCII
+	static_assert(!ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::utf8, ztd::text::mutf8>);
+	static_assert(!ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::ascii, ztd::text::mutf8>);
+	static_assert(ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::mutf8, ztd::text::mutf8>);
+	static_assert(ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::utf16, ztd::text::utf16>);
+	static_assert(
+	     ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::basic_utf16<char16_t>, ztd::text::utf16>);
+	static_assert(ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::utf32, ztd::text::utf32>);
+	static_assert(
+	     ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::basic_utf32<char32_t>, ztd::text::utf32>);
+	static_assert(!ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::utf8, ztd::text::utf16>);
+	static_assert(!ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::utf16, ztd::text::utf32>);
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_WCHAR_T_UTF32_COMPATIBLE_I_) && ZTD_TEXT_IS_OFF(ZTD_TEXT_PLATFORM_WINDOWS_I_)
+	static_assert(ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::wide_execution, ztd::text::utf32>
+	     == (sizeof(wchar_t) == sizeof(char32_t) && alignof(wchar_t) == alignof(char32_t)));
+	static_assert(ztd::text::is_bitwise_transcoding_compatible_v<ztd::text::utf32, ztd::text::wide_execution>
+	     == (sizeof(wchar_t) == sizeof(char32_t) && alignof(wchar_t) == alignof(char32_t)));
+#endif
+
+} // namespace ztd_text_tests_basic_compile_time_is_transcoding_compatible
@@ -0,0 +1,25 @@
+#include <ztd/text/max_transcode_expansion.hpp>
+#include <ztd/text/encoding.hpp>
+
+inline namespace ztd_text_tests_basic_compile_time_max_transcode_expansion {
+
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::utf8, ztd::text::utf16> == 1);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::utf8, ztd::text::utf32> == 1);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::utf8, ztd::text::utf8> == 3);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::utf16, ztd::text::utf8> == 3);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::utf16, ztd::text::utf16> == 1);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::utf16, ztd::text::utf32> == 1);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::utf32, ztd::text::utf8> == 4);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::utf32, ztd::text::utf16> == 2);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::utf32, ztd::text::utf32> == 1);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::ascii, ztd::text::utf8> == 3);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::ascii, ztd::text::utf16> == 1);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::utf8, ztd::text::ascii> == 1);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::compat_utf8, ztd::text::utf16> == 1);
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::wtf8, ztd::text::utf8> == 3);
+	// Modified UTF-8 writes U+0000 with 2 code units, so it gets the general bound
+	static_assert(ztd::text::max_transcode_expansion_v<ztd::text::utf8, ztd::text::mutf8>
+	     == ztd::text::max_code_units_v<ztd::text::mutf8>);
+	static_assert(ztd::text::max_transcode_expansion_v<const ztd::text::utf16&, ztd::text::utf8&&> == 3);
+
+} // namespace ztd_text_tests_basic_compile_time_max_transcode_expansion
@@ -0,0 +1,117 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <ztd/text/transcode.hpp>
+#include <ztd/text/decode.hpp>
+#include <ztd/text/encode.hpp>
+#include <ztd/text/encoding.hpp>
+#include <ztd/text/text.hpp>
+
+#include <ztd/text/tests/basic_unicode_strings.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_STD_LIBRARY_MEMORY_RESOURCE_I_)
+#include <memory_resource>
+#endif
+
+TEST_CASE("text/append", "appending conversions keep the container's contents and reuse its capacity") {
+	const std::u8string_view u8_input   = ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+	const std::u16string_view u16_input = ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+	const std::u32string_view u32_input = ztd::text::tests::u32_unicode_sequence_truth_native_endian;
+
+	SECTION("transcode") {
+		std::u16string output = u"prefix";
+		auto result = ztd::text::transcode_append(u8_input, ztd::text::utf8 {}, output, ztd::text::utf16 {});
+		static_assert(std::is_same_v<decltype(result.output), std::u16string&>);
+		REQUIRE(&result.output == &output);
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(result.input.empty());
+		REQUIRE(output.size() == 6 + u16_input.size());
+		REQUIRE(std::u16string_view(output).substr(0, 6) == u"prefix");
+		REQUIRE(std::u16string_view(output).substr(6) == u16_input);
+	}
+	SECTION("transcode (copy)") {
+		std::u8string output = u8"prefix";
+		auto result = ztd::text::transcode_append(u8_input, ztd::text::utf8 {}, output, ztd::text::utf8 {});
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(std::u8string_view(output).substr(0, 6) == u8"prefix");
+		REQUIRE(std::u8string_view(output).substr(6) == u8_input);
+	}
+	SECTION("decode") {
+		std::vector<char32_t> output(3, U'a');
+		auto result = ztd::text::decode_append(u8_input, ztd::text::utf8 {}, output);
+		REQUIRE(&result.output == &output);
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(output.size() == 3 + u32_input.size());
+		REQUIRE(std::u32string_view(output.data() + 3, output.size() - 3) == u32_input);
+	}
+	SECTION("encode") {
+		std::u8string output = u8"prefix";
+		auto result = ztd::text::encode_append(u32_input, ztd::text::utf8 {}, output);
+		REQUIRE(&result.output == &output);
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(std::u8string_view(output).substr(6) == u8_input);
+	}
+	SECTION("reused capacity") {
+		std::u16string output;
+		ztd::text::transcode_append(u8_input, ztd::text::utf8 {}, output, ztd::text::utf16 {});
+		const std::u16string first = output;
+		for (int i = 0; i < 4; ++i) {
+			output.clear();
+			const char16_t* const data = output.data();
+			ztd::text::transcode_append(u8_input, ztd::text::utf8 {}, output, ztd::text::utf16 {});
+			REQUIRE(output.data() == data);
+			REQUIRE(output == first);
+		}
+	}
+	SECTION("to") {
+		auto result = ztd::text::transcode_to<std::u16string>(u8_input, ztd::text::utf8 {}, ztd::text::utf16 {});
+		static_assert(std::is_same_v<decltype(result.output), std::u16string>);
+		REQUIRE(result.output == u16_input);
+	}
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_STD_LIBRARY_MEMORY_RESOURCE_I_)
+	SECTION("pmr") {
+		std::byte storage[1 << 16];
+		std::pmr::monotonic_buffer_resource resource(storage, sizeof(storage), std::pmr::null_memory_resource());
+		std::pmr::u16string output(&resource);
+		auto result = ztd::text::transcode_append(u8_input, ztd::text::utf8 {}, output, ztd::text::utf16 {});
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(output == u16_input);
+		REQUIRE(output.get_allocator().resource() == &resource);
+
+		static_assert(std::is_same_v<ztd::text::pmr::u8text::range_type, std::pmr::u8string>);
+		static_assert(std::is_same_v<ztd::text::pmr::basic_text<ztd::text::utf16>::range_type, std::pmr::u16string>);
+	}
+#endif
+}
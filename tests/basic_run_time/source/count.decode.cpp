@@ -34,6 +34,11 @@
 
 #include <ztd/text/tests/basic_unicode_strings.hpp>
 
+#include <iterator>
+#include <list>
+#include <string>
+#include <string_view>
+
 TEST_CASE("text/count_code_points/core", "basic usages of count_code_points function do not explode") {
 	std::size_t expected0 = std::size(ztd::text::tests::u32_basic_source_character_set);
 	std::size_t expected1 = std::size(ztd::text::tests::u32_unicode_sequence_truth_native_endian);
@@ -127,3 +132,61 @@ TEST_CASE("text/count_code_points/core", "basic usages of count_code_points func
 		REQUIRE(result1.count == expected1);
 	}
 }
+
+template <typename Encoding, typename ErrorHandler, typename Char>
+void bulk_count_check(std::basic_string_view<Char> input) {
+	// the std::list input goes through the generic, one-code-point-at-a-time loop
+	std::list<Char> slow_input(input.cbegin(), input.cend());
+	auto fast_result = ztd::text::count_code_points(input, Encoding {}, ErrorHandler {});
+	auto slow_result = ztd::text::count_code_points(slow_input, Encoding {}, ErrorHandler {});
+	REQUIRE(fast_result.count == slow_result.count);
+	REQUIRE(fast_result.error_code == slow_result.error_code);
+	REQUIRE(fast_result.handled_error == slow_result.handled_error);
+	std::size_t slow_input_left
+	     = static_cast<std::size_t>(std::distance(slow_result.input.begin(), slow_result.input.end()));
+	REQUIRE(fast_result.input.size() == slow_input_left);
+}
+
+template <typename Encoding, typename Char, std::size_t BadN, std::size_t PositionN>
+void bulk_count_check_all(std::basic_string_view<Char> text,
+     const std::basic_string_view<Char> (&bad_sequences)[BadN], const std::size_t (&positions)[PositionN]) {
+	for (const auto& bad : bad_sequences) {
+		for (std::size_t position : positions) {
+			std::basic_string<Char> input(text);
+			input.insert(position, bad);
+			std::basic_string_view<Char> input_view(input);
+			bulk_count_check<Encoding, ztd::text::replacement_handler>(input_view);
+			bulk_count_check<Encoding, ztd::text::pass_handler>(input_view);
+		}
+	}
+	auto trusted_result = ztd::text::count_code_points(text, Encoding {}, ztd::text::assume_valid_handler {});
+	auto checked_result = ztd::text::count_code_points(text, Encoding {}, ztd::text::pass_handler {});
+	REQUIRE(checked_result.error_code == ztd::text::encoding_error::ok);
+	REQUIRE(trusted_result.error_code == ztd::text::encoding_error::ok);
+	REQUIRE(trusted_result.count == checked_result.count);
+	REQUIRE(trusted_result.input.empty());
+}
+
+TEST_CASE("text/count_code_points/bulk",
+	"counting contiguous UTF-8 and UTF-16 gives the same results as counting one code point at a time") {
+	const std::size_t positions[] = { 0, 1, 17, 63, 200 };
+	SECTION("utf8") {
+		std::u8string text;
+		for (int repeat = 0; repeat < 3; ++repeat) {
+			text += ztd::text::tests::u8_basic_source_character_set;
+			text += ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+		}
+		const std::u8string_view bad_sequences[]
+		     = { u8"", u8"\x80", u8"\xC0\xAF", u8"\xED\xA0\x80", u8"\xF0\x9F\x98" };
+		bulk_count_check_all<ztd::text::utf8>(std::u8string_view(text), bad_sequences, positions);
+	}
+	SECTION("utf16") {
+		std::u16string text;
+		for (int repeat = 0; repeat < 3; ++repeat) {
+			text += ztd::text::tests::u16_basic_source_character_set;
+			text += ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+		}
+		const std::u16string_view bad_sequences[] = { u"", u"\xD800", u"\xDC00", u"\xDBFF\xDBFF" };
+		bulk_count_check_all<ztd::text::utf16>(std::u16string_view(text), bad_sequences, positions);
+	}
+}
@@ -36,6 +36,11 @@
 
 #include <ztd/text/tests/basic_unicode_strings.hpp>
 
+#include <list>
+#include <string>
+#include <string_view>
+#include <vector>
+
 TEST_CASE("text/decode/core", "basic usages of decode function do not explode") {
 	SECTION("execution") {
 		ztd::text::execution encoding {};
@@ -123,3 +128,116 @@ TEST_CASE("text/decode/core", "basic usages of decode function do not explode")
 		REQUIRE(result1 == ztd::text::tests::u32_unicode_sequence_truth_native_endian);
 	}
 }
+
+TEST_CASE("text/decode/utf8 bulk",
+	"decoding contiguous UTF-8 gives the same results as decoding it one code point at a time") {
+	std::u8string text;
+	for (int repeat = 0; repeat < 3; ++repeat) {
+		text += ztd::text::tests::u8_basic_source_character_set;
+		text += ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+	}
+	const std::u8string_view bad_sequences[]
+	     = { u8"", u8"\x80", u8"\xC0\xAF", u8"\xED\xA0\x80", u8"\xF0\x9F\x98" };
+	const std::size_t positions[] = { 0, 1, 17, 63, 200 };
+	const std::size_t output_sizes[] = { 0, 1, 2, 31, 64, 1000 };
+	for (const auto& bad : bad_sequences) {
+		for (std::size_t position : positions) {
+			std::u8string input = text;
+			input.insert(position, bad);
+			std::u8string_view input_view(input);
+			// the std::list input goes through the generic, one-code-point-at-a-time loop
+			std::list<char8_t> slow_input(input.cbegin(), input.cend());
+			for (std::size_t output_size : output_sizes) {
+				std::vector<char32_t> fast_storage(output_size + 1, U'*');
+				std::vector<char32_t> slow_storage(output_size + 1, U'*');
+				ztd::text::span<char32_t> fast_output_view(fast_storage.data(), output_size);
+				ztd::text::span<char32_t> slow_output_view(slow_storage.data(), output_size);
+				auto fast_result = ztd::text::decode_into(
+				     input_view, ztd::text::utf8 {}, fast_output_view, ztd::text::replacement_handler {});
+				auto slow_result = ztd::text::decode_into(
+				     slow_input, ztd::text::utf8 {}, slow_output_view, ztd::text::replacement_handler {});
+				REQUIRE(fast_result.error_code == slow_result.error_code);
+				REQUIRE(fast_result.handled_error == slow_result.handled_error);
+				std::size_t slow_input_left
+				     = static_cast<std::size_t>(std::distance(slow_result.input.begin(), slow_result.input.end()));
+				REQUIRE(fast_result.input.size() == slow_input_left);
+				REQUIRE(fast_storage == slow_storage);
+			}
+			auto fast_output = ztd::text::decode_to<std::u32string>(
+			     input_view, ztd::text::utf8 {}, ztd::text::replacement_handler {});
+			auto slow_output = ztd::text::decode_to<std::u32string>(
+			     slow_input, ztd::text::utf8 {}, ztd::text::replacement_handler {});
+			REQUIRE(fast_output.output == slow_output.output);
+		}
+	}
+}
+
+TEST_CASE("text/decode/utf8 bulk trusted",
+	"decoding valid contiguous UTF-8 with assume_valid_handler gives the same results as the checked loop") {
+	std::u8string input;
+	for (int repeat = 0; repeat < 5; ++repeat) {
+		input += ztd::text::tests::u8_basic_source_character_set;
+		input += ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+	}
+	std::u8string_view input_view(input);
+	std::list<char8_t> slow_input(input.cbegin(), input.cend());
+	// assume_valid_handler still stops when the output is full
+	const std::size_t decoded_size
+	     = ztd::text::decode_to<std::u32string>(input_view, ztd::text::utf8 {}).output.size();
+	const std::size_t output_sizes[]
+	     = { 0, 1, 2, 9, 31, 64, decoded_size - 1, decoded_size, decoded_size + 1, input.size(), input.size() + 100 };
+	for (std::size_t output_size : output_sizes) {
+		std::vector<char32_t> fast_storage(output_size + 1, U'*');
+		std::vector<char32_t> slow_storage(output_size + 1, U'*');
+		ztd::text::span<char32_t> fast_output_view(fast_storage.data(), output_size);
+		ztd::text::span<char32_t> slow_output_view(slow_storage.data(), output_size);
+		auto fast_result = ztd::text::decode_into(
+		     input_view, ztd::text::utf8 {}, fast_output_view, ztd::text::assume_valid_handler {});
+		auto slow_result = ztd::text::decode_into(
+		     slow_input, ztd::text::utf8 {}, slow_output_view, ztd::text::replacement_handler {});
+		REQUIRE(fast_result.error_code == slow_result.error_code);
+		std::size_t slow_input_left
+		     = static_cast<std::size_t>(std::distance(slow_result.input.begin(), slow_result.input.end()));
+		REQUIRE(fast_result.input.size() == slow_input_left);
+		REQUIRE(fast_storage == slow_storage);
+	}
+	auto fast_output
+	     = ztd::text::decode_to<std::u32string>(input_view, ztd::text::utf8 {}, ztd::text::assume_valid_handler {});
+	auto slow_output
+	     = ztd::text::decode_to<std::u32string>(slow_input, ztd::text::utf8 {}, ztd::text::replacement_handler {});
+	REQUIRE(fast_output.output == slow_output.output);
+}
+
+TEST_CASE("text/decode/exact", "decode_to_exact gives the same results as decode_to, in exactly-sized storage") {
+	std::u8string input;
+	for (int repeat = 0; repeat < 3; ++repeat) {
+		input += ztd::text::tests::u8_basic_source_character_set;
+		input += ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+	}
+	SECTION("valid") {
+		auto expected = ztd::text::decode_to<std::u32string>(input, ztd::text::utf8 {});
+		auto result   = ztd::text::decode_to_exact<std::vector<char32_t>>(input, ztd::text::utf8 {});
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(std::u32string(result.output.cbegin(), result.output.cend()) == expected.output);
+		REQUIRE(result.output.capacity() == result.output.size());
+		auto trusted_result = ztd::text::decode_to_exact<std::vector<char32_t>>(
+		     input, ztd::text::utf8 {}, ztd::text::assume_valid_handler {});
+		REQUIRE(trusted_result.output == result.output);
+	}
+	SECTION("invalid") {
+		input.insert(40, u8"\xC0\x80");
+		auto expected
+		     = ztd::text::decode_to<std::u32string>(input, ztd::text::utf8 {}, ztd::text::replacement_handler {});
+		auto result = ztd::text::decode_to_exact<std::u32string>(
+		     input, ztd::text::utf8 {}, ztd::text::replacement_handler {});
+		REQUIRE(result.handled_error);
+		REQUIRE(result.output == expected.output);
+	}
+	SECTION("not sized") {
+		// a std::list can only be decoded once, the usual way
+		std::list<char8_t> list_input(input.cbegin(), input.cend());
+		auto expected = ztd::text::decode_to<std::u32string>(input, ztd::text::utf8 {});
+		auto result   = ztd::text::decode_to_exact<std::u32string>(list_input, ztd::text::utf8 {});
+		REQUIRE(result.output == expected.output);
+	}
+}
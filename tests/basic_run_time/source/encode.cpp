@@ -35,6 +35,10 @@
 
 #include <ztd/text/tests/basic_unicode_strings.hpp>
 
+#include <list>
+#include <string>
+#include <vector>
+
 TEST_CASE("text/encode/core", "basic usages of encode function do not explode") {
 	SECTION("execution") {
 		ztd::text::execution encoding {};
@@ -112,3 +116,114 @@ TEST_CASE("text/encode/core", "basic usages of encode function do not explode")
 		REQUIRE(result1 == ztd::text::tests::u32_unicode_sequence_truth_native_endian);
 	}
 }
+
+TEST_CASE("text/encode/utf8 bulk",
+	"encoding contiguous UTF-32 to UTF-8 gives the same results as encoding it one code point at a time") {
+	std::u32string text;
+	for (int repeat = 0; repeat < 3; ++repeat) {
+		text += ztd::text::tests::u32_basic_source_character_set;
+		text += ztd::text::tests::u32_unicode_sequence_truth_native_endian;
+	}
+	const std::u32string bad_code_points[] = { U"", std::u32string(1, static_cast<char32_t>(0xD800)),
+		std::u32string(1, static_cast<char32_t>(0xDFFF)), std::u32string(1, static_cast<char32_t>(0x110000)),
+		std::u32string(1, static_cast<char32_t>(0xFFFFFFFF)) };
+	const std::size_t positions[]    = { 0, 1, 17, 63, 200 };
+	const std::size_t output_sizes[] = { 0, 1, 2, 31, 64, 1000 };
+	for (const auto& bad : bad_code_points) {
+		for (std::size_t position : positions) {
+			std::u32string input = text;
+			input.insert(position, bad);
+			// the std::list input goes through the generic, one-code-point-at-a-time loop
+			std::list<char32_t> slow_input(input.cbegin(), input.cend());
+			for (std::size_t output_size : output_sizes) {
+				std::vector<char8_t> fast_storage(output_size + 1, u8'*');
+				std::vector<char8_t> slow_storage(output_size + 1, u8'*');
+				ztd::text::span<char8_t> fast_output_view(fast_storage.data(), output_size);
+				ztd::text::span<char8_t> slow_output_view(slow_storage.data(), output_size);
+				auto fast_result = ztd::text::encode_into(
+				     input, ztd::text::utf8 {}, fast_output_view, ztd::text::replacement_handler {});
+				auto slow_result = ztd::text::encode_into(
+				     slow_input, ztd::text::utf8 {}, slow_output_view, ztd::text::replacement_handler {});
+				REQUIRE(fast_result.error_code == slow_result.error_code);
+				REQUIRE(fast_result.handled_error == slow_result.handled_error);
+				std::size_t slow_input_left
+				     = static_cast<std::size_t>(std::distance(slow_result.input.begin(), slow_result.input.end()));
+				REQUIRE(fast_result.input.size() == slow_input_left);
+				REQUIRE(fast_storage == slow_storage);
+			}
+			auto fast_output
+			     = ztd::text::encode_to<std::u8string>(input, ztd::text::utf8 {}, ztd::text::replacement_handler {});
+			auto slow_output = ztd::text::encode_to<std::u8string>(
+			     slow_input, ztd::text::utf8 {}, ztd::text::replacement_handler {});
+			REQUIRE(fast_output.output == slow_output.output);
+		}
+	}
+}
+
+TEST_CASE("text/encode/exact", "encode_to_exact gives the same results as encode_to, in exactly-sized storage") {
+	std::u32string input;
+	for (int repeat = 0; repeat < 3; ++repeat) {
+		input += ztd::text::tests::u32_basic_source_character_set;
+		input += ztd::text::tests::u32_unicode_sequence_truth_native_endian;
+	}
+	SECTION("valid") {
+		auto expected = ztd::text::encode_to<std::u8string>(input, ztd::text::utf8 {});
+		auto result   = ztd::text::encode_to_exact<std::vector<char8_t>>(input, ztd::text::utf8 {});
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(std::u8string(result.output.cbegin(), result.output.cend()) == expected.output);
+		REQUIRE(result.output.capacity() == result.output.size());
+		auto utf16_expected = ztd::text::encode_to<std::u16string>(input, ztd::text::utf16 {});
+		auto utf16_result   = ztd::text::encode_to_exact<std::u16string>(input, ztd::text::utf16 {});
+		REQUIRE(utf16_result.output == utf16_expected.output);
+	}
+	SECTION("invalid") {
+		input.insert(40, 1, static_cast<char32_t>(0xD800));
+		auto expected
+		     = ztd::text::encode_to<std::u8string>(input, ztd::text::utf8 {}, ztd::text::replacement_handler {});
+		auto result = ztd::text::encode_to_exact<std::u8string>(
+		     input, ztd::text::utf8 {}, ztd::text::replacement_handler {});
+		REQUIRE(result.handled_error);
+		REQUIRE(result.output == expected.output);
+	}
+	SECTION("not sized") {
+		std::list<char32_t> list_input(input.cbegin(), input.cend());
+		auto expected = ztd::text::encode_to<std::u8string>(input, ztd::text::utf8 {});
+		auto result   = ztd::text::encode_to_exact<std::u8string>(list_input, ztd::text::utf8 {});
+		REQUIRE(result.output == expected.output);
+	}
+}
+
+template <typename Encoding>
+void bounded_assume_valid_encode_check(std::u32string_view input) {
+	using CodeUnit = ztd::text::code_unit_t<Encoding>;
+	const auto expected
+	     = ztd::text::encode_to<std::basic_string<CodeUnit>>(input, Encoding {}, ztd::text::replacement_handler {});
+	const std::size_t output_sizes[] = { 0, 1, 2, 5, 7, expected.output.size() - 1, expected.output.size() };
+	for (std::size_t output_size : output_sizes) {
+		std::vector<CodeUnit> storage(output_size + 8, static_cast<CodeUnit>('*'));
+		ztd::text::span<CodeUnit> output(storage.data(), output_size);
+		auto result = ztd::text::encode_into(input, Encoding {}, output, ztd::text::assume_valid_handler {});
+		if (output_size < expected.output.size()) {
+			REQUIRE(result.error_code == ztd::text::encoding_error::insufficient_output_space);
+		}
+		else {
+			REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		}
+		const std::size_t written = output_size - result.output.size();
+		REQUIRE(written <= output_size);
+		REQUIRE(std::basic_string<CodeUnit>(storage.data(), written) == expected.output.substr(0, written));
+		for (std::size_t index = output_size; index < storage.size(); ++index) {
+			REQUIRE(storage[index] == static_cast<CodeUnit>('*'));
+		}
+	}
+}
+
+TEST_CASE("text/encode/assume_valid bounded",
+	"encoding with assume_valid_handler into an output that is too small stops at the end of the output") {
+	std::u32string input(10, U'\x4E00');
+	input += U"a\U0001F600b";
+	bounded_assume_valid_encode_check<ztd::text::utf8>(input);
+	bounded_assume_valid_encode_check<ztd::text::utf16>(input);
+	bounded_assume_valid_encode_check<ztd::text::utf32>(input);
+	bounded_assume_valid_encode_check<ztd::text::compat_utf8>(input);
+}
@@ -0,0 +1,208 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <ztd/text/decode.hpp>
+#include <ztd/text/encode.hpp>
+#include <ztd/text/execution.hpp>
+#include <ztd/text/wide_execution.hpp>
+
+#include <ztd/text/tests/basic_unicode_strings.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <clocale>
+#include <cwchar>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#ifndef _WIN32
+#include <locale.h>
+#endif
+
+inline namespace ztd_text_tests_basic_run_time_execution {
+	template <typename Output, typename Input>
+	struct one_at_a_time_result {
+		Output output;
+		std::size_t input_left;
+		ztd::text::encoding_error error_code;
+	};
+
+	template <typename Encoding, typename Input, typename ErrorHandler>
+	auto decode_one_at_a_time(const Encoding& encoding, Input input, ErrorHandler error_handler) {
+		using CodePoint = ztd::text::code_point_t<Encoding>;
+		one_at_a_time_result<std::u32string, Input> result { {}, 0, ztd::text::encoding_error::ok };
+		ztd::text::decode_state_t<Encoding> state {};
+		while (!input.empty()) {
+			CodePoint storage[ztd::text::max_code_points_v<Encoding>] {};
+			ztd::text::span<CodePoint> buffer(storage);
+			auto one = encoding.decode_one(input, buffer, error_handler, state);
+			result.output.append(storage, one.output.data());
+			input = Input(one.input.data(), one.input.size());
+			if (one.error_code != ztd::text::encoding_error::ok) {
+				result.error_code = one.error_code;
+				break;
+			}
+		}
+		result.input_left = input.size();
+		return result;
+	}
+
+	template <typename Output, typename Encoding, typename ErrorHandler>
+	auto encode_one_at_a_time(const Encoding& encoding, std::u32string_view input, ErrorHandler error_handler) {
+		using CodeUnit = ztd::text::code_unit_t<Encoding>;
+		one_at_a_time_result<Output, std::u32string_view> result { {}, 0, ztd::text::encoding_error::ok };
+		ztd::text::encode_state_t<Encoding> state {};
+		while (!input.empty()) {
+			CodeUnit storage[ztd::text::max_code_units_v<Encoding>] {};
+			ztd::text::span<CodeUnit> buffer(storage);
+			auto one = encoding.encode_one(input, buffer, error_handler, state);
+			result.output.append(storage, one.output.data());
+			input = std::u32string_view(one.input.data(), one.input.size());
+			if (one.error_code != ztd::text::encoding_error::ok) {
+				result.error_code = one.error_code;
+				break;
+			}
+		}
+		result.input_left = input.size();
+		return result;
+	}
+
+	template <typename Expected, typename Result>
+	void check_same(const Expected& expected, const Result& result) {
+		REQUIRE(result.error_code == expected.error_code);
+		REQUIRE(result.input.size() == expected.input_left);
+		REQUIRE(result.output == expected.output);
+	}
+
+	void check_execution() {
+		const std::u32string_view u32_input = ztd::text::tests::u32_unicode_sequence_truth_native_endian;
+		std::u32string code_points;
+		for (int i = 0; i < 64; ++i) {
+			code_points.append(u32_input);
+			code_points.append(U"plain ascii text, and a null: ");
+			code_points.push_back(U'\0');
+		}
+		const std::u32string_view code_points_view(code_points);
+		std::u32string representable;
+		for (char32_t code_point : code_points) {
+			char storage[ztd::text::max_code_units_v<ztd::text::execution>] {};
+			ztd::text::encode_state_t<ztd::text::execution> state {};
+			auto one = ztd::text::execution {}.encode_one(std::u32string_view(&code_point, 1),
+				ztd::text::span<char>(storage), ztd::text::pass_handler {}, state);
+			if (one.error_code == ztd::text::encoding_error::ok) {
+				representable.push_back(code_point);
+			}
+		}
+		const std::string encoded
+			= encode_one_at_a_time<std::string>(ztd::text::execution {}, representable, ztd::text::pass_handler {})
+			       .output;
+		std::string invalid = encoded;
+		invalid.insert(invalid.size() / 3, "\xFF\xC3");
+		invalid.insert(invalid.size() / 2, 1, '\xE2');
+		invalid.push_back('\xE2');
+
+		for (const std::string_view input : { std::string_view(encoded), std::string_view(invalid) }) {
+			check_same(decode_one_at_a_time(ztd::text::execution {}, input, ztd::text::replacement_handler {}),
+				ztd::text::decode_to<std::u32string>(
+				     input, ztd::text::execution {}, ztd::text::replacement_handler {}));
+			check_same(decode_one_at_a_time(ztd::text::execution {}, input, ztd::text::pass_handler {}),
+				ztd::text::decode_to<std::u32string>(input, ztd::text::execution {}, ztd::text::pass_handler {}));
+		}
+		check_same(encode_one_at_a_time<std::string>(
+			           ztd::text::execution {}, code_points_view, ztd::text::replacement_handler {}),
+			ztd::text::encode_to<std::string>(
+			     code_points_view, ztd::text::execution {}, ztd::text::replacement_handler {}));
+		check_same(
+			encode_one_at_a_time<std::string>(ztd::text::execution {}, code_points_view, ztd::text::pass_handler {}),
+			ztd::text::encode_to<std::string>(
+			     code_points_view, ztd::text::execution {}, ztd::text::pass_handler {}));
+		check_same(encode_one_at_a_time<std::string>(
+			           ztd::text::execution {}, representable, ztd::text::replacement_handler {}),
+			ztd::text::encode_to<std::string>(
+			     std::u32string_view(representable), ztd::text::execution {}, ztd::text::replacement_handler {}));
+
+		const std::wstring wide_encoded = encode_one_at_a_time<std::wstring>(
+			ztd::text::wide_execution {}, code_points_view, ztd::text::replacement_handler {})
+			                                  .output;
+		check_same(decode_one_at_a_time(ztd::text::wide_execution {}, std::wstring_view(wide_encoded),
+			           ztd::text::replacement_handler {}),
+			ztd::text::decode_to<std::u32string>(
+			     std::wstring_view(wide_encoded), ztd::text::wide_execution {}, ztd::text::replacement_handler {}));
+		check_same(encode_one_at_a_time<std::wstring>(
+			           ztd::text::wide_execution {}, code_points_view, ztd::text::replacement_handler {}),
+			ztd::text::encode_to<std::wstring>(
+			     code_points_view, ztd::text::wide_execution {}, ztd::text::replacement_handler {}));
+	}
+} // namespace ztd_text_tests_basic_run_time_execution
+
+TEST_CASE("text/execution/bulk", "bulk conversions with the execution encodings match converting one at a time") {
+	SECTION("current locale") {
+		check_execution();
+	}
+	SECTION("C locale") {
+		const std::string previous_locale = std::setlocale(LC_ALL, nullptr);
+		std::setlocale(LC_ALL, "C");
+		ztd::text::refresh_execution_encoding();
+		check_execution();
+		std::setlocale(LC_ALL, previous_locale.c_str());
+		ztd::text::refresh_execution_encoding();
+	}
+}
+
+TEST_CASE("text/execution/refresh", "the detected execution encoding is kept until it is refreshed") {
+	const bool was_unicode            = ztd::text::execution::contains_unicode_encoding();
+	const std::string previous_locale = std::setlocale(LC_ALL, nullptr);
+	std::setlocale(LC_ALL, "C");
+	REQUIRE(ztd::text::execution::contains_unicode_encoding() == was_unicode);
+	ztd::text::refresh_execution_encoding();
+	REQUIRE_FALSE(ztd::text::execution::contains_unicode_encoding());
+	std::setlocale(LC_ALL, previous_locale.c_str());
+	ztd::text::refresh_execution_encoding();
+	REQUIRE(ztd::text::execution::contains_unicode_encoding() == was_unicode);
+
+	ztd::text::execution::decode_state decode_state {};
+	ztd::text::execution::encode_state encode_state {};
+	REQUIRE(std::mbsinit(&decode_state.__narrow_state) != 0);
+	REQUIRE(std::mbsinit(&encode_state.__narrow_state) != 0);
+}
+
+#ifndef _WIN32
+TEST_CASE("text/execution/thread locale",
+	"bulk conversions match converting one at a time when only the current thread's locale has changed") {
+	ztd::text::refresh_execution_encoding();
+	locale_t c_locale = newlocale(LC_CTYPE_MASK, "C", static_cast<locale_t>(0));
+	REQUIRE(c_locale != static_cast<locale_t>(0));
+	locale_t previous_locale = uselocale(c_locale);
+	check_execution();
+	uselocale(previous_locale);
+	freelocale(c_locale);
+	check_execution();
+}
+#endif
@@ -0,0 +1,170 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <ztd/text/file.hpp>
+#include <ztd/text/encoding.hpp>
+#include <ztd/text/count_code_points.hpp>
+#include <ztd/text/transcode.hpp>
+
+#include <ztd/text/tests/basic_unicode_strings.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+struct throw_error_code_handler {
+	template <typename Encoding, typename Result, typename Progress>
+	Result operator()(const Encoding&, Result result, const Progress&) const {
+		throw result.error_code;
+	}
+};
+
+template <typename CharType>
+void write_test_file(const std::filesystem::path& path, std::basic_string_view<CharType> contents) {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(contents.data()),
+	     static_cast<std::streamsize>(contents.size() * sizeof(CharType)));
+}
+
+template <typename CharType>
+std::basic_string<CharType> read_test_file(const std::filesystem::path& path) {
+	std::ifstream file(path, std::ios::binary);
+	std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	std::basic_string<CharType> contents(bytes.size() / sizeof(CharType), CharType {});
+	std::char_traits<char>::copy(reinterpret_cast<char*>(contents.data()), bytes.data(),
+	     contents.size() * sizeof(CharType));
+	return contents;
+}
+
+TEST_CASE("text/file", "files are transcoded, validated and counted without reading them into containers") {
+	const std::filesystem::path directory = std::filesystem::temp_directory_path();
+	const std::filesystem::path source    = directory / "ztd.text.tests.file.source";
+	const std::filesystem::path output    = directory / "ztd.text.tests.file.output";
+
+	// large enough for several blocks of output, with a byte order mark in front
+	std::u8string text;
+	while (text.size() < (static_cast<std::size_t>(1) << 20)) {
+		text += ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+	}
+	std::u8string text_with_bom = u8"\uFEFF" + text;
+	write_test_file<char8_t>(source, text_with_bom);
+
+	SECTION("transcode") {
+		auto result = ztd::text::transcode_file(source, ztd::text::utf8 {}, output, ztd::text::utf16 {});
+		REQUIRE_FALSE(result.file_error);
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE_FALSE(result.handled_error);
+		REQUIRE(result.code_units_read == text_with_bom.size());
+		auto expected = ztd::text::transcode_to<std::u16string>(
+		     std::u8string_view(text), ztd::text::utf8 {}, ztd::text::utf16 {});
+		REQUIRE(result.code_units_written == expected.output.size());
+		REQUIRE(read_test_file<char16_t>(output) == expected.output);
+
+		// and back again, this time without a byte order mark to skip
+		auto back_result = ztd::text::transcode_file(output, ztd::text::utf16 {}, source, ztd::text::utf8 {});
+		REQUIRE_FALSE(back_result.file_error);
+		REQUIRE(back_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(read_test_file<char8_t>(source) == text);
+	}
+	SECTION("throwing handlers") {
+		// filling up a block of output is not an error, so only the ill-formed file throws
+		auto result = ztd::text::transcode_file(source, ztd::text::utf8 {}, output, ztd::text::utf16 {},
+		     throw_error_code_handler {}, throw_error_code_handler {});
+		REQUIRE_FALSE(result.file_error);
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE_FALSE(result.handled_error);
+		auto expected = ztd::text::transcode_to<std::u16string>(
+		     std::u8string_view(text), ztd::text::utf8 {}, ztd::text::utf16 {});
+		REQUIRE(read_test_file<char16_t>(output) == expected.output);
+
+		std::u8string error_text = text;
+		error_text[600000]       = static_cast<char8_t>(0xFF);
+		write_test_file<char8_t>(source, error_text);
+		REQUIRE_THROWS_AS(ztd::text::transcode_file(source, ztd::text::utf8 {}, output, ztd::text::utf16 {},
+		     throw_error_code_handler {}, throw_error_code_handler {}),
+	     ztd::text::encoding_error);
+	}
+	SECTION("assume_valid") {
+		// every output block fills up in the middle of a 3-byte sequence
+		const std::u32string cjk_text(100000, U'\x4E00');
+		write_test_file<char32_t>(source, cjk_text);
+		auto result = ztd::text::transcode_file(source, ztd::text::utf32 {}, output, ztd::text::utf8 {},
+		     ztd::text::assume_valid_handler {}, ztd::text::assume_valid_handler {});
+		REQUIRE_FALSE(result.file_error);
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(result.code_units_read == cjk_text.size());
+		auto expected = ztd::text::transcode_to<std::u8string>(
+		     std::u32string_view(cjk_text), ztd::text::utf32 {}, ztd::text::utf8 {});
+		REQUIRE(result.code_units_written == expected.output.size());
+		REQUIRE(read_test_file<char8_t>(output) == expected.output);
+	}
+	SECTION("validate and count") {
+		auto validate_result = ztd::text::validate_file(source, ztd::text::utf8 {});
+		REQUIRE(validate_result);
+		REQUIRE(validate_result.code_units_read == text_with_bom.size());
+		auto count_result = ztd::text::count_file(source, ztd::text::utf8 {});
+		REQUIRE_FALSE(count_result.file_error);
+		REQUIRE(count_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(count_result.count
+		     == ztd::text::count_code_points(std::u8string_view(text), ztd::text::utf8 {}).count);
+
+		std::u8string error_text = text;
+		error_text[1000]         = static_cast<char8_t>(0xFF);
+		write_test_file<char8_t>(source, error_text);
+		auto error_validate_result = ztd::text::validate_file(source, ztd::text::utf8 {});
+		REQUIRE_FALSE(error_validate_result.valid);
+		REQUIRE(error_validate_result.code_units_read == 1000);
+		auto error_result = ztd::text::transcode_file(
+		     source, ztd::text::utf8 {}, output, ztd::text::utf16 {}, ztd::text::pass_handler {});
+		REQUIRE(error_result.error_code == ztd::text::encoding_error::invalid_sequence);
+		REQUIRE(error_result.code_units_read == 1000);
+		REQUIRE(read_test_file<char16_t>(output).size() == error_result.code_units_written);
+	}
+	SECTION("empty and missing files") {
+		write_test_file<char8_t>(source, u8"");
+		auto empty_result = ztd::text::transcode_file(source, ztd::text::utf8 {}, output, ztd::text::utf16 {});
+		REQUIRE_FALSE(empty_result.file_error);
+		REQUIRE(empty_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(empty_result.code_units_written == 0);
+		REQUIRE(std::filesystem::file_size(output) == 0);
+
+		auto missing_result = ztd::text::transcode_file(
+		     directory / "ztd.text.tests.file.missing", ztd::text::utf8 {}, output, ztd::text::utf16 {});
+		REQUIRE(missing_result.file_error);
+		REQUIRE_FALSE(ztd::text::validate_file(directory / "ztd.text.tests.file.missing", ztd::text::utf8 {}));
+	}
+
+	std::filesystem::remove(source);
+	std::filesystem::remove(output);
+}
@@ -0,0 +1,267 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <ztd/text/iconv_encoding.hpp>
+#include <ztd/text/decode.hpp>
+#include <ztd/text/encode.hpp>
+#include <ztd/text/transcode.hpp>
+#include <ztd/text/count_code_points.hpp>
+
+#include <ztd/text/tests/basic_unicode_strings.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_USE_ICONV_I_)
+inline namespace ztd_text_tests_basic_run_time_iconv_encoding {
+	template <typename Output>
+	struct one_at_a_time_result {
+		Output output;
+		std::size_t input_left;
+		ztd::text::encoding_error error_code;
+	};
+
+	template <typename ErrorHandler>
+	auto decode_one_at_a_time(
+		const ztd::text::iconv_encoding& encoding, std::string_view input, ErrorHandler error_handler) {
+		one_at_a_time_result<std::u32string> result { {}, 0, ztd::text::encoding_error::ok };
+		auto state = ztd::text::make_decode_state(encoding);
+		while (!input.empty()) {
+			char32_t storage[ztd::text::iconv_encoding::max_code_points] {};
+			ztd::text::span<char32_t> buffer(storage);
+			auto one = encoding.decode_one(input, buffer, error_handler, state);
+			result.output.append(storage, one.output.data());
+			input = std::string_view(one.input.data(), one.input.size());
+			if (one.error_code != ztd::text::encoding_error::ok) {
+				result.error_code = one.error_code;
+				break;
+			}
+		}
+		result.input_left = input.size();
+		return result;
+	}
+
+	template <typename ErrorHandler>
+	auto encode_one_at_a_time(
+		const ztd::text::iconv_encoding& encoding, std::u32string_view input, ErrorHandler error_handler) {
+		one_at_a_time_result<std::string> result { {}, 0, ztd::text::encoding_error::ok };
+		auto state = ztd::text::make_encode_state(encoding);
+		while (!input.empty()) {
+			char storage[ztd::text::iconv_encoding::max_code_units] {};
+			ztd::text::span<char> buffer(storage);
+			auto one = encoding.encode_one(input, buffer, error_handler, state);
+			result.output.append(storage, one.output.data());
+			input = std::u32string_view(one.input.data(), one.input.size());
+			if (one.error_code != ztd::text::encoding_error::ok) {
+				result.error_code = one.error_code;
+				break;
+			}
+		}
+		result.input_left = input.size();
+		return result;
+	}
+
+	template <typename Expected, typename Result>
+	void check_same(const Expected& expected, const Result& result) {
+		REQUIRE(result.error_code == expected.error_code);
+		REQUIRE(result.input.size() == expected.input_left);
+		REQUIRE(result.output == expected.output);
+	}
+} // namespace ztd_text_tests_basic_run_time_iconv_encoding
+
+TEST_CASE("text/iconv_encoding", "iconv_encoding converts legacy character sets, a buffer at a time") {
+	SECTION("known text") {
+		ztd::text::iconv_encoding koi8_r("KOI8-R");
+		REQUIRE_FALSE(koi8_r.contains_unicode_encoding());
+		REQUIRE_FALSE(koi8_r.has_shift_states());
+		const std::string_view koi8_r_text = "\xF0\xD2\xC9\xD7\xC5\xD4, world";
+		const std::u32string_view u32_text = U"Привет, world";
+
+		auto decode_result = ztd::text::decode_to<std::u32string>(koi8_r_text, koi8_r, ztd::text::pass_handler {});
+		REQUIRE(decode_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(decode_result.output == u32_text);
+		auto encode_result = ztd::text::encode_to<std::string>(u32_text, koi8_r, ztd::text::pass_handler {});
+		REQUIRE(encode_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(encode_result.output == koi8_r_text);
+
+		ztd::text::iconv_encoding cp1251("CP1251");
+		char storage[64] {};
+		auto into_result = ztd::text::transcode_into(koi8_r_text, koi8_r, ztd::text::span<char>(storage), cp1251,
+			ztd::text::pass_handler {}, ztd::text::pass_handler {});
+		REQUIRE(into_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(std::string_view(storage, static_cast<std::size_t>(into_result.output.data() - storage))
+			== "\xCF\xF0\xE8\xE2\xE5\xF2, world");
+
+		ztd::text::iconv_encoding latin_1("ISO-8859-1");
+		auto transcode_result
+			= ztd::text::transcode_to<std::string>(koi8_r_text, koi8_r, latin_1, ztd::text::pass_handler {});
+		REQUIRE(transcode_result.error_code == ztd::text::encoding_error::invalid_sequence);
+		REQUIRE(transcode_result.output.empty());
+		auto replaced_result = ztd::text::transcode_to<std::string>(
+			koi8_r_text, koi8_r, latin_1, ztd::text::replacement_handler {});
+		REQUIRE(replaced_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(replaced_result.output == "??????, world");
+	}
+	SECTION("same as one at a time") {
+		ztd::text::iconv_encoding utf8("UTF-8");
+		REQUIRE(utf8.contains_unicode_encoding());
+		const std::u32string_view u32_input = ztd::text::tests::u32_unicode_sequence_truth_native_endian;
+		std::u32string code_points;
+		for (int i = 0; i < 64; ++i) {
+			code_points.append(u32_input);
+			code_points.append(U"plain ascii text, and a null: ");
+			code_points.push_back(U'\0');
+		}
+		const std::u32string_view code_points_view(code_points);
+		const std::string encoded
+			= encode_one_at_a_time(utf8, code_points_view, ztd::text::pass_handler {}).output;
+		std::string invalid = encoded;
+		invalid.insert(invalid.size() / 3, "\xFF\xC3");
+		invalid.insert(invalid.size() / 2, 1, '\xE2');
+		invalid.push_back('\xE2');
+
+		for (const std::string_view input : { std::string_view(encoded), std::string_view(invalid) }) {
+			check_same(decode_one_at_a_time(utf8, input, ztd::text::replacement_handler {}),
+				ztd::text::decode_to<std::u32string>(input, utf8, ztd::text::replacement_handler {}));
+			check_same(decode_one_at_a_time(utf8, input, ztd::text::pass_handler {}),
+				ztd::text::decode_to<std::u32string>(input, utf8, ztd::text::pass_handler {}));
+		}
+		auto truncated_result = ztd::text::decode_to<std::u32string>(
+			std::string_view("a\xE2\x82" "b\xE2"), utf8, ztd::text::replacement_handler {});
+		REQUIRE(truncated_result.output == U"a\uFFFDb\uFFFD");
+
+		ztd::text::iconv_encoding koi8_r("KOI8-R");
+		check_same(encode_one_at_a_time(koi8_r, code_points_view, ztd::text::replacement_handler {}),
+			ztd::text::encode_to<std::string>(code_points_view, koi8_r, ztd::text::replacement_handler {}));
+		check_same(encode_one_at_a_time(koi8_r, code_points_view, ztd::text::pass_handler {}),
+			ztd::text::encode_to<std::string>(code_points_view, koi8_r, ztd::text::pass_handler {}));
+	}
+	SECTION("shift states") {
+		ztd::text::iconv_encoding iso_2022_jp("ISO-2022-JP");
+		REQUIRE(iso_2022_jp.has_shift_states());
+		const std::u32string_view u32_text = U"aあいbう";
+		auto encode_result = ztd::text::encode_to<std::string>(u32_text, iso_2022_jp, ztd::text::pass_handler {});
+		REQUIRE(encode_result.error_code == ztd::text::encoding_error::ok);
+		auto decode_result = ztd::text::decode_to<std::u32string>(
+			std::string_view(encode_result.output), iso_2022_jp, ztd::text::pass_handler {});
+		REQUIRE(decode_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(decode_result.output == u32_text);
+		check_same(decode_one_at_a_time(iso_2022_jp, encode_result.output, ztd::text::pass_handler {}),
+			decode_result);
+	}
+	SECTION("preflight with states that cannot be copied") {
+		ztd::text::iconv_encoding koi8_r("KOI8-R");
+		ztd::text::iconv_encoding cp1251("CP1251");
+		const std::string_view koi8_r_text = "\xF0\xD2\xC9\xD7\xC5\xD4, world";
+		const std::string_view cp1251_text = "\xCF\xF0\xE8\xE2\xE5\xF2, world";
+		auto from_state = ztd::text::make_decode_state(koi8_r);
+		auto to_state   = ztd::text::make_encode_state(cp1251);
+		char storage[64] {};
+		auto preflight_result = ztd::text::transcode_into_preflight(koi8_r_text, koi8_r,
+			ztd::text::span<char>(storage, 3), cp1251, ztd::text::pass_handler {}, ztd::text::pass_handler {},
+			from_state, to_state);
+		REQUIRE(preflight_result.error_code == ztd::text::encoding_error::insufficient_output_space);
+		REQUIRE(preflight_result.required_size == decltype(preflight_result)::unknown_size);
+		const std::size_t written = static_cast<std::size_t>(preflight_result.output.data() - storage);
+		// the rest was not counted, so the input and states can still be used to finish the job
+		auto rest_result = ztd::text::transcode_into(preflight_result.input, koi8_r,
+			ztd::text::span<char>(storage + written, sizeof(storage) - written), cp1251,
+			ztd::text::pass_handler {}, ztd::text::pass_handler {}, from_state, to_state);
+		REQUIRE(rest_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(std::string_view(storage, static_cast<std::size_t>(rest_result.output.data() - storage))
+			== cp1251_text);
+	}
+	SECTION("characters held back for composition") {
+		ztd::text::iconv_encoding cp1258("CP1258");
+		const std::string_view cp1258_text = "ABC";
+		auto decode_result = ztd::text::decode_to<std::u32string>(cp1258_text, cp1258, ztd::text::pass_handler {});
+		REQUIRE(decode_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(decode_result.output == U"ABC");
+		check_same(decode_one_at_a_time(cp1258, cp1258_text, ztd::text::pass_handler {}), decode_result);
+		std::list<char> cp1258_list(cp1258_text.cbegin(), cp1258_text.cend());
+		auto list_result = ztd::text::decode_to<std::u32string>(cp1258_list, cp1258, ztd::text::pass_handler {});
+		REQUIRE(list_result.output == U"ABC");
+		auto count_result = ztd::text::count_code_points(cp1258_text, cp1258, ztd::text::pass_handler {});
+		REQUIRE(count_result.count == 3);
+		auto utf8_result = ztd::text::transcode_to<std::u8string>(
+			cp1258_text, cp1258, ztd::text::utf8 {}, ztd::text::pass_handler {}, ztd::text::pass_handler {});
+		REQUIRE(utf8_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(utf8_result.output == u8"ABC");
+		ztd::text::iconv_encoding utf8("UTF-8");
+		auto iconv_utf8_result = ztd::text::transcode_to<std::string>(
+			cp1258_text, cp1258, utf8, ztd::text::pass_handler {}, ztd::text::pass_handler {});
+		REQUIRE(iconv_utf8_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(iconv_utf8_result.output == "ABC");
+		// what is held back still combines with the mark after it
+		auto composed_result = ztd::text::decode_to<std::u32string>(
+			std::string_view("A\xEC"), cp1258, ztd::text::pass_handler {});
+		REQUIRE(composed_result.output == U"\u00C1");
+
+		ztd::text::iconv_encoding cp1255("CP1255");
+		const std::string_view cp1255_text = "\xE0\xE1\xE2";
+		auto hebrew_result = ztd::text::decode_to<std::u32string>(cp1255_text, cp1255, ztd::text::pass_handler {});
+		REQUIRE(hebrew_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(hebrew_result.output == U"\u05D0\u05D1\u05D2");
+		check_same(decode_one_at_a_time(cp1255, cp1255_text, ztd::text::pass_handler {}), hebrew_result);
+	}
+	SECTION("several code points from one character") {
+		ztd::text::iconv_encoding big5_hkscs("BIG5-HKSCS");
+		const std::string_view big5_hkscs_text = "\x88\x62";
+		auto state = ztd::text::make_decode_state(big5_hkscs);
+		char32_t storage[ztd::text::iconv_encoding::max_code_points] {};
+		// it decodes to two code points: with room for only one, nothing is written and nothing is read
+		auto short_result = big5_hkscs.decode_one(big5_hkscs_text, ztd::text::span<char32_t>(storage, 1),
+			ztd::text::pass_handler {}, state);
+		REQUIRE(short_result.error_code == ztd::text::encoding_error::insufficient_output_space);
+		REQUIRE(short_result.input.size() == big5_hkscs_text.size());
+		REQUIRE(short_result.output.data() == storage);
+		auto rest_result = big5_hkscs.decode_one(
+			short_result.input, ztd::text::span<char32_t>(storage), ztd::text::pass_handler {}, state);
+		REQUIRE(rest_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(rest_result.input.empty());
+		REQUIRE(std::u32string_view(storage, static_cast<std::size_t>(rest_result.output.data() - storage))
+			== U"\u00CA\u0304");
+		auto utf8_result = ztd::text::transcode_to<std::u8string>(big5_hkscs_text, big5_hkscs, ztd::text::utf8 {},
+			ztd::text::pass_handler {}, ztd::text::pass_handler {});
+		REQUIRE(utf8_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(utf8_result.output == u8"\u00CA\u0304");
+	}
+	SECTION("bad character set name") {
+		std::error_code error;
+		ztd::text::iconv_encoding encoding("NOT-A-REAL-CHARSET-NOPE", error);
+		REQUIRE(static_cast<bool>(error));
+		REQUIRE_THROWS_AS(ztd::text::iconv_encoding("NOT-A-REAL-CHARSET-NOPE"), std::system_error);
+	}
+}
+#endif
@@ -0,0 +1,122 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <ztd/text/locale_execution.hpp>
+#include <ztd/text/decode.hpp>
+#include <ztd/text/encode.hpp>
+#include <ztd/text/execution.hpp>
+#include <ztd/text/utf8.hpp>
+
+#include <ztd/text/tests/basic_unicode_strings.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <clocale>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_LOCALE_T_I_)
+TEST_CASE("text/locale_execution", "locale_execution converts with its own locale, not the global one") {
+	const std::string_view u8_input(
+		reinterpret_cast<const char*>(ztd::text::tests::u8_unicode_sequence_truth_native_endian.data()),
+		ztd::text::tests::u8_unicode_sequence_truth_native_endian.size());
+	const std::u32string_view u32_input = ztd::text::tests::u32_unicode_sequence_truth_native_endian;
+	std::string mixed_input;
+	for (int i = 0; i < 32; ++i) {
+		mixed_input.append(u8_input);
+		mixed_input.append("plain ascii text");
+	}
+	mixed_input.insert(mixed_input.size() / 2, "\xFF");
+
+	SECTION("utf-8 locale under the C locale") {
+		const std::string previous_locale = std::setlocale(LC_ALL, nullptr);
+		std::setlocale(LC_ALL, "C");
+		ztd::text::locale_execution encoding("en_US.utf8");
+		REQUIRE(encoding.contains_unicode_encoding());
+
+		auto decode_result = ztd::text::decode_to<std::u32string>(u8_input, encoding, ztd::text::pass_handler {});
+		REQUIRE(decode_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(decode_result.output == u32_input);
+		auto encode_result = ztd::text::encode_to<std::string>(u32_input, encoding, ztd::text::pass_handler {});
+		REQUIRE(encode_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(encode_result.output == u8_input);
+
+		auto mixed_result
+			= ztd::text::decode_to<std::u32string>(mixed_input, encoding, ztd::text::replacement_handler {});
+		auto expected_result = ztd::text::decode_to<std::u32string>(
+			mixed_input, ztd::text::basic_utf8<char> {}, ztd::text::replacement_handler {});
+		REQUIRE(mixed_result.output == expected_result.output);
+		std::setlocale(LC_ALL, previous_locale.c_str());
+	}
+	SECTION("C locale under the current locale") {
+		ztd::text::locale_execution encoding("C");
+		REQUIRE_FALSE(encoding.contains_unicode_encoding());
+		const std::string previous_locale = std::setlocale(LC_ALL, nullptr);
+		std::setlocale(LC_ALL, "C");
+		ztd::text::refresh_execution_encoding();
+		auto expected_decode = ztd::text::decode_to<std::u32string>(
+			mixed_input, ztd::text::execution {}, ztd::text::replacement_handler {});
+		auto expected_encode = ztd::text::encode_to<std::string>(
+			u32_input, ztd::text::execution {}, ztd::text::replacement_handler {});
+		std::setlocale(LC_ALL, previous_locale.c_str());
+		ztd::text::refresh_execution_encoding();
+
+		auto decode_result
+			= ztd::text::decode_to<std::u32string>(mixed_input, encoding, ztd::text::replacement_handler {});
+		REQUIRE(decode_result.error_code == expected_decode.error_code);
+		REQUIRE(decode_result.output == expected_decode.output);
+		auto encode_result
+			= ztd::text::encode_to<std::string>(u32_input, encoding, ztd::text::replacement_handler {});
+		REQUIRE(encode_result.error_code == expected_encode.error_code);
+		REQUIRE(encode_result.output == expected_encode.output);
+		REQUIRE(std::string_view(std::setlocale(LC_ALL, nullptr)) == previous_locale);
+	}
+	SECTION("copies and moves") {
+		ztd::text::locale_execution encoding("en_US.utf8");
+		ztd::text::locale_execution copy = encoding;
+		REQUIRE(copy.native_handle() != encoding.native_handle());
+		ztd::text::locale_execution moved = std::move(copy);
+		copy                              = moved;
+		REQUIRE(moved.contains_unicode_encoding());
+		REQUIRE(copy.contains_unicode_encoding());
+		auto result = ztd::text::decode_to<std::u32string>(u8_input, moved, ztd::text::pass_handler {});
+		REQUIRE(result.output == u32_input);
+		ztd::text::locale_execution adopted(moved.native_handle());
+		REQUIRE(adopted.contains_unicode_encoding());
+	}
+	SECTION("bad locale name") {
+		std::error_code error;
+		ztd::text::locale_execution encoding("not-a-real-locale.nope", error);
+		REQUIRE(static_cast<bool>(error));
+		REQUIRE_THROWS_AS(ztd::text::locale_execution("not-a-real-locale.nope"), std::system_error);
+	}
+}
+#endif
@@ -0,0 +1,207 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#include <ztd/text/parallel.hpp>
+
+#if ZTD_TEXT_IS_ON(ZTD_TEXT_STD_LIBRARY_EXECUTION_I_)
+
+#include <ztd/text/encoding.hpp>
+#include <ztd/text/count_code_points.hpp>
+#include <ztd/text/transcode.hpp>
+#include <ztd/text/validate_code_units.hpp>
+
+#include <ztd/text/tests/basic_unicode_strings.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <execution>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct throw_offset_handler {
+	// the decode errors are the only ones thrown for, so the input is always code units
+	const char8_t* first;
+
+	template <typename Encoding, typename Result, typename Progress>
+	Result operator()(const Encoding&, Result result, const Progress&) const {
+		throw static_cast<std::size_t>(std::to_address(result.input.begin()) - first);
+	}
+};
+
+template <typename Function>
+std::size_t thrown_offset(Function&& function) {
+	try {
+		function();
+	}
+	catch (std::size_t offset) {
+		return offset;
+	}
+	return static_cast<std::size_t>(-1);
+}
+
+template <typename ErrorHandler>
+void parallel_check(std::u8string_view input) {
+	auto parallel_result = ztd::text::transcode_to_parallel<std::u16string>(std::execution::par, input,
+	     ztd::text::utf8 {}, ztd::text::utf16 {}, ErrorHandler {}, ErrorHandler {});
+	auto result = ztd::text::transcode_to<std::u16string>(
+	     input, ztd::text::utf8 {}, ztd::text::utf16 {}, ErrorHandler {}, ErrorHandler {});
+	REQUIRE(parallel_result.error_code == result.error_code);
+	REQUIRE(parallel_result.handled_error == result.handled_error);
+	REQUIRE(parallel_result.input.size() == result.input.size());
+	REQUIRE(parallel_result.output == result.output);
+
+	auto parallel_list_result = ztd::text::transcode_to_parallel<std::vector<char32_t>>(std::execution::par,
+	     std::u16string_view(result.output), ztd::text::utf16 {}, ztd::text::utf32 {}, ErrorHandler {},
+	     ErrorHandler {});
+	auto list_result = ztd::text::transcode_to<std::vector<char32_t>>(std::u16string_view(result.output),
+	     ztd::text::utf16 {}, ztd::text::utf32 {}, ErrorHandler {}, ErrorHandler {});
+	REQUIRE(parallel_list_result.error_code == list_result.error_code);
+	REQUIRE(parallel_list_result.output == list_result.output);
+
+	auto parallel_count_result
+	     = ztd::text::count_code_points_parallel(std::execution::par, input, ztd::text::utf8 {}, ErrorHandler {});
+	auto count_result = ztd::text::count_code_points(input, ztd::text::utf8 {}, ErrorHandler {});
+	REQUIRE(parallel_count_result.error_code == count_result.error_code);
+	REQUIRE(parallel_count_result.handled_error == count_result.handled_error);
+	REQUIRE(parallel_count_result.input.size() == count_result.input.size());
+	REQUIRE(parallel_count_result.count == count_result.count);
+
+	auto parallel_validate_result
+	     = ztd::text::validate_code_units_parallel(std::execution::par, input, ztd::text::utf8 {});
+	auto validate_result = ztd::text::validate_code_units(input, ztd::text::utf8 {});
+	REQUIRE(parallel_validate_result.valid == validate_result.valid);
+	REQUIRE(parallel_validate_result.input.size() == validate_result.input.size());
+}
+
+TEST_CASE("text/parallel", "transcoding, counting and validating in chunks gives the same results as all at once") {
+	// large enough to be split into several chunks, with multi-byte sequences falling across the split points
+	std::u8string text;
+	while (text.size() < (static_cast<std::size_t>(1) << 20)) {
+		text += ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+	}
+	parallel_check<ztd::text::replacement_handler>(text);
+	parallel_check<ztd::text::pass_handler>(text);
+
+	// errors in several chunks: the first one is the one reported
+	std::u8string error_text = text;
+	const std::size_t error_positions[] = { 600000, 300001, 900002 };
+	for (std::size_t error_position : error_positions) {
+		error_text[error_position] = static_cast<char8_t>(0xFF);
+		parallel_check<ztd::text::replacement_handler>(error_text);
+		parallel_check<ztd::text::pass_handler>(error_text);
+	}
+	auto result = ztd::text::validate_code_units_parallel(std::execution::par, std::u8string_view(error_text),
+	     ztd::text::utf8 {});
+	REQUIRE_FALSE(result.valid);
+	REQUIRE(result.input.size() == error_text.size() - 300001);
+
+	// too small to be split
+	parallel_check<ztd::text::pass_handler>(ztd::text::tests::u8_unicode_sequence_truth_native_endian);
+}
+
+template <typename CodeUnit, typename Encoding>
+void parallel_straddle_check(std::basic_string_view<CodeUnit> input, Encoding encoding) {
+	auto parallel_result = ztd::text::transcode_to_parallel<std::u32string>(std::execution::par, input, encoding,
+	     ztd::text::utf32 {}, ztd::text::replacement_handler {}, ztd::text::replacement_handler {});
+	auto result = ztd::text::transcode_to<std::u32string>(
+	     input, encoding, ztd::text::utf32 {}, ztd::text::replacement_handler {}, ztd::text::replacement_handler {});
+	REQUIRE(parallel_result.error_code == result.error_code);
+	REQUIRE(parallel_result.handled_error == result.handled_error);
+	REQUIRE(parallel_result.output == result.output);
+
+	auto parallel_count_result = ztd::text::count_code_points_parallel(
+	     std::execution::par, input, encoding, ztd::text::replacement_handler {});
+	auto count_result = ztd::text::count_code_points(input, encoding, ztd::text::replacement_handler {});
+	REQUIRE(parallel_count_result.count == count_result.count);
+
+	auto parallel_pass_result = ztd::text::count_code_points_parallel(
+	     std::execution::par, input, encoding, ztd::text::pass_handler {});
+	auto pass_result = ztd::text::count_code_points(input, encoding, ztd::text::pass_handler {});
+	REQUIRE(parallel_pass_result.error_code == pass_result.error_code);
+	REQUIRE(parallel_pass_result.input.size() == pass_result.input.size());
+	REQUIRE(parallel_pass_result.count == pass_result.count);
+}
+
+TEST_CASE("text/parallel straddling errors",
+     "an ill-formed sequence that swallows the code unit after it is not split at a chunk boundary") {
+	// two chunks of this size are made no matter how many threads there are, so the one boundary is right in the
+	// middle
+	constexpr std::size_t size = static_cast<std::size_t>(1) << 17;
+	constexpr std::size_t half = size / 2;
+	SECTION("utf8") {
+		for (std::size_t offset = 1; offset <= 4; ++offset) {
+			// a truncated 3-byte sequence, followed by an 'A' that it swallows
+			std::u8string text(size, u8'A');
+			text[half - offset] = static_cast<char8_t>(0xE2);
+			parallel_straddle_check(std::u8string_view(text), ztd::text::utf8 {});
+			text[half - offset + 1] = static_cast<char8_t>(0x82);
+			parallel_straddle_check(std::u8string_view(text), ztd::text::utf8 {});
+		}
+	}
+	SECTION("utf16") {
+		for (std::size_t offset = 1; offset <= 2; ++offset) {
+			// a lead surrogate, followed by an 'A' that it swallows
+			std::u16string text(size, u'A');
+			text[half - offset] = static_cast<char16_t>(0xD800);
+			parallel_straddle_check(std::u16string_view(text), ztd::text::utf16 {});
+		}
+	}
+}
+
+TEST_CASE("text/parallel exceptions",
+     "an exception thrown while working on a chunk is rethrown, from the same place as all at once") {
+	std::u8string text;
+	while (text.size() < (static_cast<std::size_t>(1) << 20)) {
+		text += ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+	}
+	const std::size_t error_positions[] = { 900002, 600000, 300001 };
+	for (std::size_t error_position : error_positions) {
+		text[error_position] = static_cast<char8_t>(0xFF);
+		const std::u8string_view input = text;
+		const throw_offset_handler handler { text.data() };
+		const std::size_t expected_offset = thrown_offset([&] {
+			ztd::text::transcode_to<std::u16string>(
+			     input, ztd::text::utf8 {}, ztd::text::utf16 {}, handler, ztd::text::pass_handler {});
+		});
+		REQUIRE(expected_offset != static_cast<std::size_t>(-1));
+		REQUIRE(thrown_offset([&] {
+			ztd::text::transcode_to_parallel<std::u16string>(
+			     std::execution::par, input, ztd::text::utf8 {}, ztd::text::utf16 {}, handler, ztd::text::pass_handler {});
+		}) == expected_offset);
+		REQUIRE(thrown_offset([&] {
+			ztd::text::count_code_points_parallel(std::execution::par, input, ztd::text::utf8 {}, handler);
+		}) == expected_offset);
+	}
+}
+
+#endif
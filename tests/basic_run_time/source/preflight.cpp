@@ -0,0 +1,147 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <ztd/text/transcode.hpp>
+#include <ztd/text/decode.hpp>
+#include <ztd/text/encode.hpp>
+#include <ztd/text/encoding.hpp>
+
+#include <ztd/text/tests/basic_unicode_strings.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+template <typename CodeUnit>
+ztd::text::subrange<CodeUnit*> output_view(std::vector<CodeUnit>& buffer) {
+	return ztd::text::subrange<CodeUnit*>(buffer.data(), buffer.data() + buffer.size());
+}
+
+template <typename Expected, typename Result, typename Buffer>
+void check_preflight_result(
+     const Expected& expected, const Result& result, const Buffer& buffer, std::size_t input_size) {
+	REQUIRE(result.required_size == expected.size());
+	REQUIRE_FALSE(result.handled_error);
+	const std::size_t written = buffer.size() - result.output.size();
+	REQUIRE(std::equal(buffer.data(), buffer.data() + written, expected.data()));
+	if (buffer.size() >= expected.size()) {
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(result.input.empty());
+		REQUIRE(written == expected.size());
+	}
+	else {
+		REQUIRE(result.error_code == ztd::text::encoding_error::insufficient_output_space);
+		REQUIRE(written < expected.size());
+		REQUIRE(result.input.size() <= input_size);
+		if (buffer.empty()) {
+			REQUIRE(result.input.size() == input_size);
+		}
+	}
+}
+
+TEST_CASE("text/preflight", "preflighting conversions report the whole size, even when the output is too small") {
+	const std::size_t output_sizes[] = { 0, 1, 7, 64, 4096 };
+
+	SECTION("transcode") {
+		const std::u8string_view input = ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+		const std::u16string_view expected = ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+		for (std::size_t output_size : output_sizes) {
+			std::vector<char16_t> buffer(output_size);
+			auto result = ztd::text::transcode_into_preflight(input, ztd::text::utf8 {},
+			     output_view(buffer), ztd::text::utf16 {}, ztd::text::pass_handler {},
+			     ztd::text::pass_handler {});
+			check_preflight_result(expected, result, buffer, input.size());
+		}
+		std::vector<char16_t> exact_buffer(expected.size());
+		auto exact_result = ztd::text::transcode_into_preflight(
+		     input, ztd::text::utf8 {}, output_view(exact_buffer), ztd::text::utf16 {});
+		check_preflight_result(expected, exact_result, exact_buffer, input.size());
+	}
+	SECTION("decode") {
+		const std::u8string_view input = ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+		const std::u32string_view expected = ztd::text::tests::u32_unicode_sequence_truth_native_endian;
+		for (std::size_t output_size : output_sizes) {
+			std::vector<char32_t> buffer(output_size);
+			auto result = ztd::text::decode_into_preflight(
+			     input, ztd::text::utf8 {}, output_view(buffer), ztd::text::pass_handler {});
+			check_preflight_result(expected, result, buffer, input.size());
+		}
+	}
+	SECTION("encode") {
+		const std::u32string_view input = ztd::text::tests::u32_unicode_sequence_truth_native_endian;
+		const std::u8string_view expected = ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+		for (std::size_t output_size : output_sizes) {
+			std::vector<char8_t> buffer(output_size);
+			auto result = ztd::text::encode_into_preflight(
+			     input, ztd::text::utf8 {}, output_view(buffer), ztd::text::pass_handler {});
+			check_preflight_result(expected, result, buffer, input.size());
+		}
+	}
+	SECTION("replacements are counted") {
+		std::u8string input(ztd::text::tests::u8_unicode_sequence_truth_native_endian);
+		input.insert(input.begin() + input.size() / 2, static_cast<char8_t>(0xFF));
+		auto expected = ztd::text::transcode_to<std::u16string>(std::u8string_view(input), ztd::text::utf8 {},
+		     ztd::text::utf16 {}, ztd::text::replacement_handler {}, ztd::text::replacement_handler {});
+		REQUIRE(expected.handled_error);
+		std::vector<char16_t> buffer(expected.output.size() / 4);
+		auto result = ztd::text::transcode_into_preflight(std::u8string_view(input), ztd::text::utf8 {},
+		     output_view(buffer), ztd::text::utf16 {}, ztd::text::replacement_handler {},
+		     ztd::text::replacement_handler {});
+		REQUIRE(result.error_code == ztd::text::encoding_error::insufficient_output_space);
+		REQUIRE(result.required_size == expected.output.size());
+	}
+	SECTION("span output") {
+		const std::u8string_view input = ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+		const std::u16string_view expected = ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+		for (std::size_t output_size : output_sizes) {
+			std::vector<char16_t> buffer(output_size);
+			auto result = ztd::text::transcode_into_preflight(input, ztd::text::utf8 {},
+			     ztd::text::span<char16_t>(buffer.data(), buffer.size()), ztd::text::utf16 {},
+			     ztd::text::pass_handler {}, ztd::text::pass_handler {});
+			check_preflight_result(expected, result, buffer, input.size());
+		}
+	}
+	SECTION("assume_valid") {
+		// the output checks stay on, even when the error handlers say the input is valid
+		const std::u32string input(10, U'\x4E00');
+		std::vector<char8_t> buffer(8, static_cast<char8_t>('*'));
+		auto result = ztd::text::transcode_into_preflight(std::u32string_view(input), ztd::text::utf32 {},
+		     ztd::text::subrange<char8_t*>(buffer.data(), buffer.data() + 5), ztd::text::utf8 {},
+		     ztd::text::assume_valid_handler {}, ztd::text::assume_valid_handler {});
+		REQUIRE(result.error_code == ztd::text::encoding_error::insufficient_output_space);
+		REQUIRE(result.required_size == 30);
+		REQUIRE(result.input.size() == 9);
+		REQUIRE(result.output.size() == 2);
+		REQUIRE(std::all_of(buffer.begin() + 5, buffer.end(), [](char8_t c) { return c == '*'; }));
+	}
+}
@@ -0,0 +1,45 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ============================================================================>
+
+#include <ztd/text/simd_level.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("text/simd_level/basic", "the vector instructions in use are reported and stay the same") {
+	const ztd::text::simd_level detected = ztd::text::detected_simd_level();
+	const ztd::text::simd_level active   = ztd::text::active_simd_level();
+	REQUIRE(ztd::text::detected_simd_level() == detected);
+	REQUIRE(ztd::text::active_simd_level() == active);
+	REQUIRE(active <= ztd::text::simd_level::avx2);
+	REQUIRE_FALSE(ztd::text::to_name(active).empty());
+	REQUIRE(ztd::text::to_name(ztd::text::simd_level::scalar) == "scalar");
+	REQUIRE(ztd::text::to_name(ztd::text::simd_level::sse4_2) == "sse4_2");
+	REQUIRE(ztd::text::to_name(ztd::text::simd_level::avx512) == "avx512");
+}
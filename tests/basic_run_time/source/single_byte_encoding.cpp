@@ -0,0 +1,277 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <ztd/text/single_byte_encoding.hpp>
+#include <ztd/text/decode.hpp>
+#include <ztd/text/encode.hpp>
+#include <ztd/text/transcode.hpp>
+#include <ztd/text/detail/encoding_name.hpp>
+
+#include <ztd/text/tests/basic_unicode_strings.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+inline namespace ztd_text_tests_basic_run_time_single_byte_encoding {
+	template <typename Output>
+	struct one_at_a_time_result {
+		Output output;
+		std::size_t input_left;
+		ztd::text::encoding_error error_code;
+	};
+
+	template <typename Encoding, typename ErrorHandler>
+	auto decode_one_at_a_time(const Encoding& encoding, std::string_view input, ErrorHandler error_handler) {
+		one_at_a_time_result<std::u32string> result { {}, 0, ztd::text::encoding_error::ok };
+		typename Encoding::state state {};
+		while (!input.empty()) {
+			char32_t storage[Encoding::max_code_points] {};
+			ztd::text::span<char32_t> buffer(storage);
+			auto one = encoding.decode_one(input, buffer, error_handler, state);
+			result.output.append(storage, one.output.data());
+			input = std::string_view(one.input.data(), one.input.size());
+			if (one.error_code != ztd::text::encoding_error::ok) {
+				result.error_code = one.error_code;
+				break;
+			}
+		}
+		result.input_left = input.size();
+		return result;
+	}
+
+	template <typename Encoding, typename ErrorHandler>
+	auto encode_one_at_a_time(const Encoding& encoding, std::u32string_view input, ErrorHandler error_handler) {
+		one_at_a_time_result<std::string> result { {}, 0, ztd::text::encoding_error::ok };
+		typename Encoding::state state {};
+		while (!input.empty()) {
+			char storage[Encoding::max_code_units] {};
+			ztd::text::span<char> buffer(storage);
+			auto one = encoding.encode_one(input, buffer, error_handler, state);
+			result.output.append(storage, one.output.data());
+			input = std::u32string_view(one.input.data(), one.input.size());
+			if (one.error_code != ztd::text::encoding_error::ok) {
+				result.error_code = one.error_code;
+				break;
+			}
+		}
+		result.input_left = input.size();
+		return result;
+	}
+
+	template <typename Expected, typename Result>
+	void check_same(const Expected& expected, const Result& result) {
+		REQUIRE(result.error_code == expected.error_code);
+		REQUIRE(result.input.size() == expected.input_left);
+		REQUIRE(result.output == expected.output);
+	}
+
+	template <typename Encoding>
+	void check_same_as_one_at_a_time(const Encoding& encoding) {
+		std::string bytes;
+		for (int i = 0; i < 64; ++i) {
+			bytes.append("plain ascii text, long enough for a few vectors of it, and a null: ");
+			bytes.push_back('\0');
+			for (int byte = 0x80 - i; byte < 0x100; byte += 3) {
+				bytes.push_back(static_cast<char>(byte));
+			}
+		}
+		const std::string_view input(bytes);
+		for (std::size_t offset : { std::size_t(0), std::size_t(1), std::size_t(67) }) {
+			const std::string_view shifted = input.substr(offset);
+			check_same(decode_one_at_a_time(encoding, shifted, ztd::text::replacement_handler {}),
+				ztd::text::decode_to<std::u32string>(shifted, encoding, ztd::text::replacement_handler {}));
+			check_same(decode_one_at_a_time(encoding, shifted, ztd::text::pass_handler {}),
+				ztd::text::decode_to<std::u32string>(shifted, encoding, ztd::text::pass_handler {}));
+		}
+
+		std::u32string code_points = decode_one_at_a_time(encoding, input, ztd::text::replacement_handler {}).output;
+		code_points.append(ztd::text::tests::u32_unicode_sequence_truth_native_endian);
+		code_points.append(U"more plain ascii text, so that there is a vector or two of it at the end");
+		const std::u32string_view code_points_view(code_points);
+		check_same(encode_one_at_a_time(encoding, code_points_view, ztd::text::replacement_handler {}),
+			ztd::text::encode_to<std::string>(code_points_view, encoding, ztd::text::replacement_handler {}));
+		check_same(encode_one_at_a_time(encoding, code_points_view, ztd::text::pass_handler {}),
+			ztd::text::encode_to<std::string>(code_points_view, encoding, ztd::text::pass_handler {}));
+
+		// a std::list is not contiguous, so it always goes through the plain transcoding loop
+		const ztd::text::basic_utf8<char> utf8 {};
+		std::list<char> list_input(input.cbegin(), input.cend());
+		auto replaced_result
+			= ztd::text::transcode_to<std::string>(input, encoding, utf8, ztd::text::replacement_handler {});
+		auto replaced_expected
+			= ztd::text::transcode_to<std::string>(list_input, encoding, utf8, ztd::text::replacement_handler {});
+		REQUIRE(replaced_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(replaced_result.output == replaced_expected.output);
+		auto passed_result = ztd::text::transcode_to<std::string>(input, encoding, utf8, ztd::text::pass_handler {});
+		auto passed_expected
+			= ztd::text::transcode_to<std::string>(list_input, encoding, utf8, ztd::text::pass_handler {});
+		REQUIRE(passed_result.error_code == passed_expected.error_code);
+		REQUIRE(passed_result.input.size()
+			== static_cast<std::size_t>(std::distance(passed_expected.input.begin(), passed_expected.input.end())));
+		REQUIRE(passed_result.output == passed_expected.output);
+	}
+} // namespace ztd_text_tests_basic_run_time_single_byte_encoding
+
+TEST_CASE("text/single_byte_encoding", "the table-driven single-byte code pages decode, encode and transcode") {
+	static_assert(ztd::text::iso_8859_1::is_decode_injective::value);
+	static_assert(ztd::text::koi8_r::is_decode_injective::value);
+	static_assert(!ztd::text::windows_1252::is_decode_injective::value);
+	static_assert(!ztd::text::windows_1252::is_encode_injective::value);
+
+	SECTION("known text") {
+		const std::string_view windows_1252_text = "caf\xE9 \x80\x35, \x93quoted\x94";
+		const std::u32string_view u32_text       = U"café €5, “quoted”";
+		auto decode_result                       = ztd::text::decode_to<std::u32string>(
+               windows_1252_text, ztd::text::windows_1252 {}, ztd::text::pass_handler {});
+		REQUIRE(decode_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(decode_result.output == u32_text);
+		auto encode_result
+			= ztd::text::encode_to<std::string>(u32_text, ztd::text::windows_1252 {}, ztd::text::pass_handler {});
+		REQUIRE(encode_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(encode_result.output == windows_1252_text);
+
+		const std::string_view koi8_r_text = "\xF0\xD2\xC9\xD7\xC5\xD4, world";
+		auto koi8_r_result
+			= ztd::text::decode_to<std::u32string>(koi8_r_text, ztd::text::koi8_r {}, ztd::text::pass_handler {});
+		REQUIRE(koi8_r_result.output == U"Привет, world");
+		auto utf8_result = ztd::text::transcode_to<std::string>(
+			koi8_r_text, ztd::text::koi8_r {}, ztd::text::basic_utf8<char> {}, ztd::text::pass_handler {});
+		REQUIRE(utf8_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(utf8_result.output == "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82, world");
+
+		auto windows_1251_result = ztd::text::transcode_to<std::string>(
+			koi8_r_text, ztd::text::koi8_r {}, ztd::text::windows_1251 {}, ztd::text::pass_handler {});
+		REQUIRE(windows_1251_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(windows_1251_result.output == "\xCF\xF0\xE8\xE2\xE5\xF2, world");
+
+		auto box_result = ztd::text::decode_to<std::u32string>(
+			std::string_view("\xC9\xCD\xBB\xB0"), ztd::text::cp437 {}, ztd::text::pass_handler {});
+		REQUIRE(box_result.output == U"╔═╗░");
+	}
+	SECTION("undefined bytes and unencodable code points") {
+		const std::string_view undefined = "a\x81" "b";
+		auto pass_result = ztd::text::decode_to<std::u32string>(
+			undefined, ztd::text::windows_1252 {}, ztd::text::pass_handler {});
+		REQUIRE(pass_result.error_code == ztd::text::encoding_error::invalid_sequence);
+		REQUIRE(pass_result.output == U"a");
+		REQUIRE(pass_result.input.size() == 1);
+		auto replaced_result = ztd::text::decode_to<std::u32string>(
+			undefined, ztd::text::windows_1252 {}, ztd::text::replacement_handler {});
+		REQUIRE(replaced_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(replaced_result.output == U"a�b");
+
+		const std::u32string_view unencodable = U"€✓Ж\U0001F600";
+		auto encode_result = ztd::text::encode_to<std::string>(
+			unencodable, ztd::text::windows_1252 {}, ztd::text::replacement_handler {});
+		REQUIRE(encode_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(encode_result.output == "\x80???");
+		auto transcode_result = ztd::text::transcode_to<std::string>(std::string_view("\xF0\xD2\xC9 hi"),
+			ztd::text::koi8_r {}, ztd::text::iso_8859_1 {}, ztd::text::replacement_handler {});
+		REQUIRE(transcode_result.output == "??? hi");
+	}
+	SECTION("same as one at a time") {
+		check_same_as_one_at_a_time(ztd::text::iso_8859_1 {});
+		check_same_as_one_at_a_time(ztd::text::iso_8859_7 {});
+		check_same_as_one_at_a_time(ztd::text::windows_1252 {});
+		check_same_as_one_at_a_time(ztd::text::koi8_r {});
+		check_same_as_one_at_a_time(ztd::text::cp437 {});
+	}
+	SECTION("encoding names") {
+		using ztd::text::__detail::__encoding_id;
+		using ztd::text::__detail::__to_encoding_id;
+		REQUIRE(__to_encoding_id("UTF-8") == __encoding_id::__utf8);
+		REQUIRE(__to_encoding_id("utf8") == __encoding_id::__utf8);
+		REQUIRE(__to_encoding_id("UTF-16LE") == __encoding_id::__utf16le);
+		REQUIRE(__to_encoding_id("UTF-32BE") == __encoding_id::__utf32be);
+		REQUIRE(__to_encoding_id("UTF-7-IMAP") == __encoding_id::__utf7imap);
+		REQUIRE(__to_encoding_id("ISO-8859-1") == __encoding_id::__iso_8859_1);
+		REQUIRE(__to_encoding_id("iso_8859-15") == __encoding_id::__iso_8859_15);
+		REQUIRE(__to_encoding_id("latin1") == __encoding_id::__iso_8859_1);
+		REQUIRE(__to_encoding_id("LATIN10") == __encoding_id::__iso_8859_16);
+		REQUIRE(__to_encoding_id("CP1252") == __encoding_id::__windows_1252);
+		REQUIRE(__to_encoding_id("windows-1251") == __encoding_id::__windows_1251);
+		REQUIRE(__to_encoding_id("KOI8-U") == __encoding_id::__koi8_u);
+		REQUIRE(__to_encoding_id("IBM437") == __encoding_id::__cp437);
+		REQUIRE(__to_encoding_id("ISO-8859-11") == __encoding_id::__unknown);
+		REQUIRE(__to_encoding_id("UTF") == __encoding_id::__unknown);
+		static_assert(std::is_same_v<decltype(ztd::text::__detail::__select_encoding<char,
+		                                   __encoding_id::__windows_1252>()),
+			ztd::text::windows_1252>);
+		static_assert(std::is_same_v<decltype(ztd::text::__detail::__select_encoding<char,
+		                                   __encoding_id::__cp866>()),
+			ztd::text::cp866>);
+	}
+	SECTION("whole code units in either byte order") {
+		using ztd::text::__detail::__encoding_id;
+		using ztd::text::__detail::__reverse_bytes;
+		using ztd::text::__detail::__select_encoding;
+		constexpr bool is_little           = ztd::text::endian::native == ztd::text::endian::little;
+		constexpr __encoding_id own_utf16  = is_little ? __encoding_id::__utf16le : __encoding_id::__utf16be;
+		constexpr __encoding_id own_utf32  = is_little ? __encoding_id::__utf32le : __encoding_id::__utf32be;
+		constexpr __encoding_id swap_utf16 = is_little ? __encoding_id::__utf16be : __encoding_id::__utf16le;
+		constexpr __encoding_id swap_utf32 = is_little ? __encoding_id::__utf32be : __encoding_id::__utf32le;
+		static_assert(
+		     std::is_same_v<decltype(__select_encoding<char16_t, own_utf16>()), ztd::text::basic_utf16<char16_t>>);
+		static_assert(
+		     std::is_same_v<decltype(__select_encoding<char32_t, own_utf32>()), ztd::text::basic_utf32<char32_t>>);
+		static_assert(
+		     !std::is_same_v<decltype(__select_encoding<char16_t, swap_utf16>()), ztd::text::basic_utf16<char16_t>>);
+		static_assert(
+		     !std::is_same_v<decltype(__select_encoding<char32_t, swap_utf32>()), ztd::text::basic_utf32<char32_t>>);
+
+		const std::u32string_view code_points = U"a\U0001F600";
+		const char16_t swapped_u16[]          = { __reverse_bytes(u'a'), __reverse_bytes(char16_t(0xD83D)),
+			         __reverse_bytes(char16_t(0xDE00)) };
+		const char32_t swapped_u32[]          = { __reverse_bytes(U'a'), __reverse_bytes(U'\U0001F600') };
+		auto decoded16 = ztd::text::decode_to<std::u32string>(std::u16string_view(swapped_u16, 3),
+		     __select_encoding<char16_t, swap_utf16>(), ztd::text::replacement_handler {});
+		REQUIRE(decoded16.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(decoded16.output == code_points);
+		auto decoded32 = ztd::text::decode_to<std::u32string>(std::u32string_view(swapped_u32, 2),
+		     __select_encoding<char32_t, swap_utf32>(), ztd::text::replacement_handler {});
+		REQUIRE(decoded32.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(decoded32.output == code_points);
+
+		char16_t encoded16[3] {};
+		char32_t encoded32[2] {};
+		auto encode16_result = ztd::text::encode_into(code_points, __select_encoding<char16_t, swap_utf16>(),
+		     ztd::text::span<char16_t>(encoded16), ztd::text::replacement_handler {});
+		REQUIRE(encode16_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(std::u16string_view(encoded16, 3) == std::u16string_view(swapped_u16, 3));
+		auto encode32_result = ztd::text::encode_into(code_points, __select_encoding<char32_t, swap_utf32>(),
+		     ztd::text::span<char32_t>(encoded32), ztd::text::replacement_handler {});
+		REQUIRE(encode32_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(std::u32string_view(encoded32, 2) == std::u32string_view(swapped_u32, 2));
+	}
+}
@@ -0,0 +1,181 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <ztd/text/streaming_transcoder.hpp>
+#include <ztd/text/encoding.hpp>
+#include <ztd/text/transcode.hpp>
+
+#include <ztd/text/tests/basic_unicode_strings.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+template <typename FromEncoding, typename ToEncoding, typename ErrorHandler, typename Input>
+auto streaming_transcode(const Input& input, std::size_t chunk_size, std::size_t output_size) {
+	using transcoder   = ztd::text::streaming_transcoder<FromEncoding, ToEncoding, ErrorHandler, ErrorHandler>;
+	using input_type   = typename transcoder::input_type;
+	using output_type  = typename transcoder::output_type;
+	using to_code_unit = typename transcoder::to_code_unit_type;
+	transcoder streamer;
+	std::basic_string<to_code_unit> output;
+	std::vector<to_code_unit> buffer(output_size);
+	for (std::size_t index = 0; index < input.size(); index += chunk_size) {
+		input_type chunk(input.data() + index, (std::min)(chunk_size, input.size() - index));
+		for (;;) {
+			auto result = streamer.push(chunk, output_type(buffer.data(), buffer.size()));
+			output.append(buffer.data(), buffer.size() - result.output.size());
+			chunk = result.input;
+			if (result.error_code != ztd::text::encoding_error::insufficient_output_space) {
+				REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+				break;
+			}
+		}
+		REQUIRE(chunk.empty());
+	}
+	for (;;) {
+		auto result = streamer.finish(output_type(buffer.data(), buffer.size()));
+		output.append(buffer.data(), buffer.size() - result.output.size());
+		if (result.error_code != ztd::text::encoding_error::insufficient_output_space) {
+			REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+			REQUIRE(result.input.empty());
+			break;
+		}
+	}
+	REQUIRE(streamer.pending_code_units().empty());
+	return output;
+}
+
+TEST_CASE("text/streaming_transcoder", "pushing input in pieces gives the same output as transcoding all at once") {
+	const std::size_t chunk_sizes[]  = { 1, 2, 3, 5, 7, 4096 };
+	const std::size_t output_sizes[] = { 4, 7, 4096 };
+
+	SECTION("utf8 to utf16") {
+		const auto& input    = ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+		const auto& expected = ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+		for (std::size_t chunk_size : chunk_sizes) {
+			for (std::size_t output_size : output_sizes) {
+				auto output = streaming_transcode<ztd::text::utf8, ztd::text::utf16, ztd::text::pass_handler>(
+				     input, chunk_size, output_size);
+				REQUIRE(output == expected);
+			}
+		}
+	}
+	SECTION("utf16 to utf8") {
+		const auto& input    = ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+		const auto& expected = ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+		for (std::size_t chunk_size : chunk_sizes) {
+			for (std::size_t output_size : output_sizes) {
+				auto output = streaming_transcode<ztd::text::utf16, ztd::text::utf8, ztd::text::pass_handler>(
+				     input, chunk_size, output_size);
+				REQUIRE(output == expected);
+			}
+		}
+	}
+	SECTION("errors") {
+		// an invalid byte in the middle and a 4-byte sequence cut off at the very end
+		std::u8string input(ztd::text::tests::u8_unicode_sequence_truth_native_endian);
+		input.insert(input.begin() + input.size() / 2, static_cast<char8_t>(0xFF));
+		input += u8"\U0001F600";
+		input.pop_back();
+		auto expected = ztd::text::transcode_to<std::u16string>(std::u8string_view(input), ztd::text::utf8 {},
+		     ztd::text::utf16 {}, ztd::text::replacement_handler {}, ztd::text::replacement_handler {});
+		REQUIRE(expected.handled_error);
+		for (std::size_t chunk_size : chunk_sizes) {
+			for (std::size_t output_size : output_sizes) {
+				auto output
+				     = streaming_transcode<ztd::text::utf8, ztd::text::utf16, ztd::text::replacement_handler>(
+				          input, chunk_size, output_size);
+				REQUIRE(output == expected.output);
+			}
+		}
+	}
+	SECTION("unfinished") {
+		using transcoder = ztd::text::streaming_transcoder<ztd::text::utf8, ztd::text::utf32,
+		     ztd::text::pass_handler, ztd::text::pass_handler>;
+		const std::u8string_view input = u8"a\U0001F600";
+		char32_t buffer[4] {};
+		transcoder streamer;
+		auto first_result = streamer.push(transcoder::input_type(input.data(), 3), buffer);
+		REQUIRE(first_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE_FALSE(first_result.handled_error);
+		REQUIRE(first_result.input.empty());
+		REQUIRE(first_result.output.size() == 3);
+		REQUIRE(buffer[0] == U'a');
+		REQUIRE(streamer.pending_code_units().size() == 2);
+
+		auto finish_result = streamer.finish(first_result.output);
+		REQUIRE(finish_result.error_code == ztd::text::encoding_error::incomplete_sequence);
+		REQUIRE(finish_result.input.size() == 2);
+		REQUIRE(finish_result.output.size() == 3);
+
+		auto second_result = streamer.push(transcoder::input_type(input.data() + 3, 2), first_result.output);
+		REQUIRE(second_result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(second_result.output.size() == 2);
+		REQUIRE(buffer[1] == U'\U0001F600');
+		REQUIRE(streamer.pending_code_units().empty());
+		REQUIRE(streamer.finish(second_result.output).error_code == ztd::text::encoding_error::ok);
+
+		// running out of room is not an error that was handled
+		char32_t small_buffer[1] {};
+		auto full_result = streamer.push(transcoder::input_type(input.data(), input.size()), small_buffer);
+		REQUIRE(full_result.error_code == ztd::text::encoding_error::insufficient_output_space);
+		REQUIRE_FALSE(full_result.handled_error);
+		REQUIRE(full_result.input.size() == 4);
+		REQUIRE(small_buffer[0] == U'a');
+	}
+	SECTION("assume_valid") {
+		const auto& input    = ztd::text::tests::u32_unicode_sequence_truth_native_endian;
+		const auto& expected = ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+		for (std::size_t chunk_size : chunk_sizes) {
+			for (std::size_t output_size : output_sizes) {
+				auto output = streaming_transcode<ztd::text::utf32, ztd::text::utf8,
+				     ztd::text::assume_valid_handler>(input, chunk_size, output_size);
+				REQUIRE(output == expected);
+			}
+		}
+
+		// a trusted input still stops at the end of the output
+		using transcoder = ztd::text::streaming_transcoder<ztd::text::utf32, ztd::text::utf8,
+		     ztd::text::assume_valid_handler, ztd::text::assume_valid_handler>;
+		const std::u32string cjk_input(10, U'\x4E00');
+		std::vector<char8_t> storage(16, u8'*');
+		transcoder streamer;
+		auto result = streamer.push(transcoder::input_type(cjk_input.data(), cjk_input.size()),
+		     transcoder::output_type(storage.data(), 5));
+		REQUIRE(result.error_code == ztd::text::encoding_error::insufficient_output_space);
+		REQUIRE(result.input.size() == 9);
+		REQUIRE(result.output.size() == 2);
+		REQUIRE(std::all_of(storage.cbegin() + 5, storage.cend(), [](char8_t unit) { return unit == u8'*'; }));
+	}
+}
@@ -28,6 +28,9 @@
 //
 // ============================================================================>
 
+#include <ztd/text/count_code_points.hpp>
+#include <ztd/text/decode.hpp>
+#include <ztd/text/encode.hpp>
 #include <ztd/text/encoding.hpp>
 #include <ztd/text/transcode.hpp>
 
@@ -35,6 +38,11 @@
 
 #include <catch2/catch.hpp>
 
+#include <list>
+#include <string>
+#include <string_view>
+#include <vector>
+
 TEST_CASE("text/transcode/roundtrip", "transcode can roundtrip") {
 	SECTION("execution") {
 		ztd::text::execution encoding {};
@@ -112,3 +120,396 @@ TEST_CASE("text/transcode/roundtrip", "transcode can roundtrip") {
 		REQUIRE(result1 == ztd::text::tests::u32_unicode_sequence_truth_native_endian);
 	}
 }
+
+template <typename FromEncoding, typename ToEncoding, typename FastFromErrorHandler = ztd::text::replacement_handler,
+	typename InputChar>
+void bulk_transcode_check(std::basic_string_view<InputChar> input, std::size_t output_size) {
+	using OutputChar = ztd::text::code_unit_t<ToEncoding>;
+	// the std::list input goes through the generic, one-code-point-at-a-time loop
+	std::list<InputChar> slow_input(input.cbegin(), input.cend());
+	std::vector<OutputChar> fast_storage(output_size + 1, OutputChar(0x2A));
+	std::vector<OutputChar> slow_storage(output_size + 1, OutputChar(0x2A));
+	auto fast_result = ztd::text::transcode_into(input, FromEncoding {},
+	     ztd::text::subrange<OutputChar*>(fast_storage.data(), fast_storage.data() + output_size), ToEncoding {},
+	     FastFromErrorHandler {}, ztd::text::replacement_handler {});
+	auto slow_result = ztd::text::transcode_into(slow_input, FromEncoding {},
+	     ztd::text::subrange<OutputChar*>(slow_storage.data(), slow_storage.data() + output_size), ToEncoding {},
+	     ztd::text::replacement_handler {}, ztd::text::replacement_handler {});
+	REQUIRE(fast_result.error_code == slow_result.error_code);
+	REQUIRE(fast_result.handled_error == slow_result.handled_error);
+	REQUIRE(fast_result.input.size()
+	     == static_cast<std::size_t>(std::distance(slow_result.input.begin(), slow_result.input.end())));
+	REQUIRE(fast_result.output.size() == slow_result.output.size());
+	REQUIRE(fast_storage == slow_storage);
+
+	std::basic_string<OutputChar> fast_output = ztd::text::transcode_to<std::basic_string<OutputChar>>(input,
+	     FromEncoding {}, ToEncoding {}, FastFromErrorHandler {}, ztd::text::replacement_handler {})
+	                                                 .output;
+	std::basic_string<OutputChar> slow_output = ztd::text::transcode_to<std::basic_string<OutputChar>>(slow_input,
+	     FromEncoding {}, ToEncoding {}, ztd::text::replacement_handler {}, ztd::text::replacement_handler {})
+	                                                 .output;
+	REQUIRE(fast_output == slow_output);
+}
+
+TEST_CASE("text/transcode/utf8 utf16 bulk",
+	"transcoding contiguous UTF-8 and UTF-16 into each other gives the same results as the one-at-a-time loop") {
+	std::u8string u8_text;
+	std::u16string u16_text;
+	for (int repeat = 0; repeat < 3; ++repeat) {
+		u8_text += ztd::text::tests::u8_basic_source_character_set;
+		u8_text += ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+		u16_text += ztd::text::tests::u16_basic_source_character_set;
+		u16_text += ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+	}
+	const std::u8string_view u8_bad[] = { u8"\x80", u8"\xE0\x80\xAF", u8"\xED\xA0\x80", u8"\xF0\x9F\x98" };
+	const std::u16string_view u16_bad[] = { u"\xDC00", u"\xD800" u"a", u"\xD800" };
+	const std::size_t positions[] = { 0, 1, 17, 63, 200 };
+	const std::size_t output_sizes[] = { 0, 1, 2, 3, 31, 64, 1000, 4000 };
+	for (std::size_t output_size : output_sizes) {
+		bulk_transcode_check<ztd::text::utf8, ztd::text::utf16>(std::u8string_view(u8_text), output_size);
+		bulk_transcode_check<ztd::text::utf16, ztd::text::utf8>(std::u16string_view(u16_text), output_size);
+		for (std::size_t position : positions) {
+			for (const auto& bad : u8_bad) {
+				std::u8string text = u8_text;
+				text.insert(position, bad);
+				bulk_transcode_check<ztd::text::utf8, ztd::text::utf16>(std::u8string_view(text), output_size);
+			}
+			for (const auto& bad : u16_bad) {
+				std::u16string text = u16_text;
+				text.insert(position, bad);
+				bulk_transcode_check<ztd::text::utf16, ztd::text::utf8>(std::u16string_view(text), output_size);
+			}
+		}
+		std::u16string truncated = u16_text + u"\xD83D";
+		bulk_transcode_check<ztd::text::utf16, ztd::text::utf8>(std::u16string_view(truncated), output_size);
+	}
+	// valid input with an ignorable error handler skips validation altogether, but the output has to fit all of it
+	for (std::size_t output_size : { u16_text.size(), u16_text.size() + 1, u8_text.size() }) {
+		bulk_transcode_check<ztd::text::utf8, ztd::text::utf16, ztd::text::assume_valid_handler>(
+		     std::u8string_view(u8_text), output_size);
+	}
+}
+
+TEST_CASE("text/transcode/utf16 utf8 bulk surrogates",
+	"unpaired surrogates in otherwise bulk-convertible UTF-16 are reported at their exact offset") {
+	// 2-code unit (Cyrillic), 3-code unit (CJK) and mixed text, so every kind of block is hit
+	const std::u16string_view texts[] = { u"\x043F\x0440\x0438\x0432\x0435\x0442 \x043C\x0438\x0440",
+		u"\x4E2D\x6587\x5B57", u"h\x00E9llo \xD83D\xDE00 w\x00F6rld" };
+	const std::u16string_view surrogates[] = { u"\xD800", u"\xDBFF", u"\xDC00", u"\xDFFF" };
+	for (const auto& unit : texts) {
+		std::u16string text;
+		while (text.size() < 80) {
+			text += unit;
+		}
+		for (std::size_t position = 0; position < 24; ++position) {
+			if (position > 0 && text[position - 1] >= 0xD800 && text[position - 1] <= 0xDBFF) {
+				// do not split an existing pair
+				continue;
+			}
+			for (const auto& surrogate : surrogates) {
+				std::u16string input = text;
+				input.insert(position, surrogate);
+				bulk_transcode_check<ztd::text::utf16, ztd::text::utf8>(std::u16string_view(input), 1000);
+				std::vector<char8_t> storage(input.size() * 3);
+				ztd::text::subrange<char8_t*> output(storage.data(), storage.data() + storage.size());
+				auto result = ztd::text::transcode_into(std::u16string_view(input), ztd::text::utf16 {}, output,
+				     ztd::text::utf8 {}, ztd::text::pass_handler {}, ztd::text::pass_handler {});
+				REQUIRE(result.error_code == ztd::text::encoding_error::invalid_sequence);
+				REQUIRE(result.input.size() == input.size() - position);
+			}
+		}
+	}
+}
+
+TEST_CASE("text/transcode/utf16 utf32 bulk",
+	"transcoding contiguous UTF-16 and UTF-32 into each other gives the same results as the one-at-a-time loop") {
+	std::u16string u16_text;
+	std::u32string u32_text;
+	for (int repeat = 0; repeat < 3; ++repeat) {
+		u16_text += ztd::text::tests::u16_basic_source_character_set;
+		u16_text += ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+		u32_text += ztd::text::tests::u32_basic_source_character_set;
+		u32_text += ztd::text::tests::u32_unicode_sequence_truth_native_endian;
+	}
+	const std::u16string_view u16_bad[] = { u"\xDC00", u"\xD800" u"a", u"\xDBFF\xDBFF" };
+	const std::u32string_view u32_bad[]
+	     = { U"\xD800", U"\xDFFF", std::u32string_view(U"\x110000", 1), std::u32string_view(U"\xFFFFFFFF", 1) };
+	const std::size_t positions[] = { 0, 1, 7, 8, 17, 63, 200 };
+	const std::size_t output_sizes[] = { 0, 1, 2, 3, 9, 31, 64, 1000, 4000 };
+	for (std::size_t output_size : output_sizes) {
+		bulk_transcode_check<ztd::text::utf16, ztd::text::utf32>(std::u16string_view(u16_text), output_size);
+		bulk_transcode_check<ztd::text::utf32, ztd::text::utf16>(std::u32string_view(u32_text), output_size);
+		for (std::size_t position : positions) {
+			for (const auto& bad : u16_bad) {
+				std::u16string text = u16_text;
+				text.insert(position, bad);
+				bulk_transcode_check<ztd::text::utf16, ztd::text::utf32>(std::u16string_view(text), output_size);
+			}
+			for (const auto& bad : u32_bad) {
+				std::u32string text = u32_text;
+				text.insert(position, bad);
+				bulk_transcode_check<ztd::text::utf32, ztd::text::utf16>(std::u32string_view(text), output_size);
+			}
+		}
+		std::u16string truncated = u16_text + u"\xD83D";
+		bulk_transcode_check<ztd::text::utf16, ztd::text::utf32>(std::u16string_view(truncated), output_size);
+	}
+}
+
+TEST_CASE("text/transcode/bitwise copy",
+	"transcoding between bitwise-compatible encodings with an ignorable error handler copies the input") {
+	std::string text;
+	std::u16string u16_text;
+	std::u32string u32_text;
+	for (int repeat = 0; repeat < 3; ++repeat) {
+		text += ztd::text::tests::basic_source_character_set;
+		text += ztd::text::tests::unicode_sequence_truth_native_endian;
+		u16_text += ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+		u32_text += ztd::text::tests::u32_unicode_sequence_truth_native_endian;
+	}
+	const std::string ascii_text(ztd::text::tests::basic_source_character_set);
+	const std::u8string u8_text(text.cbegin(), text.cend());
+	// partial outputs are cut at the end of the last whole sequence that fits
+	const std::size_t output_sizes[] = { 0, 1, 2, 3, 31, 64, 1000, 4000 };
+	for (std::size_t output_size : output_sizes) {
+		bulk_transcode_check<ztd::text::compat_utf8, ztd::text::utf8, ztd::text::assume_valid_handler>(
+		     std::string_view(text), output_size);
+		bulk_transcode_check<ztd::text::utf8, ztd::text::compat_utf8, ztd::text::assume_valid_handler>(
+		     std::u8string_view(u8_text), output_size);
+		bulk_transcode_check<ztd::text::ascii, ztd::text::utf8, ztd::text::assume_valid_handler>(
+		     std::string_view(ascii_text), output_size);
+		bulk_transcode_check<ztd::text::utf16, ztd::text::utf16, ztd::text::assume_valid_handler>(
+		     std::u16string_view(u16_text), output_size);
+		bulk_transcode_check<ztd::text::utf32, ztd::text::utf32, ztd::text::assume_valid_handler>(
+		     std::u32string_view(u32_text), output_size);
+	}
+	auto result = ztd::text::transcode_to<std::vector<char8_t>>(text, ztd::text::compat_utf8 {}, ztd::text::utf8 {},
+	     ztd::text::assume_valid_handler {}, ztd::text::assume_valid_handler {});
+	REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+	REQUIRE(std::u8string(result.output.cbegin(), result.output.cend()) == u8_text);
+	REQUIRE(result.output.capacity() == result.output.size());
+	std::u16string u16_copy = ztd::text::transcode<std::u16string>(u16_text, ztd::text::utf16 {}, ztd::text::utf16 {},
+	     ztd::text::assume_valid_handler {}, ztd::text::assume_valid_handler {});
+	REQUIRE(u16_copy == u16_text);
+}
+
+TEST_CASE("text/transcode/exact",
+	"transcode_to_exact gives the same results as transcode_to, in exactly-sized storage") {
+	std::u8string input;
+	for (int repeat = 0; repeat < 3; ++repeat) {
+		input += ztd::text::tests::u8_basic_source_character_set;
+		input += ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+	}
+	SECTION("valid") {
+		auto expected = ztd::text::transcode_to<std::u16string>(input, ztd::text::utf8 {}, ztd::text::utf16 {});
+		auto result
+		     = ztd::text::transcode_to_exact<std::vector<char16_t>>(input, ztd::text::utf8 {}, ztd::text::utf16 {});
+		REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+		REQUIRE(std::u16string(result.output.cbegin(), result.output.cend()) == expected.output);
+		REQUIRE(result.output.capacity() == result.output.size());
+		auto roundtrip = ztd::text::transcode_to_exact<std::u8string>(
+		     expected.output, ztd::text::utf16 {}, ztd::text::utf8 {});
+		REQUIRE(roundtrip.output == input);
+	}
+	SECTION("invalid") {
+		input.insert(40, u8"\xED\xA0\x80");
+		auto expected = ztd::text::transcode_to<std::u16string>(input, ztd::text::utf8 {}, ztd::text::utf16 {},
+		     ztd::text::replacement_handler {}, ztd::text::replacement_handler {});
+		auto result   = ztd::text::transcode_to_exact<std::u16string>(input, ztd::text::utf8 {},
+		       ztd::text::utf16 {}, ztd::text::replacement_handler {}, ztd::text::replacement_handler {});
+		REQUIRE(result.handled_error == expected.handled_error);
+		REQUIRE(result.output == expected.output);
+	}
+	SECTION("not sized") {
+		std::list<char8_t> list_input(input.cbegin(), input.cend());
+		auto expected = ztd::text::transcode_to<std::u16string>(input, ztd::text::utf8 {}, ztd::text::utf16 {});
+		auto result
+		     = ztd::text::transcode_to_exact<std::u16string>(list_input, ztd::text::utf8 {}, ztd::text::utf16 {});
+		REQUIRE(result.output == expected.output);
+	}
+}
+
+template <typename FromEncoding, typename ToEncoding, typename InputChar>
+void max_transcode_expansion_check(std::basic_string_view<InputChar> input) {
+	using OutputChar                 = ztd::text::code_unit_t<ToEncoding>;
+	const std::size_t max_output_size = input.size() * ztd::text::max_transcode_expansion_v<FromEncoding, ToEncoding>;
+	std::vector<OutputChar> storage(max_output_size);
+	auto result = ztd::text::transcode_into(input, FromEncoding {},
+	     ztd::text::subrange<OutputChar*>(storage.data(), storage.data() + storage.size()), ToEncoding {},
+	     ztd::text::replacement_handler {}, ztd::text::replacement_handler {});
+	REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+	REQUIRE(result.input.empty());
+}
+
+TEST_CASE("text/transcode/max_transcode_expansion",
+	"an output of the input's size times max_transcode_expansion_v always fits the result") {
+	// the worst cases: input made only of characters that grow the most, or only of errors
+	max_transcode_expansion_check<ztd::text::utf8, ztd::text::utf16>(std::u8string_view(u8"aé\U0001F600"));
+	max_transcode_expansion_check<ztd::text::utf8, ztd::text::utf8>(std::u8string_view(u8"\x80\xFF\xC3"));
+	max_transcode_expansion_check<ztd::text::utf16, ztd::text::utf8>(std::u16string_view(u"\x4E2D\xDC00\xD800"));
+	max_transcode_expansion_check<ztd::text::utf32, ztd::text::utf16>(std::u32string_view(U"\U0001F600\x110000"));
+	max_transcode_expansion_check<ztd::text::utf32, ztd::text::utf8>(std::u32string_view(U"\U0001F600\xD800"));
+	max_transcode_expansion_check<ztd::text::ascii, ztd::text::utf8>(std::string_view("a\x80\xFF"));
+}
+
+// an ASCII encoding written outside of the library, with only an encode_one: transcode_into decodes whole blocks of
+// code points before encoding them
+struct user_ascii : ztd::text::ascii { };
+
+// the same, but also encoding many code points at once through the text_encode extension point
+struct block_ascii : ztd::text::ascii {
+	static inline std::size_t text_encode_calls = 0;
+
+	template <typename Input, typename Output, typename ErrorHandler, typename State>
+	friend auto text_encode(Input&& input, const block_ascii& encoding, Output&& output,
+	     ErrorHandler&& error_handler, State& state) {
+		++text_encode_calls;
+		const ztd::text::ascii& plain_encoding = encoding;
+		return ztd::text::basic_encode_into(std::forward<Input>(input), plain_encoding, std::forward<Output>(output),
+		     std::forward<ErrorHandler>(error_handler), state);
+	}
+};
+
+template <typename ErrorHandler>
+struct counting_handler : ErrorHandler {
+	std::size_t* calls;
+
+	template <typename Encoding, typename Result, typename Progress>
+	auto operator()(const Encoding& encoding, Result result, const Progress& progress) const {
+		++*calls;
+		return ErrorHandler::operator()(encoding, std::move(result), progress);
+	}
+};
+
+template <typename BlockedEncoding, typename FromErrorHandler, typename ToErrorHandler>
+void blocked_transcode_check(std::u8string_view input, std::size_t output_size) {
+	std::list<char8_t> list_input(input.cbegin(), input.cend());
+	std::vector<char> blocked_storage(output_size + 1, '*');
+	std::vector<char> list_storage(output_size + 1, '*');
+	std::vector<char> plain_storage(output_size + 1, '*');
+	std::size_t blocked_calls = 0;
+	std::size_t list_calls    = 0;
+	std::size_t plain_calls   = 0;
+
+	auto blocked_result = ztd::text::transcode_into(input, ztd::text::utf8 {},
+	     ztd::text::subrange<char*>(blocked_storage.data(), blocked_storage.data() + output_size),
+	     BlockedEncoding {}, FromErrorHandler {}, counting_handler<ToErrorHandler> { {}, &blocked_calls });
+	auto list_result = ztd::text::transcode_into(list_input, ztd::text::utf8 {},
+	     ztd::text::subrange<char*>(list_storage.data(), list_storage.data() + output_size), BlockedEncoding {},
+	     FromErrorHandler {}, counting_handler<ToErrorHandler> { {}, &list_calls });
+	auto plain_result = ztd::text::transcode_into(input, ztd::text::utf8 {},
+	     ztd::text::subrange<char*>(plain_storage.data(), plain_storage.data() + output_size), ztd::text::ascii {},
+	     FromErrorHandler {}, counting_handler<ToErrorHandler> { {}, &plain_calls });
+	REQUIRE(blocked_result.error_code == plain_result.error_code);
+	REQUIRE(blocked_result.handled_error == plain_result.handled_error);
+	REQUIRE(blocked_result.input.size() == plain_result.input.size());
+	REQUIRE(blocked_result.output.size() == plain_result.output.size());
+	REQUIRE(blocked_storage == plain_storage);
+	// the error handler is never called twice for the same code point
+	REQUIRE(blocked_calls == plain_calls);
+	REQUIRE(list_result.error_code == plain_result.error_code);
+	REQUIRE(list_result.handled_error == plain_result.handled_error);
+	REQUIRE(static_cast<std::size_t>(std::distance(list_result.input.begin(), list_result.input.end()))
+	     == plain_result.input.size());
+	REQUIRE(list_storage == plain_storage);
+	REQUIRE(list_calls == plain_calls);
+}
+
+template <typename BlockedEncoding>
+void blocked_transcode_checks() {
+	std::u8string text;
+	for (int repeat = 0; repeat < 40; ++repeat) {
+		text += u8"The quick brown fox jumps over the lazy dog. ";
+	}
+	// a decoding error, then an encoding error, both in the middle of the first block
+	std::u8string decode_error_text = text;
+	decode_error_text.insert(100, u8"\xC3");
+	std::u8string encode_error_text = text;
+	encode_error_text.insert(300, u8"\u00E9");
+	// and an encoding error that gets fixed, before one that does not
+	std::u8string encode_errors_text = encode_error_text;
+	encode_errors_text.insert(200, u8"\u00E8");
+	const std::size_t output_sizes[] = { 0, 1, 99, 100, 101, 255, 256, 257, 299, 300, 301, 4000 };
+	for (std::size_t output_size : output_sizes) {
+		blocked_transcode_check<BlockedEncoding, ztd::text::replacement_handler, ztd::text::replacement_handler>(
+		     text, output_size);
+		blocked_transcode_check<BlockedEncoding, ztd::text::replacement_handler, ztd::text::replacement_handler>(
+		     decode_error_text, output_size);
+		blocked_transcode_check<BlockedEncoding, ztd::text::replacement_handler, ztd::text::replacement_handler>(
+		     encode_error_text, output_size);
+		blocked_transcode_check<BlockedEncoding, ztd::text::replacement_handler, ztd::text::replacement_handler>(
+		     encode_errors_text, output_size);
+		blocked_transcode_check<BlockedEncoding, ztd::text::pass_handler, ztd::text::pass_handler>(
+		     decode_error_text, output_size);
+		blocked_transcode_check<BlockedEncoding, ztd::text::pass_handler, ztd::text::pass_handler>(
+		     encode_error_text, output_size);
+		blocked_transcode_check<BlockedEncoding, ztd::text::replacement_handler, ztd::text::pass_handler>(
+		     encode_error_text, output_size);
+	}
+}
+
+TEST_CASE("text/transcode/blocked",
+	"transcoding into an encoding from outside of the library decodes blocks of code points and resumes like the "
+	"plain loop") {
+	blocked_transcode_checks<user_ascii>();
+	blocked_transcode_checks<block_ascii>();
+
+	std::u8string text;
+	for (int repeat = 0; repeat < 40; ++repeat) {
+		text += u8"The quick brown fox jumps over the lazy dog. ";
+	}
+	block_ascii::text_encode_calls = 0;
+	auto result = ztd::text::transcode_to<std::string>(text, ztd::text::utf8 {}, block_ascii {},
+	     ztd::text::replacement_handler {}, ztd::text::replacement_handler {});
+	REQUIRE(result.error_code == ztd::text::encoding_error::ok);
+	REQUIRE(result.output.size() == text.size());
+	REQUIRE(block_ascii::text_encode_calls <= (text.size() + 255) / 256);
+}
+
+template <typename Encoding, typename ToEncoding>
+void empty_input_check() {
+	using CodeUnit   = ztd::text::code_unit_t<Encoding>;
+	using ToCodeUnit = ztd::text::code_unit_t<ToEncoding>;
+	// a default-constructed view has no storage at all, so any read through it is caught right away
+	const std::basic_string_view<CodeUnit> input {};
+	const std::u32string_view code_points {};
+	auto decode_result = ztd::text::decode_to<std::u32string>(input, Encoding {}, ztd::text::assume_valid_handler {});
+	REQUIRE(decode_result.error_code == ztd::text::encoding_error::ok);
+	REQUIRE(decode_result.output.empty());
+	auto encode_result = ztd::text::encode_to<std::basic_string<CodeUnit>>(
+	     code_points, Encoding {}, ztd::text::assume_valid_handler {});
+	REQUIRE(encode_result.error_code == ztd::text::encoding_error::ok);
+	REQUIRE(encode_result.output.empty());
+	auto count_result = ztd::text::count_code_points(input, Encoding {}, ztd::text::assume_valid_handler {});
+	REQUIRE(count_result.error_code == ztd::text::encoding_error::ok);
+	REQUIRE(count_result.count == 0);
+	auto transcode_result = ztd::text::transcode_to<std::basic_string<ToCodeUnit>>(input, Encoding {},
+	     ToEncoding {}, ztd::text::assume_valid_handler {}, ztd::text::assume_valid_handler {});
+	REQUIRE(transcode_result.error_code == ztd::text::encoding_error::ok);
+	REQUIRE(transcode_result.output.empty());
+	auto back_result = ztd::text::transcode_to<std::basic_string<CodeUnit>>(std::basic_string_view<ToCodeUnit> {},
+	     ToEncoding {}, Encoding {}, ztd::text::assume_valid_handler {}, ztd::text::assume_valid_handler {});
+	REQUIRE(back_result.error_code == ztd::text::encoding_error::ok);
+	REQUIRE(back_result.output.empty());
+}
+
+TEST_CASE("text/transcode/empty assume_valid",
+	"empty input is never read from, even when the error handler says the input can be trusted") {
+	empty_input_check<ztd::text::utf8, ztd::text::utf16>();
+	empty_input_check<ztd::text::utf8, ztd::text::utf32>();
+	empty_input_check<ztd::text::utf16, ztd::text::utf8>();
+	empty_input_check<ztd::text::utf16, ztd::text::utf32>();
+	empty_input_check<ztd::text::utf32, ztd::text::utf16>();
+	empty_input_check<ztd::text::compat_utf8, ztd::text::utf8>();
+	empty_input_check<ztd::text::ascii, ztd::text::utf8>();
+	empty_input_check<ztd::text::execution, ztd::text::utf8>();
+	empty_input_check<ztd::text::wide_execution, ztd::text::utf16>();
+	empty_input_check<ztd::text::iso_8859_1, ztd::text::utf8>();
+	empty_input_check<ztd::text::windows_1252, ztd::text::utf16>();
+	empty_input_check<ztd::text::koi8_r, ztd::text::utf32>();
+
+	std::u16string_view literal_input(u"");
+	std::u8string u8_output = ztd::text::transcode<std::u8string>(literal_input, ztd::text::utf16 {},
+	     ztd::text::utf8 {}, ztd::text::assume_valid_handler {}, ztd::text::assume_valid_handler {});
+	REQUIRE(u8_output.empty());
+}
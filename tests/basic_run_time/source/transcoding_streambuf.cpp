@@ -0,0 +1,253 @@
+// =============================================================================
+//
+// ztd.text
+// Copyright © 2021 JeanHeyd "ThePhD" Meneide and Shepherd's Oasis, LLC
+// Contact: opensource@soasis.org
+//
+// Commercial License Usage
+// Licensees holding valid commercial ztd.text licenses may use this file in
+// accordance with the commercial license agreement provided with the
+// Software or, alternatively, in accordance with the terms contained in
+// a written agreement between you and Shepherd's Oasis, LLC.
+// For licensing terms and conditions see your agreement. For
+// further information contact opensource@soasis.org.
+//
+// Apache License Version 2 Usage
+// Alternatively, this file may be used under the terms of Apache License
+// Version 2.0 (the "License") for non-commercial use; you may not use this
+// file except in compliance with the License. You may obtain a copy of the
+// License at
+//
+//		http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <ztd/text/transcoding_streambuf.hpp>
+#include <ztd/text/encoding.hpp>
+#include <ztd/text/transcode.hpp>
+
+#include <ztd/text/tests/basic_unicode_strings.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+// hands out its characters one at a time, so that code units wider than a byte arrive split in two
+class trickle_streambuf : public std::streambuf {
+public:
+	trickle_streambuf(std::string_view data) : m_data(data), m_index(0) {
+	}
+
+protected:
+	int_type underflow() override {
+		if (m_index == m_data.size()) {
+			return traits_type::eof();
+		}
+		char* first = const_cast<char*>(m_data.data()) + m_index;
+		++m_index;
+		setg(first, first, first + 1);
+		return traits_type::to_int_type(*first);
+	}
+
+private:
+	std::string_view m_data;
+	std::size_t m_index;
+};
+
+// has no get area, so it never says how much it has ready: counts how often it is read from
+class counting_streambuf : public std::streambuf {
+public:
+	counting_streambuf(std::string_view data) : m_data(data), m_index(0), m_reads(0) {
+	}
+
+	std::size_t reads() const {
+		return m_reads;
+	}
+
+protected:
+	std::streamsize xsgetn(char* destination, std::streamsize count) override {
+		++m_reads;
+		const std::size_t read = (std::min)(static_cast<std::size_t>(count), m_data.size() - m_index);
+		std::copy_n(m_data.data() + m_index, read, destination);
+		m_index += read;
+		return static_cast<std::streamsize>(read);
+	}
+
+private:
+	std::string_view m_data;
+	std::size_t m_index;
+	std::size_t m_reads;
+};
+
+struct throw_error_code_handler {
+	template <typename Encoding, typename Result, typename Progress>
+	Result operator()(const Encoding&, Result result, const Progress&) const {
+		throw result.error_code;
+	}
+};
+
+template <typename CharType>
+std::string_view as_chars(std::basic_string_view<CharType> str) {
+	return std::string_view(reinterpret_cast<const char*>(str.data()), str.size() * sizeof(CharType));
+}
+
+TEST_CASE("text/transcoding_streambuf", "streams convert whole buffers, carrying over split sequences") {
+	const std::size_t buffer_sizes[] = { 4, 7, 8192 };
+	const std::size_t piece_sizes[]  = { 1, 3, 4096 };
+
+	SECTION("writing utf16 as utf8") {
+		const auto& input = ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+		const auto& expected
+		     = as_chars(std::u8string_view(ztd::text::tests::u8_unicode_sequence_truth_native_endian));
+		for (std::size_t buffer_size : buffer_sizes) {
+			for (std::size_t piece_size : piece_sizes) {
+				std::stringbuf sink;
+				{
+					ztd::text::basic_transcoding_streambuf<ztd::text::utf16, ztd::text::utf8> buf(
+					     &sink, buffer_size);
+					std::basic_ostream<char16_t> stream(&buf);
+					for (std::size_t index = 0; index < input.size(); index += piece_size) {
+						stream.write(input.data() + index,
+						     static_cast<std::streamsize>((std::min)(piece_size, input.size() - index)));
+					}
+					REQUIRE(stream.flush().good());
+				}
+				REQUIRE(sink.str() == expected);
+			}
+		}
+	}
+	SECTION("reading utf8 as utf16") {
+		const auto& input
+		     = as_chars(std::u8string_view(ztd::text::tests::u8_unicode_sequence_truth_native_endian));
+		const auto& expected = ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+		for (std::size_t buffer_size : buffer_sizes) {
+			std::stringbuf source { std::string(input) };
+			ztd::text::basic_transcoding_streambuf<ztd::text::utf16, ztd::text::utf8> buf(&source, buffer_size);
+			std::basic_istream<char16_t> stream(&buf);
+			std::u16string output { std::istreambuf_iterator<char16_t>(stream),
+				std::istreambuf_iterator<char16_t>() };
+			REQUIRE(output == expected);
+
+			trickle_streambuf trickle(input);
+			ztd::text::basic_transcoding_streambuf<ztd::text::utf16, ztd::text::utf8> trickle_buf(
+			     &trickle, buffer_size);
+			std::basic_istream<char16_t> trickle_stream(&trickle_buf);
+			std::u16string trickle_output { std::istreambuf_iterator<char16_t>(trickle_stream),
+				std::istreambuf_iterator<char16_t>() };
+			REQUIRE(trickle_output == expected);
+		}
+
+		// a source that cannot say what it has ready is still read a full buffer at a time
+		std::string long_input;
+		for (int repeat = 0; repeat < 64; ++repeat) {
+			long_input += input;
+		}
+		std::u16string long_expected;
+		for (int repeat = 0; repeat < 64; ++repeat) {
+			long_expected += expected;
+		}
+		counting_streambuf counting(long_input);
+		ztd::text::basic_transcoding_streambuf<ztd::text::utf16, ztd::text::utf8> counting_buf(&counting, 4096);
+		std::basic_istream<char16_t> counting_stream(&counting_buf);
+		std::u16string counting_output { std::istreambuf_iterator<char16_t>(counting_stream),
+			std::istreambuf_iterator<char16_t>() };
+		REQUIRE(counting_output == long_expected);
+		REQUIRE(counting.reads() <= long_input.size() / 4096 + 2);
+	}
+	SECTION("utf8 through utf16 and back") {
+		const std::u8string_view input = ztd::text::tests::u8_unicode_sequence_truth_native_endian;
+		const auto& expected
+		     = as_chars(std::u16string_view(ztd::text::tests::u16_unicode_sequence_truth_native_endian));
+		for (std::size_t buffer_size : buffer_sizes) {
+			std::stringbuf sink;
+			{
+				ztd::text::basic_transcoding_streambuf<ztd::text::utf8, ztd::text::utf16> buf(&sink, buffer_size);
+				REQUIRE(buf.sputn(input.data(), static_cast<std::streamsize>(input.size()))
+				     == static_cast<std::streamsize>(input.size()));
+			}
+			const std::string written = sink.str();
+			REQUIRE(written == expected);
+
+			trickle_streambuf trickle(written);
+			ztd::text::basic_transcoding_streambuf<ztd::text::utf8, ztd::text::utf16> buf(&trickle, buffer_size);
+			std::u8string output(input.size(), u8'\0');
+			REQUIRE(buf.sgetn(output.data(), static_cast<std::streamsize>(output.size()))
+			     == static_cast<std::streamsize>(output.size()));
+			REQUIRE(output == input);
+			REQUIRE(std::char_traits<char8_t>::eq_int_type(buf.sgetc(), std::char_traits<char8_t>::eof()));
+		}
+	}
+	SECTION("full buffers are not errors") {
+		using throwing_streambuf = ztd::text::basic_transcoding_streambuf<ztd::text::utf16, ztd::text::utf8,
+		     throw_error_code_handler, throw_error_code_handler>;
+		const auto& input = ztd::text::tests::u16_unicode_sequence_truth_native_endian;
+		const auto& expected
+		     = as_chars(std::u8string_view(ztd::text::tests::u8_unicode_sequence_truth_native_endian));
+		for (std::size_t buffer_size : buffer_sizes) {
+			// utf16 grows into utf8, so the write buffer fills up on every sync
+			std::stringbuf sink;
+			{
+				throwing_streambuf buf(&sink, buffer_size);
+				std::basic_ostream<char16_t> stream(&buf);
+				stream.write(input.data(), static_cast<std::streamsize>(input.size()));
+				REQUIRE(stream.flush().good());
+			}
+			REQUIRE(sink.str() == expected);
+
+			std::stringbuf source { std::string(expected) };
+			throwing_streambuf buf(&source, buffer_size);
+			std::basic_istream<char16_t> stream(&buf);
+			std::u16string output { std::istreambuf_iterator<char16_t>(stream),
+				std::istreambuf_iterator<char16_t>() };
+			REQUIRE(output == input);
+		}
+
+		// an error while the destructor writes out what is left is not thrown out of it
+		std::stringbuf sink;
+		{
+			throwing_streambuf buf(&sink);
+			const std::u16string_view cut_off = u"a\xD800";
+			REQUIRE(buf.sputn(cut_off.data(), static_cast<std::streamsize>(cut_off.size()))
+			     == static_cast<std::streamsize>(cut_off.size()));
+		}
+		REQUIRE(sink.str() == "a");
+	}
+	SECTION("errors") {
+		// an invalid byte in the middle and a sequence cut off at the very end
+		std::string input(as_chars(std::u8string_view(u8"abc\U0001F600")));
+		input.insert(input.begin() + 1, '\xFF');
+		input.pop_back();
+		const std::u16string expected = u"a\uFFFDbc\uFFFD";
+
+		std::stringbuf source(input);
+		ztd::text::basic_transcoding_streambuf<ztd::text::utf16, ztd::text::utf8, ztd::text::replacement_handler,
+		     ztd::text::replacement_handler>
+		     buf(&source);
+		std::basic_istream<char16_t> stream(&buf);
+		std::u16string output { std::istreambuf_iterator<char16_t>(stream), std::istreambuf_iterator<char16_t>() };
+		REQUIRE(output == expected);
+
+		std::stringbuf sink;
+		{
+			ztd::text::basic_transcoding_streambuf<ztd::text::utf8, ztd::text::utf16, ztd::text::replacement_handler,
+			     ztd::text::replacement_handler>
+			     write_buf(&sink);
+			write_buf.sputn(
+			     reinterpret_cast<const char8_t*>(input.data()), static_cast<std::streamsize>(input.size()));
+		}
+		REQUIRE(sink.str() == as_chars(std::u16string_view(expected)));
+	}
+}
@@ -90,3 +90,42 @@ TEST_CASE("text/validate_code_units/basic", "basic usages of validate_code_units
 		validate_check(ztd::text::tests::u32_unicode_sequence_truth_native_endian, encoding);
 	}
 }
+
+TEST_CASE("text/validate_code_units/utf8 errors",
+	"validate_code_units on contiguous UTF-8 stops at the first ill-formed sequence, wherever it is") {
+	const std::u8string_view bad_sequences[] = {
+		u8"\x80",             // lone continuation
+		u8"\xC0\xAF",         // invalid lead
+		u8"\xE0\x80\xAF",     // overlong
+		u8"\xED\xA0\x80",     // surrogate
+		u8"\xF4\x90\x80\x80", // above U+10FFFF
+		u8"\xF8\x88\x80\x80", // 5-byte lead
+		u8"\xE2\x82",         // truncated, followed by more text
+		u8"\xF0\x9F\x98",     // truncated, at the end
+	};
+	const std::u8string_view fillers[] = { u8"a", u8"é", u8"中", u8"\U0001F600" };
+	for (std::size_t prefix_size = 0; prefix_size < 80; prefix_size += 7) {
+		for (const auto& filler : fillers) {
+			std::u8string prefix;
+			while (prefix.size() < prefix_size) {
+				prefix += filler;
+			}
+			for (std::size_t bad_index = 0; bad_index < std::size(bad_sequences); ++bad_index) {
+				const bool at_end = bad_index + 1 == std::size(bad_sequences);
+				std::u8string text(prefix);
+				text += bad_sequences[bad_index];
+				if (!at_end) {
+					text += u8"abcdefghijklmnopqrstuvwxyzé中";
+				}
+				std::u8string_view text_view(text);
+				auto result = ztd::text::validate_code_units(text_view, ztd::text::utf8 {});
+				REQUIRE_FALSE(result.valid);
+				REQUIRE(text_view.size() - result.input.size() == prefix.size());
+			}
+			std::u8string_view prefix_view(prefix);
+			auto result = ztd::text::validate_code_units(prefix_view, ztd::text::utf8 {});
+			REQUIRE(result.valid);
+			REQUIRE(result.input.empty());
+		}
+	}
+}